@@ -64,6 +64,7 @@ struct PipelineLayoutDescriptor;
 struct QueryHeapDescriptor;
 struct QueryPipelineStatistics;
 struct RasterizerDescriptor;
+struct RendererConfigurationNull;
 struct RendererConfigurationOpenGL;
 struct RendererConfigurationVulkan;
 struct RendererInfo;
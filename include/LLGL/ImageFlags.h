@@ -22,6 +22,29 @@ namespace LLGL
 {
 
 
+/* ----- Enumerations ----- */
+
+/**
+\brief Block compression mode enumeration.
+\see CompressImageBuffer
+*/
+enum class ImageCompressionMode
+{
+    /**
+    \brief Fast compression that spans the endpoints of each block over the range of its colors along their principal axis (range fit).
+    \remarks This is meant for run-time compression, e.g. of streamed content.
+    */
+    RangeFit,
+
+    /**
+    \brief Higher quality compression that searches all clusterings of the colors along their principal axis for the best endpoints (cluster fit).
+    \remarks Single channel blocks (BC4, BC5, and the alpha of BC3) refine their endpoints iteratively instead.
+    This is considerably slower than ImageCompressionMode::RangeFit and is meant for offline texture ingestion.
+    */
+    ClusterFit,
+};
+
+
 /* ----- Types ----- */
 
 /**
@@ -175,6 +198,9 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
 If this is less than 2, no multi-threading is used. If this is 'Constants::maxThreadCount',
 the maximal count of threads the system supports will be used (e.g. 4 on a quad-core processor). By default 0.
 \return Byte buffer with the decompressed image data or null if the compression format is not supported for decompression.
+\remarks Supported compression formats are ImageFormat::BC1, ImageFormat::BC2, ImageFormat::BC3, ImageFormat::BC4, and ImageFormat::BC5.
+For BC4 and BC5, the data type DataType::Int8 denotes signed data (e.g. Format::BC4SNorm), which is mapped from the range [-1, 1] to [0, 1].
+Missing color components are decompressed to zero and missing alpha components to one.
 */
 LLGL_EXPORT ByteBuffer DecompressImageBufferToRGBA8UNorm(
     const SrcImageDescriptor&   srcImageDesc,
@@ -182,6 +208,36 @@ LLGL_EXPORT ByteBuffer DecompressImageBufferToRGBA8UNorm(
     unsigned                    threadCount = 0
 );
 
+/**
+\brief Compresses the specified image buffer to a block compression format.
+\param[in] srcImageDesc Specifies the source image descriptor. This must be an uncompressed color format.
+Images that are not in RGBA format with DataType::UInt8 are converted before compression.
+\param[in] extent Specifies the image extent. Blocks at the right and bottom border of images whose extent is not a multiple of 4 repeat the border pixels.
+\param[in] dstFormat Specifies the destination compression format. This must be ImageFormat::BC1, ImageFormat::BC2, ImageFormat::BC3, ImageFormat::BC4, or ImageFormat::BC5.
+BC1 blocks with pixels whose alpha is less than 0.5 use 1-bit transparency.
+\param[in] dstDataType Specifies the destination data type. For BC4 and BC5, DataType::Int8 denotes signed data (e.g. Format::BC4SNorm),
+which is mapped from the range [0, 1] to [-1, 1]. Otherwise, this must be DataType::UInt8.
+\param[in] mode Specifies the compression mode to trade quality for speed. By default ImageCompressionMode::RangeFit.
+\param[in] threadCount Specifies the number of threads to use for compression.
+If this is less than 2, no multi-threading is used. If this is 'Constants::maxThreadCount',
+the maximal count of threads the system supports will be used (e.g. 4 on a quad-core processor). By default 0.
+\return Byte buffer with the compressed image data or null if the compression format is not supported for compression.
+The buffer holds the 4x4 blocks in row-major order, i.e. 8 bytes per block for BC1 and BC4, and 16 bytes per block otherwise.
+\throw std::invalid_argument If the source buffer is a null pointer.
+\throw std::invalid_argument If the source image is compressed or has a depth-stencil format.
+\throw std::invalid_argument If the source buffer size does not match the image extent.
+\throw std::invalid_argument If the destination data type is neither DataType::UInt8 nor DataType::Int8 for BC4 and BC5.
+\see DecompressImageBufferToRGBA8UNorm
+*/
+LLGL_EXPORT ByteBuffer CompressImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent2D&             extent,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType = DataType::UInt8,
+    ImageCompressionMode        mode        = ImageCompressionMode::RangeFit,
+    unsigned                    threadCount = 0
+);
+
 /**
 \brief Copies an image buffer region from the source buffer to the destination buffer.
 \param[out] dstImageDesc Specifies the destination image descriptor.
@@ -225,6 +281,7 @@ LLGL_EXPORT void CopyImageBufferRegion(
 \param[in] dataType Specifies the data type of each component of each pixel in the output image.
 \param[in] imageSize Specifies the 1-Dimensional size (in pixels) of the output image. For a 2D image, this can be width times height for instance.
 \param[in] fillColor Specifies the color to fill the image for each pixel.
+For ImageFormat::Depth and ImageFormat::DepthStencil, the leading components of the fill color are used.
 \return The new allocated and initialized byte buffer.
 \remarks This can be used to generate a single-colored n-Dimensional image.
 Usage example for a 2D image:
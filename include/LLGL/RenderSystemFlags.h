@@ -296,6 +296,7 @@ struct RenderSystemDescriptor
     \see RendererConfigurationVulkan
     \see RendererConfigurationOpenGL
     \see RendererConfigurationOpenGLES3
+    \see RendererConfigurationNull
     */
     const void*     rendererConfig      = nullptr;
 
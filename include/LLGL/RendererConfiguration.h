@@ -10,7 +10,9 @@
 
 
 #include <LLGL/Container/ArrayView.h>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 
 
 namespace LLGL
@@ -39,8 +41,98 @@ enum class OpenGLContextProfile
 };
 
 
+/**
+\brief Null renderer frame capture format enumeration.
+\see RendererConfigurationNull::frameCaptureFormat
+*/
+enum class NullFrameCaptureFormat
+{
+    //! Captured frames are not written to files.
+    None,
+
+    //! Raw RGBA pixel data with 8 bits per component and without any header. File extension is ".raw".
+    Raw,
+
+    //! Binary Portable Pixmap (P6) with 8-bit RGB pixel data. File extension is ".ppm".
+    PPM,
+
+    //! Portable Network Graphics with uncompressed 8-bit RGBA pixel data. File extension is ".png".
+    PNG,
+};
+
+
+/* ----- Types ----- */
+
+/**
+\brief Callback for frames captured by the Null renderer.
+\param[in] frame Specifies the zero-based index of the captured frame.
+\param[in] width Specifies the width (in pixels) of the captured frame.
+\param[in] height Specifies the height (in pixels) of the captured frame.
+\param[in] data Pointer to the RGBA pixel data with 8 bits per component and without row padding.
+This pointer is only valid during the callback.
+\see RendererConfigurationNull::frameCaptureCallback
+*/
+using NullFrameCaptureCallback = std::function<void(std::uint64_t frame, std::uint32_t width, std::uint32_t height, const void* data)>;
+
+struct NullCommandCost;
+
+/**
+\brief Callback for the estimated costs of all draw and dispatch commands of an executed command buffer.
+\param[in] numCommands Specifies the number of entries in \c commands.
+\param[in] commands Pointer to the cost estimates in the order the commands were executed.
+This pointer, including the debug group strings, is only valid during the callback.
+\see RendererConfigurationNull::performanceModelCallback
+*/
+using NullPerformanceModelCallback = std::function<void(std::size_t numCommands, const NullCommandCost* commands)>;
+
+
 /* ----- Structures ----- */
 
+/**
+\brief Estimated cost of a single draw or dispatch command executed by the Null renderer.
+\remarks All values are estimates derived from the bound states and the Null rasterizer. They are meant to detect changes between runs,
+not to predict the absolute cost on a particular GPU.
+\see NullPerformanceModelCallback
+*/
+struct NullCommandCost
+{
+    /**
+    \brief Name of the debug group the command was recorded in, or an empty string if there is none.
+    \remarks Nested debug groups are joined with a slash, e.g. "Scene/Shadows".
+    \see CommandBuffer::PushDebugGroup
+    */
+    const char*     debugGroup          = "";
+
+    //! Specifies whether this is a compute dispatch. Otherwise, it is a draw command.
+    bool            isDispatch          = false;
+
+    //! Number of bytes fetched from vertex buffers, derived from the vertex shader invocations and the vertex input layout.
+    std::uint64_t   vertexFetchBytes    = 0;
+
+    //! Number of bytes read from the index buffer.
+    std::uint64_t   indexBytes          = 0;
+
+    /**
+    \brief Number of bytes read from the bound textures.
+    \remarks Each pixel that passed the depth and stencil tests (or each compute invocation) is assumed to read one texel of each bound texture,
+    but not more than the total size of all bound textures per command.
+    */
+    std::uint64_t   textureBytes        = 0;
+
+    /**
+    \brief Number of pixels covered by rasterized primitives, including those that failed the depth or stencil test.
+    \remarks Pixels of screen tiles that are rejected entirely by the hierarchical depth test are not rasterized and not counted.
+    */
+    std::uint64_t   rasterizedPixels    = 0;
+
+    /**
+    \brief Number of vertex, fragment, and compute shader invocations.
+    \remarks Fragment shader invocations are counted per rasterized pixel. Compute shader invocations are only counted if the Null renderer
+    was built with SPIR-V reflection, since the work group size is not known otherwise.
+    */
+    std::uint64_t   shaderInvocations   = 0;
+};
+
 /**
 \brief Application descriptor structure.
 \note Only supported with: Vulkan.
@@ -99,6 +191,42 @@ struct RendererConfigurationVulkan
     bool                        reduceDeviceMemoryFragmentation = false;
 };
 
+/**
+\brief Structure for a Null renderer specific configuration.
+\remarks Frame capture is enabled if either \c frameCaptureFormat is not NullFrameCaptureFormat::None or \c frameCaptureCallback is set.
+Each call to SwapChain::Present then enqueues a copy of the back buffer into a ring of frames that are encoded by a background thread.
+The copy is made by the command queue once all previously submitted command buffers have been executed.
+The performance model is enabled if \c performanceModelCallback is set.
+*/
+struct RendererConfigurationNull
+{
+    //! Specifies the file format for captured frames. By default NullFrameCaptureFormat::None.
+    NullFrameCaptureFormat      frameCaptureFormat      = NullFrameCaptureFormat::None;
+
+    /**
+    \brief Specifies the path prefix for captured frame files. By default "frame".
+    \remarks The zero-padded frame index and the file extension are appended, e.g. "frame000042.png".
+    */
+    const char*                 frameCapturePath        = "frame";
+
+    //! Optional callback that is invoked on the background thread for each captured frame, e.g. to forward frames to a shared-memory segment.
+    NullFrameCaptureCallback    frameCaptureCallback;
+
+    /**
+    \brief Specifies the number of frames that can be in flight for encoding. By default 3.
+    \remarks If all frames are in flight, the command queue delays subsequent submissions until the background thread has encoded the oldest one.
+    */
+    std::uint32_t               frameCaptureRingSize    = 3;
+
+    /**
+    \brief Optional callback that enables the performance model and receives the estimated costs of each executed command buffer.
+    \remarks This is invoked once per command buffer after its commands have been executed, including command buffers without draw or dispatch commands.
+    Invocations are serialized, but may happen on a different thread than the one that submitted the command buffer.
+    \see NullCommandCost
+    */
+    NullPerformanceModelCallback performanceModelCallback;
+};
+
 /**
 \brief OpenGL profile descriptor structure.
 \note On MacOS the only supported OpenGL profiles are compatibility profile (for lagecy OpenGL before 3.0), 3.2 core profile, or 4.1 core profile.
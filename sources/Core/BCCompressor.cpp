@@ -0,0 +1,741 @@
+/*
+ * BCCompressor.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "BCCompressor.h"
+#include "Threading.h"
+#include <LLGL/Types.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+// Pixels of a single 4x4 block in RGBA8 format.
+struct BCBlockPixels
+{
+    std::uint8_t pixels[16][4];
+};
+
+// Encoded color block with its squared error to the original pixels.
+struct BCColorCandidate
+{
+    std::uint16_t   color0  = 0;
+    std::uint16_t   color1  = 0;
+    std::uint32_t   indices = 0;
+    int             error   = std::numeric_limits<int>::max();
+};
+
+// Encoded single channel block with its squared error to the original values.
+struct BCChannelCandidate
+{
+    int             value0  = 0;
+    int             value1  = 0;
+    std::uint64_t   indices = 0;
+    int             error   = std::numeric_limits<int>::max();
+};
+
+// Function signature to encode one 4x4 block into 8 or 16 bytes.
+using CompressBCBlockFunc = void (*)(const BCBlockPixels& block, bool isSigned, ImageCompressionMode mode, std::uint8_t* dst);
+
+
+/* ----- Color blocks ----- */
+
+// Expands a 16-bit RGB565 color to RGB8 in the same way as the decompressor.
+static void ExpandRGB565(std::uint32_t color, int (&rgb)[3])
+{
+    const int r = (color >> 11) & 0x1F;
+    const int g = (color >>  5) & 0x3F;
+    const int b = (color      ) & 0x1F;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+static int QuantizeComponent(float value, int maxValue)
+{
+    return std::max(0, std::min(maxValue, static_cast<int>(value * static_cast<float>(maxValue) / 255.0f + 0.5f)));
+}
+
+// Quantizes the specified RGB color in the range [0, 255] to a 16-bit RGB565 color.
+static std::uint16_t QuantizeRGB565(const float (&rgb)[3])
+{
+    return static_cast<std::uint16_t>(
+        QuantizeComponent(rgb[0], 31) << 11 |
+        QuantizeComponent(rgb[1], 63) <<  5 |
+        QuantizeComponent(rgb[2], 31)
+    );
+}
+
+// Builds the color palette of the specified endpoints like the decompressor and returns the number of opaque palette entries.
+static int BuildColorPalette(std::uint32_t color0, std::uint32_t color1, bool isThreeColorMode, int (&palette)[4][3])
+{
+    ExpandRGB565(color0, palette[0]);
+    ExpandRGB565(color1, palette[1]);
+
+    for_range(i, 3)
+    {
+        if (isThreeColorMode)
+            palette[2][i] = (palette[0][i] + palette[1][i]) / 2;
+        else
+        {
+            palette[2][i] = (2 * palette[0][i] + palette[1][i] + 1) / 3;
+            palette[3][i] = (palette[0][i] + 2 * palette[1][i] + 1) / 3;
+        }
+    }
+
+    return (isThreeColorMode ? 3 : 4);
+}
+
+// Selects the closest palette entry for each pixel and sums up the squared errors. Transparent pixels select index 3 in three-color mode.
+static void SelectColorIndices(const BCBlockPixels& block, std::uint32_t transparentMask, bool isThreeColorMode, BCColorCandidate& candidate)
+{
+    int palette[4][3];
+    const int numColors = BuildColorPalette(candidate.color0, candidate.color1, isThreeColorMode, palette);
+
+    candidate.indices   = 0;
+    candidate.error     = 0;
+
+    for_range(i, 16u)
+    {
+        if ((transparentMask & (1u << i)) != 0)
+        {
+            candidate.indices |= (3u << (i * 2));
+            continue;
+        }
+
+        std::uint32_t   bestIndex = 0;
+        int             bestError = std::numeric_limits<int>::max();
+
+        for_range(j, numColors)
+        {
+            int error = 0;
+            for_range(c, 3)
+            {
+                const int delta = palette[j][c] - static_cast<int>(block.pixels[i][c]);
+                error += delta * delta;
+            }
+            if (error < bestError)
+            {
+                bestIndex = static_cast<std::uint32_t>(j);
+                bestError = error;
+            }
+        }
+
+        candidate.indices   |= (bestIndex << (i * 2));
+        candidate.error     += bestError;
+    }
+}
+
+// Quantizes the specified endpoints and selects the indices. Blocks with transparent pixels are encoded in three-color mode.
+static BCColorCandidate MakeColorCandidate(const BCBlockPixels& block, const float (&start)[3], const float (&end)[3], std::uint32_t transparentMask)
+{
+    BCColorCandidate candidate;
+
+    std::uint16_t color0 = QuantizeRGB565(start);
+    std::uint16_t color1 = QuantizeRGB565(end);
+
+    /* Four-color mode requires the first endpoint to be greater than the second one, three-color mode the opposite */
+    const bool isThreeColorMode = (transparentMask != 0);
+    if (isThreeColorMode ? (color0 > color1) : (color0 < color1))
+        std::swap(color0, color1);
+
+    candidate.color0 = color0;
+    candidate.color1 = color1;
+
+    /* Equal endpoints are decoded in three-color mode, so the fourth palette entry must not be selected */
+    SelectColorIndices(block, transparentMask, (isThreeColorMode || color0 == color1), candidate);
+
+    return candidate;
+}
+
+// Runs power iteration on the covariance matrix from the specified seed axis and returns the variance along the resulting unit axis.
+static float IteratePrincipalAxis(const float (&covariance)[3][3], float (&axis)[3])
+{
+    for_range(iteration, 8)
+    {
+        float next[3];
+        for_range(row, 3)
+            next[row] = covariance[row][0] * axis[0] + covariance[row][1] * axis[1] + covariance[row][2] * axis[2];
+
+        /* Normalize by the largest component */
+        const float scale = std::max(std::abs(next[0]), std::max(std::abs(next[1]), std::abs(next[2])));
+        if (scale <= 0.0f)
+            return 0.0f;
+
+        for_range(c, 3)
+            axis[c] = next[c] / scale;
+    }
+
+    const float length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    for_range(c, 3)
+        axis[c] /= length;
+
+    float variance = 0.0f;
+    for_range(row, 3)
+        variance += axis[row] * (covariance[row][0] * axis[0] + covariance[row][1] * axis[1] + covariance[row][2] * axis[2]);
+
+    return variance;
+}
+
+// Computes the mean and the principal axis of the specified colors. The axis is zero if all colors are equal.
+static void ComputePrincipalAxis(const float (*colors)[3], int numColors, float (&mean)[3], float (&axis)[3])
+{
+    for_range(c, 3)
+    {
+        mean[c] = 0.0f;
+        for_range(i, numColors)
+            mean[c] += colors[i][c];
+        mean[c] /= static_cast<float>(numColors);
+    }
+
+    float covariance[3][3] = {};
+    for_range(i, numColors)
+    {
+        const float delta[3] = { colors[i][0] - mean[0], colors[i][1] - mean[1], colors[i][2] - mean[2] };
+        for_range(row, 3)
+        {
+            for_range(col, 3)
+                covariance[row][col] += delta[row] * delta[col];
+        }
+    }
+
+    /*
+    Seed power iteration with each row of the covariance matrix and keep the axis of the greatest variance.
+    A single seed can be orthogonal to the principal axis, e.g. (1, 1, 1) for a red and green checkerboard that varies along (1, -1, 0).
+    A row is zero if its diagonal entry is zero, and all rows are zero only if all colors are equal.
+    */
+    axis[0] = axis[1] = axis[2] = 0.0f;
+
+    float maxVariance = 0.0f;
+    for_range(seed, 3)
+    {
+        if (covariance[seed][seed] <= 0.0f)
+            continue;
+
+        float seedAxis[3] = { covariance[seed][0], covariance[seed][1], covariance[seed][2] };
+        const float variance = IteratePrincipalAxis(covariance, seedAxis);
+        if (variance > maxVariance)
+        {
+            maxVariance = variance;
+            std::copy(seedAxis, seedAxis + 3, axis);
+        }
+    }
+}
+
+static float Dot(const float (&lhs)[3], const float (&rhs)[3])
+{
+    return (lhs[0] * rhs[0] + lhs[1] * rhs[1] + lhs[2] * rhs[2]);
+}
+
+// Spans the endpoints over the range of the colors projected onto their principal axis.
+static BCColorCandidate FitColorRange(const BCBlockPixels& block, const float (*colors)[3], int numColors, std::uint32_t transparentMask)
+{
+    float mean[3], axis[3];
+    ComputePrincipalAxis(colors, numColors, mean, axis);
+
+    float minProjection = 0.0f, maxProjection = 0.0f;
+    for_range(i, numColors)
+    {
+        const float delta[3]    = { colors[i][0] - mean[0], colors[i][1] - mean[1], colors[i][2] - mean[2] };
+        const float projection  = Dot(delta, axis);
+        minProjection = std::min(minProjection, projection);
+        maxProjection = std::max(maxProjection, projection);
+    }
+
+    float start[3], end[3];
+    for_range(c, 3)
+    {
+        start[c]    = mean[c] + axis[c] * maxProjection;
+        end[c]      = mean[c] + axis[c] * minProjection;
+    }
+
+    return MakeColorCandidate(block, start, end, transparentMask);
+}
+
+// Rounds the specified RGB color in the range [0, 255] to the closest color of the RGB565 grid.
+static void SnapToRGB565Grid(float (&rgb)[3])
+{
+    const int maxValues[3] = { 31, 63, 31 };
+    for_range(c, 3)
+    {
+        rgb[c] = std::max(0.0f, std::min(255.0f, rgb[c]));
+        rgb[c] = static_cast<float>(QuantizeComponent(rgb[c], maxValues[c])) * 255.0f / static_cast<float>(maxValues[c]);
+    }
+}
+
+/*
+Orders the colors along their principal axis and tries every partition into four consecutive clusters, one per palette entry.
+For each partition, the endpoints are solved with least squares and snapped to the RGB565 grid before their error is compared.
+*/
+static BCColorCandidate FitColorClusters(const BCBlockPixels& block, const float (*colors)[3], int numColors)
+{
+    float mean[3], axis[3];
+    ComputePrincipalAxis(colors, numColors, mean, axis);
+
+    /* Sort colors by their projection onto the principal axis */
+    int order[16];
+    float projections[16];
+    for_range(i, numColors)
+    {
+        order[i]        = i;
+        projections[i]  = Dot(colors[i], axis);
+    }
+    std::sort(order, order + numColors, [&projections](int lhs, int rhs) { return (projections[lhs] < projections[rhs]); });
+
+    float prefixSums[17][3] = {};
+    for_range(i, numColors)
+    {
+        for_range(c, 3)
+            prefixSums[i + 1][c] = prefixSums[i][c] + colors[order[i]][c];
+    }
+
+    float   bestError = std::numeric_limits<float>::max();
+    float   bestStart[3], bestEnd[3];
+
+    for (int count0 = 0; count0 <= numColors; ++count0)
+    {
+        for (int count1 = 0; count0 + count1 <= numColors; ++count1)
+        {
+            for (int count2 = 0; count0 + count1 + count2 <= numColors; ++count2)
+            {
+                const int end0  = count0;
+                const int end1  = end0 + count1;
+                const int end2  = end1 + count2;
+                const int count3 = numColors - end2;
+
+                /* Weights of the start and end point for the clusters with the palette entries 0, 2/3, 1/3, and 1 */
+                const float alpha2      = static_cast<float>(count0) + static_cast<float>(count1) * (4.0f/9.0f) + static_cast<float>(count2) * (1.0f/9.0f);
+                const float beta2       = static_cast<float>(count3) + static_cast<float>(count1) * (1.0f/9.0f) + static_cast<float>(count2) * (4.0f/9.0f);
+                const float alphaBeta   = static_cast<float>(count1 + count2) * (2.0f/9.0f);
+                const float det         = alpha2 * beta2 - alphaBeta * alphaBeta;
+
+                if (std::abs(det) < 1.0e-6f)
+                    continue;
+
+                float start[3], end[3];
+                for_range(c, 3)
+                {
+                    const float sum0    = prefixSums[end0][c];
+                    const float sum1    = prefixSums[end1][c] - prefixSums[end0][c];
+                    const float sum2    = prefixSums[end2][c] - prefixSums[end1][c];
+                    const float sum3    = prefixSums[numColors][c] - prefixSums[end2][c];
+                    const float alphaX  = sum0 + sum1 * (2.0f/3.0f) + sum2 * (1.0f/3.0f);
+                    const float betaX   = sum3 + sum1 * (1.0f/3.0f) + sum2 * (2.0f/3.0f);
+                    start[c]    = (alphaX * beta2 - betaX * alphaBeta) / det;
+                    end[c]      = (betaX * alpha2 - alphaX * alphaBeta) / det;
+                }
+
+                SnapToRGB565Grid(start);
+                SnapToRGB565Grid(end);
+
+                /* Squared error of this partition without the constant sum of squared colors */
+                float error = 0.0f;
+                for_range(c, 3)
+                {
+                    const float sum0    = prefixSums[end0][c];
+                    const float sum1    = prefixSums[end1][c] - prefixSums[end0][c];
+                    const float sum2    = prefixSums[end2][c] - prefixSums[end1][c];
+                    const float sum3    = prefixSums[numColors][c] - prefixSums[end2][c];
+                    const float alphaX  = sum0 + sum1 * (2.0f/3.0f) + sum2 * (1.0f/3.0f);
+                    const float betaX   = sum3 + sum1 * (1.0f/3.0f) + sum2 * (2.0f/3.0f);
+                    error +=
+                    (
+                        start[c] * start[c] * alpha2 + end[c] * end[c] * beta2 +
+                        2.0f * (start[c] * end[c] * alphaBeta - start[c] * alphaX - end[c] * betaX)
+                    );
+                }
+
+                if (error < bestError)
+                {
+                    bestError = error;
+                    std::copy(start, start + 3, bestStart);
+                    std::copy(end, end + 3, bestEnd);
+                }
+            }
+        }
+    }
+
+    if (bestError == std::numeric_limits<float>::max())
+        return BCColorCandidate{};
+
+    return MakeColorCandidate(block, bestStart, bestEnd, 0);
+}
+
+// Encodes the color part of a block into 8 bytes. BC1 pixels with an alpha below one half are encoded as transparent black.
+static void EncodeColorBlock(const BCBlockPixels& block, bool allowTransparency, ImageCompressionMode mode, std::uint8_t* dst)
+{
+    float           colors[16][3];
+    int             numColors       = 0;
+    std::uint32_t   transparentMask = 0;
+
+    for_range(i, 16u)
+    {
+        if (allowTransparency && block.pixels[i][3] < 128)
+            transparentMask |= (1u << i);
+        else
+        {
+            for_range(c, 3)
+                colors[numColors][c] = static_cast<float>(block.pixels[i][c]);
+            ++numColors;
+        }
+    }
+
+    BCColorCandidate candidate;
+    if (numColors > 0)
+    {
+        candidate = FitColorRange(block, colors, numColors, transparentMask);
+
+        /* Cluster fit only covers four-color mode */
+        if (mode == ImageCompressionMode::ClusterFit && transparentMask == 0)
+        {
+            const BCColorCandidate clusterCandidate = FitColorClusters(block, colors, numColors);
+            if (clusterCandidate.error < candidate.error)
+                candidate = clusterCandidate;
+        }
+    }
+    else
+    {
+        /* All pixels are transparent */
+        candidate.indices = 0xFFFFFFFF;
+    }
+
+    dst[0] = static_cast<std::uint8_t>(candidate.color0 & 0xFF);
+    dst[1] = static_cast<std::uint8_t>(candidate.color0 >> 8);
+    dst[2] = static_cast<std::uint8_t>(candidate.color1 & 0xFF);
+    dst[3] = static_cast<std::uint8_t>(candidate.color1 >> 8);
+    for_range(i, 4u)
+        dst[4 + i] = static_cast<std::uint8_t>((candidate.indices >> (i * 8)) & 0xFF);
+}
+
+
+/* ----- Single channel blocks ----- */
+
+// Divides the specified value by the divisor and rounds to the nearest integer, also for negative values.
+static int DivideRounded(int value, int divisor)
+{
+    return (value >= 0 ? (value + divisor / 2) / divisor : (value - divisor / 2) / divisor);
+}
+
+// Builds the palette of the specified endpoints like the decompressor. Eight-value mode is used if the first endpoint is greater than the second one.
+static void BuildChannelPalette(int value0, int value1, int minValue, int maxValue, int (&palette)[8])
+{
+    palette[0] = value0;
+    palette[1] = value1;
+
+    if (value0 > value1)
+    {
+        for_subrange(i, 1, 7)
+            palette[i + 1] = DivideRounded((7 - i) * value0 + i * value1, 7);
+    }
+    else
+    {
+        for_subrange(i, 1, 5)
+            palette[i + 1] = DivideRounded((5 - i) * value0 + i * value1, 5);
+        palette[6] = minValue;
+        palette[7] = maxValue;
+    }
+}
+
+// Selects the closest palette entry for each value and sums up the squared errors.
+static BCChannelCandidate MakeChannelCandidate(const int (&values)[16], int minValue, int maxValue, int value0, int value1)
+{
+    BCChannelCandidate candidate;
+    candidate.value0    = std::max(minValue, std::min(maxValue, value0));
+    candidate.value1    = std::max(minValue, std::min(maxValue, value1));
+    candidate.error     = 0;
+
+    int palette[8];
+    BuildChannelPalette(candidate.value0, candidate.value1, minValue, maxValue, palette);
+
+    for_range(i, 16u)
+    {
+        std::uint64_t   bestIndex = 0;
+        int             bestError = std::numeric_limits<int>::max();
+
+        for_range(j, 8)
+        {
+            const int error = (palette[j] - values[i]) * (palette[j] - values[i]);
+            if (error < bestError)
+            {
+                bestIndex = j;
+                bestError = error;
+            }
+        }
+
+        candidate.indices   |= (bestIndex << (i * 3));
+        candidate.error     += bestError;
+    }
+
+    return candidate;
+}
+
+// Solves the endpoints for the indices of the specified candidate with least squares. Returns false if the system has no unique solution.
+static bool RefineChannelEndpoints(const int (&values)[16], const BCChannelCandidate& candidate, int& value0, int& value1)
+{
+    const bool  isEightValueMode    = (candidate.value0 > candidate.value1);
+    const float numSteps            = (isEightValueMode ? 7.0f : 5.0f);
+
+    float alpha2 = 0.0f, beta2 = 0.0f, alphaBeta = 0.0f, alphaX = 0.0f, betaX = 0.0f;
+
+    for_range(i, 16u)
+    {
+        /* The explicit extremes of six-value mode do not depend on the endpoints */
+        const int index = static_cast<int>((candidate.indices >> (i * 3)) & 0x7);
+        if (!isEightValueMode && index >= 6)
+            continue;
+
+        const float beta    = (index <= 1 ? static_cast<float>(index) : static_cast<float>(index - 1) / numSteps);
+        const float alpha   = 1.0f - beta;
+        const float x       = static_cast<float>(values[i]);
+
+        alpha2      += alpha * alpha;
+        beta2       += beta * beta;
+        alphaBeta   += alpha * beta;
+        alphaX      += alpha * x;
+        betaX       += beta * x;
+    }
+
+    const float det = alpha2 * beta2 - alphaBeta * alphaBeta;
+    if (std::abs(det) < 1.0e-6f)
+        return false;
+
+    value0 = static_cast<int>(std::lround((alphaX * beta2 - betaX * alphaBeta) / det));
+    value1 = static_cast<int>(std::lround((betaX * alpha2 - alphaX * alphaBeta) / det));
+    return true;
+}
+
+// Refines the endpoints of the specified candidate iteratively as long as the error decreases and the palette mode stays the same.
+static void RefineChannelCandidate(const int (&values)[16], int minValue, int maxValue, BCChannelCandidate& candidate)
+{
+    const bool isEightValueMode = (candidate.value0 > candidate.value1);
+
+    for_range(iteration, 4)
+    {
+        int value0 = 0, value1 = 0;
+        if (!RefineChannelEndpoints(values, candidate, value0, value1))
+            break;
+
+        const BCChannelCandidate refined = MakeChannelCandidate(values, minValue, maxValue, value0, value1);
+        if ((refined.value0 > refined.value1) != isEightValueMode || refined.error >= candidate.error)
+            break;
+
+        candidate = refined;
+    }
+}
+
+// Encodes the specified values in the range [minValue, maxValue] into an 8-byte channel block.
+static void EncodeChannelBlock(const int (&values)[16], int minValue, int maxValue, ImageCompressionMode mode, std::uint8_t* dst)
+{
+    const int lowest    = *std::min_element(values, values + 16);
+    const int highest   = *std::max_element(values, values + 16);
+
+    /* Span eight-value mode over the range of all values */
+    BCChannelCandidate candidate = MakeChannelCandidate(values, minValue, maxValue, highest, lowest);
+
+    if (mode == ImageCompressionMode::ClusterFit && highest > lowest)
+    {
+        RefineChannelCandidate(values, minValue, maxValue, candidate);
+
+        /* Try six-value mode for the values in between the explicit extremes */
+        int innerLowest = maxValue, innerHighest = minValue;
+        for (int value : values)
+        {
+            if (value > minValue && value < maxValue)
+            {
+                innerLowest     = std::min(innerLowest, value);
+                innerHighest    = std::max(innerHighest, value);
+            }
+        }
+
+        if (innerLowest <= innerHighest)
+        {
+            BCChannelCandidate sixValueCandidate = MakeChannelCandidate(values, minValue, maxValue, innerLowest, innerHighest);
+            RefineChannelCandidate(values, minValue, maxValue, sixValueCandidate);
+            if (sixValueCandidate.error < candidate.error)
+                candidate = sixValueCandidate;
+        }
+    }
+
+    dst[0] = static_cast<std::uint8_t>(candidate.value0 & 0xFF);
+    dst[1] = static_cast<std::uint8_t>(candidate.value1 & 0xFF);
+    for_range(i, 6u)
+        dst[2 + i] = static_cast<std::uint8_t>((candidate.indices >> (i * 8)) & 0xFF);
+}
+
+// Maps an unsigned normalized value in the range [0, 255] to a signed normalized value in the range [-127, 127].
+static int UNorm8ToSNorm(int value)
+{
+    return (value * 254 + 127) / 255 - 127;
+}
+
+// Encodes the specified component of all pixels into an 8-byte channel block.
+static void EncodeChannel(const BCBlockPixels& block, int component, bool isSigned, ImageCompressionMode mode, std::uint8_t* dst)
+{
+    int values[16];
+    for_range(i, 16u)
+    {
+        const int value = block.pixels[i][component];
+        values[i] = (isSigned ? UNorm8ToSNorm(value) : value);
+    }
+
+    if (isSigned)
+        EncodeChannelBlock(values, -127, 127, mode, dst);
+    else
+        EncodeChannelBlock(values, 0, 255, mode, dst);
+}
+
+
+/* ----- Blocks ----- */
+
+static void CompressBC1Block(const BCBlockPixels& block, bool /*isSigned*/, ImageCompressionMode mode, std::uint8_t* dst)
+{
+    EncodeColorBlock(block, true, mode, dst);
+}
+
+static void CompressBC2Block(const BCBlockPixels& block, bool /*isSigned*/, ImageCompressionMode mode, std::uint8_t* dst)
+{
+    /* Encode explicit 4-bit alpha values */
+    for_range(i, 8u)
+    {
+        const int alpha0 = (block.pixels[i*2    ][3] + 8) / 17;
+        const int alpha1 = (block.pixels[i*2 + 1][3] + 8) / 17;
+        dst[i] = static_cast<std::uint8_t>(alpha0 | alpha1 << 4);
+    }
+    EncodeColorBlock(block, false, mode, dst + 8);
+}
+
+static void CompressBC3Block(const BCBlockPixels& block, bool /*isSigned*/, ImageCompressionMode mode, std::uint8_t* dst)
+{
+    EncodeChannel(block, 3, false, mode, dst);
+    EncodeColorBlock(block, false, mode, dst + 8);
+}
+
+static void CompressBC4Block(const BCBlockPixels& block, bool isSigned, ImageCompressionMode mode, std::uint8_t* dst)
+{
+    EncodeChannel(block, 0, isSigned, mode, dst);
+}
+
+static void CompressBC5Block(const BCBlockPixels& block, bool isSigned, ImageCompressionMode mode, std::uint8_t* dst)
+{
+    EncodeChannel(block, 0, isSigned, mode, dst);
+    EncodeChannel(block, 1, isSigned, mode, dst + 8);
+}
+
+
+/* ----- Functions ----- */
+
+// Loads the pixels of the specified block. Pixels outside the image repeat the last row and column.
+static void LoadBlockPixels(const Extent2D& extent, const std::uint8_t* data, std::uint32_t blockX, std::uint32_t blockY, BCBlockPixels& block)
+{
+    for_range(y, 4u)
+    {
+        const std::uint32_t srcY = std::min(blockY * 4 + y, extent.height - 1);
+        for_range(x, 4u)
+        {
+            const std::uint32_t srcX = std::min(blockX * 4 + x, extent.width - 1);
+            const std::uint8_t* src = data + (static_cast<std::size_t>(srcY) * extent.width + srcX) * 4;
+            std::copy(src, src + 4, block.pixels[y * 4 + x]);
+        }
+    }
+}
+
+// Compresses the blocks of the specified block rows into the output buffer.
+template <CompressBCBlockFunc CompressBlock>
+void CompressBCBlockRows(
+    const Extent2D&         extent,
+    const std::uint8_t*     data,
+    std::size_t             blockSize,
+    bool                    isSigned,
+    ImageCompressionMode    mode,
+    std::uint8_t*           output,
+    std::size_t             blockRowBegin,
+    std::size_t             blockRowEnd)
+{
+    const std::uint32_t numBlocksX = (extent.width + 3) / 4;
+
+    BCBlockPixels block;
+    for_subrange(y, blockRowBegin, blockRowEnd)
+    {
+        std::uint8_t* dst = output + y * numBlocksX * blockSize;
+        for_range(x, numBlocksX)
+        {
+            LoadBlockPixels(extent, data, x, static_cast<std::uint32_t>(y), block);
+            CompressBlock(block, isSigned, mode, dst);
+            dst += blockSize;
+        }
+    }
+}
+
+ByteBuffer CompressRGBA8UNormToBC(
+    ImageFormat             format,
+    DataType                dataType,
+    ImageCompressionMode    mode,
+    const Extent2D&         extent,
+    const std::uint8_t*     data,
+    unsigned                threadCount)
+{
+    /* Select block encoder and block size (in bytes) */
+    std::size_t blockSize = 16;
+    void (*compressBlockRows)(const Extent2D&, const std::uint8_t*, std::size_t, bool, ImageCompressionMode, std::uint8_t*, std::size_t, std::size_t) = nullptr;
+
+    switch (format)
+    {
+        case ImageFormat::BC1:
+            compressBlockRows   = CompressBCBlockRows<CompressBC1Block>;
+            blockSize           = 8;
+            break;
+        case ImageFormat::BC2:
+            compressBlockRows   = CompressBCBlockRows<CompressBC2Block>;
+            break;
+        case ImageFormat::BC3:
+            compressBlockRows   = CompressBCBlockRows<CompressBC3Block>;
+            break;
+        case ImageFormat::BC4:
+            compressBlockRows   = CompressBCBlockRows<CompressBC4Block>;
+            blockSize           = 8;
+            break;
+        case ImageFormat::BC5:
+            compressBlockRows   = CompressBCBlockRows<CompressBC5Block>;
+            break;
+        default:
+            return nullptr;
+    }
+
+    const std::size_t numBlocksX = (extent.width  + 3) / 4;
+    const std::size_t numBlocksY = (extent.height + 3) / 4;
+
+    auto imageBuffer = AllocateByteBuffer(numBlocksX * numBlocksY * blockSize, UninitializeTag{});
+
+    /* Compress rows of 4x4 blocks in parallel */
+    const bool isSigned = (dataType == DataType::Int8);
+    auto output = reinterpret_cast<std::uint8_t*>(imageBuffer.get());
+
+    DoConcurrentRange(
+        [&extent, compressBlockRows, data, blockSize, isSigned, mode, output](std::size_t begin, std::size_t end)
+        {
+            compressBlockRows(extent, data, blockSize, isSigned, mode, output, begin, end);
+        },
+        numBlocksY,
+        threadCount,
+        1
+    );
+
+    return imageBuffer;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
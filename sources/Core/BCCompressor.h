@@ -0,0 +1,45 @@
+/*
+ * BCCompressor.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_BC_COMPRESSOR_H
+#define LLGL_BC_COMPRESSOR_H
+
+
+#include <LLGL/ImageFlags.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+struct Extent2D;
+
+/* ----- Functions ----- */
+
+/*
+Returns an image buffer in the BC1, BC2, BC3, BC4, or BC5 format for the specified RGBA8UNorm image, or null if the format is not supported.
+BC4 and BC5 data is signed if the data type is DataType::Int8. Blocks outside the image repeat the border pixels.
+*/
+ByteBuffer CompressRGBA8UNormToBC(
+    ImageFormat             format,
+    DataType                dataType,
+    ImageCompressionMode    mode,
+    const Extent2D&         extent,
+    const std::uint8_t*     data,
+    unsigned                threadCount = 0
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,115 +6,457 @@
  */
 
 #include "BCDecompressor.h"
+#include "Threading.h"
+#include "CPUFeatures.h"
 #include <LLGL/Types.h>
 #include <LLGL/Utils/ForRange.h>
+#include <algorithm>
 #include <cstring>
 
+#ifdef LLGL_HAS_SSSE3_TARGET
+#   include <tmmintrin.h>
+#endif
+
 
 namespace LLGL
 {
 
 
-static void DecompressRGBColor16Bit(std::uint8_t* dst, std::uint16_t src)
+/* ----- Internal structures ----- */
+
+// Palette and 2-bit indices of a BC1 color block or the color part of a BC2/BC3 block. The palette stores four RGBA8 colors.
+struct BCColorBlock
 {
-    dst[0] = ((src >> 12) & 0x000F) * 0xFF / 0x0F;
-    dst[1] = ((src >>  6) & 0x001F) * 0xFF / 0x1F;
-    dst[2] = ((src >>  1) & 0x000F) * 0xFF / 0x0F;
+    std::uint8_t    palette[16];
+    std::uint32_t   indices;
+};
+
+/*
+Palette and indices of a single channel of a BC2, BC3, BC4, or BC5 block.
+BC2 alpha uses all 16 entries with 4-bit indices, the others only 8 entries with 3-bit indices.
+*/
+struct BCChannelBlock
+{
+    std::uint8_t    palette[16];
+    std::uint64_t   indices;
+    int             bitsPerIndex;
+};
+
+// Function signature to decode one 4x4 block into four rows of RGBA8 pixels with the specified row stride (in bytes).
+using DecompressBCBlockFunc = void (*)(const std::uint8_t* src, std::uint8_t* dst, std::size_t dstRowStride, bool isSigned);
+
+// Function signature to decode the specified range of block rows into the RGBA8 output image.
+using DecompressBCBlockRowsFunc = void (*)(const Extent2D& extent, const std::uint8_t* data, std::size_t blockSize, bool isSigned, std::uint8_t* output, std::size_t blockRowBegin, std::size_t blockRowEnd);
+
+
+/* ----- Block decoding ----- */
+
+static std::uint32_t ReadUInt16LE(const std::uint8_t* src)
+{
+    return (static_cast<std::uint32_t>(src[0]) | static_cast<std::uint32_t>(src[1]) << 8);
 }
 
-#if 0 //UNUSED
-static void DecompressRGBAColor16Bit(std::uint8_t* dst, std::uint16_t src)
+static std::uint32_t ReadUInt32LE(const std::uint8_t* src)
 {
-    DecompressRGBColor16Bit(dst, src);
-    dst[3] = (src & 0x0001) * 0xFF;
+    return (ReadUInt16LE(src) | ReadUInt16LE(src + 2) << 16);
 }
 
-static std::uint8_t DecompressAlphaChannel4Bit(std::uint32_t& src)
+// Expands a 16-bit RGB565 color to RGBA8 by replicating the high bits into the low bits.
+static void DecompressRGBColor16Bit(std::uint8_t* dst, std::uint32_t src)
 {
-    auto alpha = static_cast<std::uint8_t >((src & 0x0000000F) * 0xFF / 0x0F);
-    src >>= 4;
-    return alpha;
+    const std::uint32_t r = (src >> 11) & 0x1F;
+    const std::uint32_t g = (src >>  5) & 0x3F;
+    const std::uint32_t b = (src      ) & 0x1F;
+    dst[0] = static_cast<std::uint8_t>((r << 3) | (r >> 2));
+    dst[1] = static_cast<std::uint8_t>((g << 2) | (g >> 4));
+    dst[2] = static_cast<std::uint8_t>((b << 3) | (b >> 2));
+    dst[3] = 0xFF;
 }
 
-static void Decompress16AlphaChannels4Bit(std::uint8_t* dst, std::uint32_t src0, std::uint32_t src1)
+// Decodes the 8-byte color block. BC1 blocks with the first endpoint not greater than the second one use three colors and transparent black.
+static void DecodeBCColorBlock(const std::uint8_t* src, BCColorBlock& block, bool allowTransparency)
 {
-    for (int i = 0; i < 8; ++i)
+    const std::uint32_t color0 = ReadUInt16LE(src);
+    const std::uint32_t color1 = ReadUInt16LE(src + 2);
+
+    std::uint8_t* palette = block.palette;
+    DecompressRGBColor16Bit(palette + 0, color0);
+    DecompressRGBColor16Bit(palette + 4, color1);
+
+    if (color0 > color1 || !allowTransparency)
     {
-        dst[i    ] = DecompressAlphaChannel4Bit(src0);
-        dst[i + 8] = DecompressAlphaChannel4Bit(src1);
+        for_range(i, 3)
+        {
+            palette[ 8 + i] = static_cast<std::uint8_t>((2 * palette[i] + palette[4 + i] + 1) / 3);
+            palette[12 + i] = static_cast<std::uint8_t>((palette[i] + 2 * palette[4 + i] + 1) / 3);
+        }
+        palette[11] = 0xFF;
+        palette[15] = 0xFF;
     }
+    else
+    {
+        for_range(i, 3)
+            palette[8 + i] = static_cast<std::uint8_t>((palette[i] + palette[4 + i]) / 2);
+        palette[11] = 0xFF;
+        ::memset(palette + 12, 0, 4);
+    }
+
+    block.indices = ReadUInt32LE(src + 4);
+}
+
+// Decodes the 8-byte explicit alpha block of BC2 with 4-bit alpha values.
+static void DecodeBC2AlphaBlock(const std::uint8_t* src, BCChannelBlock& block)
+{
+    for_range(i, 16u)
+        block.palette[i] = static_cast<std::uint8_t>(i * 0x11);
+    block.indices       = (ReadUInt32LE(src) | static_cast<std::uint64_t>(ReadUInt32LE(src + 4)) << 32);
+    block.bitsPerIndex  = 4;
+}
+
+// Maps a signed normalized value in the range [-127, 127] to an unsigned normalized value in the range [0, 255].
+static std::uint8_t SNormToUNorm8(int value)
+{
+    return static_cast<std::uint8_t>(((value + 127) * 255 + 127) / 254);
+}
+
+// Divides the specified value by the divisor and rounds to the nearest integer, also for negative values.
+static int DivideRounded(int value, int divisor)
+{
+    return (value >= 0 ? (value + divisor / 2) / divisor : (value - divisor / 2) / divisor);
 }
-#endif
 
-static std::uint8_t InterpolateColorComponent(std::uint16_t a, std::uint16_t b)
+/*
+Decodes the 8-byte interpolated channel block of BC3 alpha, BC4, and BC5 with 3-bit indices.
+Signed endpoints are interpolated in the signed range and mapped to unsigned values afterwards.
+*/
+static void DecodeBCChannelBlock(const std::uint8_t* src, BCChannelBlock& block, bool isSigned)
 {
-    if (a > b)
-        return static_cast<std::uint8_t>((2 * a + b + 1) / 3);
+    int value0, value1, minValue, maxValue;
+
+    if (isSigned)
+    {
+        /* The value -128 is clamped to -127 so that the range is symmetric */
+        value0      = std::max(-127, static_cast<int>(static_cast<std::int8_t>(src[0])));
+        value1      = std::max(-127, static_cast<int>(static_cast<std::int8_t>(src[1])));
+        minValue    = -127;
+        maxValue    = 127;
+    }
     else
-        return static_cast<std::uint8_t>((a + b) / 2);
+    {
+        value0      = src[0];
+        value1      = src[1];
+        minValue    = 0;
+        maxValue    = 255;
+    }
+
+    int palette[8];
+    palette[0] = value0;
+    palette[1] = value1;
+
+    if (value0 > value1)
+    {
+        for_subrange(i, 1, 7)
+            palette[i + 1] = DivideRounded((7 - i) * value0 + i * value1, 7);
+    }
+    else
+    {
+        for_subrange(i, 1, 5)
+            palette[i + 1] = DivideRounded((5 - i) * value0 + i * value1, 5);
+        palette[6] = minValue;
+        palette[7] = maxValue;
+    }
+
+    for_range(i, 8)
+        block.palette[i] = (isSigned ? SNormToUNorm8(palette[i]) : static_cast<std::uint8_t>(palette[i]));
+    ::memset(block.palette + 8, 0, 8);
+
+    block.indices       = (ReadUInt16LE(src + 2) | static_cast<std::uint64_t>(ReadUInt32LE(src + 4)) << 16);
+    block.bitsPerIndex  = 3;
+}
+
+
+/* ----- Block writing ----- */
+
+// Returns the palette value of the specified pixel of a channel block.
+static std::uint8_t LookupBCChannel(const BCChannelBlock& block, int pixel)
+{
+    const std::uint32_t mask = (1u << block.bitsPerIndex) - 1u;
+    return block.palette[(block.indices >> (pixel * block.bitsPerIndex)) & mask];
+}
+
+// Writes a 4x4 block of the color block. If the alpha block is not null, it replaces the alpha component.
+template <bool UseSSSE3>
+void WriteBCColorBlock(std::uint8_t* dst, std::size_t dstRowStride, const BCColorBlock& color, const BCChannelBlock* alpha);
+
+template <>
+void WriteBCColorBlock<false>(std::uint8_t* dst, std::size_t dstRowStride, const BCColorBlock& color, const BCChannelBlock* alpha)
+{
+    for_range(row, 4)
+    {
+        std::uint8_t* dstRow = dst + row * dstRowStride;
+        for_range(x, 4)
+        {
+            const int i = row * 4 + x;
+            ::memcpy(dstRow + x * 4, color.palette + ((color.indices >> (i * 2)) & 0x3) * 4, 4);
+            if (alpha != nullptr)
+                dstRow[x * 4 + 3] = LookupBCChannel(*alpha, i);
+        }
+    }
+}
+
+// Writes a 4x4 block of the red and (optional) green channel blocks. Blue is zero and alpha is one.
+template <bool UseSSSE3>
+void WriteBCChannelBlocks(std::uint8_t* dst, std::size_t dstRowStride, const BCChannelBlock& red, const BCChannelBlock* green);
+
+template <>
+void WriteBCChannelBlocks<false>(std::uint8_t* dst, std::size_t dstRowStride, const BCChannelBlock& red, const BCChannelBlock* green)
+{
+    for_range(row, 4)
+    {
+        std::uint8_t* dstRow = dst + row * dstRowStride;
+        for_range(x, 4)
+        {
+            const int i = row * 4 + x;
+            dstRow[x * 4 + 0] = LookupBCChannel(red, i);
+            dstRow[x * 4 + 1] = (green != nullptr ? LookupBCChannel(*green, i) : 0);
+            dstRow[x * 4 + 2] = 0;
+            dstRow[x * 4 + 3] = 0xFF;
+        }
+    }
 }
 
-static void InterpolateColor(std::uint8_t* dst, const std::uint8_t* src0, const std::uint8_t* src1)
+#ifdef LLGL_HAS_SSSE3_TARGET
+
+// Shuffle masks to replicate the palette index of each pixel to all four components, and byte offsets of each component.
+static const std::uint8_t g_colorSelect[16] = { 0,0,0,0, 1,1,1,1, 2,2,2,2, 3,3,3,3 };
+static const std::uint8_t g_colorOffset[16] = { 0,1,2,3, 0,1,2,3, 0,1,2,3, 0,1,2,3 };
+
+// Shuffle masks to move the palette index of each pixel into a single component. Indices of 0x80 produce zero.
+static const std::uint8_t g_channelSelect[4][16] =
+{
+    { 0x00,0x80,0x80,0x80, 0x01,0x80,0x80,0x80, 0x02,0x80,0x80,0x80, 0x03,0x80,0x80,0x80 },
+    { 0x80,0x00,0x80,0x80, 0x80,0x01,0x80,0x80, 0x80,0x02,0x80,0x80, 0x80,0x03,0x80,0x80 },
+    { 0x80,0x80,0x00,0x80, 0x80,0x80,0x01,0x80, 0x80,0x80,0x02,0x80, 0x80,0x80,0x03,0x80 },
+    { 0x80,0x80,0x80,0x00, 0x80,0x80,0x80,0x01, 0x80,0x80,0x80,0x02, 0x80,0x80,0x80,0x03 },
+};
+
+// Returns the packed indices of the specified row with one index per byte.
+static std::uint32_t GetBCRowIndices(std::uint64_t indices, int bitsPerIndex, int row)
+{
+    const std::uint32_t rowIndices  = static_cast<std::uint32_t>(indices >> (row * 4 * bitsPerIndex));
+    const std::uint32_t mask        = (1u << bitsPerIndex) - 1u;
+    return
+    (
+        ((rowIndices                       ) & mask)        |
+        ((rowIndices >> (bitsPerIndex    )) & mask) <<  8   |
+        ((rowIndices >> (bitsPerIndex * 2)) & mask) << 16   |
+        ((rowIndices >> (bitsPerIndex * 3)) & mask) << 24
+    );
+}
+
+LLGL_TARGET_SSSE3
+static __m128i LoadBytes16(const std::uint8_t* src)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+}
+
+// Returns the four pixels of a block row with the palette colors of the color block.
+LLGL_TARGET_SSSE3
+static __m128i LookupBCColorRow(const BCColorBlock& block, int row)
+{
+    const __m128i indices   = _mm_cvtsi32_si128(static_cast<int>(GetBCRowIndices(block.indices, 2, row)));
+    const __m128i replicate = _mm_shuffle_epi8(indices, LoadBytes16(g_colorSelect));
+    const __m128i offsets   = _mm_add_epi8(_mm_slli_epi16(replicate, 2), LoadBytes16(g_colorOffset));
+    return _mm_shuffle_epi8(LoadBytes16(block.palette), offsets);
+}
+
+// Returns the four pixels of a block row with the palette values of the channel block in the specified component and zero in all others.
+LLGL_TARGET_SSSE3
+static __m128i LookupBCChannelRow(const BCChannelBlock& block, int row, int component)
+{
+    const __m128i select    = LoadBytes16(g_channelSelect[component]);
+    const __m128i indices   = _mm_cvtsi32_si128(static_cast<int>(GetBCRowIndices(block.indices, block.bitsPerIndex, row)));
+
+    /* Indices of other components are zero after the first shuffle, so they must be set to 0x80 again to produce zero */
+    const __m128i offsets   = _mm_or_si128(_mm_shuffle_epi8(indices, select), _mm_and_si128(select, _mm_set1_epi8(static_cast<char>(0x80))));
+    return _mm_shuffle_epi8(LoadBytes16(block.palette), offsets);
+}
+
+template <>
+LLGL_TARGET_SSSE3
+void WriteBCColorBlock<true>(std::uint8_t* dst, std::size_t dstRowStride, const BCColorBlock& color, const BCChannelBlock* alpha)
+{
+    const __m128i rgbMask = _mm_set1_epi32(0x00FFFFFF);
+    for_range(row, 4)
+    {
+        __m128i pixels = LookupBCColorRow(color, row);
+        if (alpha != nullptr)
+            pixels = _mm_or_si128(_mm_and_si128(pixels, rgbMask), LookupBCChannelRow(*alpha, row, 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + row * dstRowStride), pixels);
+    }
+}
+
+template <>
+LLGL_TARGET_SSSE3
+void WriteBCChannelBlocks<true>(std::uint8_t* dst, std::size_t dstRowStride, const BCChannelBlock& red, const BCChannelBlock* green)
+{
+    const __m128i alphaOne = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    for_range(row, 4)
+    {
+        __m128i pixels = _mm_or_si128(alphaOne, LookupBCChannelRow(red, row, 0));
+        if (green != nullptr)
+            pixels = _mm_or_si128(pixels, LookupBCChannelRow(*green, row, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + row * dstRowStride), pixels);
+    }
+}
+
+#endif // /LLGL_HAS_SSSE3_TARGET
+
+template <bool UseSSSE3>
+void DecompressBC1Block(const std::uint8_t* src, std::uint8_t* dst, std::size_t dstRowStride, bool /*isSigned*/)
+{
+    BCColorBlock color;
+    DecodeBCColorBlock(src, color, true);
+    WriteBCColorBlock<UseSSSE3>(dst, dstRowStride, color, nullptr);
+}
+
+template <bool UseSSSE3>
+void DecompressBC2Block(const std::uint8_t* src, std::uint8_t* dst, std::size_t dstRowStride, bool /*isSigned*/)
+{
+    BCChannelBlock alpha;
+    DecodeBC2AlphaBlock(src, alpha);
+    BCColorBlock color;
+    DecodeBCColorBlock(src + 8, color, false);
+    WriteBCColorBlock<UseSSSE3>(dst, dstRowStride, color, &alpha);
+}
+
+template <bool UseSSSE3>
+void DecompressBC3Block(const std::uint8_t* src, std::uint8_t* dst, std::size_t dstRowStride, bool /*isSigned*/)
 {
-    dst[0] = InterpolateColorComponent(src0[0], src1[0]);
-    dst[1] = InterpolateColorComponent(src0[1], src1[1]);
-    dst[2] = InterpolateColorComponent(src0[2], src1[2]);
+    BCChannelBlock alpha;
+    DecodeBCChannelBlock(src, alpha, false);
+    BCColorBlock color;
+    DecodeBCColorBlock(src + 8, color, false);
+    WriteBCColorBlock<UseSSSE3>(dst, dstRowStride, color, &alpha);
 }
 
-ByteBuffer DecompressBC1ToRGBA8UNorm(
+template <bool UseSSSE3>
+void DecompressBC4Block(const std::uint8_t* src, std::uint8_t* dst, std::size_t dstRowStride, bool isSigned)
+{
+    BCChannelBlock red;
+    DecodeBCChannelBlock(src, red, isSigned);
+    WriteBCChannelBlocks<UseSSSE3>(dst, dstRowStride, red, nullptr);
+}
+
+template <bool UseSSSE3>
+void DecompressBC5Block(const std::uint8_t* src, std::uint8_t* dst, std::size_t dstRowStride, bool isSigned)
+{
+    BCChannelBlock red, green;
+    DecodeBCChannelBlock(src, red, isSigned);
+    DecodeBCChannelBlock(src + 8, green, isSigned);
+    WriteBCChannelBlocks<UseSSSE3>(dst, dstRowStride, red, &green);
+}
+
+
+/* ----- Functions ----- */
+
+// Decompresses the blocks of the specified block rows directly into the RGBA8UNorm output image.
+template <DecompressBCBlockFunc DecompressBlock>
+void DecompressBCBlockRows(
+    const Extent2D&     extent,
+    const std::uint8_t* data,
+    std::size_t         blockSize,
+    bool                isSigned,
+    std::uint8_t*       output,
+    std::size_t         blockRowBegin,
+    std::size_t         blockRowEnd)
+{
+    const std::size_t numBlocksX    = extent.width / 4u;
+    const std::size_t dstRowStride  = extent.width * 4u;
+
+    for_subrange(y, blockRowBegin, blockRowEnd)
+    {
+        const std::uint8_t* src = data + y * numBlocksX * blockSize;
+        std::uint8_t*       dst = output + y * 4 * dstRowStride;
+
+        for_range(x, numBlocksX)
+        {
+            DecompressBlock(src, dst, dstRowStride, isSigned);
+            src += blockSize;
+            dst += 16;
+        }
+    }
+}
+
+// Returns the block row decoder for the specified format and its block size (in bytes), or null if the format is not supported.
+template <bool UseSSSE3>
+DecompressBCBlockRowsFunc SelectDecompressBCBlockRows(ImageFormat format, std::size_t& outBlockSize)
+{
+    switch (format)
+    {
+        case ImageFormat::BC1:
+            outBlockSize = 8;
+            return DecompressBCBlockRows<DecompressBC1Block<UseSSSE3>>;
+        case ImageFormat::BC2:
+            outBlockSize = 16;
+            return DecompressBCBlockRows<DecompressBC2Block<UseSSSE3>>;
+        case ImageFormat::BC3:
+            outBlockSize = 16;
+            return DecompressBCBlockRows<DecompressBC3Block<UseSSSE3>>;
+        case ImageFormat::BC4:
+            outBlockSize = 8;
+            return DecompressBCBlockRows<DecompressBC4Block<UseSSSE3>>;
+        case ImageFormat::BC5:
+            outBlockSize = 16;
+            return DecompressBCBlockRows<DecompressBC5Block<UseSSSE3>>;
+        default:
+            return nullptr;
+    }
+}
+
+ByteBuffer DecompressBCToRGBA8UNorm(
+    ImageFormat     format,
+    DataType        dataType,
     const Extent2D& extent,
     const char*     data,
     std::size_t     dataSize,
-    unsigned        /*threadCount*/)
+    unsigned        threadCount)
 {
+    /* Select block decoder and block size (in bytes); palette lookups use byte shuffles if the CPU supports SSSE3 */
+    std::size_t blockSize = 0;
+    DecompressBCBlockRowsFunc decompressBlockRows = SelectDecompressBCBlockRows<false>(format, blockSize);
+
+    #ifdef LLGL_HAS_SSSE3_TARGET
+
+    if (IsSSSE3Supported())
+        decompressBlockRows = SelectDecompressBCBlockRows<true>(format, blockSize);
+
+    #endif // /LLGL_HAS_SSSE3_TARGET
+
+    if (decompressBlockRows == nullptr)
+        return nullptr;
+
     /* Return null on invalid arguments */
-    if (extent.width % 4 != 0 || extent.height % 4 != 0 || data == nullptr || dataSize < extent.width * extent.height / 2)
+    const std::size_t numBlocks = (extent.width / 4u) * (extent.height / 4u);
+    if (extent.width % 4 != 0 || extent.height % 4 != 0 || data == nullptr || dataSize < numBlocks * blockSize)
         return nullptr;
 
     auto imageBuffer = AllocateByteBuffer(extent.width * extent.height * 4, UninitializeTag{});
 
+    /* Decompress rows of 4x4 blocks in parallel */
+    const bool isSigned = (dataType == DataType::Int8);
+    auto input  = reinterpret_cast<const std::uint8_t*>(data);
     auto output = reinterpret_cast<std::uint8_t*>(imageBuffer.get());
-    std::uint16_t compressedColor[2];
-    std::uint8_t decompressedColor[4][3];
 
-    const std::size_t formatByteSize = 4;
-
-    for_range(y, extent.height / 4u)
-    {
-        for_range(x, extent.width / 4u)
+    DoConcurrentRange(
+        [&extent, decompressBlockRows, input, blockSize, isSigned, output](std::size_t begin, std::size_t end)
         {
-            /* Decompress two 16 bit colors */
-            for_range(i, 2)
-            {
-                compressedColor[i] = *reinterpret_cast<const std::uint16_t*>(data);
-                DecompressRGBColor16Bit(decompressedColor[i], compressedColor[i]);
-                data += 2;
-            }
-
-            /* Generate two more colors by interpolating the previous two */
-            InterpolateColor(decompressedColor[2], decompressedColor[0], decompressedColor[1]);
-            InterpolateColor(decompressedColor[3], decompressedColor[1], decompressedColor[0]);
-
-            /* Read palette bitfield */
-            std::uint32_t palette = *reinterpret_cast<const std::uint32_t*>(data);
-            data += 4;
-
-            /* Generate 4x4 pixel block from palette bitmask */
-            for_range(i, 16u)
-            {
-                /* Get palette index from last two bits */
-                const std::uint32_t paletteIndex = palette & 0x00000003;
-                palette >>= 2;
-
-                /* Write out image color */
-                const std::size_t outputOffset = (((y * 4 + i/4) * extent.width) + (x*4 + i%4)) * formatByteSize;
-                output[outputOffset + 0] = decompressedColor[paletteIndex][0];
-                output[outputOffset + 1] = decompressedColor[paletteIndex][1];
-                output[outputOffset + 2] = decompressedColor[paletteIndex][2];
-                output[outputOffset + 3] = 0xFF;
-            }
-        }
-    }
+            decompressBlockRows(extent, input, blockSize, isSigned, output, begin, end);
+        },
+        extent.height / 4u,
+        threadCount,
+        1
+    );
 
     return imageBuffer;
 }
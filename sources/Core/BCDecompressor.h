@@ -22,10 +22,13 @@ struct Extent2D;
 /* ----- Functions ----- */
 
 /*
-Returns an image buffer in the Format::RGBA8UNorm format for the specified BC1 encoded data, or null on failure
-Width and height of the input image must be a multiple of 4.
+Returns an image buffer in the Format::RGBA8UNorm format for the specified BC1, BC2, BC3, BC4, or BC5 encoded data, or null on failure.
+BC4 and BC5 data is signed if the data type is DataType::Int8. Signed values are mapped from [-1, 1] to [0, 1].
+Missing components are zero for color and one for alpha. Width and height of the input image must be a multiple of 4.
 */
-ByteBuffer DecompressBC1ToRGBA8UNorm(
+ByteBuffer DecompressBCToRGBA8UNorm(
+    ImageFormat     format,
+    DataType        dataType,
     const Extent2D& extent,
     const char*     data,
     std::size_t     dataSize,
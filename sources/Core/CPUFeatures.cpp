@@ -0,0 +1,68 @@
+/*
+ * CPUFeatures.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "CPUFeatures.h"
+
+#if defined LLGL_HAS_SSE2 && defined _MSC_VER && !defined __clang__
+#   include <intrin.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+static CPUFeatures QueryCPUFeatures()
+{
+    CPUFeatures features;
+
+    #if defined LLGL_HAS_SSE2
+
+    #if defined __GNUC__ || defined __clang__
+
+    /* The compiler's feature query also checks that the operating system saves the AVX registers */
+    __builtin_cpu_init();
+    features.ssse3  = (__builtin_cpu_supports("ssse3") != 0);
+    features.avx2   = (__builtin_cpu_supports("avx2") != 0);
+
+    #elif defined _MSC_VER
+
+    int info[4] = {};
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    features.ssse3 = ((info[2] & (1 << 9)) != 0);
+
+    /* AVX2 also requires the operating system to save the YMM registers (OSXSAVE and XCR0 bits 1 and 2) */
+    const bool hasOSXSAVE   = ((info[2] & (1 << 27)) != 0);
+    const bool hasAVX       = ((info[2] & (1 << 28)) != 0);
+    if (maxLeaf >= 7 && hasOSXSAVE && hasAVX && (_xgetbv(0) & 0x6) == 0x6)
+    {
+        __cpuidex(info, 7, 0);
+        features.avx2 = ((info[1] & (1 << 5)) != 0);
+    }
+
+    #endif
+
+    #endif // /LLGL_HAS_SSE2
+
+    return features;
+}
+
+const CPUFeatures& GetCPUFeatures()
+{
+    static const CPUFeatures features = QueryCPUFeatures();
+    return features;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,59 @@
+/*
+ * CPUFeatures.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_CPU_FEATURES_H
+#define LLGL_CPU_FEATURES_H
+
+
+#include "CompilerExtensions.h"
+
+
+namespace LLGL
+{
+
+
+// Instruction set extensions the host CPU and operating system support.
+struct CPUFeatures
+{
+    bool ssse3  = false;
+    bool avx2   = false;
+};
+
+/* ----- Functions ----- */
+
+// Returns the instruction set extensions of the host CPU. They are queried only once.
+const CPUFeatures& GetCPUFeatures();
+
+// Returns true if functions with the LLGL_TARGET_SSSE3 attribute can be called. This is known at compile time if the compiler targets SSSE3.
+inline bool IsSSSE3Supported()
+{
+    #ifdef LLGL_HAS_SSSE3
+    return true;
+    #else
+    return GetCPUFeatures().ssse3;
+    #endif
+}
+
+// Returns true if functions with the LLGL_TARGET_AVX2 attribute can be called. This is known at compile time if the compiler targets AVX2.
+inline bool IsAVX2Supported()
+{
+    #ifdef LLGL_HAS_AVX2
+    return true;
+    #else
+    return GetCPUFeatures().avx2;
+    #endif
+}
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -20,6 +20,33 @@
 #   define unlikely(COND)   (COND)
 #endif
 
+// SSE2 is part of the baseline instruction set of AMD64, but must be enabled explicitly for IA-32.
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#   define LLGL_HAS_SSE2
+#endif
+
+// SSSE3 and AVX2 are only used if the compiler targets them, e.g. with -mssse3, -mavx2, or /arch:AVX2. MSVC does not define a macro for SSSE3, but it is implied by AVX.
+#if defined __SSSE3__ || defined __AVX__
+#   define LLGL_HAS_SSSE3
+#endif
+
+#if defined __AVX2__
+#   define LLGL_HAS_AVX2
+#endif
+
+// Otherwise, individual functions are compiled for SSSE3 and AVX2 with these attributes. They must only be called after a CPU feature check (see CPUFeatures.h).
+#if defined LLGL_HAS_SSE2 && (defined __GNUC__ || defined __clang__ || defined _MSC_VER)
+#   define LLGL_HAS_SSSE3_TARGET
+#   define LLGL_HAS_AVX2_TARGET
+#   if defined __GNUC__ || defined __clang__
+#       define LLGL_TARGET_SSSE3    __attribute__((target("ssse3")))
+#       define LLGL_TARGET_AVX2     __attribute__((target("avx2")))
+#   else
+#       define LLGL_TARGET_SSSE3
+#       define LLGL_TARGET_AVX2
+#   endif
+#endif
+
 
 #endif
 
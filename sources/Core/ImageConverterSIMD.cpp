@@ -0,0 +1,498 @@
+/*
+ * ImageConverterSIMD.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "ImageConverterSIMD.h"
+#include "CPUFeatures.h"
+#include <LLGL/Utils/ForRange.h>
+#include <cstdint>
+
+#ifdef LLGL_HAS_SSE2
+#   include <emmintrin.h>
+#endif
+
+#ifdef LLGL_HAS_SSSE3_TARGET
+#   include <tmmintrin.h>
+#endif
+
+#ifdef LLGL_HAS_AVX2_TARGET
+#   include <immintrin.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+#ifdef LLGL_HAS_SSE2
+
+/* ----- Data type conversion ----- */
+
+#ifdef LLGL_HAS_AVX2_TARGET
+
+LLGL_TARGET_AVX2
+static std::size_t ConvertUInt8ToFloat32AVX2(const std::uint8_t* src, float* dst, std::size_t numComponents)
+{
+    std::size_t i = 0;
+
+    const __m256 scale = _mm256_set1_ps(255.0f);
+    for (; i + 8 <= numComponents; i += 8)
+    {
+        const __m256i ints = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_div_ps(_mm256_cvtepi32_ps(ints), scale));
+    }
+
+    return i;
+}
+
+#endif // /LLGL_HAS_AVX2_TARGET
+
+// Converts UInt8 components to Float32 components in the range [0, 1]. The division matches the rounding of the generic path.
+static std::size_t ConvertUInt8ToFloat32(const std::uint8_t* src, float* dst, std::size_t numComponents)
+{
+    std::size_t i = 0;
+
+    #ifdef LLGL_HAS_AVX2_TARGET
+    if (IsAVX2Supported())
+        i = ConvertUInt8ToFloat32AVX2(src, dst, numComponents);
+    #endif // /LLGL_HAS_AVX2_TARGET
+
+    const __m128    scale   = _mm_set1_ps(255.0f);
+    const __m128i   zero    = _mm_setzero_si128();
+
+    for (; i + 16 <= numComponents; i += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i lo    = _mm_unpacklo_epi8(bytes, zero);
+        const __m128i hi    = _mm_unpackhi_epi8(bytes, zero);
+        _mm_storeu_ps(dst + i     , _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+        _mm_storeu_ps(dst + i +  4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+        _mm_storeu_ps(dst + i +  8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+        _mm_storeu_ps(dst + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+    }
+
+    return i;
+}
+
+#ifdef LLGL_HAS_AVX2_TARGET
+
+LLGL_TARGET_AVX2
+static std::size_t ConvertFloat32ToUInt8AVX2(const float* src, std::uint8_t* dst, std::size_t numComponents)
+{
+    std::size_t i = 0;
+
+    const __m256    scale   = _mm256_set1_ps(255.0f);
+    const __m256i   lowByte = _mm256_set1_epi32(0xFF);
+    const __m256i   lanes   = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    for (; i + 32 <= numComponents; i += 32)
+    {
+        const __m256i a = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + i     ), scale)), lowByte);
+        const __m256i b = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + i +  8), scale)), lowByte);
+        const __m256i c = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + i + 16), scale)), lowByte);
+        const __m256i d = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + i + 24), scale)), lowByte);
+
+        /* Packing operates on 128-bit lanes, so the 32-bit groups must be restored to their original order */
+        const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permutevar8x32_epi32(packed, lanes));
+    }
+
+    return i;
+}
+
+#endif // /LLGL_HAS_AVX2_TARGET
+
+/*
+Converts Float32 components to UInt8 components by truncation like the generic path.
+Only the low byte of out-of-range values is kept, which matches a scalar conversion on x86.
+*/
+static std::size_t ConvertFloat32ToUInt8(const float* src, std::uint8_t* dst, std::size_t numComponents)
+{
+    std::size_t i = 0;
+
+    #ifdef LLGL_HAS_AVX2_TARGET
+    if (IsAVX2Supported())
+        i = ConvertFloat32ToUInt8AVX2(src, dst, numComponents);
+    #endif // /LLGL_HAS_AVX2_TARGET
+
+    const __m128    scale   = _mm_set1_ps(255.0f);
+    const __m128i   lowByte = _mm_set1_epi32(0xFF);
+
+    for (; i + 16 <= numComponents; i += 16)
+    {
+        const __m128i a = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i     ), scale)), lowByte);
+        const __m128i b = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i +  4), scale)), lowByte);
+        const __m128i c = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i +  8), scale)), lowByte);
+        const __m128i d = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i + 12), scale)), lowByte);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+    }
+
+    return i;
+}
+
+// Constants of the branchless half-precision conversion; see Float16Compressor.cpp.
+static const std::int32_t g_f16Shift    = 13;
+static const std::int32_t g_f16InfN     = 0x7f800000;
+static const std::int32_t g_f16MaxN     = 0x477fe000;
+static const std::int32_t g_f16MinN     = 0x38800000;
+static const std::int32_t g_f16SignN    = static_cast<std::int32_t>(0x80000000u);
+static const std::int32_t g_f16InfC     = (g_f16InfN >> g_f16Shift);
+static const std::int32_t g_f16NanN     = ((g_f16InfC + 1) << g_f16Shift);
+static const std::int32_t g_f16MaxC     = (g_f16MaxN >> g_f16Shift);
+static const std::int32_t g_f16MinC     = (g_f16MinN >> g_f16Shift);
+static const std::int32_t g_f16SignC    = 0x8000;
+static const std::int32_t g_f16MulN     = 0x52000000;
+static const std::int32_t g_f16MulC     = 0x33800000;
+static const std::int32_t g_f16SubC     = 0x003ff;
+static const std::int32_t g_f16NorC     = 0x00400;
+static const std::int32_t g_f16MaxD     = (g_f16InfC - g_f16MaxC - 1);
+static const std::int32_t g_f16MinD     = (g_f16MinC - g_f16SubC - 1);
+
+// Selects 'b' where the mask is set and 'a' otherwise, written as in the scalar implementation: a ^ ((b ^ a) & mask).
+static inline __m128i SelectEpi32(__m128i a, __m128i b, __m128i mask)
+{
+    return _mm_xor_si128(a, _mm_and_si128(_mm_xor_si128(b, a), mask));
+}
+
+// Vectorized equivalent of CompressFloat16() for four values. Each result is in the low 16 bits of its 32-bit lane.
+static inline __m128i CompressFloat16x4(__m128 value)
+{
+    __m128i v       = _mm_castps_si128(value);
+    __m128i sign    = _mm_and_si128(v, _mm_set1_epi32(g_f16SignN));
+    v       = _mm_xor_si128(v, sign);
+    sign    = _mm_srli_epi32(sign, 16);
+
+    const __m128i s = _mm_cvttps_epi32(_mm_mul_ps(_mm_castsi128_ps(_mm_set1_epi32(g_f16MulN)), _mm_castsi128_ps(v)));
+    v = SelectEpi32(v, s, _mm_cmpgt_epi32(_mm_set1_epi32(g_f16MinN), v));
+    v = SelectEpi32(v, _mm_set1_epi32(g_f16InfN), _mm_and_si128(_mm_cmpgt_epi32(_mm_set1_epi32(g_f16InfN), v), _mm_cmpgt_epi32(v, _mm_set1_epi32(g_f16MaxN))));
+    v = SelectEpi32(v, _mm_set1_epi32(g_f16NanN), _mm_and_si128(_mm_cmpgt_epi32(_mm_set1_epi32(g_f16NanN), v), _mm_cmpgt_epi32(v, _mm_set1_epi32(g_f16InfN))));
+    v = _mm_srli_epi32(v, g_f16Shift);
+    v = SelectEpi32(v, _mm_sub_epi32(v, _mm_set1_epi32(g_f16MaxD)), _mm_cmpgt_epi32(v, _mm_set1_epi32(g_f16MaxC)));
+    v = SelectEpi32(v, _mm_sub_epi32(v, _mm_set1_epi32(g_f16MinD)), _mm_cmpgt_epi32(v, _mm_set1_epi32(g_f16SubC)));
+
+    return _mm_or_si128(v, sign);
+}
+
+// Vectorized equivalent of DecompressFloat16() for four values that are zero-extended to 32-bit lanes.
+static inline __m128 DecompressFloat16x4(__m128i value)
+{
+    __m128i v       = value;
+    __m128i sign    = _mm_and_si128(v, _mm_set1_epi32(g_f16SignC));
+    v       = _mm_xor_si128(v, sign);
+    sign    = _mm_slli_epi32(sign, 16);
+
+    v = SelectEpi32(v, _mm_add_epi32(v, _mm_set1_epi32(g_f16MinD)), _mm_cmpgt_epi32(v, _mm_set1_epi32(g_f16SubC)));
+    v = SelectEpi32(v, _mm_add_epi32(v, _mm_set1_epi32(g_f16MaxD)), _mm_cmpgt_epi32(v, _mm_set1_epi32(g_f16MaxC)));
+
+    const __m128    s       = _mm_mul_ps(_mm_castsi128_ps(_mm_set1_epi32(g_f16MulC)), _mm_cvtepi32_ps(v));
+    const __m128i   mask    = _mm_cmpgt_epi32(_mm_set1_epi32(g_f16NorC), v);
+    v = _mm_slli_epi32(v, g_f16Shift);
+    v = SelectEpi32(v, _mm_castps_si128(s), mask);
+
+    return _mm_castsi128_ps(_mm_or_si128(v, sign));
+}
+
+static std::size_t ConvertFloat32ToFloat16(const float* src, std::uint16_t* dst, std::size_t numComponents)
+{
+    std::size_t i = 0;
+
+    for (; i + 8 <= numComponents; i += 8)
+    {
+        /* Sign-extend the 16-bit results, so the signed saturation of the pack instruction keeps them unchanged */
+        const __m128i a = _mm_srai_epi32(_mm_slli_epi32(CompressFloat16x4(_mm_loadu_ps(src + i    )), 16), 16);
+        const __m128i b = _mm_srai_epi32(_mm_slli_epi32(CompressFloat16x4(_mm_loadu_ps(src + i + 4)), 16), 16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(a, b));
+    }
+
+    return i;
+}
+
+static std::size_t ConvertFloat16ToFloat32(const std::uint16_t* src, float* dst, std::size_t numComponents)
+{
+    std::size_t i = 0;
+
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i + 8 <= numComponents; i += 8)
+    {
+        const __m128i halfs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_ps(dst + i    , DecompressFloat16x4(_mm_unpacklo_epi16(halfs, zero)));
+        _mm_storeu_ps(dst + i + 4, DecompressFloat16x4(_mm_unpackhi_epi16(halfs, zero)));
+    }
+
+    return i;
+}
+
+
+/* ----- Format conversion ----- */
+
+// Returns the number of channels of the specified format if it has three or four channels, or zero otherwise. Channels are indexed as R=0, G=1, B=2, A=3.
+static int GetImageFormatChannels(ImageFormat format, int (&outChannels)[4])
+{
+    switch (format)
+    {
+        case ImageFormat::RGB:  outChannels[0] = 0; outChannels[1] = 1; outChannels[2] = 2;                     return 3;
+        case ImageFormat::BGR:  outChannels[0] = 2; outChannels[1] = 1; outChannels[2] = 0;                     return 3;
+        case ImageFormat::RGBA: outChannels[0] = 0; outChannels[1] = 1; outChannels[2] = 2; outChannels[3] = 3; return 4;
+        case ImageFormat::BGRA: outChannels[0] = 2; outChannels[1] = 1; outChannels[2] = 0; outChannels[3] = 3; return 4;
+        case ImageFormat::ARGB: outChannels[0] = 3; outChannels[1] = 0; outChannels[2] = 1; outChannels[3] = 2; return 4;
+        case ImageFormat::ABGR: outChannels[0] = 3; outChannels[1] = 2; outChannels[2] = 1; outChannels[3] = 0; return 4;
+        default:                                                                                                return 0;
+    }
+}
+
+#ifdef LLGL_HAS_SSSE3_TARGET
+
+// Returns the bit pattern of the maximum value of the specified data type, which the generic path writes into a missing alpha channel.
+static std::uint32_t GetAlphaBits(DataType dataType)
+{
+    switch (dataType)
+    {
+        case DataType::Int8:    return 0x7F;
+        case DataType::UInt8:   return 0xFF;
+        case DataType::Int16:   return 0x7FFF;
+        case DataType::UInt16:  return 0xFFFF;
+        case DataType::Float16: return 0x3C00;
+        case DataType::Int32:   return 0x7FFFFFFF;
+        case DataType::UInt32:  return 0xFFFFFFFF;
+        case DataType::Float32: return 0x3F800000;
+        default:                return 0;
+    }
+}
+
+/*
+Byte shuffle of a block of pixels that occupies 16 bytes with four channels, i.e. 4, 2, or 1 pixels for 8-, 16-, or 32-bit components.
+Each destination byte is either taken from the source block (index 0-15) or zeroed (0x80) and then combined with the alpha bytes.
+*/
+struct PixelBlockShuffle
+{
+    std::uint32_t   pixelsPerBlock;
+    std::uint32_t   srcBlockSize;
+    std::uint32_t   dstBlockSize;
+    std::uint8_t    indices[16];
+    std::uint8_t    alpha[16];
+};
+
+static void BuildPixelBlockShuffle(
+    const int           (&srcChannels)[4],
+    int                 numSrcChannels,
+    const int           (&dstChannels)[4],
+    int                 numDstChannels,
+    std::uint32_t       componentSize,
+    std::uint32_t       alphaBits,
+    PixelBlockShuffle&  outShuffle)
+{
+    outShuffle.pixelsPerBlock   = 16 / (4 * componentSize);
+    outShuffle.srcBlockSize     = outShuffle.pixelsPerBlock * numSrcChannels * componentSize;
+    outShuffle.dstBlockSize     = outShuffle.pixelsPerBlock * numDstChannels * componentSize;
+
+    for_range(i, 16)
+    {
+        outShuffle.indices[i]   = 0x80;
+        outShuffle.alpha[i]     = 0;
+    }
+
+    for_range(pixel, outShuffle.pixelsPerBlock)
+    {
+        for_range(dstComponent, numDstChannels)
+        {
+            const std::uint32_t dstOffset = (pixel * numDstChannels + dstComponent) * componentSize;
+
+            /* Find source component of the same channel */
+            int srcComponent = -1;
+            for_range(i, numSrcChannels)
+            {
+                if (srcChannels[i] == dstChannels[dstComponent])
+                    srcComponent = static_cast<int>(i);
+            }
+
+            for_range(byte, componentSize)
+            {
+                if (srcComponent >= 0)
+                    outShuffle.indices[dstOffset + byte] = static_cast<std::uint8_t>((pixel * numSrcChannels + srcComponent) * componentSize + byte);
+                else
+                    outShuffle.alpha[dstOffset + byte] = static_cast<std::uint8_t>(alphaBits >> (byte * 8));
+            }
+        }
+    }
+}
+
+#ifdef LLGL_HAS_AVX2_TARGET
+
+// Shuffles two pixel blocks per iteration and advances the offsets past the last shuffled block.
+LLGL_TARGET_AVX2
+static void ShufflePixelBlocksAVX2(
+    const PixelBlockShuffle&    shuffle,
+    const char*                 src,
+    char*                       dst,
+    std::size_t                 srcSize,
+    std::size_t                 dstSize,
+    std::size_t&                srcOffset,
+    std::size_t&                dstOffset)
+{
+    const __m256i indices   = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle.indices)));
+    const __m256i alpha     = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle.alpha)));
+
+    if (shuffle.srcBlockSize == 16 && shuffle.dstBlockSize == 16)
+    {
+        /* Two blocks per iteration with contiguous 32-byte accesses */
+        for (; srcOffset + 32 <= srcSize && dstOffset + 32 <= dstSize; srcOffset += 32, dstOffset += 32)
+        {
+            const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + srcOffset));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + dstOffset), _mm256_or_si256(_mm256_shuffle_epi8(pixels, indices), alpha));
+        }
+    }
+    else
+    {
+        /* Two blocks per iteration with one block in each 128-bit lane; the second store overwrites the unused tail of the first one */
+        const std::size_t srcStep = shuffle.srcBlockSize * 2;
+        const std::size_t dstStep = shuffle.dstBlockSize * 2;
+        for (; srcOffset + shuffle.srcBlockSize + 16 <= srcSize && dstOffset + shuffle.dstBlockSize + 16 <= dstSize; srcOffset += srcStep, dstOffset += dstStep)
+        {
+            const __m256i pixels = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + srcOffset))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + srcOffset + shuffle.srcBlockSize)),
+                1
+            );
+            const __m256i result = _mm256_or_si256(_mm256_shuffle_epi8(pixels, indices), alpha);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dstOffset), _mm256_castsi256_si128(result));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dstOffset + shuffle.dstBlockSize), _mm256_extracti128_si256(result, 1));
+        }
+    }
+}
+
+#endif // /LLGL_HAS_AVX2_TARGET
+
+// Shuffles all pixel blocks that can be loaded and stored with 16-byte accesses without leaving the image range.
+LLGL_TARGET_SSSE3
+static std::size_t ShufflePixelBlocksSSSE3(const PixelBlockShuffle& shuffle, const char* src, char* dst, std::size_t numPixels)
+{
+    const std::size_t srcSize = numPixels * (shuffle.srcBlockSize / shuffle.pixelsPerBlock);
+    const std::size_t dstSize = numPixels * (shuffle.dstBlockSize / shuffle.pixelsPerBlock);
+
+    std::size_t srcOffset = 0, dstOffset = 0;
+
+    #ifdef LLGL_HAS_AVX2_TARGET
+    if (IsAVX2Supported())
+        ShufflePixelBlocksAVX2(shuffle, src, dst, srcSize, dstSize, srcOffset, dstOffset);
+    #endif // /LLGL_HAS_AVX2_TARGET
+
+    const __m128i indices   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle.indices));
+    const __m128i alpha     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle.alpha));
+
+    for (; srcOffset + 16 <= srcSize && dstOffset + 16 <= dstSize; srcOffset += shuffle.srcBlockSize, dstOffset += shuffle.dstBlockSize)
+    {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + srcOffset));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dstOffset), _mm_or_si128(_mm_shuffle_epi8(pixels, indices), alpha));
+    }
+
+    return (srcOffset / shuffle.srcBlockSize * shuffle.pixelsPerBlock);
+}
+
+#endif // /LLGL_HAS_SSSE3_TARGET
+
+/*
+Swizzles 8-bit components of four-channel pixels with SSE2, which has no byte shuffle.
+Each destination byte is shifted into place within its 32-bit pixel using run-time shift counts.
+*/
+static std::size_t SwizzlePixelsRGBA8SSE2(const int (&srcChannels)[4], const int (&dstChannels)[4], const char* src, char* dst, std::size_t numPixels)
+{
+    __m128i srcShifts[4] = {}, dstShifts[4] = {};
+    for_range(dstComponent, 4)
+    {
+        for_range(srcComponent, 4)
+        {
+            if (srcChannels[srcComponent] == dstChannels[dstComponent])
+                srcShifts[dstComponent] = _mm_cvtsi32_si128(static_cast<int>(srcComponent * 8));
+        }
+        dstShifts[dstComponent] = _mm_cvtsi32_si128(static_cast<int>(dstComponent * 8));
+    }
+
+    const __m128i lowByte = _mm_set1_epi32(0xFF);
+
+    std::size_t i = 0;
+    for (; i + 4 <= numPixels; i += 4)
+    {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        __m128i result = _mm_setzero_si128();
+        for_range(component, 4)
+        {
+            const __m128i channel = _mm_and_si128(_mm_srl_epi32(pixels, srcShifts[component]), lowByte);
+            result = _mm_or_si128(result, _mm_sll_epi32(channel, dstShifts[component]));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), result);
+    }
+
+    return i;
+}
+
+#endif // /LLGL_HAS_SSE2
+
+
+/* ----- Functions ----- */
+
+std::size_t ConvertImageDataTypeSIMD(
+    DataType    srcDataType,
+    const void* srcData,
+    DataType    dstDataType,
+    void*       dstData,
+    std::size_t numComponents)
+{
+    #ifdef LLGL_HAS_SSE2
+    if (srcDataType == DataType::UInt8 && dstDataType == DataType::Float32)
+        return ConvertUInt8ToFloat32(static_cast<const std::uint8_t*>(srcData), static_cast<float*>(dstData), numComponents);
+    if (srcDataType == DataType::Float32 && dstDataType == DataType::UInt8)
+        return ConvertFloat32ToUInt8(static_cast<const float*>(srcData), static_cast<std::uint8_t*>(dstData), numComponents);
+    if (srcDataType == DataType::Float32 && dstDataType == DataType::Float16)
+        return ConvertFloat32ToFloat16(static_cast<const float*>(srcData), static_cast<std::uint16_t*>(dstData), numComponents);
+    if (srcDataType == DataType::Float16 && dstDataType == DataType::Float32)
+        return ConvertFloat16ToFloat32(static_cast<const std::uint16_t*>(srcData), static_cast<float*>(dstData), numComponents);
+    #endif // /LLGL_HAS_SSE2
+    return 0;
+}
+
+std::size_t ConvertImageFormatSIMD(
+    ImageFormat srcFormat,
+    ImageFormat dstFormat,
+    DataType    dataType,
+    const void* srcData,
+    void*       dstData,
+    std::size_t numPixels)
+{
+    #ifdef LLGL_HAS_SSE2
+
+    int srcChannels[4] = {}, dstChannels[4] = {};
+    const int numSrcChannels = GetImageFormatChannels(srcFormat, srcChannels);
+    const int numDstChannels = GetImageFormatChannels(dstFormat, dstChannels);
+    if (numSrcChannels == 0 || numDstChannels == 0)
+        return 0;
+
+    const std::uint32_t componentSize = DataTypeSize(dataType);
+
+    #ifdef LLGL_HAS_SSSE3_TARGET
+
+    if (IsSSSE3Supported() && (componentSize == 1 || componentSize == 2 || componentSize == 4))
+    {
+        PixelBlockShuffle shuffle;
+        BuildPixelBlockShuffle(srcChannels, numSrcChannels, dstChannels, numDstChannels, componentSize, GetAlphaBits(dataType), shuffle);
+        return ShufflePixelBlocksSSSE3(shuffle, static_cast<const char*>(srcData), static_cast<char*>(dstData), numPixels);
+    }
+
+    #endif // /LLGL_HAS_SSSE3_TARGET
+
+    if (componentSize == 1 && numSrcChannels == 4 && numDstChannels == 4)
+        return SwizzlePixelsRGBA8SSE2(srcChannels, dstChannels, static_cast<const char*>(srcData), static_cast<char*>(dstData), numPixels);
+
+    #endif // /LLGL_HAS_SSE2
+
+    return 0;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
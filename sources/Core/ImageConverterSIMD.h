@@ -0,0 +1,58 @@
+/*
+ * ImageConverterSIMD.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_IMAGE_CONVERTER_SIMD_H
+#define LLGL_IMAGE_CONVERTER_SIMD_H
+
+
+#include <LLGL/Format.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/* ----- Functions ----- */
+
+/*
+Converts the data type of the leading image components with a SIMD fast path.
+Returns the number of components that have been converted, which is zero if there is no fast path for the data types.
+The remaining components must be converted with the generic path. Results are identical to the generic path.
+*/
+std::size_t ConvertImageDataTypeSIMD(
+    DataType    srcDataType,
+    const void* srcData,
+    DataType    dstDataType,
+    void*       dstData,
+    std::size_t numComponents
+);
+
+/*
+Converts the format of the leading image pixels with a SIMD fast path. Source and destination share the same data type.
+Only swizzles between formats with three or four channels as well as adding or dropping the alpha channel are supported.
+Returns the number of pixels that have been converted, which is zero if there is no fast path for the formats.
+The remaining pixels must be converted with the generic path. Memory after the last pixel is neither read nor written.
+*/
+std::size_t ConvertImageFormatSIMD(
+    ImageFormat srcFormat,
+    ImageFormat dstFormat,
+    DataType    dataType,
+    const void* srcData,
+    void*       dstData,
+    std::size_t numPixels
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,7 +6,6 @@
  */
 
 #include <LLGL/ImageFlags.h>
-#include <LLGL/Utils/ColorRGBA.h>
 #include <limits>
 #include <algorithm>
 #include <cstdint>
@@ -18,6 +17,8 @@
 #include "../Core/Threading.h"
 #include "Float16Compressor.h"
 #include "BCDecompressor.h"
+#include "BCCompressor.h"
+#include "ImageConverterSIMD.h"
 #include <LLGL/Utils/ForRange.h>
 
 
@@ -25,442 +26,472 @@ namespace LLGL
 {
 
 
-/* ----- Internal structures ----- */
+/* ----- Internal templates ----- */
 
 /*
-The Variant structures are used to unify the data type conversion.
+The generic image converter consists of two matrices of kernels that are specialized at compile time:
+one for every combination of source and destination data type, and one for every combination of source and destination
+image format per component size. The kernels are selected once per conversion, so the inner loops have no run-time switches
+and can be vectorized by the compiler. If both format and data type change, the kernels are applied one after another on small chunks.
 */
 
-union Variant
+// Size (in bytes) of the intermediate chunk when both format and data type are converted.
+static const std::size_t g_imageConversionChunkSize = 4096;
+
+// Reads the specified source value and returns it to the normalized range [0, 1].
+template <typename T>
+double ReadNormalizedInteger(T src)
 {
-    Variant()
+    auto min = static_cast<double>(std::numeric_limits<T>::min());
+    auto max = static_cast<double>(std::numeric_limits<T>::max());
+    return (static_cast<double>(src) - min) / (max - min);
+}
+
+// Writes the specified value from the range [0, 1] to the destination value.
+template <typename T>
+T WriteNormalizedInteger(double value)
+{
+    auto min = static_cast<double>(std::numeric_limits<T>::min());
+    auto max = static_cast<double>(std::numeric_limits<T>::max());
+    return static_cast<T>(value * (max - min) + min);
+}
+
+// Data type traits for integers that are normalized over their entire value range.
+template <typename T>
+struct NormalizedIntegerTraits
+{
+    using Type = T;
+
+    static double ToNormalized(T value)
     {
-        // do nothing
+        return ReadNormalizedInteger(value);
     }
 
-    std::int8_t      int8;
-    std::uint8_t     uint8;
-    std::int16_t     int16;
-    std::uint16_t    uint16;
-    std::int32_t     int32;
-    std::uint32_t    uint32;
-    float            real32;
-    double           real64;
+    static T FromNormalized(double value)
+    {
+        return WriteNormalizedInteger<T>(value);
+    }
 };
 
-union VariantBuffer
+// Data type traits for floating-point types. Values are stored as they are.
+template <typename T>
+struct FloatTraits
 {
-    VariantBuffer(void* raw) :
-        raw { raw }
+    using Type = T;
+
+    static double ToNormalized(T value)
     {
+        return static_cast<double>(value);
     }
 
-    void*           raw;
-    std::int8_t*    int8;
-    std::uint8_t*   uint8;
-    std::int16_t*   int16;
-    std::uint16_t*  uint16;
-    std::int32_t*   int32;
-    std::uint32_t*  uint32;
-    float*          real32;
-    double*         real64;
+    static T FromNormalized(double value)
+    {
+        return static_cast<T>(value);
+    }
 };
 
-union VariantConstBuffer
+// Data type traits for half-precision floats, which are stored as 16-bit unsigned integers.
+struct Float16Traits
 {
-    VariantConstBuffer(const void* raw) :
-        raw { raw }
+    using Type = std::uint16_t;
+
+    static double ToNormalized(std::uint16_t value)
     {
+        return static_cast<double>(DecompressFloat16(value));
     }
 
-    const void*             raw;
-    const std::int8_t*      int8;
-    const std::uint8_t*     uint8;
-    const std::int16_t*     int16;
-    const std::uint16_t*    uint16;
-    const std::int32_t*     int32;
-    const std::uint32_t*    uint32;
-    const float*            real32;
-    const double*           real64;
+    static std::uint16_t FromNormalized(double value)
+    {
+        return CompressFloat16(static_cast<float>(value));
+    }
 };
 
-using VariantColor = ColorRGBA<Variant>;
+template <DataType T>
+struct DataTypeTraits;
 
+template <> struct DataTypeTraits<DataType::Int8>       : NormalizedIntegerTraits<std::int8_t>      {};
+template <> struct DataTypeTraits<DataType::UInt8>      : NormalizedIntegerTraits<std::uint8_t>     {};
+template <> struct DataTypeTraits<DataType::Int16>      : NormalizedIntegerTraits<std::int16_t>     {};
+template <> struct DataTypeTraits<DataType::UInt16>     : NormalizedIntegerTraits<std::uint16_t>    {};
+template <> struct DataTypeTraits<DataType::Int32>      : NormalizedIntegerTraits<std::int32_t>     {};
+template <> struct DataTypeTraits<DataType::UInt32>     : NormalizedIntegerTraits<std::uint32_t>    {};
+template <> struct DataTypeTraits<DataType::Float16>    : Float16Traits                             {};
+template <> struct DataTypeTraits<DataType::Float32>    : FloatTraits<float>                        {};
+template <> struct DataTypeTraits<DataType::Float64>    : FloatTraits<double>                       {};
 
-/* ----- Internal functions ----- */
+/*
+Image format traits with the number of components and their layout.
+The layout stores the RGBA channel (R=0, G=1, B=2, A=3) of each component in a nibble, starting with the first component in the lowest nibble.
+*/
+template <std::uint32_t NumComponents, std::uint32_t Layout>
+struct ImageFormatLayout
+{
+    static const int            numComponents   = static_cast<int>(NumComponents);
+    static const std::uint32_t  layout          = Layout;
+};
 
-// Reads the specified source variant and returns it to the normalized range [0, 1].
-template <typename T>
-double ReadNormalizedVariant(const T& src)
+template <ImageFormat Format>
+struct ImageFormatTraits;
+
+template <> struct ImageFormatTraits<ImageFormat::Alpha>    : ImageFormatLayout<1, 0x3>     {};
+template <> struct ImageFormatTraits<ImageFormat::R>        : ImageFormatLayout<1, 0x0>     {};
+template <> struct ImageFormatTraits<ImageFormat::RG>       : ImageFormatLayout<2, 0x10>    {};
+template <> struct ImageFormatTraits<ImageFormat::RGB>      : ImageFormatLayout<3, 0x210>   {};
+template <> struct ImageFormatTraits<ImageFormat::BGR>      : ImageFormatLayout<3, 0x012>   {};
+template <> struct ImageFormatTraits<ImageFormat::RGBA>     : ImageFormatLayout<4, 0x3210>  {};
+template <> struct ImageFormatTraits<ImageFormat::BGRA>     : ImageFormatLayout<4, 0x3012>  {};
+template <> struct ImageFormatTraits<ImageFormat::ARGB>     : ImageFormatLayout<4, 0x2103>  {};
+template <> struct ImageFormatTraits<ImageFormat::ABGR>     : ImageFormatLayout<4, 0x0123>  {};
+
+// Returns the RGBA channel of the specified component in a format layout.
+static constexpr int GetLayoutChannel(std::uint32_t layout, int component)
 {
-    auto min = static_cast<double>(std::numeric_limits<T>::min());
-    auto max = static_cast<double>(std::numeric_limits<T>::max());
-    return (static_cast<double>(src) - min) / (max - min);
+    return static_cast<int>((layout >> (component * 4)) & 0xF);
 }
 
-// Writes the specified value from the range [0, 1] to the destination variant.
-template <typename T>
-void WriteNormalizedVariant(T& dst, double value)
+// Returns the component of the specified RGBA channel in a format layout, or -1 if the format does not have this channel.
+static constexpr int FindLayoutComponent(std::uint32_t layout, int numComponents, int channel, int component = 0)
 {
-    auto min = static_cast<double>(std::numeric_limits<T>::min());
-    auto max = static_cast<double>(std::numeric_limits<T>::max());
-    dst = static_cast<T>(value * (max - min) + min);
+    return
+    (
+        component >= numComponents
+            ? -1
+            : GetLayoutChannel(layout, component) == channel
+                ? component
+                : FindLayoutComponent(layout, numComponents, channel, component + 1)
+    );
 }
 
-static double ReadNormalizedTypedVariant(DataType srcDataType, const VariantConstBuffer& srcBuffer, std::size_t idx)
+// Converts a single component. Components of the same data type are copied as they are.
+template <DataType SrcType, DataType DstType>
+struct ComponentConverter
 {
-    switch (srcDataType)
+    static typename DataTypeTraits<DstType>::Type Convert(typename DataTypeTraits<SrcType>::Type value)
     {
-        case DataType::Undefined:
-            break;
-        case DataType::Int8:
-            return ReadNormalizedVariant(srcBuffer.int8[idx]);
-        case DataType::UInt8:
-            return ReadNormalizedVariant(srcBuffer.uint8[idx]);
-        case DataType::Int16:
-            return ReadNormalizedVariant(srcBuffer.int16[idx]);
-        case DataType::UInt16:
-            return ReadNormalizedVariant(srcBuffer.uint16[idx]);
-        case DataType::Int32:
-            return ReadNormalizedVariant(srcBuffer.int32[idx]);
-        case DataType::UInt32:
-            return ReadNormalizedVariant(srcBuffer.uint32[idx]);
-        case DataType::Float16:
-            return static_cast<double>(DecompressFloat16(srcBuffer.uint16[idx]));
-        case DataType::Float32:
-            return static_cast<double>(srcBuffer.real32[idx]);
-        case DataType::Float64:
-            return srcBuffer.real64[idx];
+        return DataTypeTraits<DstType>::FromNormalized(DataTypeTraits<SrcType>::ToNormalized(value));
     }
-    return 0.0;
-}
+};
 
-static void WriteNormalizedTypedVariant(DataType dstDataType, VariantBuffer& dstBuffer, std::size_t idx, double value)
+template <DataType T>
+struct ComponentConverter<T, T>
 {
-    switch (dstDataType)
+    static typename DataTypeTraits<T>::Type Convert(typename DataTypeTraits<T>::Type value)
     {
-        case DataType::Undefined:
-            break;
-        case DataType::Int8:
-            WriteNormalizedVariant(dstBuffer.int8[idx], value);
-            break;
-        case DataType::UInt8:
-            WriteNormalizedVariant(dstBuffer.uint8[idx], value);
-            break;
-        case DataType::Int16:
-            WriteNormalizedVariant(dstBuffer.int16[idx], value);
-            break;
-        case DataType::UInt16:
-            WriteNormalizedVariant(dstBuffer.uint16[idx], value);
-            break;
-        case DataType::Int32:
-            WriteNormalizedVariant(dstBuffer.int32[idx], value);
-            break;
-        case DataType::UInt32:
-            WriteNormalizedVariant(dstBuffer.uint32[idx], value);
-            break;
-        case DataType::Float16:
-            dstBuffer.uint16[idx] = CompressFloat16(static_cast<float>(value));
-            break;
-        case DataType::Float32:
-            dstBuffer.real32[idx] = static_cast<float>(value);
-            break;
-        case DataType::Float64:
-            dstBuffer.real64[idx] = value;
-            break;
+        return value;
     }
-}
+};
 
-// Worker thread procedure for the "ConvertImageBufferDataType" function
-static void ConvertImageBufferDataTypeWorker(
-    DataType            srcDataType,
-    VariantConstBuffer  srcBuffer,
-    DataType            dstDataType,
-    VariantBuffer       dstBuffer,
-    std::size_t         idxBegin,
-    std::size_t         idxEnd)
+/*
+Copies the destination component 'DstComponent' of a single pixel and all subsequent ones from the source pixel.
+Both pixels share the same data type, so components are copied as values of type T with the same size.
+Channels that are missing in the source format are taken from the default color.
+*/
+template <
+    ImageFormat SrcFormat,
+    ImageFormat DstFormat,
+    typename    T,
+    int         DstComponent,
+    bool        End = (DstComponent >= ImageFormatTraits<DstFormat>::numComponents)
+>
+struct PixelConverter
 {
-    for_subrange(i, idxBegin, idxEnd)
+    static void Convert(const T* src, T* dst, const T* defaultColor)
     {
-        /* Read normalized variant from source buffer */
-        double value = ReadNormalizedTypedVariant(srcDataType, srcBuffer, i);
+        using SrcTraits = ImageFormatTraits<SrcFormat>;
+        using DstTraits = ImageFormatTraits<DstFormat>;
+
+        const int channel       = GetLayoutChannel(DstTraits::layout, DstComponent);
+        const int srcComponent  = FindLayoutComponent(SrcTraits::layout, SrcTraits::numComponents, channel);
+
+        if (srcComponent >= 0)
+            dst[DstComponent] = src[srcComponent >= 0 ? srcComponent : 0];
+        else
+            dst[DstComponent] = defaultColor[channel];
+
+        PixelConverter<SrcFormat, DstFormat, T, DstComponent + 1>::Convert(src, dst, defaultColor);
+    }
+};
 
-        /* Write normalized variant to destination buffer */
-        WriteNormalizedTypedVariant(dstDataType, dstBuffer, i, value);
+template <ImageFormat SrcFormat, ImageFormat DstFormat, typename T, int DstComponent>
+struct PixelConverter<SrcFormat, DstFormat, T, DstComponent, true>
+{
+    static void Convert(const T* /*src*/, T* /*dst*/, const T* /*defaultColor*/)
+    {
+        // terminates recursion
     }
+};
+
+// Function signature of data type conversion kernels for the specified number of components.
+using ConvertDataTypeFunc = void (*)(const void* srcData, void* dstData, std::size_t numComponents);
+
+// Function signature of format conversion kernels for the specified number of pixels. The default color provides missing channels in RGBA order.
+using ConvertFormatFunc = void (*)(const void* srcData, void* dstData, std::size_t numPixels, const void* defaultColor);
+
+// Data type conversion kernel for a single combination of data types.
+template <DataType SrcType, DataType DstType>
+void ConvertDataType(const void* srcData, void* dstData, std::size_t numComponents)
+{
+    auto src = static_cast<const typename DataTypeTraits<SrcType>::Type*>(srcData);
+    auto dst = static_cast<typename DataTypeTraits<DstType>::Type*>(dstData);
+
+    for_range(i, numComponents)
+        dst[i] = ComponentConverter<SrcType, DstType>::Convert(src[i]);
 }
 
-static void ConvertImageBufferDataType(
-    DataType    srcDataType,
-    const void* srcBuffer,
-    std::size_t srcBufferSize,
-    DataType    dstDataType,
-    void*       dstBuffer,
-    std::size_t dstBufferSize,
-    unsigned    threadCount)
+// Format conversion kernel for a single combination of formats with components of type T.
+template <ImageFormat SrcFormat, ImageFormat DstFormat, typename T>
+void ConvertFormat(const void* srcData, void* dstData, std::size_t numPixels, const void* defaultColor)
 {
-    /* Validate destination buffer size */
-    auto imageSize              = srcBufferSize / DataTypeSize(srcDataType);
-    auto requiredDstBufferSize  = imageSize * DataTypeSize(dstDataType);
+    const int numSrcComponents = ImageFormatTraits<SrcFormat>::numComponents;
+    const int numDstComponents = ImageFormatTraits<DstFormat>::numComponents;
 
-    if (dstBufferSize != requiredDstBufferSize)
-        throw std::invalid_argument("cannot convert image data type with destination buffer size mismatch");
+    auto src        = static_cast<const T*>(srcData);
+    auto dst        = static_cast<T*>(dstData);
+    auto defaults   = static_cast<const T*>(defaultColor);
 
-    /* Get variant buffer for source and destination images */
-    DoConcurrentRange(
-        std::bind(
-            ConvertImageBufferDataTypeWorker,
-            srcDataType,
-            srcBuffer,
-            dstDataType,
-            dstBuffer,
-            std::placeholders::_1,
-            std::placeholders::_2
-        ),
-        imageSize,
-        threadCount
-    );
+    for_range(i, numPixels)
+    {
+        PixelConverter<SrcFormat, DstFormat, T, 0>::Convert(src, dst, defaults);
+        src += numSrcComponents;
+        dst += numDstComponents;
+    }
+}
+
+template <DataType SrcType>
+ConvertDataTypeFunc SelectConvertDataTypeFunc(DataType dstDataType)
+{
+    switch (dstDataType)
+    {
+        case DataType::Undefined:   break;
+        case DataType::Int8:        return ConvertDataType<SrcType, DataType::Int8   >;
+        case DataType::UInt8:       return ConvertDataType<SrcType, DataType::UInt8  >;
+        case DataType::Int16:       return ConvertDataType<SrcType, DataType::Int16  >;
+        case DataType::UInt16:      return ConvertDataType<SrcType, DataType::UInt16 >;
+        case DataType::Int32:       return ConvertDataType<SrcType, DataType::Int32  >;
+        case DataType::UInt32:      return ConvertDataType<SrcType, DataType::UInt32 >;
+        case DataType::Float16:     return ConvertDataType<SrcType, DataType::Float16>;
+        case DataType::Float32:     return ConvertDataType<SrcType, DataType::Float32>;
+        case DataType::Float64:     return ConvertDataType<SrcType, DataType::Float64>;
+    }
+    return nullptr;
+}
+
+// Returns the data type conversion kernel for the specified data types, or null if either of them is undefined.
+static ConvertDataTypeFunc SelectConvertDataTypeFunc(DataType srcDataType, DataType dstDataType)
+{
+    switch (srcDataType)
+    {
+        case DataType::Undefined:   break;
+        case DataType::Int8:        return SelectConvertDataTypeFunc<DataType::Int8   >(dstDataType);
+        case DataType::UInt8:       return SelectConvertDataTypeFunc<DataType::UInt8  >(dstDataType);
+        case DataType::Int16:       return SelectConvertDataTypeFunc<DataType::Int16  >(dstDataType);
+        case DataType::UInt16:      return SelectConvertDataTypeFunc<DataType::UInt16 >(dstDataType);
+        case DataType::Int32:       return SelectConvertDataTypeFunc<DataType::Int32  >(dstDataType);
+        case DataType::UInt32:      return SelectConvertDataTypeFunc<DataType::UInt32 >(dstDataType);
+        case DataType::Float16:     return SelectConvertDataTypeFunc<DataType::Float16>(dstDataType);
+        case DataType::Float32:     return SelectConvertDataTypeFunc<DataType::Float32>(dstDataType);
+        case DataType::Float64:     return SelectConvertDataTypeFunc<DataType::Float64>(dstDataType);
+    }
+    return nullptr;
 }
 
-static void SetVariantMinMax(DataType dataType, Variant& var, bool setMin)
+template <ImageFormat SrcFormat, ImageFormat DstFormat>
+ConvertFormatFunc SelectConvertFormatFunc(std::uint32_t componentSize)
 {
-    switch (dataType)
+    switch (componentSize)
     {
-        case DataType::Undefined:
-            break;
-        case DataType::Int8:
-            var.int8 = (setMin ? std::numeric_limits<std::int8_t>::min() : std::numeric_limits<std::int8_t>::max());
-            break;
-        case DataType::UInt8:
-            var.uint8 = (setMin ? std::numeric_limits<std::uint8_t>::min() : std::numeric_limits<std::uint8_t>::max());
-            break;
-        case DataType::Int16:
-            var.int16 = (setMin ? std::numeric_limits<std::int16_t>::min() : std::numeric_limits<std::int16_t>::max());
-            break;
-        case DataType::UInt16:
-            var.uint16 = (setMin ? std::numeric_limits<std::uint16_t>::min() : std::numeric_limits<std::uint16_t>::max());
-            break;
-        case DataType::Int32:
-            var.int32 = (setMin ? std::numeric_limits<std::int32_t>::min() : std::numeric_limits<std::int32_t>::max());
-            break;
-        case DataType::UInt32:
-            var.uint32 = (setMin ? std::numeric_limits<std::uint32_t>::min() : std::numeric_limits<std::uint32_t>::max());
-            break;
-        case DataType::Float16:
-            var.uint16 = CompressFloat16(setMin ? 0.0f : 1.0f);
-            break;
-        case DataType::Float32:
-            var.real32 = (setMin ? 0.0f : 1.0f);
-            break;
-        case DataType::Float64:
-            var.real64 = (setMin ? 0.0 : 1.0);
-            break;
+        case 1:     return ConvertFormat<SrcFormat, DstFormat, std::uint8_t >;
+        case 2:     return ConvertFormat<SrcFormat, DstFormat, std::uint16_t>;
+        case 4:     return ConvertFormat<SrcFormat, DstFormat, std::uint32_t>;
+        case 8:     return ConvertFormat<SrcFormat, DstFormat, std::uint64_t>;
+        default:    return nullptr;
     }
 }
 
-static void CopyTypedVariant(DataType dataType, const VariantConstBuffer& srcBuffer, std::size_t idx, Variant& dst)
+template <ImageFormat SrcFormat>
+ConvertFormatFunc SelectConvertFormatFunc(ImageFormat dstFormat, std::uint32_t componentSize)
 {
-    switch (dataType)
+    switch (dstFormat)
     {
-        case DataType::Undefined:
-            break;
-        case DataType::Int8:
-            dst.int8 = srcBuffer.int8[idx];
-            break;
-        case DataType::UInt8:
-            dst.uint8 = srcBuffer.uint8[idx];
-            break;
-        case DataType::Int16:
-            dst.int16 = srcBuffer.int16[idx];
-            break;
-        case DataType::UInt16:
-            dst.uint16 = srcBuffer.uint16[idx];
-            break;
-        case DataType::Int32:
-            dst.int32 = srcBuffer.int32[idx];
-            break;
-        case DataType::UInt32:
-            dst.uint32 = srcBuffer.uint32[idx];
-            break;
-        case DataType::Float16:
-            dst.uint16 = srcBuffer.uint16[idx];
-            break;
-        case DataType::Float32:
-            dst.real32 = srcBuffer.real32[idx];
-            break;
-        case DataType::Float64:
-            dst.real64 = srcBuffer.real64[idx];
-            break;
+        case ImageFormat::Alpha:    return SelectConvertFormatFunc<SrcFormat, ImageFormat::Alpha>(componentSize);
+        case ImageFormat::R:        return SelectConvertFormatFunc<SrcFormat, ImageFormat::R    >(componentSize);
+        case ImageFormat::RG:       return SelectConvertFormatFunc<SrcFormat, ImageFormat::RG   >(componentSize);
+        case ImageFormat::RGB:      return SelectConvertFormatFunc<SrcFormat, ImageFormat::RGB  >(componentSize);
+        case ImageFormat::BGR:      return SelectConvertFormatFunc<SrcFormat, ImageFormat::BGR  >(componentSize);
+        case ImageFormat::RGBA:     return SelectConvertFormatFunc<SrcFormat, ImageFormat::RGBA >(componentSize);
+        case ImageFormat::BGRA:     return SelectConvertFormatFunc<SrcFormat, ImageFormat::BGRA >(componentSize);
+        case ImageFormat::ARGB:     return SelectConvertFormatFunc<SrcFormat, ImageFormat::ARGB >(componentSize);
+        case ImageFormat::ABGR:     return SelectConvertFormatFunc<SrcFormat, ImageFormat::ABGR >(componentSize);
+        default:                    return nullptr;
     }
 }
 
-static void CopyTypedVariant(DataType dataType, VariantBuffer& dstBuffer, std::size_t idx, const Variant& src)
+// Returns the format conversion kernel for the specified color formats and component size in bytes, or null if any of them is not supported.
+static ConvertFormatFunc SelectConvertFormatFunc(ImageFormat srcFormat, ImageFormat dstFormat, std::uint32_t componentSize)
 {
-    switch (dataType)
+    switch (srcFormat)
     {
-        case DataType::Undefined:
-            break;
-        case DataType::Int8:
-            dstBuffer.int8[idx] = src.int8;
-            break;
-        case DataType::UInt8:
-            dstBuffer.uint8[idx] = src.uint8;
-            break;
-        case DataType::Int16:
-            dstBuffer.int16[idx] = src.int16;
-            break;
-        case DataType::UInt16:
-            dstBuffer.uint16[idx] = src.uint16;
-            break;
-        case DataType::Int32:
-            dstBuffer.int32[idx] = src.int32;
-            break;
-        case DataType::UInt32:
-            dstBuffer.uint32[idx] = src.uint32;
-            break;
-        case DataType::Float16:
-            dstBuffer.uint16[idx] = src.uint16;
-            break;
-        case DataType::Float32:
-            dstBuffer.real32[idx] = src.real32;
-            break;
-        case DataType::Float64:
-            dstBuffer.real64[idx] = src.real64;
-            break;
+        case ImageFormat::Alpha:    return SelectConvertFormatFunc<ImageFormat::Alpha>(dstFormat, componentSize);
+        case ImageFormat::R:        return SelectConvertFormatFunc<ImageFormat::R    >(dstFormat, componentSize);
+        case ImageFormat::RG:       return SelectConvertFormatFunc<ImageFormat::RG   >(dstFormat, componentSize);
+        case ImageFormat::RGB:      return SelectConvertFormatFunc<ImageFormat::RGB  >(dstFormat, componentSize);
+        case ImageFormat::BGR:      return SelectConvertFormatFunc<ImageFormat::BGR  >(dstFormat, componentSize);
+        case ImageFormat::RGBA:     return SelectConvertFormatFunc<ImageFormat::RGBA >(dstFormat, componentSize);
+        case ImageFormat::BGRA:     return SelectConvertFormatFunc<ImageFormat::BGRA >(dstFormat, componentSize);
+        case ImageFormat::ARGB:     return SelectConvertFormatFunc<ImageFormat::ARGB >(dstFormat, componentSize);
+        case ImageFormat::ABGR:     return SelectConvertFormatFunc<ImageFormat::ABGR >(dstFormat, componentSize);
+        default:                    return nullptr;
     }
 }
 
-template <typename TBuf, typename TVar>
-void TransferRGBAFormattedVariantColor(ImageFormat format, DataType dataType, TBuf& buffer, std::size_t idx, TVar& value)
+/*
+Conversion kernels and parameters that are selected once per image conversion.
+Each kernel is null if its part of the conversion is not required. If both are required, the data type is converted first.
+*/
+struct ImageConversion
 {
-    switch (format)
+    ImageConversion(const SrcImageDescriptor& srcImageDesc, ImageFormat dstFormat, DataType dstDataType);
+
+    ImageFormat         srcFormat;
+    DataType            srcDataType;
+    ImageFormat         dstFormat;
+    DataType            dstDataType;
+    ConvertDataTypeFunc convertDataType = nullptr;
+    ConvertFormatFunc   convertFormat   = nullptr;
+    double              defaultColor[4];                // Default color (0, 0, 0, 1) in the destination data type
+};
+
+ImageConversion::ImageConversion(const SrcImageDescriptor& srcImageDesc, ImageFormat dstFormat, DataType dstDataType) :
+    srcFormat   { srcImageDesc.format   },
+    srcDataType { srcImageDesc.dataType },
+    dstFormat   { dstFormat             },
+    dstDataType { dstDataType           }
+{
+    /* Select kernels */
+    if (srcDataType != dstDataType)
     {
-        case ImageFormat::Alpha:
-            CopyTypedVariant(dataType, buffer, idx    , value.a);
-            break;
-        case ImageFormat::R:
-            CopyTypedVariant(dataType, buffer, idx    , value.r);
-            break;
-        case ImageFormat::RG:
-            CopyTypedVariant(dataType, buffer, idx    , value.r);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.g);
-            break;
-        case ImageFormat::RGB:
-            CopyTypedVariant(dataType, buffer, idx    , value.r);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.b);
-            break;
-        case ImageFormat::BGR:
-            CopyTypedVariant(dataType, buffer, idx    , value.b);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.r);
-            break;
-        case ImageFormat::RGBA:
-            CopyTypedVariant(dataType, buffer, idx    , value.r);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.b);
-            CopyTypedVariant(dataType, buffer, idx + 3, value.a);
-            break;
-        case ImageFormat::BGRA:
-            CopyTypedVariant(dataType, buffer, idx    , value.b);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.r);
-            CopyTypedVariant(dataType, buffer, idx + 3, value.a);
-            break;
-        case ImageFormat::ARGB:
-            CopyTypedVariant(dataType, buffer, idx    , value.a);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.r);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 3, value.b);
-            break;
-        case ImageFormat::ABGR:
-            CopyTypedVariant(dataType, buffer, idx    , value.a);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.b);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 3, value.r);
-            break;
-        default:
-            break;
+        convertDataType = SelectConvertDataTypeFunc(srcDataType, dstDataType);
+        if (convertDataType == nullptr)
+            throw std::invalid_argument("cannot convert image data type with undefined data type");
+    }
+
+    if (srcFormat != dstFormat)
+    {
+        convertFormat = SelectConvertFormatFunc(srcFormat, dstFormat, DataTypeSize(dstDataType));
+        if (convertFormat == nullptr)
+            throw std::invalid_argument("cannot convert image format with unsupported format or data type");
+
+        /* Normalized values 0 and 1 are the minimum and maximum of each data type */
+        const double defaultColorNormalized[4] = { 0.0, 0.0, 0.0, 1.0 };
+        if (ConvertDataTypeFunc convertDefaultColor = SelectConvertDataTypeFunc(DataType::Float64, dstDataType))
+            convertDefaultColor(defaultColorNormalized, defaultColor, 4);
     }
 }
 
-static void ReadRGBAFormattedVariant(
-    ImageFormat srcFormat, DataType dataType, const VariantConstBuffer& srcBuffer, std::size_t idx, VariantColor& value)
+/* ----- Internal functions ----- */
+
+// Converts the data type of the specified components with the SIMD fast path first and the specialized kernel for the remaining components.
+static void ConvertImageDataType(
+    const ImageConversion&  conversion,
+    const void*             srcData,
+    void*                   dstData,
+    std::size_t             numComponents)
 {
-    TransferRGBAFormattedVariantColor(srcFormat, dataType, srcBuffer, idx, value);
+    const std::size_t numConverted = ConvertImageDataTypeSIMD(conversion.srcDataType, srcData, conversion.dstDataType, dstData, numComponents);
+    if (numConverted < numComponents)
+    {
+        conversion.convertDataType(
+            static_cast<const char*>(srcData) + numConverted * DataTypeSize(conversion.srcDataType),
+            static_cast<char*>(dstData) + numConverted * DataTypeSize(conversion.dstDataType),
+            numComponents - numConverted
+        );
+    }
 }
 
-static void WriteRGBAFormattedVariant(
-    ImageFormat dstFormat, DataType dataType, VariantBuffer& dstBuffer, std::size_t idx, const VariantColor& value)
+// Converts the format of the specified pixels with the SIMD fast path first and the specialized kernel for the remaining pixels.
+static void ConvertImageFormat(
+    const ImageConversion&  conversion,
+    const void*             srcData,
+    void*                   dstData,
+    std::size_t             numPixels)
 {
-    TransferRGBAFormattedVariantColor(dstFormat, dataType, dstBuffer, idx, value);
+    const std::size_t numConverted = ConvertImageFormatSIMD(conversion.srcFormat, conversion.dstFormat, conversion.dstDataType, srcData, dstData, numPixels);
+    if (numConverted < numPixels)
+    {
+        const std::size_t componentSize = DataTypeSize(conversion.dstDataType);
+        conversion.convertFormat(
+            static_cast<const char*>(srcData) + numConverted * ImageFormatSize(conversion.srcFormat) * componentSize,
+            static_cast<char*>(dstData) + numConverted * ImageFormatSize(conversion.dstFormat) * componentSize,
+            numPixels - numConverted,
+            conversion.defaultColor
+        );
+    }
 }
 
-// Worker thread procedure for the "ConvertImageBufferFormat" function
-static void ConvertImageBufferFormatWorker(
-    ImageFormat         srcFormat,
-    DataType            srcDataType,
-    VariantConstBuffer  srcBuffer,
-    ImageFormat         dstFormat,
-    VariantBuffer       dstBuffer,
-    std::size_t         begin,
-    std::size_t         end)
-{
-    /* Get size for source and destination formats */
-    auto srcFormatSize = ImageFormatSize(srcFormat);
-    auto dstFormatSize = ImageFormatSize(dstFormat);
-
-    /* Initialize default variant color (0, 0, 0, 1) */
-    VariantColor value{ UninitializeTag{} };
-
-    SetVariantMinMax(srcDataType, value.r, true);
-    SetVariantMinMax(srcDataType, value.g, true);
-    SetVariantMinMax(srcDataType, value.b, true);
-    SetVariantMinMax(srcDataType, value.a, false);
-
-    for_subrange(i, begin, end)
+// Worker thread procedure for the "ConvertImageBufferPixels" function
+static void ConvertImageBufferWorker(
+    const ImageConversion&  conversion,
+    const void*             srcImageData,
+    void*                   dstImageData,
+    std::size_t             begin,
+    std::size_t             end)
+{
+    const std::size_t numSrcComponents  = ImageFormatSize(conversion.srcFormat);
+    const std::size_t srcPixelSize      = numSrcComponents * DataTypeSize(conversion.srcDataType);
+    const std::size_t dstPixelSize      = ImageFormatSize(conversion.dstFormat) * DataTypeSize(conversion.dstDataType);
+
+    auto srcData = static_cast<const char*>(srcImageData) + begin * srcPixelSize;
+    auto dstData = static_cast<char*>(dstImageData) + begin * dstPixelSize;
+
+    if (conversion.convertFormat == nullptr && conversion.convertDataType == nullptr)
+        ::memcpy(dstData, srcData, (end - begin) * dstPixelSize);
+    else if (conversion.convertFormat == nullptr)
+        ConvertImageDataType(conversion, srcData, dstData, (end - begin) * numSrcComponents);
+    else if (conversion.convertDataType == nullptr)
+        ConvertImageFormat(conversion, srcData, dstData, end - begin);
+    else
     {
-        /* Read RGBA variant from source buffer */
-        ReadRGBAFormattedVariant(srcFormat, srcDataType, srcBuffer, i*srcFormatSize, value);
+        /* Convert data type and format in chunks that stay in the cache, instead of going through an intermediate image buffer */
+        const std::size_t   intermediatePixelSize   = numSrcComponents * DataTypeSize(conversion.dstDataType);
+        const std::size_t   numChunkPixels          = g_imageConversionChunkSize / intermediatePixelSize;
+        double              intermediateData[g_imageConversionChunkSize / sizeof(double)];
 
-        /* Write RGBA variant to destination buffer */
-        WriteRGBAFormattedVariant(dstFormat, srcDataType, dstBuffer, i*dstFormatSize, value);
+        for (std::size_t chunkBegin = begin; chunkBegin < end; chunkBegin += numChunkPixels)
+        {
+            const std::size_t numPixels = std::min(numChunkPixels, end - chunkBegin);
+            ConvertImageDataType(conversion, srcData, intermediateData, numPixels * numSrcComponents);
+            ConvertImageFormat(conversion, intermediateData, dstData, numPixels);
+            srcData += numPixels * srcPixelSize;
+            dstData += numPixels * dstPixelSize;
+        }
     }
 }
 
-static void ConvertImageBufferFormat(
+static void ConvertImageBufferPixels(
     const SrcImageDescriptor&   srcImageDesc,
     const DstImageDescriptor&   dstImageDesc,
     unsigned                    threadCount)
 {
-    /* Get image parameters */
-    auto dataTypeSize   = DataTypeSize(srcImageDesc.dataType);
-    auto srcFormatSize  = ImageFormatSize(srcImageDesc.format);
-    auto dstFormatSize  = ImageFormatSize(dstImageDesc.format);
-
     /* Validate destination buffer size */
-    auto imageSize              = srcImageDesc.dataSize / srcFormatSize;
-    auto requiredDstBufferSize  = imageSize * dstFormatSize;
+    const std::size_t numPixels             = srcImageDesc.dataSize / GetMemoryFootprint(srcImageDesc.format, srcImageDesc.dataType, 1);
+    const std::size_t requiredDstBufferSize = numPixels * GetMemoryFootprint(dstImageDesc.format, dstImageDesc.dataType, 1);
 
     if (dstImageDesc.dataSize != requiredDstBufferSize)
-        throw std::invalid_argument("cannot convert image format with destination buffer size mismatch");
+        throw std::invalid_argument("cannot convert image buffer with destination buffer size mismatch");
 
-    /* Allocate destination buffer */
-    imageSize /= dataTypeSize;
+    /* Select conversion kernels once for the entire image */
+    const ImageConversion conversion{ srcImageDesc, dstImageDesc.format, dstImageDesc.dataType };
 
-    /* Get variant buffer for source and destination images */
     DoConcurrentRange(
         std::bind(
-            ConvertImageBufferFormatWorker,
-            srcImageDesc.format,
-            srcImageDesc.dataType,
+            ConvertImageBufferWorker,
+            std::cref(conversion),
             srcImageDesc.data,
-            dstImageDesc.format,
             dstImageDesc.data,
             std::placeholders::_1,
             std::placeholders::_2
         ),
-        imageSize,
+        numPixels,
         threadCount
     );
 }
@@ -503,61 +534,16 @@ LLGL_EXPORT bool ConvertImageBuffer(
     ValidateDestinationImageDesc(dstImageDesc);
     ValidateImageConversionParams(srcImageDesc, dstImageDesc.format, dstImageDesc.dataType);
 
+    if (srcImageDesc.format == dstImageDesc.format && srcImageDesc.dataType == dstImageDesc.dataType)
+        return false;
+
     if (threadCount >= Constants::maxThreadCount)
         threadCount = std::thread::hardware_concurrency();
 
-    if (srcImageDesc.dataType != dstImageDesc.dataType && srcImageDesc.format != dstImageDesc.format)
-    {
-        /* Convert image data type with intermediate buffer */
-        auto intermediateBufferSize = srcImageDesc.dataSize / DataTypeSize(srcImageDesc.dataType) * DataTypeSize(dstImageDesc.dataType);
-        auto intermediateBuffer     = MakeUniqueArray<char>(intermediateBufferSize);
-
-        ConvertImageBufferDataType(
-            srcImageDesc.dataType,
-            srcImageDesc.data,
-            srcImageDesc.dataSize,
-            dstImageDesc.dataType,
-            intermediateBuffer.get(),
-            intermediateBufferSize,
-            threadCount
-        );
-
-        /* Set new source buffer and source data type */
-        const SrcImageDescriptor intermediateImageDesc
-        {
-            srcImageDesc.format,
-            dstImageDesc.dataType,
-            intermediateBuffer.get(),
-            intermediateBufferSize
-        };
-
-        /* Convert image format */
-        ConvertImageBufferFormat(intermediateImageDesc, dstImageDesc, threadCount);
-
-        return true;
-    }
-    else if (srcImageDesc.dataType != dstImageDesc.dataType)
-    {
-        /* Convert image data type */
-        ConvertImageBufferDataType(
-            srcImageDesc.dataType,
-            srcImageDesc.data,
-            srcImageDesc.dataSize,
-            dstImageDesc.dataType,
-            dstImageDesc.data,
-            dstImageDesc.dataSize,
-            threadCount
-        );
-        return true;
-    }
-    else if (srcImageDesc.format != dstImageDesc.format)
-    {
-        /* Convert image format */
-        ConvertImageBufferFormat(srcImageDesc, dstImageDesc, threadCount);
-        return true;
-    }
+    /* Convert image format and data type in a single pass */
+    ConvertImageBufferPixels(srcImageDesc, dstImageDesc, threadCount);
 
-    return false;
+    return true;
 }
 
 LLGL_EXPORT ByteBuffer ConvertImageBuffer(
@@ -570,6 +556,9 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     ValidateSourceImageDesc(srcImageDesc);
     ValidateImageConversionParams(srcImageDesc, dstFormat, dstDataType);
 
+    if (srcImageDesc.format == dstFormat && srcImageDesc.dataType == dstDataType)
+        return nullptr;
+
     if (threadCount >= Constants::maxThreadCount)
         threadCount = std::thread::hardware_concurrency();
 
@@ -584,69 +573,13 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
         srcNumPixels * DataTypeSize(dstDataType) * ImageFormatSize(dstFormat)
     };
 
-    if (srcImageDesc.dataType != dstDataType && srcImageDesc.format != dstFormat)
+    /* Convert image format and data type in a single pass */
+    auto dstImage = MakeUniqueArray<char>(dstImageDesc.dataSize);
     {
-        auto dstImage = MakeUniqueArray<char>(dstImageDesc.dataSize);
-        {
-            /* Convert image data type with intermediate buffer */
-            auto intermediateBufferSize = srcImageDesc.dataSize / DataTypeSize(srcImageDesc.dataType) * DataTypeSize(dstDataType);
-            auto intermediateBuffer     = MakeUniqueArray<char>(intermediateBufferSize);
-
-            ConvertImageBufferDataType(
-                srcImageDesc.dataType,
-                srcImageDesc.data,
-                srcImageDesc.dataSize,
-                dstDataType,
-                intermediateBuffer.get(),
-                intermediateBufferSize,
-                threadCount
-            );
-
-            /* Set new source buffer and source data type */
-            const SrcImageDescriptor intermediateImageDesc
-            {
-                srcImageDesc.format,
-                dstDataType,
-                intermediateBuffer.get(),
-                intermediateBufferSize
-            };
-
-            /* Convert image format */
-            dstImageDesc.data = dstImage.get();
-            ConvertImageBufferFormat(intermediateImageDesc, dstImageDesc, threadCount);
-        }
-        return dstImage;
-    }
-    else if (srcImageDesc.dataType != dstDataType)
-    {
-        /* Convert image data type */
-        auto dstImage = MakeUniqueArray<char>(dstImageDesc.dataSize);
-        {
-            dstImageDesc.data = dstImage.get();
-            ConvertImageBufferDataType(
-                srcImageDesc.dataType,
-                srcImageDesc.data,
-                srcImageDesc.dataSize,
-                dstDataType,
-                dstImageDesc.data,
-                dstImageDesc.dataSize,
-                threadCount
-            );
-        }
-        return dstImage;
+        dstImageDesc.data = dstImage.get();
+        ConvertImageBufferPixels(srcImageDesc, dstImageDesc, threadCount);
     }
-    else if (srcImageDesc.format != dstFormat)
-    {
-        /* Convert image format */
-        auto dstImage = MakeUniqueArray<char>(dstImageDesc.dataSize);
-        {
-            dstImageDesc.data = dstImage.get();
-            ConvertImageBufferFormat(srcImageDesc, dstImageDesc, threadCount);
-        }
-        return dstImage;
-    }
-
-    return nullptr;
+    return dstImage;
 }
 
 LLGL_EXPORT ByteBuffer DecompressImageBufferToRGBA8UNorm(
@@ -658,10 +591,54 @@ LLGL_EXPORT ByteBuffer DecompressImageBufferToRGBA8UNorm(
         threadCount = std::thread::hardware_concurrency();
 
     /* Check for BC compression */
-    if (srcImageDesc.format == ImageFormat::BC1)
-        return DecompressBC1ToRGBA8UNorm(extent, reinterpret_cast<const char*>(srcImageDesc.data), srcImageDesc.dataSize, threadCount);
+    return DecompressBCToRGBA8UNorm(
+        srcImageDesc.format,
+        srcImageDesc.dataType,
+        extent,
+        reinterpret_cast<const char*>(srcImageDesc.data),
+        srcImageDesc.dataSize,
+        threadCount
+    );
+}
 
-    return nullptr;
+LLGL_EXPORT ByteBuffer CompressImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent2D&             extent,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType,
+    ImageCompressionMode        mode,
+    unsigned                    threadCount)
+{
+    /* Validate input parameters */
+    ValidateSourceImageDesc(srcImageDesc);
+    ValidateImageConversionParams(srcImageDesc, ImageFormat::RGBA, DataType::UInt8);
+
+    if (srcImageDesc.dataSize != GetMemoryFootprint(srcImageDesc.format, srcImageDesc.dataType, extent.width * extent.height))
+        throw std::invalid_argument("cannot compress image buffer with source buffer size mismatch");
+
+    const bool isSignedFormat = (dstFormat == ImageFormat::BC4 || dstFormat == ImageFormat::BC5);
+    if (!(dstDataType == DataType::UInt8 || (isSignedFormat && dstDataType == DataType::Int8)))
+        throw std::invalid_argument("cannot compress image buffer with destination data type other than UInt8, or Int8 for BC4 and BC5");
+
+    if (!IsCompressedFormat(dstFormat) || extent.width == 0 || extent.height == 0)
+        return nullptr;
+
+    if (threadCount >= Constants::maxThreadCount)
+        threadCount = std::thread::hardware_concurrency();
+
+    /* Convert source image to RGBA8UNorm if necessary */
+    auto rgbaImage = ConvertImageBuffer(srcImageDesc, ImageFormat::RGBA, DataType::UInt8, threadCount);
+    auto rgbaData  = (rgbaImage ? rgbaImage.get() : static_cast<const char*>(srcImageDesc.data));
+
+    /* Check for BC compression */
+    return CompressRGBA8UNormToBC(
+        dstFormat,
+        dstDataType,
+        mode,
+        extent,
+        reinterpret_cast<const std::uint8_t*>(rgbaData),
+        threadCount
+    );
 }
 
 // Returns the 1D flattened buffer position for a 3D image coordinate ('bpp' denotes the bytes per pixel)
@@ -747,22 +724,16 @@ LLGL_EXPORT ByteBuffer GenerateImageBuffer(
     std::size_t imageSize,
     const float fillColor[4])
 {
-    /* Convert fill color data type */
-    VariantColor fillColor0{ UninitializeTag{} };
-    VariantBuffer fillBuffer0{ &fillColor0 };
-
-    WriteNormalizedTypedVariant(dataType, fillBuffer0, 0, fillColor[0]);
-    WriteNormalizedTypedVariant(dataType, fillBuffer0, 1, fillColor[1]);
-    WriteNormalizedTypedVariant(dataType, fillBuffer0, 2, fillColor[2]);
-    WriteNormalizedTypedVariant(dataType, fillBuffer0, 3, fillColor[3]);
-
-    /* Convert fill color format */
-    VariantColor fillColor1{ UninitializeTag{} };
-    VariantBuffer fillBuffer1{ &fillColor1 };
-    VariantConstBuffer fillBuffer2{ fillBuffer0.raw };
+    /*
+    Convert fill color to the image format and data type.
+    Formats without color channels (i.e. depth-stencil formats) take the leading components of the fill color instead.
+    */
+    const SrcImageDescriptor fillColorDesc{ ImageFormat::RGBA, DataType::Float32, fillColor, sizeof(float) * 4 };
+    const bool isColorFormat = (SelectConvertFormatFunc(ImageFormat::RGBA, format, DataTypeSize(dataType)) != nullptr);
+    const ImageConversion conversion{ fillColorDesc, (isColorFormat ? format : ImageFormat::RGBA), dataType };
 
-    ReadRGBAFormattedVariant(ImageFormat::RGBA, dataType, fillBuffer2, 0, fillColor1);
-    WriteRGBAFormattedVariant(format, dataType, fillBuffer1, 0, fillColor1);
+    double fillPixel[4] = {};
+    ConvertImageBufferWorker(conversion, fillColor, fillPixel, 0, 1);
 
     /* Allocate image buffer */
     const auto bytesPerPixel = DataTypeSize(dataType) * ImageFormatSize(format);
@@ -770,10 +741,10 @@ LLGL_EXPORT ByteBuffer GenerateImageBuffer(
 
     /* Initialize image buffer with fill color */
     DoConcurrentRange(
-        [&imageBuffer, bytesPerPixel, &fillBuffer1](std::size_t begin, std::size_t end)
+        [&imageBuffer, bytesPerPixel, &fillPixel](std::size_t begin, std::size_t end)
         {
             for_subrange(i, begin, end)
-                ::memcpy(imageBuffer.get() + bytesPerPixel * i, fillBuffer1.raw, bytesPerPixel);
+                ::memcpy(imageBuffer.get() + bytesPerPixel * i, fillPixel, bytesPerPixel);
         },
         imageSize
     );
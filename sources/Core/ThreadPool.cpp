@@ -0,0 +1,197 @@
+/*
+ * ThreadPool.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "ThreadPool.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+
+namespace LLGL
+{
+
+
+// Range of a job that is primarily processed by one thread. The padding keeps the atomic counters of different slices in separate cache lines.
+struct ThreadPoolSlice
+{
+    std::atomic<std::size_t>    next;
+    std::size_t                 end;
+    char                        padding[64 - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)];
+};
+
+struct ThreadPool::Job
+{
+    const RangeTask*                task            = nullptr;
+    std::size_t                     chunkSize       = 1;
+    std::vector<ThreadPoolSlice>    slices;
+    std::atomic<unsigned>           nextSlice;                      // Slice of the next thread that joins this job
+    std::atomic<bool>               failed;
+    std::exception_ptr              exception;                      // First exception thrown by the task; guarded by 'failed'
+    unsigned                        numWorkers      = 0;            // Worker threads currently processing this job; guarded by the pool mutex
+    unsigned                        maxWorkers      = 0;
+};
+
+ThreadPool::ThreadPool(unsigned numWorkers)
+{
+    workers_.reserve(numWorkers);
+    for_range(i, numWorkers)
+        workers_.push_back(std::thread(&ThreadPool::WorkerProc, this));
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        quit_ = true;
+    }
+    jobVar_.notify_all();
+    for (auto& w : workers_)
+        w.join();
+}
+
+ThreadPool& ThreadPool::Get()
+{
+    /*
+    The pool is intentionally never destroyed: joining threads during static deinitialization
+    can deadlock when the library is unloaded, and the worker threads only wait for new jobs at that point.
+    */
+    static ThreadPool* instance = new ThreadPool{ std::max(1u, std::thread::hardware_concurrency()) - 1u };
+    return *instance;
+}
+
+void ThreadPool::Run(const RangeTask& task, std::size_t count, std::size_t chunkSize, unsigned threadCount)
+{
+    threadCount = std::min(threadCount, GetNumWorkers() + 1u);
+
+    if (threadCount <= 1 || count <= chunkSize)
+    {
+        /* Run single-threaded */
+        task(0, count);
+        return;
+    }
+
+    /* Split range into one slice per thread */
+    Job job;
+    {
+        job.task        = &task;
+        job.chunkSize   = std::max<std::size_t>(1, chunkSize);
+        job.slices      = std::vector<ThreadPoolSlice>(threadCount);
+        job.nextSlice   = 0;
+        job.failed      = false;
+        job.maxWorkers  = threadCount - 1;
+
+        const std::size_t sliceSize         = count / threadCount;
+        const std::size_t sliceSizeRemain   = count % threadCount;
+
+        std::size_t offset = 0;
+        for_range(i, threadCount)
+        {
+            job.slices[i].next = offset;
+            offset += sliceSize + (i < sliceSizeRemain ? 1 : 0);
+            job.slices[i].end = offset;
+        }
+    }
+
+    /* Hand job over to worker threads and take part in it on the calling thread */
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        jobs_.push_back(&job);
+    }
+    jobVar_.notify_all();
+
+    ProcessJob(job);
+
+    /* Wait until all worker threads have left the job, since it only lives on this stack */
+    {
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        RemoveJob(&job);
+        doneVar_.wait(lock, [&job]{ return (job.numWorkers == 0); });
+    }
+
+    if (job.exception)
+        std::rethrow_exception(job.exception);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ThreadPool::WorkerProc()
+{
+    std::unique_lock<std::mutex> lock{ mutex_ };
+
+    for (;;)
+    {
+        jobVar_.wait(lock, [this]{ return (quit_ || !jobs_.empty()); });
+        if (quit_)
+            break;
+
+        /* Join the most recent job; nested jobs are completed first this way */
+        Job* job = jobs_.back();
+        if (++job->numWorkers == job->maxWorkers)
+            jobs_.pop_back();
+
+        lock.unlock();
+        {
+            ProcessJob(*job);
+        }
+        lock.lock();
+
+        /* All chunks of this job have been taken once the worker returns from it, so no other worker must join it anymore */
+        RemoveJob(job);
+        if (--job->numWorkers == 0)
+            doneVar_.notify_all();
+    }
+}
+
+void ThreadPool::RemoveJob(const Job* job)
+{
+    auto it = std::find(jobs_.begin(), jobs_.end(), job);
+    if (it != jobs_.end())
+        jobs_.erase(it);
+}
+
+void ThreadPool::ProcessJob(Job& job)
+{
+    const std::size_t numSlices = job.slices.size();
+    const std::size_t ownSlice  = job.nextSlice++ % numSlices;
+
+    /* Process own slice first, then steal chunks from the other slices */
+    for_range(i, numSlices)
+    {
+        ThreadPoolSlice& slice = job.slices[(ownSlice + i) % numSlices];
+        for (;;)
+        {
+            const std::size_t begin = slice.next.fetch_add(job.chunkSize);
+            if (begin >= slice.end)
+                break;
+
+            /* Skip remaining chunks after the task has failed */
+            if (job.failed)
+                continue;
+
+            try
+            {
+                (*job.task)(begin, std::min(begin + job.chunkSize, slice.end));
+            }
+            catch (...)
+            {
+                if (!job.failed.exchange(true))
+                    job.exception = std::current_exception();
+            }
+        }
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
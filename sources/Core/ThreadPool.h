@@ -0,0 +1,89 @@
+/*
+ * ThreadPool.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_THREAD_POOL_H
+#define LLGL_THREAD_POOL_H
+
+
+#include <functional>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Process-wide pool of persistent worker threads for concurrent range tasks.
+Each range is split into one slice per thread, which is processed in small chunks.
+Threads that run out of work in their own slice steal chunks from the other slices.
+*/
+class ThreadPool
+{
+
+    public:
+
+        using RangeTask = std::function<void(std::size_t begin, std::size_t end)>;
+
+    public:
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator = (const ThreadPool&) = delete;
+
+        ~ThreadPool();
+
+        // Returns the process-wide thread pool. It is created on first use with one worker thread less than the hardware concurrency.
+        static ThreadPool& Get();
+
+        // Returns the number of worker threads. This does not include the threads that call Run.
+        inline unsigned GetNumWorkers() const
+        {
+            return static_cast<unsigned>(workers_.size());
+        }
+
+        /**
+        Runs the task for chunks of 'chunkSize' elements until the range [0, count) is processed, with up to 'threadCount' threads.
+        The calling thread always takes part, so nested calls from within a task cannot deadlock even if all worker threads are busy.
+        The first exception thrown by the task is rethrown on the calling thread after all other chunks have been processed or skipped.
+        */
+        void Run(const RangeTask& task, std::size_t count, std::size_t chunkSize, unsigned threadCount);
+
+    private:
+
+        struct Job;
+
+        ThreadPool(unsigned numWorkers);
+
+        void WorkerProc();
+        void RemoveJob(const Job* job);
+
+        static void ProcessJob(Job& job);
+
+    private:
+
+        std::vector<std::thread>    workers_;
+        std::vector<Job*>           jobs_;                  // Jobs that still accept worker threads; the most recent job is taken first
+        bool                        quit_       = false;
+        std::mutex                  mutex_;
+        std::condition_variable     jobVar_;                // Signaled when a job is added or the pool quits
+        std::condition_variable     doneVar_;               // Signaled when a worker thread leaves a job
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,9 +6,9 @@
  */
 
 #include "Threading.h"
+#include "ThreadPool.h"
 #include <LLGL/Utils/ForRange.h>
 #include <thread>
-#include <vector>
 #include <algorithm>
 
 
@@ -16,6 +16,9 @@ namespace LLGL
 {
 
 
+// Number of chunks each thread of a concurrent range is assigned initially.
+static const std::size_t g_chunksPerThread = 8;
+
 LLGL_EXPORT void DoConcurrentRange(
     const std::function<void(std::size_t begin, std::size_t end)>&  task,
     std::size_t                                                     count,
@@ -25,31 +28,13 @@ LLGL_EXPORT void DoConcurrentRange(
     if (threadCount >= Constants::maxThreadCount)
         threadCount = std::thread::hardware_concurrency();
 
-    threadCount = std::min(threadCount, static_cast<unsigned>(count / threadMinWorkSize));
+    threadCount = std::min(threadCount, static_cast<unsigned>(std::min<std::size_t>(count / threadMinWorkSize, ~0u)));
 
     if (threadCount > 1)
     {
-        /* Launch worker threads */
-        std::vector<std::thread> workers(threadCount);
-
-        const std::size_t workSize          = count / threadCount;
-        const std::size_t workSizeRemain    = count % threadCount;
-
-        std::size_t offset = 0;
-
-        for_range(i, threadCount)
-        {
-            workers[i] = std::thread(task, offset, offset + workSize);
-            offset += workSize;
-        }
-
-        /* Execute task of remaining work on main thread */
-        if (workSizeRemain > 0)
-            task(offset, offset + workSizeRemain);
-
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
+        /* Split work into several chunks per thread, so threads that finish early can steal the remaining chunks of others */
+        const std::size_t chunkSize = std::max<std::size_t>(count / (threadCount * g_chunksPerThread), 1);
+        ThreadPool::Get().Run(task, count, chunkSize, threadCount);
     }
     else
     {
@@ -19,6 +19,10 @@ namespace LLGL
 {
 
 
+/*
+Runs the task for sub ranges of [0, count) on the process-wide thread pool with up to 'threadCount' threads, including the calling thread.
+Only as many threads are used that each one gets at least 'threadMinWorkSize' elements. This function can be called from within a task.
+*/
 LLGL_EXPORT void DoConcurrentRange(
     const std::function<void(std::size_t begin, std::size_t end)>&  task,
     std::size_t                                                     count,
@@ -26,6 +30,7 @@ LLGL_EXPORT void DoConcurrentRange(
     unsigned                                                        threadMinWorkSize   = 64
 );
 
+// Runs the task for each index in [0, count). See DoConcurrentRange.
 LLGL_EXPORT void DoConcurrent(
     const std::function<void(std::size_t index)>&   task,
     std::size_t                                     count,
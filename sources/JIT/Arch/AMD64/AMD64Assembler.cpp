@@ -8,6 +8,8 @@
 #include "AMD64Assembler.h"
 #include "AMD64Opcode.h"
 #include <limits.h>
+#include <limits>
+#include <string.h>
 
 #include <fstream>//!!!
 #include <iomanip>
@@ -66,6 +68,15 @@ static std::uint8_t GetArgSize(const ArgType t)
     return sizes[static_cast<std::uint8_t>(t)];
 }
 
+// Returns the 4-bit register index including the extension bit for REX.R, REX.X, and REX.B.
+static std::uint8_t RegIndex(const Reg reg)
+{
+    const bool isExtReg = ((reg >= Reg::R8 && reg <= Reg::R15) || reg >= Reg::XMM8);
+    return (RegByte(reg) | (isExtReg ? 0x08 : 0x00));
+}
+
+static const std::size_t g_unboundLabelOffset = std::numeric_limits<std::size_t>::max();
+
 
 /*
  * AMD64Assembler class
@@ -241,6 +252,237 @@ void AMD64Assembler::WriteFuncCall(const void* addr, JITCallConv conv, bool farC
 }
 
 
+/* ----- Native function generation ----- */
+
+Reg AMD64Assembler::GetIntParamReg(std::size_t index)
+{
+    return (index < g_amd64IntParamsCount ? g_amd64IntParams[index] : g_amd64TempReg);
+}
+
+AMD64Assembler::Label AMD64Assembler::NewLabel()
+{
+    const Label label = static_cast<Label>(labelOffsets_.size());
+    labelOffsets_.push_back(g_unboundLabelOffset);
+    labelRefs_.emplace_back();
+    return label;
+}
+
+void AMD64Assembler::BindLabel(Label label)
+{
+    auto& code = GetAssembly();
+    const std::size_t offset = code.size();
+    labelOffsets_[label] = offset;
+
+    /* Resolve forward references; displacements are relative to the end of their 32-bit operand */
+    for (std::size_t refOffset : labelRefs_[label])
+    {
+        const std::int32_t rel32 = static_cast<std::int32_t>(offset - (refOffset + 4));
+        ::memcpy(&(code[refOffset]), &rel32, sizeof(rel32));
+    }
+    labelRefs_[label].clear();
+}
+
+// Opcode: E9 cd
+void AMD64Assembler::Jmp(Label label)
+{
+    WriteByte(0xE9);
+    WriteRel32(label);
+}
+
+// Opcode: 0F 80+cc cd
+void AMD64Assembler::Jcc(CondCode cond, Label label)
+{
+    WriteByte(OpcodePrefix_2);
+    WriteByte(0x80 | static_cast<std::uint8_t>(cond));
+    WriteRel32(label);
+}
+
+// Opcode: E8 cd
+void AMD64Assembler::CallLabel(Label label)
+{
+    WriteByte(0xE8);
+    WriteRel32(label);
+}
+
+void AMD64Assembler::CallAddr(const void* addr)
+{
+    #ifdef _WIN32
+    /* Reserve shadow space for the four register parameters */
+    SubImm32(Reg::RSP, 32);
+    #endif
+
+    MovRegImm64(g_amd64TempReg, reinterpret_cast<std::uint64_t>(addr));
+    CallNear(g_amd64TempReg);
+
+    #ifdef _WIN32
+    AddImm32(Reg::RSP, 32);
+    #endif
+}
+
+// Opcode: 89 /r
+void AMD64Assembler::MovRegReg(Reg dstReg, Reg srcReg)
+{
+    WriteModRMInstr(0, Is64Reg(dstReg), 0x89, 1, RegIndex(srcReg), RegIndex(dstReg), nullptr);
+}
+
+// Opcode: 8B /r
+void AMD64Assembler::MovRegMem(Reg dstReg, const Mem& src)
+{
+    WriteModRMInstr(0, Is64Reg(dstReg), 0x8B, 1, RegIndex(dstReg), RegIndex(src.base), &src);
+}
+
+// Opcode: 89 /r
+void AMD64Assembler::MovMemReg(const Mem& dst, Reg srcReg)
+{
+    WriteModRMInstr(0, Is64Reg(srcReg), 0x89, 1, RegIndex(srcReg), RegIndex(dst.base), &dst);
+}
+
+// Opcode: [REX.W] B8 +rd id/iq
+void AMD64Assembler::MovRegImm(Reg dstReg, std::uint64_t qword)
+{
+    const std::uint8_t reg = RegIndex(dstReg);
+    const bool is64Bit = (Is64Reg(dstReg) && qword > 0xFFFFFFFFull);
+    const std::uint8_t rex = ((is64Bit ? REX_W : 0) | ((reg & 0x08) != 0 ? REX_B : 0));
+    if (rex != 0)
+        WriteByte(REX_Prefix | rex);
+    WriteByte(Opcode_MovRegImm | (reg & 0x07));
+    if (is64Bit)
+        WriteQWord(qword);
+    else
+        WriteDWord(static_cast<std::uint32_t>(qword));
+}
+
+// Opcode: [REX.W] C7 /0 id
+void AMD64Assembler::MovMemImm32(const Mem& dst, std::uint32_t dword, bool signExtendTo64Bits)
+{
+    WriteModRMInstr(0, signExtendTo64Bits, Opcode_MovMemImm, 1, 0, RegIndex(dst.base), &dst);
+    WriteDWord(dword);
+}
+
+// Opcode: [REX.W] 8D /r
+void AMD64Assembler::Lea(Reg dstReg, const Mem& src)
+{
+    WriteModRMInstr(0, Is64Reg(dstReg), 0x8D, 1, RegIndex(dstReg), RegIndex(src.base), &src);
+}
+
+// Opcode: 03/0B/23/2B/33/3B /r (reg <- reg op r/m)
+void AMD64Assembler::ALURegReg(ALUOp op, Reg dstReg, Reg srcReg)
+{
+    const std::uint32_t opcode = ((static_cast<std::uint32_t>(op) << 3) | 0x03);
+    WriteModRMInstr(0, Is64Reg(dstReg), opcode, 1, RegIndex(dstReg), RegIndex(srcReg), nullptr);
+}
+
+// Opcode: 03/0B/23/2B/33/3B /r
+void AMD64Assembler::ALURegMem(ALUOp op, Reg dstReg, const Mem& src)
+{
+    const std::uint32_t opcode = ((static_cast<std::uint32_t>(op) << 3) | 0x03);
+    WriteModRMInstr(0, Is64Reg(dstReg), opcode, 1, RegIndex(dstReg), RegIndex(src.base), &src);
+}
+
+// Opcode: 81 /digit id
+void AMD64Assembler::ALURegImm32(ALUOp op, Reg dstReg, std::uint32_t dword)
+{
+    WriteModRMInstr(0, Is64Reg(dstReg), 0x81, 1, static_cast<std::uint8_t>(op), RegIndex(dstReg), nullptr);
+    WriteDWord(dword);
+}
+
+// Opcode: 81 /digit id (32-bit operand size)
+void AMD64Assembler::ALUMemImm32(ALUOp op, const Mem& dst, std::uint32_t dword)
+{
+    WriteModRMInstr(0, false, 0x81, 1, static_cast<std::uint8_t>(op), RegIndex(dst.base), &dst);
+    WriteDWord(dword);
+}
+
+// Opcode: 0F AF /r
+void AMD64Assembler::IMulRegMem(Reg dstReg, const Mem& src)
+{
+    WriteModRMInstr(0, Is64Reg(dstReg), 0x0FAF, 2, RegIndex(dstReg), RegIndex(src.base), &src);
+}
+
+// Opcode: 69 /r id
+void AMD64Assembler::IMulRegRegImm32(Reg dstReg, Reg srcReg, std::int32_t dword)
+{
+    WriteModRMInstr(0, Is64Reg(dstReg), 0x69, 1, RegIndex(dstReg), RegIndex(srcReg), nullptr);
+    WriteDWord(static_cast<std::uint32_t>(dword));
+}
+
+// Opcode: D3 /digit
+void AMD64Assembler::ShiftRegCL(ShiftOp op, Reg dstReg)
+{
+    WriteModRMInstr(0, Is64Reg(dstReg), 0xD3, 1, static_cast<std::uint8_t>(op), RegIndex(dstReg), nullptr);
+}
+
+// Opcode: F7 /2
+void AMD64Assembler::NotReg(Reg dstReg)
+{
+    WriteModRMInstr(0, Is64Reg(dstReg), 0xF7, 1, 2, RegIndex(dstReg), nullptr);
+}
+
+// Opcode: F7 /3
+void AMD64Assembler::NegReg(Reg dstReg)
+{
+    WriteModRMInstr(0, Is64Reg(dstReg), 0xF7, 1, 3, RegIndex(dstReg), nullptr);
+}
+
+// Opcode: 85 /r
+void AMD64Assembler::TestRegReg(Reg lhsReg, Reg rhsReg)
+{
+    WriteModRMInstr(0, Is64Reg(lhsReg), 0x85, 1, RegIndex(rhsReg), RegIndex(lhsReg), nullptr);
+}
+
+// Opcode: 0F 90+cc /0
+void AMD64Assembler::SetCC(CondCode cond, Reg dstReg)
+{
+    WriteModRMInstr(0, false, (0x0F90 | static_cast<std::uint32_t>(cond)), 2, 0, RegByte(dstReg), nullptr);
+}
+
+// Opcode: 0F B6 /r
+void AMD64Assembler::MovZXRegReg8(Reg dstReg, Reg srcReg)
+{
+    WriteModRMInstr(0, false, 0x0FB6, 2, RegIndex(dstReg), RegByte(srcReg), nullptr);
+}
+
+// Opcode: 0F 40+cc /r
+void AMD64Assembler::CMovRegMem(CondCode cond, Reg dstReg, const Mem& src)
+{
+    WriteModRMInstr(0, Is64Reg(dstReg), (0x0F40 | static_cast<std::uint32_t>(cond)), 2, RegIndex(dstReg), RegIndex(src.base), &src);
+}
+
+// Opcode: [66|F3] 0F <op> /r
+void AMD64Assembler::SSERegReg(SSEOp op, Reg dstReg, Reg srcReg)
+{
+    const std::uint16_t code = static_cast<std::uint16_t>(op);
+    WriteModRMInstr(static_cast<std::uint8_t>(code >> 8), false, (0x0F00 | (code & 0xFF)), 2, RegIndex(dstReg), RegIndex(srcReg), nullptr);
+}
+
+// Opcode: [66|F3] 0F <op> /r
+void AMD64Assembler::SSERegMem(SSEOp op, Reg dstReg, const Mem& src)
+{
+    const std::uint16_t code = static_cast<std::uint16_t>(op);
+    WriteModRMInstr(static_cast<std::uint8_t>(code >> 8), false, (0x0F00 | (code & 0xFF)), 2, RegIndex(dstReg), RegIndex(src.base), &src);
+}
+
+// Opcode: [F3] 0F 11 /r
+void AMD64Assembler::SSEMemReg(SSEOp op, const Mem& dst, Reg srcReg)
+{
+    const std::uint16_t code = static_cast<std::uint16_t>(op) + 1;
+    WriteModRMInstr(static_cast<std::uint8_t>(code >> 8), false, (0x0F00 | (code & 0xFF)), 2, RegIndex(srcReg), RegIndex(dst.base), &dst);
+}
+
+// Opcode: 0F C6 /r ib
+void AMD64Assembler::ShufPS(Reg dstReg, Reg srcReg, std::uint8_t imm8)
+{
+    WriteModRMInstr(0, false, 0x0FC6, 2, RegIndex(dstReg), RegIndex(srcReg), nullptr);
+    WriteByte(imm8);
+}
+
+// Opcode: F3 [REX.W] 0F 2A /r
+void AMD64Assembler::CvtSI2SS(Reg dstReg, Reg srcReg)
+{
+    WriteModRMInstr(0xF3, Is64Reg(srcReg), 0x0F2A, 2, RegIndex(dstReg), RegIndex(srcReg), nullptr);
+}
+
+
 /*
  * ======= Private: =======
  */
@@ -456,6 +698,58 @@ void AMD64Assembler::ErrInvalidUseOfRSP()
     #endif
 }
 
+void AMD64Assembler::WriteModRMInstr(
+    std::uint8_t    prefix,
+    bool            rexW,
+    std::uint32_t   opcode,
+    std::size_t     opcodeSize,
+    std::uint8_t    reg,
+    std::uint8_t    rm,
+    const Mem*      mem)
+{
+    /* Mandatory prefix must precede the REX prefix */
+    if (prefix != 0)
+        WriteByte(prefix);
+
+    const std::uint8_t rex = ((rexW ? REX_W : 0) | ((reg & 0x08) != 0 ? REX_R : 0) | ((rm & 0x08) != 0 ? REX_B : 0));
+    if (rex != 0)
+        WriteByte(REX_Prefix | rex);
+
+    for (std::size_t i = opcodeSize; i > 0; --i)
+        WriteByte(static_cast<std::uint8_t>(opcode >> ((i - 1) * 8)));
+
+    if (mem != nullptr)
+    {
+        /* Always encode a displacement, so RBP and R13 as base registers need no special case */
+        const bool isDisp8 = (mem->disp >= -128 && mem->disp <= 127);
+        WriteByte((isDisp8 ? Operand_Mod01 : Operand_Mod10) | ((reg & 0x07) << 3) | (rm & 0x07));
+
+        /* RSP and R12 as base registers require a SIB byte without index */
+        if ((rm & 0x07) == Operand_SIB)
+            WriteByte(0x24);
+
+        if (isDisp8)
+            WriteByte(static_cast<std::uint8_t>(mem->disp));
+        else
+            WriteDWord(static_cast<std::uint32_t>(mem->disp));
+    }
+    else
+        WriteByte(Operand_Mod11 | ((reg & 0x07) << 3) | (rm & 0x07));
+}
+
+void AMD64Assembler::WriteRel32(Label label)
+{
+    const std::size_t offset = GetAssembly().size();
+    if (labelOffsets_[label] != g_unboundLabelOffset)
+        WriteDWord(static_cast<std::uint32_t>(static_cast<std::int32_t>(labelOffsets_[label] - (offset + 4))));
+    else
+    {
+        /* Write dummy displacement until the label is bound */
+        labelRefs_[label].push_back(offset);
+        WriteDWord(0);
+    }
+}
+
 /* ----- PUSH ----- */
 
 void AMD64Assembler::PushReg(Reg srcReg)
@@ -22,15 +22,150 @@ namespace JIT
 {
 
 
+// Condition codes for conditional jumps, SETcc, and CMOVcc instructions.
+enum class CondCode : std::uint8_t
+{
+    O   = 0x0,
+    NO  = 0x1,
+    B   = 0x2, // Below (unsigned <)
+    AE  = 0x3, // Above or equal (unsigned >=)
+    E   = 0x4,
+    NE  = 0x5,
+    BE  = 0x6, // Below or equal (unsigned <=)
+    A   = 0x7, // Above (unsigned >)
+    S   = 0x8,
+    NS  = 0x9,
+    P   = 0xA, // Parity (unordered for UCOMISS)
+    NP  = 0xB,
+    L   = 0xC, // Less (signed <)
+    GE  = 0xD, // Greater or equal (signed >=)
+    LE  = 0xE, // Less or equal (signed <=)
+    G   = 0xF, // Greater (signed >)
+};
+
+// Integer ALU operations; values denote the opcode extension of the 81 /digit encoding.
+enum class ALUOp : std::uint8_t
+{
+    Add = 0,
+    Or  = 1,
+    And = 4,
+    Sub = 5,
+    Xor = 6,
+    Cmp = 7,
+};
+
+// Shift operations; values denote the opcode extension of the D3 /digit encoding.
+enum class ShiftOp : std::uint8_t
+{
+    Shl = 4,
+    Shr = 5,
+    Sar = 7,
+};
+
+// SSE/SSE2 operations; values denote the mandatory prefix (high byte) and opcode following 0F (low byte).
+enum class SSEOp : std::uint16_t
+{
+    MovUPS  = 0x0010,
+    MovSS   = 0xF310,
+    AddPS   = 0x0058,
+    AddSS   = 0xF358,
+    MulPS   = 0x0059,
+    MulSS   = 0xF359,
+    SubPS   = 0x005C,
+    SubSS   = 0xF35C,
+    DivPS   = 0x005E,
+    DivSS   = 0xF35E,
+    SqrtPS  = 0x0051,
+    SqrtSS  = 0xF351,
+    AndPS   = 0x0054,
+    OrPS    = 0x0056,
+    XorPS   = 0x0057,
+    UComISS = 0x002E,
+    PAddD   = 0x66FE,
+    PSubD   = 0x66FA,
+    PAnd    = 0x66DB,
+    POr     = 0x66EB,
+    PXor    = 0x66EF,
+};
+
 // AMD64 (a.k.a. x86_64) assembly code generator.
-class AMD64Assembler final : public JITCompiler
+class LLGL_EXPORT AMD64Assembler final : public JITCompiler
 {
 
+    public:
+
+        // Memory operand of the form [base + disp].
+        struct Mem
+        {
+            Reg             base;
+            std::int32_t    disp;
+        };
+
+        // Index of a branch target. Labels can be referenced before they are bound to a code position.
+        using Label = std::uint32_t;
+
     public:
 
         void Begin() override;
         void End() override;
 
+    public:
+
+        /* ----- Native function generation ----- */
+
+        // Returns the register of the specified integral parameter in the native calling convention.
+        static Reg GetIntParamReg(std::size_t index);
+
+        // Creates a new unbound label.
+        Label NewLabel();
+
+        // Binds the specified label to the current code position and resolves all previous references to it.
+        void BindLabel(Label label);
+
+        void Jmp(Label label);
+        void Jcc(CondCode cond, Label label);
+        void CallLabel(Label label);
+
+        // Calls the native function at the specified address. Arguments must already be stored in the parameter registers.
+        void CallAddr(const void* addr);
+
+        void PushReg(Reg srcReg);
+        void PopReg(Reg dstReg);
+        void RetNear(std::uint16_t word = 0);
+
+        // Operand sizes are determined by the register operand, i.e. 64-bit for RAX-R15 and 32-bit for EAX-EDI.
+        void MovRegReg(Reg dstReg, Reg srcReg);
+        void MovRegMem(Reg dstReg, const Mem& src);
+        void MovMemReg(const Mem& dst, Reg srcReg);
+        void MovRegImm(Reg dstReg, std::uint64_t qword);
+        void MovMemImm32(const Mem& dst, std::uint32_t dword, bool signExtendTo64Bits = false);
+        void Lea(Reg dstReg, const Mem& src);
+
+        void ALURegReg(ALUOp op, Reg dstReg, Reg srcReg);
+        void ALURegMem(ALUOp op, Reg dstReg, const Mem& src);
+        void ALURegImm32(ALUOp op, Reg dstReg, std::uint32_t dword);
+        void ALUMemImm32(ALUOp op, const Mem& dst, std::uint32_t dword);
+
+        void IMulRegMem(Reg dstReg, const Mem& src);
+        void IMulRegRegImm32(Reg dstReg, Reg srcReg, std::int32_t dword);
+        void ShiftRegCL(ShiftOp op, Reg dstReg);
+        void NotReg(Reg dstReg);
+        void NegReg(Reg dstReg);
+        void TestRegReg(Reg lhsReg, Reg rhsReg);
+
+        // Sets the low byte of 'dstReg' (AL, CL, DL, or BL) to 1 if the condition is met, or 0 otherwise.
+        void SetCC(CondCode cond, Reg dstReg);
+        void MovZXRegReg8(Reg dstReg, Reg srcReg);
+        void CMovRegMem(CondCode cond, Reg dstReg, const Mem& src);
+
+        void SSERegReg(SSEOp op, Reg dstReg, Reg srcReg);
+        void SSERegMem(SSEOp op, Reg dstReg, const Mem& src);
+
+        // Stores an XMM register; only MovUPS and MovSS are allowed.
+        void SSEMemReg(SSEOp op, const Mem& dst, Reg srcReg);
+        void ShufPS(Reg dstReg, Reg srcReg, std::uint8_t imm8);
+        void CvtSI2SS(Reg dstReg, Reg srcReg);
+
     private:
 
         bool IsLittleEndian() const override;
@@ -61,15 +196,25 @@ class AMD64Assembler final : public JITCompiler
 
         void ErrInvalidUseOfRSP();
 
+        void WriteModRMInstr(
+            std::uint8_t    prefix,
+            bool            rexW,
+            std::uint32_t   opcode,
+            std::size_t     opcodeSize,
+            std::uint8_t    reg,
+            std::uint8_t    rm,
+            const Mem*      mem
+        );
+
+        void WriteRel32(Label label);
+
     private:
 
-        void PushReg(Reg srcReg);
         void PushImm8(std::uint8_t byte);
         void PushImm16(std::uint16_t word);
         void PushImm32(std::uint32_t dword);
         void Push(Reg srcReg);
 
-        void PopReg(Reg dstReg);
         void Pop(Reg dstReg);
 
         void MovReg(Reg dstReg, Reg srcReg);
@@ -97,7 +242,6 @@ class AMD64Assembler final : public JITCompiler
 
         void CallNear(Reg reg);
 
-        void RetNear(std::uint16_t word = 0);
         void RetFar(std::uint16_t word = 0);
 
         void Int(std::uint8_t byte);
@@ -155,6 +299,10 @@ class AMD64Assembler final : public JITCompiler
         // Base pointer offsets of stack allocations
         std::vector<std::uint32_t>  stackChunkOffsets_;
 
+        // Code positions of bound labels and pending references to unbound labels
+        std::vector<std::size_t>                labelOffsets_;
+        std::vector<std::vector<std::size_t>>   labelRefs_;
+
 };
 
 
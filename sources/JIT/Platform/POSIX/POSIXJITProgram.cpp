@@ -8,6 +8,7 @@
 #include "POSIXJITProgram.h"
 #include "../../../Core/CoreUtils.h"
 #include <cstdlib>
+#include <string.h>
 #include <stdexcept>
 #include <unistd.h> // sysconf
 #include <sys/mman.h> // mmap
@@ -45,7 +46,7 @@ POSIXJITProgram::POSIXJITProgram(const void* code, std::size_t size) :
     SetEntryPoint(addr_);
 }
 
-POSIXJITProgram::POSIXJITProgram()
+POSIXJITProgram::~POSIXJITProgram()
 {
     munmap(addr_, size_);
 }
@@ -23,7 +23,7 @@ class LLGL_EXPORT POSIXJITProgram : public JITProgram
     public:
 
         POSIXJITProgram(const void* code, std::size_t size);
-        POSIXJITProgram();
+        ~POSIXJITProgram();
 
     private:
 
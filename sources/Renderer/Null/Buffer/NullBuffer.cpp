@@ -8,9 +8,17 @@
 #include "NullBuffer.h"
 #include "../../ResourceUtils.h"
 #include "../../../Core/CoreUtils.h"
+#include <LLGL/Platform/Platform.h>
 #include <algorithm>
 #include <string.h>
 
+#ifdef LLGL_OS_WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include <Windows.h>
+#else
+#   include <sys/mman.h>
+#endif
+
 
 namespace LLGL
 {
@@ -18,23 +26,25 @@ namespace LLGL
 
 constexpr NullBuffer::WordType g_uninitializedBufferWord = 0xDEADBEEF;
 
+// Buffers of at least this size are allocated as virtual memory pages, which the OS only commits when they are touched.
+constexpr std::size_t g_minVirtualMemoryBufferSize = (64u << 20);
+
 NullBuffer::NullBuffer(const BufferDescriptor& desc, const void* initialData) :
     Buffer { desc.bindFlags },
     desc   { desc           }
 {
-    /* Allocate word-aligned buffer and initialize with hex code as debug information */
-    const std::size_t wordAlignedSize = GetAlignedSize(static_cast<std::size_t>(desc.size), sizeof(WordType));
-    data_.resize(wordAlignedSize, g_uninitializedBufferWord);
-
-    /* Allocate mapped buffer if CPU access flags are specified */
-    if (desc.cpuAccessFlags != 0)
-        mappedData_.resize(wordAlignedSize, g_uninitializedBufferWord);
+    AllocStorage(static_cast<std::size_t>(desc.size));
 
     /* Initialize buffer with initial data */
     if (initialData != nullptr)
         Write(0, initialData, static_cast<std::size_t>(desc.size));
 }
 
+NullBuffer::~NullBuffer()
+{
+    FreeStorage();
+}
+
 void NullBuffer::SetName(const char* name)
 {
     if (name != nullptr)
@@ -93,7 +103,7 @@ void* NullBuffer::Map(const CPUAccess access, std::uint64_t offset, std::uint64_
         return nullptr;
 
     /* Check for out-of-bounds and ensure there's no integer overflow with offset+length */
-    if (offset < desc.size && offset + length <= desc.size && offset + length > offset)
+    if (!(offset < desc.size && offset + length <= desc.size && offset + length > offset))
         return nullptr;
 
     const bool isWriteAccess = HasWriteAccess(access);
@@ -106,37 +116,80 @@ void* NullBuffer::Map(const CPUAccess access, std::uint64_t offset, std::uint64_
         return nullptr;
     }
 
-    if (access == CPUAccess::WriteDiscard)
+    if (access == CPUAccess::WriteDiscard && virtualSize_ == 0)
     {
-        /* Discard all buffer content by filling buffer with uninitialized word */
-        std::fill(data_.begin(), data_.end(), g_uninitializedBufferWord);
+        /* Discard all buffer content by filling buffer with uninitialized word (virtual memory is not filled, since that would commit all its pages) */
+        std::fill(storage_.begin(), storage_.end(), g_uninitializedBufferWord);
     }
 
-    /* Map internal buffer to output data */
-    mapAccess_ = access;
-    mapOffset_ = static_cast<std::size_t>(offset);
+    /* Return pointer directly into the buffer content, so no copy is required when the buffer is mapped or unmapped */
     mapLength_ = static_cast<std::size_t>(length);
 
-    if (isReadAccess)
-    {
-        /* Map buffer for reading */
-        ::memcpy(GetMappedBytes(), GetBytesAt(mapOffset_), mapLength_);
-    }
-
-    return GetMappedBytes();
+    return GetBytesAt(offset);
 }
 
 void NullBuffer::Unmap()
 {
-    if (mapLength_ > 0)
+    mapLength_ = 0;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+static void* AllocVirtualMemory(std::size_t size)
+{
+    #ifdef LLGL_OS_WIN32
+    return VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    #else
+    int flags = (MAP_PRIVATE | MAP_ANONYMOUS);
+    #   ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+    #   endif
+    void* addr = ::mmap(nullptr, size, (PROT_READ | PROT_WRITE), flags, -1, 0);
+    return (addr != MAP_FAILED ? addr : nullptr);
+    #endif
+}
+
+static void FreeVirtualMemory(void* addr, std::size_t size)
+{
+    #ifdef LLGL_OS_WIN32
+    VirtualFree(addr, 0, MEM_RELEASE);
+    #else
+    ::munmap(addr, size);
+    #endif
+}
+
+void NullBuffer::AllocStorage(std::size_t size)
+{
+    const std::size_t wordAlignedSize = GetAlignedSize(size, sizeof(WordType));
+
+    if (wordAlignedSize >= g_minVirtualMemoryBufferSize)
     {
-        if (HasWriteAccess(mapAccess_))
+        /*
+        Allocate large buffers as virtual memory pages. These are zero-initialized and only committed when they are touched,
+        so they are not filled with the uninitialized word.
+        */
+        if (void* addr = AllocVirtualMemory(wordAlignedSize))
         {
-            /* Map buffer for writing */
-            ::memcpy(GetBytesAt(mapOffset_), GetMappedBytes(), mapLength_);
+            data_           = static_cast<char*>(addr);
+            virtualSize_    = wordAlignedSize;
+            return;
         }
-        mapLength_ = 0;
     }
+
+    /* Allocate word-aligned buffer and initialize with hex code as debug information */
+    storage_.resize(wordAlignedSize / sizeof(WordType), g_uninitializedBufferWord);
+    data_ = reinterpret_cast<char*>(storage_.data());
+}
+
+void NullBuffer::FreeStorage()
+{
+    if (virtualSize_ > 0)
+        FreeVirtualMemory(data_, virtualSize_);
+    data_           = nullptr;
+    virtualSize_    = 0;
 }
 
 
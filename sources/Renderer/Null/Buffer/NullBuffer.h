@@ -30,6 +30,7 @@ class NullBuffer final : public Buffer
     public:
 
         NullBuffer(const BufferDescriptor& desc, const void* initialData);
+        ~NullBuffer();
 
         bool Read(std::uint64_t offset, void* data, std::uint64_t size);
         bool Write(std::uint64_t offset, const void* data, std::uint64_t size);
@@ -37,9 +38,21 @@ class NullBuffer final : public Buffer
         bool CpuAccessRead(std::uint64_t offset, void* data, std::uint64_t size);
         bool CpuAccessWrite(std::uint64_t offset, const void* data, std::uint64_t size);
 
+        // Maps the specified range persistently, i.e. the returned pointer refers directly to the buffer content.
         void* Map(const CPUAccess access, std::uint64_t offset, std::uint64_t length);
         void Unmap();
 
+        // Returns a pointer to the buffer content at the specified byte offset.
+        inline char* GetBytesAt(std::uint64_t offset)
+        {
+            return (data_ + static_cast<std::size_t>(offset));
+        }
+
+        inline const char* GetBytesAt(std::uint64_t offset) const
+        {
+            return (data_ + static_cast<std::size_t>(offset));
+        }
+
     public:
 
         // Data type for the internal buffer data.
@@ -49,29 +62,16 @@ class NullBuffer final : public Buffer
 
     private:
 
-        inline char* GetBytes()
-        {
-            return reinterpret_cast<char*>(data_.data());
-        }
-
-        inline char* GetBytesAt(std::uint64_t offset)
-        {
-            return (reinterpret_cast<char*>(data_.data()) + static_cast<std::size_t>(offset));
-        }
-
-        inline char* GetMappedBytes()
-        {
-            return (reinterpret_cast<char*>(mappedData_.data()) + mapOffset_);
-        }
+        void AllocStorage(std::size_t size);
+        void FreeStorage();
 
     private:
 
         std::string             label_;
-        std::vector<WordType>   data_;
-        std::vector<WordType>   mappedData_;
-        std::size_t             mapOffset_  = 0;
-        std::size_t             mapLength_  = 0;
-        CPUAccess               mapAccess_  = CPUAccess::ReadOnly;
+        char*                   data_           = nullptr;
+        std::vector<WordType>   storage_;                   // Heap storage for buffers below the virtual memory threshold
+        std::size_t             virtualSize_    = 0;        // Size of the virtual memory pages, or 0 if heap storage is used
+        std::size_t             mapLength_      = 0;
 
 };
 
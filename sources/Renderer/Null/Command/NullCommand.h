@@ -10,6 +10,8 @@
 
 
 #include <LLGL/IndirectArguments.h>
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/StaticLimits.h>
 #include <cstddef>
 #include <cstdint>
 
@@ -19,7 +21,12 @@ namespace LLGL
 
 
 class NullBuffer;
+class NullCommandBuffer;
 class NullTexture;
+class NullPipelineState;
+class NullResourceHeap;
+class NullQueryHeap;
+class RenderTarget;
 
 
 struct NullCmdBufferWrite
@@ -58,23 +65,126 @@ struct NullCmdGenerateMips
     std::uint32_t   numMipLevels;
 };
 
+struct NullCmdExecute
+{
+    NullCommandBuffer* commandBuffer;
+};
+
+/*
+Commands that set an array of states refer to an immutable state block of the command buffer,
+so draw commands don't have to carry the states they are executed with.
+*/
+
+struct NullCmdSetViewports
+{
+    std::uint32_t   numViewports;
+    const Viewport* viewports;
+};
+
+struct NullCmdSetScissors
+{
+    std::uint32_t   numScissors;
+    const Scissor*  scissors;
+};
+
+struct NullCmdSetVertexBuffers
+{
+    std::uint32_t               numBuffers;
+    const NullBuffer* const *   buffers;
+};
+
+struct NullCmdSetIndexBuffer
+{
+    const NullBuffer*   buffer;
+    Format              format;
+    std::uint64_t       offset;
+};
+
+struct NullCmdSetPipelineState
+{
+    const NullPipelineState* pipelineState;
+};
+
+struct NullCmdSetStencilReference
+{
+    std::uint32_t   reference;
+    StencilFace     stencilFace;
+};
+
+struct NullCmdSetResourceHeap
+{
+    NullResourceHeap*   resourceHeap;
+    std::uint32_t       descriptorSet;
+};
+
+struct NullCmdSetResource
+{
+    std::uint32_t       descriptor;
+    Resource*           resource;
+};
+
+struct NullCmdBeginRenderPass
+{
+    RenderTarget* renderTarget;
+};
+
+//struct NullCmdEndRenderPass {};
+
+struct NullCmdClear
+{
+    long        flags;
+    ClearValue  clearValue;
+};
+
+struct NullCmdClearAttachments
+{
+    std::uint32_t   numAttachments;
+//  AttachmentClear attachments[numAttachments];
+};
+
+struct NullCmdBeginStreamOutput
+{
+    std::uint32_t   numBuffers;
+    NullBuffer*     buffers[LLGL_MAX_NUM_SO_BUFFERS];
+};
+
+//struct NullCmdEndStreamOutput {};
+
 //TODO...
 
 struct NullCmdDraw
 {
-    DrawIndirectArguments   args;
-    std::size_t             numVertexBuffers;
-//  const NullBuffer*       vertexBuffers[numVertexBuffers];
+    DrawIndirectArguments args;
 };
 
 struct NullCmdDrawIndexed
 {
-    DrawIndexedIndirectArguments    args;
-    const NullBuffer*               indexBuffer;
-    Format                          indexBufferFormat;
-    std::uint64_t                   indexBufferOffset;
-    std::size_t                     numVertexBuffers;
-//  const NullBuffer*               vertexBuffers[numVertexBuffers];
+    DrawIndexedIndirectArguments args;
+};
+
+struct NullCmdDrawIndirect
+{
+    NullBuffer*     buffer;
+    std::uint64_t   offset;
+    std::uint32_t   numCommands;
+    std::uint32_t   stride;
+};
+
+struct NullCmdDispatch
+{
+    std::uint32_t   numWorkGroups[3];
+};
+
+struct NullCmdDispatchIndirect
+{
+    NullBuffer*     buffer;
+    std::uint64_t   offset;
+};
+
+struct NullCmdQuery
+{
+    NullQueryHeap*  queryHeap;
+    std::uint32_t   query;
 };
 
 struct NullCmdPushDebugGroup
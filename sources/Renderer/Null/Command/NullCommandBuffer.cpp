@@ -6,9 +6,11 @@
  */
 
 #include "NullCommandBuffer.h"
+#include "NullCommandQueue.h"
 #include "NullCommandExecutor.h"
 #include "NullCommand.h"
 #include "../../CheckedCast.h"
+#include "../../RenderPassUtils.h"
 #include "../../../Core/CoreUtils.h"
 #include <LLGL/TypeInfo.h>
 
@@ -18,19 +20,24 @@
 #include "../RenderState/NullQueryHeap.h"
 #include "../RenderState/NullPipelineState.h"
 #include "../RenderState/NullResourceHeap.h"
+#include "../RenderState/NullRenderPass.h"
 #include "../Texture/NullTexture.h"
 #include "../Texture/NullRenderTarget.h"
 
 #include <LLGL/RenderingDebugger.h>
 #include <LLGL/IndirectArguments.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
-NullCommandBuffer::NullCommandBuffer(const CommandBufferDescriptor& desc) :
-    desc { desc }
+NullCommandBuffer::NullCommandBuffer(NullCommandQueue& commandQueue, const CommandBufferDescriptor& desc, NullPerformanceReporter* performanceReporter) :
+    desc          { desc                },
+    commandQueue_ { commandQueue        },
+    context_      { performanceReporter }
 {
 }
 
@@ -38,20 +45,43 @@ NullCommandBuffer::NullCommandBuffer(const CommandBufferDescriptor& desc) :
 
 void NullCommandBuffer::Begin()
 {
+    /* Wait until the previous submission of this command buffer has been executed before its commands are overwritten */
+    commandQueue_.WaitForSubmission(submissionTicket_);
     buffer_.Clear();
+    stateBlocks_.Clear();
+    renderState_ = RenderState{};
+
+    /* Command buffer contexts cannot be shared between concurrent submissions */
+    resourceRefs_.clear();
+    secondaryBuffers_.clear();
+    queryHeaps_.clear();
+    AddResourceRef(this);
 }
 
 void NullCommandBuffer::End()
 {
+    std::sort(resourceRefs_.begin(), resourceRefs_.end());
+    resourceRefs_.erase(std::unique(resourceRefs_.begin(), resourceRefs_.end()), resourceRefs_.end());
+
     if ((desc.flags & CommandBufferFlags::ImmediateSubmit) != 0)
-        ExecuteVirtualCommands();
+        commandQueue_.SubmitCommandBuffer(*this);
 }
 
 void NullCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
 {
     auto& deferredCommandBufferNull = LLGL_CAST(NullCommandBuffer&, deferredCommandBuffer);
     if ((deferredCommandBufferNull.desc.flags & CommandBufferFlags::Secondary) != 0)
-        deferredCommandBufferNull.ExecuteVirtualCommands();
+    {
+        auto cmd = AllocCommand<NullCmdExecute>(NullOpcodeExecute);
+        {
+            cmd->commandBuffer = &deferredCommandBufferNull;
+        }
+        resourceRefs_.insert(resourceRefs_.end(), deferredCommandBufferNull.resourceRefs_.begin(), deferredCommandBufferNull.resourceRefs_.end());
+        secondaryBuffers_.push_back(&deferredCommandBufferNull);
+
+        /* The secondary command buffer may change any state, so none of the recorded states can be skipped as redundant anymore */
+        renderState_ = RenderState{};
+    }
 }
 
 /* ----- Blitting ----- */
@@ -70,6 +100,7 @@ void NullCommandBuffer::UpdateBuffer(
         cmd->size   = dataSize;
         ::memcpy(cmd + 1, data, dataSize);
     }
+    AddResourceRef(dstBufferNull);
 }
 
 void NullCommandBuffer::CopyBuffer(
@@ -97,6 +128,8 @@ void NullCommandBuffer::CopyBuffer(
         cmd->rowStride      = 0;
         cmd->layerStride    = 0;
     }
+    AddResourceRef(cmd->srcResource);
+    AddResourceRef(cmd->dstResource);
 }
 
 static Extent3D GetSubresourceExtent(TextureType type, const Extent3D& extent, std::uint32_t numArrayLayers)
@@ -142,6 +175,8 @@ void NullCommandBuffer::CopyBufferFromTexture(
         cmd->rowStride      = rowStride;
         cmd->layerStride    = layerStride;
     }
+    AddResourceRef(cmd->srcResource);
+    AddResourceRef(cmd->dstResource);
 }
 
 void NullCommandBuffer::FillBuffer(
@@ -171,7 +206,7 @@ void NullCommandBuffer::CopyTexture(
         cmd->srcY           = srcLocation.offset.y;
         cmd->srcZ           = srcLocation.offset.z;
         cmd->dstResource    = &dstTextureNull;
-        cmd->dstSubresource = dstTextureNull.PackSubresourceIndex(srcLocation.mipLevel, srcLocation.arrayLayer);
+        cmd->dstSubresource = dstTextureNull.PackSubresourceIndex(dstLocation.mipLevel, dstLocation.arrayLayer);
         cmd->dstX           = dstLocation.offset.x;
         cmd->dstY           = dstLocation.offset.y;
         cmd->dstZ           = dstLocation.offset.z;
@@ -181,6 +216,8 @@ void NullCommandBuffer::CopyTexture(
         cmd->rowStride      = 0;
         cmd->layerStride    = 0;
     }
+    AddResourceRef(cmd->srcResource);
+    AddResourceRef(cmd->dstResource);
 }
 
 void NullCommandBuffer::CopyTextureFromBuffer(
@@ -211,6 +248,8 @@ void NullCommandBuffer::CopyTextureFromBuffer(
         cmd->rowStride      = rowStride;
         cmd->layerStride    = layerStride;
     }
+    AddResourceRef(cmd->srcResource);
+    AddResourceRef(cmd->dstResource);
 }
 
 void NullCommandBuffer::GenerateMips(Texture& texture)
@@ -224,6 +263,7 @@ void NullCommandBuffer::GenerateMips(Texture& texture)
         cmd->baseMipLevel   = 0;
         cmd->numMipLevels   = textureNull.desc.mipLevels;
     }
+    AddResourceRef(&textureNull);
 }
 
 void NullCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& subresource)
@@ -237,55 +277,86 @@ void NullCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource&
         cmd->baseMipLevel   = subresource.baseMipLevel;
         cmd->numMipLevels   = subresource.numMipLevels;
     }
+    AddResourceRef(&textureNull);
 }
 
 /* ----- Viewport and Scissor ----- */
 
 void NullCommandBuffer::SetViewport(const Viewport& viewport)
 {
-    renderState_.viewports = { viewport };
+    SetViewports(1, &viewport);
 }
 
 void NullCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
 {
-    renderState_.viewports = SmallVector<Viewport>(viewports, viewports + numViewports);
+    const Viewport* viewportsBlock = stateBlocks_.InternArray(viewports, numViewports);
+    if (viewportsBlock == renderState_.viewports)
+        return;
+
+    auto cmd = AllocCommand<NullCmdSetViewports>(NullOpcodeSetViewports);
+    {
+        cmd->numViewports   = numViewports;
+        cmd->viewports      = viewportsBlock;
+    }
+    renderState_.viewports = viewportsBlock;
 }
 
 void NullCommandBuffer::SetScissor(const Scissor& scissor)
 {
-    renderState_.scissors = { scissor };
+    SetScissors(1, &scissor);
 }
 
 void NullCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scissors)
 {
-    renderState_.scissors = SmallVector<Scissor>(scissors, scissors + numScissors);
+    const Scissor* scissorsBlock = stateBlocks_.InternArray(scissors, numScissors);
+    if (scissorsBlock == renderState_.scissors)
+        return;
+
+    auto cmd = AllocCommand<NullCmdSetScissors>(NullOpcodeSetScissors);
+    {
+        cmd->numScissors    = numScissors;
+        cmd->scissors       = scissorsBlock;
+    }
+    renderState_.scissors = scissorsBlock;
 }
 
 /* ----- Buffers ------ */
 
 void NullCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
-    auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
-    renderState_.vertexBuffers = { &bufferNull };
+    const NullBuffer* bufferNull = LLGL_CAST(const NullBuffer*, &buffer);
+    SetVertexBuffers(1, &bufferNull);
 }
 
 void NullCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
     auto& bufferArrayNull = LLGL_CAST(NullBufferArray&, bufferArray);
-    renderState_.vertexBuffers = SmallVector<const NullBuffer*>(bufferArrayNull.buffers.begin(), bufferArrayNull.buffers.end());
+    SetVertexBuffers(static_cast<std::uint32_t>(bufferArrayNull.buffers.size()), bufferArrayNull.buffers.data());
 }
 
 void NullCommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
-    renderState_.indexBuffer        = &bufferNull;
-    renderState_.indexBufferFormat  = bufferNull.desc.format;
-    renderState_.indexBufferOffset  = 0;
+    SetIndexBuffer(buffer, bufferNull.desc.format, 0);
 }
 
 void NullCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
+    if (renderState_.indexBuffer        == &bufferNull &&
+        renderState_.indexBufferFormat  == format      &&
+        renderState_.indexBufferOffset  == offset)
+    {
+        return;
+    }
+
+    auto cmd = AllocCommand<NullCmdSetIndexBuffer>(NullOpcodeSetIndexBuffer);
+    {
+        cmd->buffer = &bufferNull;
+        cmd->format = format;
+        cmd->offset = offset;
+    }
+    AddResourceRef(&bufferNull);
     renderState_.indexBuffer        = &bufferNull;
     renderState_.indexBufferFormat  = format;
     renderState_.indexBufferOffset  = offset;
@@ -295,13 +366,28 @@ void NullCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std:
 
 void NullCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::uint32_t descriptorSet)
 {
-    //auto& resourceHeapNull = LLGL_CAST(NullResourceHeap&, resourceHeap);
-    //todo
+    auto& resourceHeapNull = LLGL_CAST(NullResourceHeap&, resourceHeap);
+    if (renderState_.resourceHeap == &resourceHeapNull && renderState_.descriptorSet == descriptorSet)
+        return;
+
+    auto cmd = AllocCommand<NullCmdSetResourceHeap>(NullOpcodeSetResourceHeap);
+    {
+        cmd->resourceHeap   = &resourceHeapNull;
+        cmd->descriptorSet  = descriptorSet;
+    }
+    AddResourceHeapRefs(resourceHeapNull);
+    renderState_.resourceHeap   = &resourceHeapNull;
+    renderState_.descriptorSet  = descriptorSet;
 }
 
 void NullCommandBuffer::SetResource(std::uint32_t descriptor, Resource& resource)
 {
-    //todo
+    auto cmd = AllocCommand<NullCmdSetResource>(NullOpcodeSetResource);
+    {
+        cmd->descriptor = descriptor;
+        cmd->resource   = &resource;
+    }
+    AddResourceRef(&resource);
 }
 
 void NullCommandBuffer::ResetResourceSlots(
@@ -322,39 +408,59 @@ void NullCommandBuffer::BeginRenderPass(
     std::uint32_t       numClearValues,
     const ClearValue*   clearValues)
 {
-    if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
+    auto cmd = AllocCommand<NullCmdBeginRenderPass>(NullOpcodeBeginRenderPass);
     {
-        //auto& swapChainNull = LLGL_CAST(NullSwapChain&, renderTarget);
-        //todo
+        cmd->renderTarget = &renderTarget;
     }
-    else
+    AddRenderTargetRefs(renderTarget);
+
+    if (renderPass != nullptr)
     {
-        //auto& renderTargetNull = LLGL_CAST(NullRenderTarget&, renderTarget);
-        //todo
+        auto renderPassNull = LLGL_CAST(const NullRenderPass*, renderPass);
+        ClearAttachmentsWithRenderPass(*renderPassNull, numClearValues, clearValues);
     }
 }
 
 void NullCommandBuffer::EndRenderPass()
 {
-    //todo
+    AllocOpcode(NullOpcodeEndRenderPass);
 }
 
 void NullCommandBuffer::Clear(long flags, const ClearValue& clearValue)
 {
-    //todo
+    auto cmd = AllocCommand<NullCmdClear>(NullOpcodeClear);
+    {
+        cmd->flags      = flags;
+        cmd->clearValue = clearValue;
+    }
 }
 
 void NullCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
-    //todo
+    if (numAttachments == 0)
+        return;
+
+    const std::size_t payloadSize = sizeof(AttachmentClear) * numAttachments;
+    auto cmd = AllocCommand<NullCmdClearAttachments>(NullOpcodeClearAttachments, payloadSize);
+    {
+        cmd->numAttachments = numAttachments;
+        ::memcpy(cmd + 1, attachments, payloadSize);
+    }
 }
 
 /* ----- Pipeline States ----- */
 
 void NullCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 {
-    //auto& pipelineStateNull = LLGL_CAST(NullPipelineState&, pipelineState);
-    //todo
+    auto& pipelineStateNull = LLGL_CAST(NullPipelineState&, pipelineState);
+    if (renderState_.pipelineState == &pipelineStateNull)
+        return;
+
+    auto cmd = AllocCommand<NullCmdSetPipelineState>(NullOpcodeSetPipelineState);
+    {
+        cmd->pipelineState = &pipelineStateNull;
+    }
+    renderState_.pipelineState = &pipelineStateNull;
 }
 
 void NullCommandBuffer::SetBlendFactor(const float color[4])
@@ -364,7 +470,11 @@ void NullCommandBuffer::SetBlendFactor(const float color[4])
 
 void NullCommandBuffer::SetStencilReference(std::uint32_t reference, const StencilFace stencilFace)
 {
-    //todo
+    auto cmd = AllocCommand<NullCmdSetStencilReference>(NullOpcodeSetStencilReference);
+    {
+        cmd->reference      = reference;
+        cmd->stencilFace    = stencilFace;
+    }
 }
 
 void NullCommandBuffer::SetUniforms(std::uint32_t first, const void* data, std::uint16_t dataSize)
@@ -376,14 +486,24 @@ void NullCommandBuffer::SetUniforms(std::uint32_t first, const void* data, std::
 
 void NullCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    //auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
-    //todo
+    auto cmd = AllocCommand<NullCmdQuery>(NullOpcodeBeginQuery);
+    {
+        cmd->queryHeap  = LLGL_CAST(NullQueryHeap*, &queryHeap);
+        cmd->query      = query;
+    }
+    AddResourceRef(cmd->queryHeap);
+    if (queryHeaps_.empty() || queryHeaps_.back() != cmd->queryHeap)
+        queryHeaps_.push_back(cmd->queryHeap);
 }
 
 void NullCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    //auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
-    //todo
+    auto cmd = AllocCommand<NullCmdQuery>(NullOpcodeEndQuery);
+    {
+        cmd->queryHeap  = LLGL_CAST(NullQueryHeap*, &queryHeap);
+        cmd->query      = query;
+    }
+    AddResourceRef(cmd->queryHeap);
 }
 
 void NullCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
@@ -401,12 +521,21 @@ void NullCommandBuffer::EndRenderCondition()
 
 void NullCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers)
 {
-    // dummy
+    numBuffers = std::min(numBuffers, LLGL_MAX_NUM_SO_BUFFERS);
+    auto cmd = AllocCommand<NullCmdBeginStreamOutput>(NullOpcodeBeginStreamOutput);
+    {
+        cmd->numBuffers = numBuffers;
+        for_range(i, numBuffers)
+        {
+            cmd->buffers[i] = LLGL_CAST(NullBuffer*, buffers[i]);
+            AddResourceRef(cmd->buffers[i]);
+        }
+    }
 }
 
 void NullCommandBuffer::EndStreamOutput()
 {
-    // dummy
+    AllocOpcode(NullOpcodeEndStreamOutput);
 }
 
 /* ----- Drawing ----- */
@@ -514,54 +643,46 @@ void NullCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint
 
 void NullCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
-    auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
-    DrawIndirectArguments drawArgs;
-    bufferNull.Read(offset, &drawArgs, sizeof(drawArgs));
-    AllocDrawCommand(drawArgs);
+    AllocDrawIndirectCommand(NullOpcodeDrawIndirect, buffer, offset, 1, 0);
 }
 
 void NullCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
-    auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
-    DrawIndirectArguments drawArgs;
-    while (numCommands-- > 0)
-    {
-        bufferNull.Read(offset, &drawArgs, sizeof(drawArgs));
-        AllocDrawCommand(drawArgs);
-        offset += stride;
-    }
+    AllocDrawIndirectCommand(NullOpcodeDrawIndirect, buffer, offset, numCommands, stride);
 }
 
 void NullCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
-    auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
-    DrawIndexedIndirectArguments drawArgs;
-    bufferNull.Read(offset, &drawArgs, sizeof(drawArgs));
-    AllocDrawIndexedCommand(drawArgs);
+    AllocDrawIndirectCommand(NullOpcodeDrawIndexedIndirect, buffer, offset, 1, 0);
 }
 
 void NullCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
-    auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
-    DrawIndexedIndirectArguments drawArgs;
-    while (numCommands-- > 0)
-    {
-        bufferNull.Read(offset, &drawArgs, sizeof(drawArgs));
-        AllocDrawIndexedCommand(drawArgs);
-        offset += stride;
-    }
+    AllocDrawIndirectCommand(NullOpcodeDrawIndexedIndirect, buffer, offset, numCommands, stride);
 }
 
 /* ----- Compute ----- */
 
 void NullCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
-    // dummy
+    auto cmd = AllocCommand<NullCmdDispatch>(NullOpcodeDispatch);
+    {
+        cmd->numWorkGroups[0] = numWorkGroupsX;
+        cmd->numWorkGroups[1] = numWorkGroupsY;
+        cmd->numWorkGroups[2] = numWorkGroupsZ;
+    }
 }
 
 void NullCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
-    // dummy
+    /* Arguments are read when the command is executed, since the buffer might be written by a preceding command */
+    auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
+    auto cmd = AllocCommand<NullCmdDispatchIndirect>(NullOpcodeDispatchIndirect);
+    {
+        cmd->buffer = &bufferNull;
+        cmd->offset = offset;
+    }
+    AddResourceRef(&bufferNull);
 }
 
 /* ----- Debugging ----- */
@@ -594,11 +715,26 @@ void NullCommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc, std:
 
 void NullCommandBuffer::ExecuteVirtualCommands()
 {
-    ExecuteNullVirtualCommandBuffer(buffer_);
-    if ((desc.flags & CommandBufferFlags::MultiSubmit) == 0)
+    ExecuteNullVirtualCommandBuffer(buffer_, context_);
+
+    /* Secondary command buffers are never cleared here, since they can be executed by several primary command buffers */
+    if ((desc.flags & (CommandBufferFlags::MultiSubmit | CommandBufferFlags::Secondary)) == 0)
         buffer_.Clear();
 }
 
+void NullCommandBuffer::SetSubmissionTicket(std::uint64_t ticket)
+{
+    submissionTicket_ = std::max(submissionTicket_, ticket);
+
+    /* Re-recording a secondary command buffer must wait until every submission that executes it has been completed */
+    for (auto secondaryBuffer : secondaryBuffers_)
+        secondaryBuffer->SetSubmissionTicket(ticket);
+
+    /* Results of queries written by this submission are not available until it has been executed */
+    for (auto queryHeap : queryHeaps_)
+        queryHeap->SetSubmissionTicket(ticket);
+}
+
 
 /*
  * ======= Private: =======
@@ -617,27 +753,134 @@ TCommand* NullCommandBuffer::AllocCommand(const NullOpcode opcode, std::size_t p
 
 void NullCommandBuffer::AllocDrawCommand(const DrawIndirectArguments& args)
 {
-    auto cmd = AllocCommand<NullCmdDraw>(NullOpcodeDraw, sizeof(const NullBuffer*) * renderState_.vertexBuffers.size());
+    auto cmd = AllocCommand<NullCmdDraw>(NullOpcodeDraw);
     {
-        cmd->args               = args;
-        cmd->numVertexBuffers   = renderState_.vertexBuffers.size();
-        ::memcpy(cmd + 1, renderState_.vertexBuffers.data(), sizeof(const NullBuffer*) * renderState_.vertexBuffers.size());
+        cmd->args = args;
     }
 }
 
 void NullCommandBuffer::AllocDrawIndexedCommand(const DrawIndexedIndirectArguments& args)
 {
-    auto cmd = AllocCommand<NullCmdDrawIndexed>(NullOpcodeDrawIndexed, sizeof(const NullBuffer*) * renderState_.vertexBuffers.size());
+    auto cmd = AllocCommand<NullCmdDrawIndexed>(NullOpcodeDrawIndexed);
     {
-        cmd->args               = args;
-        cmd->indexBuffer        = renderState_.indexBuffer;
-        cmd->indexBufferFormat  = renderState_.indexBufferFormat;
-        cmd->indexBufferOffset  = renderState_.indexBufferOffset;
-        cmd->numVertexBuffers   = renderState_.vertexBuffers.size();
-        ::memcpy(cmd + 1, renderState_.vertexBuffers.data(), sizeof(const NullBuffer*) * renderState_.vertexBuffers.size());
+        cmd->args = args;
     }
 }
 
+void NullCommandBuffer::AllocDrawIndirectCommand(
+    const NullOpcode    opcode,
+    Buffer&             buffer,
+    std::uint64_t       offset,
+    std::uint32_t       numCommands,
+    std::uint32_t       stride)
+{
+    /* Arguments are read when the command is executed, since the buffer might be written by a preceding command */
+    if (numCommands == 0)
+        return;
+
+    auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
+    auto cmd = AllocCommand<NullCmdDrawIndirect>(opcode);
+    {
+        cmd->buffer         = &bufferNull;
+        cmd->offset         = offset;
+        cmd->numCommands    = numCommands;
+        cmd->stride         = stride;
+    }
+    AddResourceRef(&bufferNull);
+}
+
+void NullCommandBuffer::SetVertexBuffers(std::uint32_t numBuffers, const NullBuffer* const * buffers)
+{
+    const NullBuffer* const * buffersBlock = stateBlocks_.InternArray(buffers, numBuffers);
+    if (buffersBlock == renderState_.vertexBuffers)
+        return;
+
+    auto cmd = AllocCommand<NullCmdSetVertexBuffers>(NullOpcodeSetVertexBuffers);
+    {
+        cmd->numBuffers = numBuffers;
+        cmd->buffers    = buffersBlock;
+    }
+    for_range(i, numBuffers)
+        AddResourceRef(buffers[i]);
+    renderState_.vertexBuffers = buffersBlock;
+}
+
+void NullCommandBuffer::AddResourceRef(const RenderSystemChild* ref)
+{
+    /* Skip consecutive duplicates here; all other duplicates are removed when the command buffer is finalized */
+    if (ref != nullptr && (resourceRefs_.empty() || resourceRefs_.back() != ref))
+        resourceRefs_.push_back(ref);
+}
+
+void NullCommandBuffer::AddRenderTargetRefs(RenderTarget& renderTarget)
+{
+    /* Refer to the attachment textures rather than the render target, since they can also be bound as resources */
+    if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
+    {
+        auto& swapChainNull = LLGL_CAST(NullSwapChain&, renderTarget);
+        AddResourceRef(swapChainNull.GetColorBuffer());
+        AddResourceRef(swapChainNull.GetMultiSampledColorBuffer());
+        AddResourceRef(swapChainNull.GetDepthStencilBuffer());
+    }
+    else
+    {
+        auto& renderTargetNull = LLGL_CAST(NullRenderTarget&, renderTarget);
+        for (const NullAttachment& attachment : renderTargetNull.GetColorAttachments())
+            AddResourceRef(attachment.texture);
+        for (const NullAttachment& attachment : renderTargetNull.GetResolveAttachments())
+            AddResourceRef(attachment.texture);
+        AddResourceRef(renderTargetNull.GetDepthStencilAttachment().texture);
+    }
+}
+
+void NullCommandBuffer::AddResourceHeapRefs(const NullResourceHeap& resourceHeap)
+{
+    /* Resources are determined when the heap is bound; heap updates between encoding and submission are not tracked */
+    for (const ResourceViewDescriptor& resourceView : resourceHeap.GetResourceViews())
+        AddResourceRef(resourceView.resource);
+}
+
+void NullCommandBuffer::ClearAttachmentsWithRenderPass(
+    const NullRenderPass&   renderPass,
+    std::uint32_t           numClearValues,
+    const ClearValue*       clearValues)
+{
+    /* Translate load operations of the render pass into attachment clears; missing clear values fall back to their defaults */
+    AttachmentClear attachments[LLGL_MAX_NUM_COLOR_ATTACHMENTS + 1];
+    std::uint32_t numAttachments = 0, clearValueIndex = 0;
+
+    auto NextClearValue = [&clearValueIndex, numClearValues, clearValues]() -> ClearValue
+    {
+        return (clearValueIndex < numClearValues ? clearValues[clearValueIndex++] : ClearValue{});
+    };
+
+    std::uint8_t colorBuffers[LLGL_MAX_NUM_COLOR_ATTACHMENTS];
+    const std::uint32_t numColorBuffers = FillClearColorAttachmentIndices(LLGL_MAX_NUM_COLOR_ATTACHMENTS, colorBuffers, renderPass.desc);
+
+    for_range(i, numColorBuffers)
+    {
+        auto& attachment = attachments[numAttachments++];
+        attachment.flags            = ClearFlags::Color;
+        attachment.colorAttachment  = colorBuffers[i];
+        attachment.clearValue       = NextClearValue();
+    }
+
+    long depthStencilFlags = 0;
+    if (renderPass.desc.depthAttachment.loadOp == AttachmentLoadOp::Clear)
+        depthStencilFlags |= ClearFlags::Depth;
+    if (renderPass.desc.stencilAttachment.loadOp == AttachmentLoadOp::Clear)
+        depthStencilFlags |= ClearFlags::Stencil;
+
+    if (depthStencilFlags != 0)
+    {
+        auto& attachment = attachments[numAttachments++];
+        attachment.flags        = depthStencilFlags;
+        attachment.clearValue   = NextClearValue();
+    }
+
+    ClearAttachments(numAttachments, attachments);
+}
+
 
 } // /namespace LLGL
 
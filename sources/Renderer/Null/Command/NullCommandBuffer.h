@@ -12,7 +12,10 @@
 #include <LLGL/CommandBuffer.h>
 #include <LLGL/Container/SmallVector.h>
 #include "NullCommandOpcode.h"
+#include "NullCommandContext.h"
+#include "NullStateBlockPool.h"
 #include "../../VirtualCommandBuffer.h"
+#include <vector>
 
 
 namespace LLGL
@@ -20,6 +23,11 @@ namespace LLGL
 
 
 class NullBuffer;
+class NullCommandQueue;
+class NullPipelineState;
+class NullQueryHeap;
+class NullRenderPass;
+class NullResourceHeap;
 
 using NullVirtualCommandBuffer = VirtualCommandBuffer<NullOpcode>;
 
@@ -30,7 +38,7 @@ class NullCommandBuffer final : public CommandBuffer
 
         /* ----- Common ----- */
 
-        NullCommandBuffer(const CommandBufferDescriptor& desc);
+        NullCommandBuffer(NullCommandQueue& commandQueue, const CommandBufferDescriptor& desc, NullPerformanceReporter* performanceReporter = nullptr);
 
         /* ----- Encoding ----- */
 
@@ -194,20 +202,42 @@ class NullCommandBuffer final : public CommandBuffer
         // Executes the internal virtual command buffer.
         void ExecuteVirtualCommands();
 
+        // Stores the ticket of the most recent submission of this command buffer, of all secondary command buffers it executes, and of all query heaps it writes to.
+        void SetSubmissionTicket(std::uint64_t ticket);
+
+        // Returns the recorded commands. Secondary command buffers are inlined into the context of the primary command buffer that executes them.
+        inline const NullVirtualCommandBuffer& GetVirtualCommandBuffer() const
+        {
+            return buffer_;
+        }
+
+        /*
+        Returns the objects the recorded commands access, sorted by address. This includes the command buffer itself and its secondary command buffers.
+        The command queue only executes submissions concurrently if they have no object in common.
+        */
+        inline const std::vector<const RenderSystemChild*>& GetResourceRefs() const
+        {
+            return resourceRefs_;
+        }
+
     public:
 
         const CommandBufferDescriptor desc;
 
     private:
 
+        // Most recently recorded states to skip redundant state changes. Arrays refer to interned state blocks.
         struct RenderState
         {
-            SmallVector<Viewport>           viewports;
-            SmallVector<Scissor>            scissors;
-            SmallVector<const NullBuffer*>  vertexBuffers;
-            const NullBuffer*               indexBuffer;
-            Format                          indexBufferFormat;
-            std::uint64_t                   indexBufferOffset;
+            const Viewport*             viewports           = nullptr;
+            const Scissor*              scissors            = nullptr;
+            const NullBuffer* const *   vertexBuffers       = nullptr;
+            const NullBuffer*           indexBuffer         = nullptr;
+            Format                      indexBufferFormat   = Format::Undefined;
+            std::uint64_t               indexBufferOffset   = 0;
+            const NullPipelineState*    pipelineState       = nullptr;
+            const NullResourceHeap*     resourceHeap        = nullptr;
+            std::uint32_t               descriptorSet       = 0;
         };
 
     private:
@@ -222,10 +252,39 @@ class NullCommandBuffer final : public CommandBuffer
         void AllocDrawCommand(const DrawIndirectArguments& args);
         void AllocDrawIndexedCommand(const DrawIndexedIndirectArguments& args);
 
+        void AllocDrawIndirectCommand(
+            const NullOpcode    opcode,
+            Buffer&             buffer,
+            std::uint64_t       offset,
+            std::uint32_t       numCommands,
+            std::uint32_t       stride
+        );
+
+        void SetVertexBuffers(std::uint32_t numBuffers, const NullBuffer* const * buffers);
+
+        void AddResourceRef(const RenderSystemChild* ref);
+        void AddRenderTargetRefs(RenderTarget& renderTarget);
+        void AddResourceHeapRefs(const NullResourceHeap& resourceHeap);
+
+        // Records an attachment clear for each attachment with a clear load operation in the specified render pass.
+        void ClearAttachmentsWithRenderPass(
+            const NullRenderPass&   renderPass,
+            std::uint32_t           numClearValues,
+            const ClearValue*       clearValues
+        );
+
     private:
 
-        NullVirtualCommandBuffer    buffer_;
-        RenderState                 renderState_;
+        NullCommandQueue&                       commandQueue_;
+        std::uint64_t                           submissionTicket_   = 0;
+
+        NullVirtualCommandBuffer                buffer_;
+        NullStateBlockPool                      stateBlocks_;
+        RenderState                             renderState_;
+        NullCommandContext                      context_;
+        std::vector<const RenderSystemChild*>   resourceRefs_;      // Sorted list of objects the recorded commands access
+        std::vector<NullCommandBuffer*>         secondaryBuffers_;  // Secondary command buffers executed by the recorded commands
+        std::vector<NullQueryHeap*>             queryHeaps_;        // Query heaps written by the recorded commands
 
 };
 
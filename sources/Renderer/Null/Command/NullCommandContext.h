@@ -0,0 +1,48 @@
+/*
+ * NullCommandContext.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_COMMAND_CONTEXT_H
+#define LLGL_NULL_COMMAND_CONTEXT_H
+
+
+#include "../Raster/NullRasterizer.h"
+#include "NullPerformanceModel.h"
+
+#ifdef LLGL_ENABLE_SPIRV_REFLECT
+#   include "../Compute/NullComputeInterpreter.h"
+#endif
+
+
+namespace LLGL
+{
+
+
+// States that persist across the commands of a virtual command buffer during execution.
+struct NullCommandContext
+{
+    NullCommandContext(NullPerformanceReporter* performanceReporter = nullptr) :
+        performance { performanceReporter }
+    {
+    }
+
+    NullRasterizer          rasterizer;
+    NullPerformanceModel    performance;
+
+    #ifdef LLGL_ENABLE_SPIRV_REFLECT
+    NullComputeInterpreter  compute;
+    #endif
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,6 +7,9 @@
 
 #include "NullCommandExecutor.h"
 #include "NullCommand.h"
+#include "NullCommandBuffer.h"
+
+#include "../NullSwapChain.h"
 
 #include "../Texture/NullTexture.h"
 #include "../Texture/NullSampler.h"
@@ -19,12 +22,316 @@
 #include "../RenderState/NullRenderPass.h"
 #include "../RenderState/NullQueryHeap.h"
 
+#include "../../CheckedCast.h"
+#include "../../TextureUtils.h"
+#include "../../../Core/Threading.h"
+#include <LLGL/TypeInfo.h>
+#include <LLGL/IndirectArguments.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <string.h>
+
 
 namespace LLGL
 {
 
 
-static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
+static void BeginNullRenderPass(NullRasterizer& rasterizer, RenderTarget& renderTarget)
+{
+    if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
+    {
+        auto& swapChainNull = LLGL_CAST(NullSwapChain&, renderTarget);
+        NullAttachment colorAttachment, resolveAttachment, depthStencilAttachment;
+        if (NullTexture* colorBufferMS = swapChainNull.GetMultiSampledColorBuffer())
+        {
+            colorAttachment.texture     = colorBufferMS;
+            resolveAttachment.texture   = swapChainNull.GetColorBuffer();
+        }
+        else
+            colorAttachment.texture     = swapChainNull.GetColorBuffer();
+        depthStencilAttachment.texture  = swapChainNull.GetDepthStencilBuffer();
+        rasterizer.BeginRenderPass(1, &colorAttachment, &resolveAttachment, depthStencilAttachment, swapChainNull.GetResolution());
+    }
+    else
+    {
+        auto& renderTargetNull = LLGL_CAST(NullRenderTarget&, renderTarget);
+        const auto& colorAttachments = renderTargetNull.GetColorAttachments();
+        rasterizer.BeginRenderPass(
+            static_cast<std::uint32_t>(colorAttachments.size()),
+            colorAttachments.data(),
+            renderTargetNull.GetResolveAttachments().data(),
+            renderTargetNull.GetDepthStencilAttachment(),
+            renderTargetNull.GetResolution()
+        );
+    }
+}
+
+// Minimum number of bytes per worker thread before a copy is split across multiple threads.
+constexpr std::size_t g_minCopySizePerThread = 256 * 1024;
+
+// Memory location of a copy region inside a buffer or texture subresource.
+struct NullCopyLocation
+{
+    char*       data;
+    std::size_t rowStride;
+    std::size_t layerStride;
+};
+
+static bool GetBufferCopyLocation(
+    NullBuffer&         buffer,
+    std::uint64_t       offset,
+    std::size_t         rowSize,
+    std::uint32_t       numRows,
+    std::uint32_t       numLayers,
+    std::uint32_t       rowStride,
+    std::uint32_t       layerStride,
+    NullCopyLocation&   outLocation)
+{
+    /* Zero strides denote tightly packed rows and layers */
+    outLocation.rowStride   = (rowStride   != 0 ? rowStride   : rowSize);
+    outLocation.layerStride = (layerStride != 0 ? layerStride : outLocation.rowStride * numRows);
+
+    /* Check for out-of-bounds of the entire footprint of the copy region */
+    const std::uint64_t footprint =
+    (
+        static_cast<std::uint64_t>(numLayers - 1) * outLocation.layerStride +
+        static_cast<std::uint64_t>(numRows - 1) * outLocation.rowStride +
+        rowSize
+    );
+    if (offset > buffer.desc.size || footprint > buffer.desc.size - offset)
+        return false;
+
+    outLocation.data = buffer.GetBytesAt(offset);
+    return true;
+}
+
+// Returns the MIP-map level and image offset of the copy region inside a texture subresource, or false if the region is out of bounds.
+static bool GetTextureCopyRegion(
+    const NullTexture&  texture,
+    std::uint32_t       subresource,
+    const Offset3D&     offset,
+    const Extent3D&     extent,
+    std::uint32_t&      outMipLevel,
+    Offset3D&           outImageOffset)
+{
+    std::uint32_t arrayLayer = 0;
+    texture.UnpackSubresourceIndex(subresource, outMipLevel, arrayLayer);
+    if (outMipLevel >= texture.desc.mipLevels)
+        return false;
+
+    /* Array layers are stored along the Y-axis (1D arrays) or Z-axis (otherwise) of each MIP-map level */
+    const Extent3D& mipExtent = texture.GetMipImageExtent(outMipLevel);
+    outImageOffset = CalcTextureOffset(texture.GetType(), offset, arrayLayer);
+
+    return
+    (
+        outImageOffset.x >= 0 && static_cast<std::uint32_t>(outImageOffset.x) + extent.width  <= mipExtent.width  &&
+        outImageOffset.y >= 0 && static_cast<std::uint32_t>(outImageOffset.y) + extent.height <= mipExtent.height &&
+        outImageOffset.z >= 0 && static_cast<std::uint32_t>(outImageOffset.z) + extent.depth  <= mipExtent.depth
+    );
+}
+
+// Returns the memory location of a copy region inside a MIP-map level that is stored in linear rows.
+static void GetTextureCopyLocation(NullTexture& texture, std::uint32_t mipLevel, const Offset3D& imageOffset, NullCopyLocation& outLocation)
+{
+    texture.ResolveClears(mipLevel);
+
+    const Extent3D& mipExtent = texture.GetMipImageExtent(mipLevel);
+    outLocation.rowStride   = texture.GetTexelRowStride(mipLevel);
+    outLocation.layerStride = outLocation.rowStride * mipExtent.height;
+    outLocation.data        = texture.GetTexelPtr(
+        mipLevel,
+        static_cast<std::uint32_t>(imageOffset.x),
+        static_cast<std::uint32_t>(imageOffset.y),
+        static_cast<std::uint32_t>(imageOffset.z)
+    );
+}
+
+static void CopyNullRegion(
+    const NullCopyLocation& dst,
+    const NullCopyLocation& src,
+    std::size_t             rowSize,
+    std::uint32_t           numRows,
+    std::uint32_t           numLayers,
+    bool                    isSameResource)
+{
+    const std::size_t layerSize = rowSize * numRows;
+
+    const bool isSrcPacked = (src.rowStride == rowSize && (numLayers == 1 || src.layerStride == layerSize));
+    const bool isDstPacked = (dst.rowStride == rowSize && (numLayers == 1 || dst.layerStride == layerSize));
+
+    if (isSrcPacked && isDstPacked)
+    {
+        /* Copy entire region with a single bulk copy if both layouts match */
+        ::memmove(dst.data, src.data, layerSize * numLayers);
+        return;
+    }
+
+    auto CopyRows = [&dst, &src, rowSize, numRows](std::size_t begin, std::size_t end)
+    {
+        for_subrange(i, begin, end)
+        {
+            const std::size_t row   = i % numRows;
+            const std::size_t layer = i / numRows;
+            ::memmove(
+                dst.data + layer * dst.layerStride + row * dst.rowStride,
+                src.data + layer * src.layerStride + row * src.rowStride,
+                rowSize
+            );
+        }
+    };
+
+    const std::size_t numRowsTotal = static_cast<std::size_t>(numRows) * numLayers;
+
+    if (isSameResource)
+    {
+        /*
+        Copies within the same resource may overlap: Like memmove, copy rows in ascending order if the destination lies before the source
+        and in descending order otherwise, so no row is overwritten before it has been read.
+        */
+        if (dst.data < src.data)
+            CopyRows(0, numRowsTotal);
+        else
+        {
+            for (std::size_t i = numRowsTotal; i > 0; --i)
+                CopyRows(i - 1, i);
+        }
+    }
+    else
+    {
+        /* Split rows of large copies across worker threads */
+        const std::size_t minRowsPerThread = std::max<std::size_t>(1, g_minCopySizePerThread / rowSize);
+        DoConcurrentRange(CopyRows, numRowsTotal, Constants::maxThreadCount, static_cast<unsigned>(std::min<std::size_t>(minRowsPerThread, ~0u)));
+    }
+}
+
+static void CopyNullSubresource(const NullCmdCopySubresource& cmd)
+{
+    const bool isSrcTexture = (cmd.srcResource->GetResourceType() == ResourceType::Texture);
+    const bool isDstTexture = (cmd.dstResource->GetResourceType() == ResourceType::Texture);
+
+    if (cmd.width == 0 || cmd.height == 0 || cmd.depth == 0)
+        return;
+
+    /* Determine size of each row: width is specified in bytes for buffer-to-buffer copies and in texels otherwise */
+    std::size_t rowSize = static_cast<std::size_t>(cmd.width);
+    if (isSrcTexture || isDstTexture)
+    {
+        const std::uint32_t srcBpp = (isSrcTexture ? LLGL_CAST(NullTexture*, cmd.srcResource)->GetBytesPerTexel() : 0);
+        const std::uint32_t dstBpp = (isDstTexture ? LLGL_CAST(NullTexture*, cmd.dstResource)->GetBytesPerTexel() : 0);
+
+        /* Texture-to-texture copies require formats of the same size; compressed formats are not supported */
+        if (isSrcTexture && isDstTexture && srcBpp != dstBpp)
+            return;
+
+        rowSize *= std::max(srcBpp, dstBpp);
+        if (rowSize == 0)
+            return;
+    }
+
+    const Extent3D extent
+    {
+        static_cast<std::uint32_t>(cmd.width),
+        cmd.height,
+        cmd.depth
+    };
+
+    NullTexture*    srcTexture      = (isSrcTexture ? LLGL_CAST(NullTexture*, cmd.srcResource) : nullptr);
+    NullTexture*    dstTexture      = (isDstTexture ? LLGL_CAST(NullTexture*, cmd.dstResource) : nullptr);
+    std::uint32_t   srcMipLevel     = 0;
+    std::uint32_t   dstMipLevel     = 0;
+    Offset3D        srcImageOffset;
+    Offset3D        dstImageOffset;
+
+    if (srcTexture != nullptr)
+    {
+        const Offset3D offset{ static_cast<std::int32_t>(cmd.srcX), static_cast<std::int32_t>(cmd.srcY), static_cast<std::int32_t>(cmd.srcZ) };
+        if (!GetTextureCopyRegion(*srcTexture, cmd.srcSubresource, offset, extent, srcMipLevel, srcImageOffset))
+            return;
+    }
+
+    if (dstTexture != nullptr)
+    {
+        const Offset3D offset{ static_cast<std::int32_t>(cmd.dstX), static_cast<std::int32_t>(cmd.dstY), static_cast<std::int32_t>(cmd.dstZ) };
+        if (!GetTextureCopyRegion(*dstTexture, cmd.dstSubresource, offset, extent, dstMipLevel, dstImageOffset))
+            return;
+    }
+
+    const bool isSrcTiled = (srcTexture != nullptr && srcTexture->IsMipTiled(srcMipLevel));
+    const bool isDstTiled = (dstTexture != nullptr && dstTexture->IsMipTiled(dstMipLevel));
+
+    NullCopyLocation src, dst;
+
+    if (srcTexture != nullptr)
+    {
+        if (!isSrcTiled)
+            GetTextureCopyLocation(*srcTexture, srcMipLevel, srcImageOffset, src);
+    }
+    else if (!GetBufferCopyLocation(*LLGL_CAST(NullBuffer*, cmd.srcResource), cmd.srcX, rowSize, cmd.height, cmd.depth, (isDstTexture ? cmd.rowStride : 0), (isDstTexture ? cmd.layerStride : 0), src))
+        return;
+
+    if (dstTexture != nullptr)
+    {
+        if (!isDstTiled)
+            GetTextureCopyLocation(*dstTexture, dstMipLevel, dstImageOffset, dst);
+    }
+    else if (!GetBufferCopyLocation(*LLGL_CAST(NullBuffer*, cmd.dstResource), cmd.dstX, rowSize, cmd.height, cmd.depth, (isSrcTexture ? cmd.rowStride : 0), (isSrcTexture ? cmd.layerStride : 0), dst))
+        return;
+
+    if (isSrcTiled && isDstTiled)
+    {
+        /* Copy between two tiled MIP-map levels through linear staging memory, which also handles overlapping regions */
+        std::vector<char> staging(rowSize * cmd.height * cmd.depth);
+        srcTexture->CopyToLinear(srcMipLevel, srcImageOffset, extent, staging.data(), rowSize, rowSize * cmd.height);
+        dstTexture->CopyFromLinear(dstMipLevel, dstImageOffset, extent, staging.data(), rowSize, rowSize * cmd.height);
+    }
+    else if (isSrcTiled)
+        srcTexture->CopyToLinear(srcMipLevel, srcImageOffset, extent, dst.data, dst.rowStride, dst.layerStride);
+    else if (isDstTiled)
+        dstTexture->CopyFromLinear(dstMipLevel, dstImageOffset, extent, src.data, src.rowStride, src.layerStride);
+    else
+        CopyNullRegion(dst, src, rowSize, cmd.height, cmd.depth, (cmd.srcResource == cmd.dstResource));
+}
+
+static void GetNullQueryCounters(NullCommandContext& context, NullQueryCounters& outCounters)
+{
+    /* Shade all binned triangles first, so their fragments and shading time are included */
+    context.rasterizer.Flush();
+
+    outCounters.time                = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()
+    );
+    outCounters.samplesPassed               = context.rasterizer.GetSamplesPassed();
+    outCounters.streamOutPrimitivesWritten  = context.rasterizer.GetStreamOutputPrimitivesWritten();
+    outCounters.streamOutPrimitivesNeeded   = context.rasterizer.GetStreamOutputPrimitivesNeeded();
+    outCounters.pipelineStatistics          = context.rasterizer.GetStatistics();
+
+    #ifdef LLGL_ENABLE_SPIRV_REFLECT
+    outCounters.pipelineStatistics.computeShaderInvocations = context.compute.GetNumInvocations();
+    #endif
+}
+
+// Reads the arguments of each indirect draw command from the buffer and passes them to the draw function. Out of bounds arguments end the multi-draw.
+template <typename TArguments, typename TDrawFunc>
+static void DrawNullIndirect(const NullBuffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride, const TDrawFunc& drawFunc)
+{
+    for_range(i, numCommands)
+    {
+        const std::uint64_t argsOffset = offset + static_cast<std::uint64_t>(i) * stride;
+        if (argsOffset > buffer.desc.size || sizeof(TArguments) > buffer.desc.size - argsOffset)
+            break;
+
+        TArguments args;
+        ::memcpy(&args, buffer.GetBytesAt(argsOffset), sizeof(args));
+        drawFunc(args);
+    }
+}
+
+static void ExecuteNullCommands(const NullVirtualCommandBuffer& virtualCmdBuffer, NullCommandContext& context);
+
+static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc, NullCommandContext& context)
 {
     switch (opcode)
     {
@@ -37,7 +344,7 @@ static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
         case NullOpcodeCopySubresource:
         {
             auto cmd = reinterpret_cast<const NullCmdCopySubresource*>(pc);
-            //TODO
+            CopyNullSubresource(*cmd);
             return sizeof(*cmd);
         }
         case NullOpcodeGenerateMips:
@@ -47,28 +354,206 @@ static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
             cmd->texture->GenerateMips(&subresource);
             return sizeof(*cmd);
         }
-        //TODO...
+        case NullOpcodeExecute:
+        {
+            /* Inline secondary command buffer with the bindings and render pass of the calling context */
+            auto cmd = reinterpret_cast<const NullCmdExecute*>(pc);
+            ExecuteNullCommands(cmd->commandBuffer->GetVirtualCommandBuffer(), context);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetViewports:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetViewports*>(pc);
+            context.rasterizer.SetViewports(cmd->numViewports, cmd->viewports);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetScissors:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetScissors*>(pc);
+            context.rasterizer.SetScissors(cmd->numScissors, cmd->scissors);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetVertexBuffers:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetVertexBuffers*>(pc);
+            context.rasterizer.SetVertexBuffers(cmd->numBuffers, cmd->buffers);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetIndexBuffer:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetIndexBuffer*>(pc);
+            context.rasterizer.SetIndexBuffer(cmd->buffer, cmd->format, cmd->offset);
+            context.performance.SetIndexFormat(cmd->format);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetPipelineState:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetPipelineState*>(pc);
+            context.rasterizer.SetPipelineState(cmd->pipelineState);
+            context.performance.SetPipelineState(cmd->pipelineState);
+            #ifdef LLGL_ENABLE_SPIRV_REFLECT
+            context.compute.SetPipelineState(cmd->pipelineState);
+            #endif
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetStencilReference:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetStencilReference*>(pc);
+            context.rasterizer.SetStencilReference(cmd->reference, cmd->stencilFace);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetResourceHeap:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetResourceHeap*>(pc);
+            context.performance.SetResourceHeap(cmd->resourceHeap, cmd->descriptorSet);
+            #ifdef LLGL_ENABLE_SPIRV_REFLECT
+            context.compute.SetResourceHeap(cmd->resourceHeap, cmd->descriptorSet);
+            #endif
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetResource:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetResource*>(pc);
+            context.performance.SetResource(cmd->descriptor, cmd->resource);
+            #ifdef LLGL_ENABLE_SPIRV_REFLECT
+            context.compute.SetResource(cmd->descriptor, cmd->resource);
+            #endif
+            return sizeof(*cmd);
+        }
+        case NullOpcodeBeginRenderPass:
+        {
+            auto cmd = reinterpret_cast<const NullCmdBeginRenderPass*>(pc);
+            BeginNullRenderPass(context.rasterizer, *(cmd->renderTarget));
+            return sizeof(*cmd);
+        }
+        case NullOpcodeEndRenderPass:
+        {
+            context.rasterizer.EndRenderPass();
+            return 0;
+        }
+        case NullOpcodeClear:
+        {
+            auto cmd = reinterpret_cast<const NullCmdClear*>(pc);
+            context.rasterizer.Clear(cmd->flags, cmd->clearValue);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeClearAttachments:
+        {
+            auto cmd = reinterpret_cast<const NullCmdClearAttachments*>(pc);
+            context.rasterizer.ClearAttachments(cmd->numAttachments, reinterpret_cast<const AttachmentClear*>(cmd + 1));
+            return (sizeof(*cmd) + sizeof(AttachmentClear) * cmd->numAttachments);
+        }
+        case NullOpcodeBeginStreamOutput:
+        {
+            auto cmd = reinterpret_cast<const NullCmdBeginStreamOutput*>(pc);
+            context.rasterizer.BeginStreamOutput(cmd->numBuffers, cmd->buffers);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeEndStreamOutput:
+        {
+            context.rasterizer.EndStreamOutput();
+            return 0;
+        }
         case NullOpcodeDraw:
         {
             auto cmd = reinterpret_cast<const NullCmdDraw*>(pc);
-            //TODO
-            return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(const NullBuffer*));
+            context.performance.BeginDraw(context.rasterizer);
+            context.rasterizer.Draw(cmd->args);
+            context.performance.EndDraw(context.rasterizer, 0, cmd->args.numInstances);
+            return sizeof(*cmd);
         }
         case NullOpcodeDrawIndexed:
         {
             auto cmd = reinterpret_cast<const NullCmdDrawIndexed*>(pc);
-            //TODO
-            return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(const NullBuffer*));
+            context.performance.BeginDraw(context.rasterizer);
+            context.rasterizer.DrawIndexed(cmd->args);
+            context.performance.EndDraw(context.rasterizer, static_cast<std::uint64_t>(cmd->args.numIndices) * cmd->args.numInstances, cmd->args.numInstances);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeDrawIndirect:
+        {
+            auto cmd = reinterpret_cast<const NullCmdDrawIndirect*>(pc);
+            std::uint64_t numInstances = 0;
+            context.performance.BeginDraw(context.rasterizer);
+            DrawNullIndirect<DrawIndirectArguments>(
+                *(cmd->buffer), cmd->offset, cmd->numCommands, cmd->stride,
+                [&context, &numInstances](const DrawIndirectArguments& args)
+                {
+                    context.rasterizer.Draw(args);
+                    numInstances += args.numInstances;
+                }
+            );
+            context.performance.EndDraw(context.rasterizer, 0, numInstances);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeDrawIndexedIndirect:
+        {
+            auto cmd = reinterpret_cast<const NullCmdDrawIndirect*>(pc);
+            std::uint64_t numIndices = 0, numInstances = 0;
+            context.performance.BeginDraw(context.rasterizer);
+            DrawNullIndirect<DrawIndexedIndirectArguments>(
+                *(cmd->buffer), cmd->offset, cmd->numCommands, cmd->stride,
+                [&context, &numIndices, &numInstances](const DrawIndexedIndirectArguments& args)
+                {
+                    context.rasterizer.DrawIndexed(args);
+                    numIndices      += static_cast<std::uint64_t>(args.numIndices) * args.numInstances;
+                    numInstances    += args.numInstances;
+                }
+            );
+            context.performance.EndDraw(context.rasterizer, numIndices, numInstances);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeDispatch:
+        {
+            auto cmd = reinterpret_cast<const NullCmdDispatch*>(pc);
+            #ifdef LLGL_ENABLE_SPIRV_REFLECT
+            const std::uint64_t numInvocations = context.compute.GetNumInvocations();
+            context.compute.Dispatch(cmd->numWorkGroups[0], cmd->numWorkGroups[1], cmd->numWorkGroups[2]);
+            context.performance.AddDispatch(context.compute.GetNumInvocations() - numInvocations);
+            #else
+            context.performance.AddDispatch(0);
+            #endif
+            return sizeof(*cmd);
+        }
+        case NullOpcodeDispatchIndirect:
+        {
+            auto cmd = reinterpret_cast<const NullCmdDispatchIndirect*>(pc);
+            #ifdef LLGL_ENABLE_SPIRV_REFLECT
+            const std::uint64_t numInvocations = context.compute.GetNumInvocations();
+            DispatchIndirectArguments args = {};
+            if (cmd->buffer->Read(cmd->offset, &args, sizeof(args)))
+                context.compute.Dispatch(args.numThreadGroups[0], args.numThreadGroups[1], args.numThreadGroups[2]);
+            context.performance.AddDispatch(context.compute.GetNumInvocations() - numInvocations);
+            #else
+            context.performance.AddDispatch(0);
+            #endif
+            return sizeof(*cmd);
+        }
+        case NullOpcodeBeginQuery:
+        {
+            auto cmd = reinterpret_cast<const NullCmdQuery*>(pc);
+            NullQueryCounters counters;
+            GetNullQueryCounters(context, counters);
+            cmd->queryHeap->Begin(cmd->query, counters);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeEndQuery:
+        {
+            auto cmd = reinterpret_cast<const NullCmdQuery*>(pc);
+            NullQueryCounters counters;
+            GetNullQueryCounters(context, counters);
+            cmd->queryHeap->End(cmd->query, counters);
+            return sizeof(*cmd);
         }
         case NullOpcodePushDebugGroup:
         {
             auto cmd = reinterpret_cast<const NullCmdPushDebugGroup*>(pc);
-            //TODO
+            context.performance.PushDebugGroup(reinterpret_cast<const char*>(cmd + 1));
             return (sizeof(*cmd) + cmd->length + 1);
         }
         case NullOpcodePopDebugGroup:
         {
-            //TODO
+            context.performance.PopDebugGroup();
             return 0;
         }
         default:
@@ -76,7 +561,7 @@ static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
     }
 }
 
-void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer)
+static void ExecuteNullCommands(const NullVirtualCommandBuffer& virtualCmdBuffer, NullCommandContext& context)
 {
     /* Initialize program counter to execute virtual GL commands */
     for (const auto& chunk : virtualCmdBuffer)
@@ -91,11 +576,26 @@ void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdB
             pc += sizeof(NullOpcode);
 
             /* Execute command and increment program counter */
-            pc += ExecuteNullCommand(opcode, pc);
+            pc += ExecuteNullCommand(opcode, pc, context);
         }
     }
 }
 
+void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer, NullCommandContext& context)
+{
+    /* Drop bindings of the previous execution; they may refer to state blocks that have been released since */
+    context.rasterizer.ResetBindings();
+    context.performance.Begin(context.rasterizer);
+
+    ExecuteNullCommands(virtualCmdBuffer, context);
+
+    /* Flush remaining primitives of an unterminated render pass */
+    context.rasterizer.Flush();
+
+    /* Report estimated command costs once all fragments have been counted */
+    context.performance.End(context.rasterizer);
+}
+
 
 } // /namespace LLGL
 
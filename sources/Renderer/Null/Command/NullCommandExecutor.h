@@ -10,6 +10,7 @@
 
 
 #include "NullCommandBuffer.h"
+#include "NullCommandContext.h"
 
 
 namespace LLGL
@@ -17,7 +18,7 @@ namespace LLGL
 
 
 // Executes all virtual commands from the specified command buffer.
-void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer);
+void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer, NullCommandContext& context);
 
 
 } // /namespace LLGL
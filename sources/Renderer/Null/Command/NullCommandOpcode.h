@@ -21,9 +21,30 @@ enum NullOpcode : std::uint8_t
     NullOpcodeBufferWrite = 1,
     NullOpcodeCopySubresource,
     NullOpcodeGenerateMips,
+    NullOpcodeExecute,
+    NullOpcodeSetViewports,
+    NullOpcodeSetScissors,
+    NullOpcodeSetVertexBuffers,
+    NullOpcodeSetIndexBuffer,
+    NullOpcodeSetPipelineState,
+    NullOpcodeSetStencilReference,
+    NullOpcodeSetResourceHeap,
+    NullOpcodeSetResource,
+    NullOpcodeBeginRenderPass,
+    NullOpcodeEndRenderPass,
+    NullOpcodeClear,
+    NullOpcodeClearAttachments,
+    NullOpcodeBeginStreamOutput,
+    NullOpcodeEndStreamOutput,
     //TODO
     NullOpcodeDraw,
     NullOpcodeDrawIndexed,
+    NullOpcodeDrawIndirect,
+    NullOpcodeDrawIndexedIndirect,
+    NullOpcodeDispatch,
+    NullOpcodeDispatchIndirect,
+    NullOpcodeBeginQuery,
+    NullOpcodeEndQuery,
     NullOpcodePushDebugGroup,
     NullOpcodePopDebugGroup,
 };
@@ -9,46 +9,258 @@
 #include "NullCommandBuffer.h"
 #include "NullCommandExecutor.h"
 #include "../RenderState/NullQueryHeap.h"
+#include "../RenderState/NullFence.h"
+#include "../NullFrameCapture.h"
 #include "../../CheckedCast.h"
+#include "../../../Core/Threading.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
+NullCommandQueue::NullCommandQueue() :
+    worker_ { &NullCommandQueue::RunWorker, this }
+{
+}
+
+NullCommandQueue::~NullCommandQueue()
+{
+    /* Let worker thread drain all remaining submissions before it quits */
+    quit_ = true;
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        workerAsleep_ = false;
+    }
+    workSignal_.notify_one();
+    worker_.join();
+}
+
 /* ----- Command Buffers ----- */
 
 void NullCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
     auto& commandBufferNull = LLGL_CAST(NullCommandBuffer&, commandBuffer);
     if ((commandBufferNull.desc.flags & (CommandBufferFlags::ImmediateSubmit | CommandBufferFlags::Secondary)) == 0)
-        commandBufferNull.ExecuteVirtualCommands();
+        SubmitCommandBuffer(commandBufferNull);
 }
 
 /* ----- Queries ----- */
 
 bool NullCommandQueue::QueryResult(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize)
 {
-    //auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
-    //todo
-    return false;
+    auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
+
+    /* Queries that are re-recorded by a pending submission still hold the results of a previous submission */
+    if (!IsSubmissionCompleted(queryHeapNull.GetSubmissionTicket()))
+        return false;
+
+    return queryHeapNull.ReadResults(firstQuery, numQueries, data, dataSize);
 }
 
 /* ----- Fences ----- */
 
 void NullCommandQueue::Submit(Fence& fence)
 {
-    //todo
+    auto& fenceNull = LLGL_CAST(NullFence&, fence);
+    Enqueue(NullSubmission{ nullptr, &fenceNull, fenceNull.NextSignal(), nullptr, nullptr });
 }
 
 bool NullCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 {
-    return false; //todo
+    auto& fenceNull = LLGL_CAST(NullFence&, fence);
+    return fenceNull.WaitForSignal(fenceNull.GetPendingSignal(), timeout);
 }
 
 void NullCommandQueue::WaitIdle()
 {
-    //todo
+    WaitForSubmission(ring_.GetLastTicket());
+}
+
+/* ----- Internal ----- */
+
+void NullCommandQueue::SubmitCommandBuffer(NullCommandBuffer& commandBuffer)
+{
+    commandBuffer.SetSubmissionTicket(Enqueue(NullSubmission{ &commandBuffer, nullptr, 0, nullptr, nullptr }));
+}
+
+void NullCommandQueue::SubmitFrameCapture(NullFrameCapture& frameCapture, NullTexture& colorBuffer)
+{
+    Enqueue(NullSubmission{ nullptr, nullptr, 0, &frameCapture, &colorBuffer });
+}
+
+void NullCommandQueue::WaitForSubmission(std::uint64_t ticket)
+{
+    std::unique_lock<std::mutex> lock{ mutex_ };
+    completionSignal_.wait(lock, [this, ticket]() -> bool { return (completedTicket_ >= ticket); });
+}
+
+bool NullCommandQueue::IsSubmissionCompleted(std::uint64_t ticket)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    return (completedTicket_ >= ticket);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::uint64_t NullCommandQueue::Enqueue(const NullSubmission& submission)
+{
+    /* Push submission into ring buffer; if it's full, give the worker thread time to catch up */
+    std::uint64_t ticket = 0;
+    while ((ticket = ring_.Push(submission)) == 0)
+        std::this_thread::yield();
+
+    /* Only lock the mutex if the worker thread went to sleep */
+    if (workerAsleep_.exchange(false))
+    {
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+        }
+        workSignal_.notify_one();
+    }
+
+    return ticket;
+}
+
+void NullCommandQueue::RunWorker()
+{
+    for (;;)
+    {
+        if (PopBatch())
+            ExecuteBatch();
+        else
+        {
+            /*
+            Announce that the worker goes to sleep before checking the ring buffer again,
+            so a producer either sees the flag or the worker sees the new submission.
+            */
+            std::unique_lock<std::mutex> lock{ mutex_ };
+            workerAsleep_ = true;
+            if (!ring_.IsEmpty())
+            {
+                workerAsleep_ = false;
+                continue;
+            }
+            if (quit_)
+                break;
+            workSignal_.wait(lock, [this]() -> bool { return (!workerAsleep_ || quit_); });
+            workerAsleep_ = false;
+        }
+    }
+}
+
+bool NullCommandQueue::PopBatch()
+{
+    batch_.clear();
+    NullSubmission submission;
+    while (batch_.size() < NullSubmissionRing::capacity && ring_.Pop(submission))
+        batch_.push_back(submission);
+    return !batch_.empty();
+}
+
+void NullCommandQueue::ExecuteBatch()
+{
+    /* Execute each run of consecutive command buffers as a group; fences and frame captures separate the groups */
+    std::size_t begin = 0;
+    while (begin < batch_.size())
+    {
+        std::size_t end = begin;
+        while (end < batch_.size() && batch_[end].commandBuffer != nullptr)
+            ++end;
+
+        if (end > begin)
+            ExecuteCommandBuffers(&batch_[begin], end - begin);
+
+        if (end < batch_.size())
+        {
+            const NullSubmission& submission = batch_[end++];
+            if (submission.fence != nullptr)
+                submission.fence->Signal(submission.fenceValue);
+            else if (submission.frameCapture != nullptr)
+                submission.frameCapture->Capture(*submission.captureSource);
+        }
+
+        CompleteSubmissions(end - begin);
+        begin = end;
+    }
+}
+
+void NullCommandQueue::ExecuteCommandBuffers(const NullSubmission* submissions, std::size_t count)
+{
+    if (count == 1)
+    {
+        submissions[0].commandBuffer->ExecuteVirtualCommands();
+        return;
+    }
+
+    /* Assign each command buffer to the level after the last level that accesses any of its objects */
+    refLevels_.clear();
+    batchLevels_.resize(count);
+
+    for_range(i, count)
+    {
+        const auto& refs = submissions[i].commandBuffer->GetResourceRefs();
+
+        std::uint32_t level = 0;
+        for (const RenderSystemChild* ref : refs)
+        {
+            auto it = refLevels_.find(ref);
+            if (it != refLevels_.end())
+                level = std::max(level, it->second + 1);
+        }
+
+        for (const RenderSystemChild* ref : refs)
+            refLevels_[ref] = level;
+
+        batchLevels_[i] = level;
+    }
+
+    /* Execute levels one after another and all command buffers within the same level concurrently */
+    batchOrder_.resize(count);
+    for_range(i, count)
+        batchOrder_[i] = i;
+
+    std::stable_sort(
+        batchOrder_.begin(),
+        batchOrder_.end(),
+        [this](std::size_t lhs, std::size_t rhs) -> bool
+        {
+            return (batchLevels_[lhs] < batchLevels_[rhs]);
+        }
+    );
+
+    for (std::size_t first = 0; first < count;)
+    {
+        std::size_t last = first + 1;
+        while (last < count && batchLevels_[batchOrder_[last]] == batchLevels_[batchOrder_[first]])
+            ++last;
+
+        DoConcurrent(
+            [this, submissions, first](std::size_t index)
+            {
+                submissions[batchOrder_[first + index]].commandBuffer->ExecuteVirtualCommands();
+            },
+            last - first,
+            Constants::maxThreadCount,
+            1
+        );
+
+        first = last;
+    }
+}
+
+void NullCommandQueue::CompleteSubmissions(std::uint64_t count)
+{
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        completedTicket_ += count;
+    }
+    completionSignal_.notify_all();
 }
 
 
@@ -10,12 +10,24 @@
 
 
 #include <LLGL/CommandQueue.h>
+#include "NullSubmissionRing.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <unordered_map>
 
 
 namespace LLGL
 {
 
 
+/*
+Command queue of the Null renderer.
+Submissions are pushed into a lock-free ring buffer and executed by a worker thread that is owned by this queue.
+The worker pops all pending submissions as one batch. Command buffers of a batch that access disjoint objects are executed concurrently,
+while command buffers that share any object keep their submission order. Fences are signaled and frames are captured once all preceding submissions have been executed.
+*/
 class NullCommandQueue final : public CommandQueue
 {
 
@@ -42,6 +54,54 @@ class NullCommandQueue final : public CommandQueue
         bool WaitFence(Fence& fence, std::uint64_t timeout) override;
         void WaitIdle() override;
 
+    public:
+
+        NullCommandQueue();
+        ~NullCommandQueue();
+
+        // Enqueues the specified command buffer for execution and stores the submission ticket in the command buffer.
+        void SubmitCommandBuffer(NullCommandBuffer& commandBuffer);
+
+        // Enqueues a capture of the specified color buffer, which the worker thread copies once all preceding submissions have been executed.
+        void SubmitFrameCapture(NullFrameCapture& frameCapture, NullTexture& colorBuffer);
+
+        // Blocks until the submission with the specified ticket has been executed. Ticket 0 refers to no submission.
+        void WaitForSubmission(std::uint64_t ticket);
+
+        // Returns true if the submission with the specified ticket has been executed.
+        bool IsSubmissionCompleted(std::uint64_t ticket);
+
+    private:
+
+        std::uint64_t Enqueue(const NullSubmission& submission);
+
+        void RunWorker();
+
+        bool PopBatch();
+        void ExecuteBatch();
+        void ExecuteCommandBuffers(const NullSubmission* submissions, std::size_t count);
+        void CompleteSubmissions(std::uint64_t count);
+
+    private:
+
+        NullSubmissionRing      ring_;
+
+        std::atomic<bool>       workerAsleep_   { false };
+        std::atomic<bool>       quit_           { false };
+
+        std::mutex              mutex_;
+        std::condition_variable workSignal_;                // Wakes up the worker thread
+        std::condition_variable completionSignal_;          // Wakes up threads waiting for a submission
+        std::uint64_t           completedTicket_    = 0;    // Guarded by mutex_
+
+        /* Batch states of the worker thread */
+        std::vector<NullSubmission>                                 batch_;
+        std::vector<std::uint32_t>                                  batchLevels_;   // Execution level of each command buffer in the batch
+        std::vector<std::size_t>                                    batchOrder_;    // Command buffer indices sorted by execution level
+        std::unordered_map<const RenderSystemChild*, std::uint32_t> refLevels_;     // Last execution level that accesses each object
+
+        std::thread             worker_;                    // Declared last, so all states are initialized before the thread starts
+
 };
 
 
@@ -0,0 +1,291 @@
+/*
+ * NullPerformanceModel.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "NullPerformanceModel.h"
+#include "../Raster/NullRasterizer.h"
+#include "../RenderState/NullPipelineState.h"
+#include "../RenderState/NullResourceHeap.h"
+#include "../Shader/NullShader.h"
+#include "../Texture/NullTexture.h"
+#include "../../CheckedCast.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+/*
+ * NullPerformanceReporter class
+ */
+
+NullPerformanceReporter::NullPerformanceReporter(const RendererConfigurationNull& config) :
+    callback_ { config.performanceModelCallback }
+{
+}
+
+void NullPerformanceReporter::Report(std::size_t numCommands, const NullCommandCost* commands)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    callback_(numCommands, commands);
+}
+
+bool NullPerformanceReporter::IsEnabled(const RendererConfigurationNull& config)
+{
+    return static_cast<bool>(config.performanceModelCallback);
+}
+
+
+/*
+ * NullPerformanceModel class
+ */
+
+// Returns the number of bytes of all MIP-map levels and array layers of the specified texture.
+static std::uint64_t GetNullTextureSize(const NullTexture& texture)
+{
+    std::uint64_t size = 0;
+    for_range(mipLevel, texture.desc.mipLevels)
+    {
+        const Extent3D& extent = texture.GetMipImageExtent(mipLevel);
+        size += static_cast<std::uint64_t>(extent.width) * extent.height * extent.depth;
+    }
+    return size * texture.GetBytesPerTexel();
+}
+
+NullPerformanceModel::NullPerformanceModel(NullPerformanceReporter* reporter) :
+    reporter_ { reporter }
+{
+}
+
+void NullPerformanceModel::Begin(NullRasterizer& rasterizer)
+{
+    if (!IsEnabled())
+        return;
+
+    pipelineState_      = nullptr;
+    indexFormat_        = Format::R32UInt;
+    resourceHeap_       = nullptr;
+    descriptorSet_      = 0;
+    textureBytesDirty_  = true;
+    resources_.clear();
+
+    debugGroupPath_.clear();
+    debugGroupLengths_.clear();
+    debugGroupNames_.assign(1, std::string());
+    debugGroup_         = 0;
+
+    records_.clear();
+    rasterizer.ResetCostRecords();
+}
+
+void NullPerformanceModel::End(NullRasterizer& rasterizer)
+{
+    if (!IsEnabled())
+        return;
+
+    const auto& fragments = rasterizer.GetCostRecordFragments();
+
+    costs_.resize(records_.size());
+    for_range(i, records_.size())
+    {
+        const CostRecord&   record  = records_[i];
+        NullCommandCost&    cost    = costs_[i];
+
+        std::uint64_t numInvocations = record.shaderInvocations;
+        std::uint64_t numTexelReads  = (record.isDispatch ? numInvocations : 0);
+
+        if (i < fragments.size())
+        {
+            /* Fragment shader invocations are counted per rasterized pixel like in the pipeline statistics */
+            cost.rasterizedPixels   = fragments[i].rasterized;
+            numInvocations          += fragments[i].rasterized;
+            numTexelReads           = fragments[i].shaded;
+        }
+        else
+            cost.rasterizedPixels   = 0;
+
+        cost.debugGroup         = debugGroupNames_[record.debugGroup].c_str();
+        cost.isDispatch         = record.isDispatch;
+        cost.vertexFetchBytes   = record.vertexFetchBytes;
+        cost.indexBytes         = record.indexBytes;
+        cost.textureBytes       = std::min(record.textureBytesMax, numTexelReads * record.textureBytesPerInvocation);
+        cost.shaderInvocations  = numInvocations;
+    }
+
+    reporter_->Report(costs_.size(), costs_.data());
+
+    records_.clear();
+    rasterizer.ResetCostRecords();
+}
+
+void NullPerformanceModel::SetPipelineState(const NullPipelineState* pipelineState)
+{
+    pipelineState_ = pipelineState;
+}
+
+void NullPerformanceModel::SetIndexFormat(const Format format)
+{
+    indexFormat_ = format;
+}
+
+void NullPerformanceModel::SetResourceHeap(const NullResourceHeap* resourceHeap, std::uint32_t descriptorSet)
+{
+    if (!IsEnabled())
+        return;
+
+    resourceHeap_       = resourceHeap;
+    descriptorSet_      = descriptorSet;
+    textureBytesDirty_  = true;
+}
+
+void NullPerformanceModel::SetResource(std::uint32_t descriptor, Resource* resource)
+{
+    if (!IsEnabled())
+        return;
+
+    if (descriptor >= resources_.size())
+        resources_.resize(descriptor + 1, nullptr);
+    resources_[descriptor]  = resource;
+    textureBytesDirty_      = true;
+}
+
+void NullPerformanceModel::PushDebugGroup(const char* name)
+{
+    if (!IsEnabled())
+        return;
+
+    debugGroupLengths_.push_back(debugGroupPath_.size());
+    if (!debugGroupPath_.empty())
+        debugGroupPath_ += '/';
+    debugGroupPath_ += name;
+    SelectDebugGroup();
+}
+
+void NullPerformanceModel::PopDebugGroup()
+{
+    if (!IsEnabled() || debugGroupLengths_.empty())
+        return;
+
+    debugGroupPath_.resize(debugGroupLengths_.back());
+    debugGroupLengths_.pop_back();
+    SelectDebugGroup();
+}
+
+void NullPerformanceModel::BeginDraw(NullRasterizer& rasterizer)
+{
+    if (!IsEnabled())
+        return;
+
+    rasterizer.SetCostRecord(static_cast<std::uint32_t>(records_.size()));
+    vertexInvocationsBegin_ = rasterizer.GetStatistics().vertexShaderInvocations;
+}
+
+void NullPerformanceModel::EndDraw(NullRasterizer& rasterizer, std::uint64_t numIndices, std::uint64_t numInstances)
+{
+    if (!IsEnabled())
+        return;
+
+    rasterizer.SetCostRecord(NullRasterizer::invalidCostRecord);
+    UpdateTextureBytes();
+
+    CostRecord record;
+    {
+        record.debugGroup                   = debugGroup_;
+        record.shaderInvocations            = rasterizer.GetStatistics().vertexShaderInvocations - vertexInvocationsBegin_;
+        record.indexBytes                   = numIndices * (GetFormatAttribs(indexFormat_).bitSize / 8);
+        record.textureBytesPerInvocation    = textureBytesPerInvocation_;
+        record.textureBytesMax              = textureBytesMax_;
+
+        /* Each vertex shader invocation fetches all per-vertex attributes, while per-instance attributes are fetched once per divisor */
+        if (pipelineState_ != nullptr && pipelineState_->isGraphicsPSO && pipelineState_->graphicsDesc.vertexShader != nullptr)
+        {
+            const auto& vertexShaderNull = LLGL_CAST(const NullShader&, *(pipelineState_->graphicsDesc.vertexShader));
+            for (const auto& attrib : vertexShaderNull.desc.vertex.inputAttribs)
+            {
+                const std::uint64_t attribSize = attrib.GetSize();
+                if (attrib.instanceDivisor > 0)
+                    record.vertexFetchBytes += attribSize * ((numInstances + attrib.instanceDivisor - 1) / attrib.instanceDivisor);
+                else
+                    record.vertexFetchBytes += attribSize * record.shaderInvocations;
+            }
+        }
+    }
+    records_.push_back(record);
+}
+
+void NullPerformanceModel::AddDispatch(std::uint64_t numInvocations)
+{
+    if (!IsEnabled())
+        return;
+
+    UpdateTextureBytes();
+
+    CostRecord record;
+    {
+        record.debugGroup                   = debugGroup_;
+        record.isDispatch                   = true;
+        record.shaderInvocations            = numInvocations;
+        record.textureBytesPerInvocation    = textureBytesPerInvocation_;
+        record.textureBytesMax              = textureBytesMax_;
+    }
+    records_.push_back(record);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullPerformanceModel::UpdateTextureBytes()
+{
+    if (!textureBytesDirty_)
+        return;
+
+    textureBytesPerInvocation_  = 0;
+    textureBytesMax_            = 0;
+
+    if (resourceHeap_ != nullptr)
+    {
+        for_range(binding, resourceHeap_->GetNumBindings())
+        {
+            if (const ResourceViewDescriptor* resourceView = resourceHeap_->GetResourceView(descriptorSet_, binding))
+                AddTextureBytes(resourceView->resource);
+        }
+    }
+
+    for (const Resource* resource : resources_)
+        AddTextureBytes(resource);
+
+    textureBytesDirty_ = false;
+}
+
+void NullPerformanceModel::AddTextureBytes(const Resource* resource)
+{
+    if (resource != nullptr && resource->GetResourceType() == ResourceType::Texture)
+    {
+        const auto& textureNull = LLGL_CAST(const NullTexture&, *resource);
+        textureBytesPerInvocation_  += textureNull.GetBytesPerTexel();
+        textureBytesMax_            += GetNullTextureSize(textureNull);
+    }
+}
+
+void NullPerformanceModel::SelectDebugGroup()
+{
+    /* Share names between all records of the same debug group; the number of distinct groups per command buffer is usually small */
+    auto it = std::find(debugGroupNames_.begin(), debugGroupNames_.end(), debugGroupPath_);
+    if (it == debugGroupNames_.end())
+        it = debugGroupNames_.insert(debugGroupNames_.end(), debugGroupPath_);
+    debugGroup_ = static_cast<std::uint32_t>(std::distance(debugGroupNames_.begin(), it));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,145 @@
+/*
+ * NullPerformanceModel.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_PERFORMANCE_MODEL_H
+#define LLGL_NULL_PERFORMANCE_MODEL_H
+
+
+#include <LLGL/RendererConfiguration.h>
+#include <LLGL/Format.h>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class Resource;
+class NullRasterizer;
+class NullPipelineState;
+class NullResourceHeap;
+
+// Forwards the estimated command costs of all command buffers to the performance model callback of the renderer configuration.
+class NullPerformanceReporter
+{
+
+    public:
+
+        NullPerformanceReporter(const RendererConfigurationNull& config);
+
+        NullPerformanceReporter(const NullPerformanceReporter&) = delete;
+        NullPerformanceReporter& operator = (const NullPerformanceReporter&) = delete;
+
+        // Passes the specified command costs to the callback. Concurrent reports are serialized.
+        void Report(std::size_t numCommands, const NullCommandCost* commands);
+
+        // Returns true if the specified configuration enables the performance model.
+        static bool IsEnabled(const RendererConfigurationNull& config);
+
+    private:
+
+        const NullPerformanceModelCallback  callback_;
+        std::mutex                          mutex_;
+
+};
+
+/*
+Estimates the cost of each draw and dispatch command of a command buffer during execution.
+Vertex and index bytes are derived from the bound states when the command is executed,
+while fragment counts are only available once the rasterizer has been flushed, so all records are finalized at the end of execution.
+*/
+class NullPerformanceModel
+{
+
+    public:
+
+        NullPerformanceModel(NullPerformanceReporter* reporter = nullptr);
+
+        // Returns true if a reporter is assigned. Otherwise, all functions of this model have no effect.
+        inline bool IsEnabled() const
+        {
+            return (reporter_ != nullptr);
+        }
+
+        // Resets all states and records at the beginning of an execution.
+        void Begin(NullRasterizer& rasterizer);
+
+        // Finalizes all records and reports them at the end of an execution. The rasterizer must have been flushed before.
+        void End(NullRasterizer& rasterizer);
+
+        void SetPipelineState(const NullPipelineState* pipelineState);
+        void SetIndexFormat(const Format format);
+        void SetResourceHeap(const NullResourceHeap* resourceHeap, std::uint32_t descriptorSet);
+        void SetResource(std::uint32_t descriptor, Resource* resource);
+
+        void PushDebugGroup(const char* name);
+        void PopDebugGroup();
+
+        // Starts a new draw record and assigns the fragments of subsequent primitives to it.
+        void BeginDraw(NullRasterizer& rasterizer);
+
+        // Finishes the current draw record with the number of indices (zero for non-indexed draws) and instances of all draws since BeginDraw.
+        void EndDraw(NullRasterizer& rasterizer, std::uint64_t numIndices, std::uint64_t numInstances);
+
+        // Adds a dispatch record with the specified number of compute shader invocations.
+        void AddDispatch(std::uint64_t numInvocations);
+
+    private:
+
+        struct CostRecord
+        {
+            std::uint32_t   debugGroup                  = 0;        // Index into debugGroupNames_
+            bool            isDispatch                  = false;
+            std::uint64_t   vertexFetchBytes            = 0;
+            std::uint64_t   indexBytes                  = 0;
+            std::uint64_t   textureBytesPerInvocation   = 0;
+            std::uint64_t   textureBytesMax             = 0;
+            std::uint64_t   shaderInvocations           = 0;        // Vertex or compute shader invocations; fragments are added at the end
+        };
+
+    private:
+
+        void UpdateTextureBytes();
+        void AddTextureBytes(const Resource* resource);
+        void SelectDebugGroup();
+
+    private:
+
+        NullPerformanceReporter*        reporter_                   = nullptr;
+
+        const NullPipelineState*        pipelineState_              = nullptr;
+        Format                          indexFormat_                = Format::R32UInt;
+        const NullResourceHeap*         resourceHeap_               = nullptr;
+        std::uint32_t                   descriptorSet_              = 0;
+        std::vector<Resource*>          resources_;                             // Individual resources set per descriptor
+        bool                            textureBytesDirty_          = true;
+        std::uint64_t                   textureBytesPerInvocation_  = 0;
+        std::uint64_t                   textureBytesMax_            = 0;
+
+        std::string                     debugGroupPath_;                        // Names of all pushed debug groups joined by '/'
+        std::vector<std::size_t>        debugGroupLengths_;                     // Length of debugGroupPath_ before each push
+        std::vector<std::string>        debugGroupNames_;                       // All debug group paths of the current execution
+        std::uint32_t                   debugGroup_                 = 0;
+
+        std::vector<CostRecord>         records_;
+        std::uint64_t                   vertexInvocationsBegin_     = 0;
+        std::vector<NullCommandCost>    costs_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,69 @@
+/*
+ * NullStateBlockPool.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "NullStateBlockPool.h"
+#include "../../../Core/CoreUtils.h"
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+// Strict-weak-order (SWO) comparison of two state blocks: first by size, then by content.
+static int CompareStateBlockSWO(std::size_t lhsSize, const void* lhsData, std::size_t rhsSize, const void* rhsData)
+{
+    if (lhsSize < rhsSize)
+        return -1;
+    if (lhsSize > rhsSize)
+        return +1;
+    return ::memcmp(lhsData, rhsData, lhsSize);
+}
+
+const void* NullStateBlockPool::Intern(const void* data, std::size_t size)
+{
+    if (size == 0)
+        return nullptr;
+
+    /* Try to find state block with same content */
+    std::size_t insertionIndex = 0;
+    auto* entry = FindInSortedArray<StateBlock>(
+        blocks_.data(),
+        blocks_.size(),
+        [data, size](const StateBlock& block) -> int
+        {
+            return CompareStateBlockSWO(size, data, block.size, block.data.get());
+        },
+        &insertionIndex
+    );
+    if (entry != nullptr)
+        return entry->data.get();
+
+    /* Allocate new state block with insertion sort */
+    StateBlock block;
+    {
+        block.size = size;
+        block.data = MakeUniqueArray<char>(size);
+        ::memcpy(block.data.get(), data, size);
+    }
+    const char* blockData = block.data.get();
+    blocks_.insert(blocks_.begin() + insertionIndex, std::move(block));
+
+    return blockData;
+}
+
+void NullStateBlockPool::Clear()
+{
+    blocks_.clear();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,71 @@
+/*
+ * NullStateBlockPool.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_STATE_BLOCK_POOL_H
+#define LLGL_NULL_STATE_BLOCK_POOL_H
+
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Pool of immutable state blocks for the Null command buffer.
+Equal state is only stored once, so recorded commands can refer to a state block by its address
+and redundant state changes can be detected by comparing addresses only.
+*/
+class NullStateBlockPool
+{
+
+    public:
+
+        NullStateBlockPool() = default;
+
+        NullStateBlockPool(const NullStateBlockPool&) = delete;
+        NullStateBlockPool& operator = (const NullStateBlockPool&) = delete;
+
+        // Returns the state block with the specified content. The block remains valid until the pool is cleared.
+        const void* Intern(const void* data, std::size_t size);
+
+        // Returns the state block with the specified array of trivially copyable elements.
+        template <typename T>
+        const T* InternArray(const T* data, std::size_t count)
+        {
+            return static_cast<const T*>(Intern(data, sizeof(T) * count));
+        }
+
+        // Releases all state blocks.
+        void Clear();
+
+    private:
+
+        struct StateBlock
+        {
+            std::size_t             size;
+            std::unique_ptr<char[]> data;
+        };
+
+    private:
+
+        std::vector<StateBlock> blocks_;    // Sorted by size and content
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,135 @@
+/*
+ * NullSubmissionRing.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_SUBMISSION_RING_H
+#define LLGL_NULL_SUBMISSION_RING_H
+
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+class NullCommandBuffer;
+class NullFence;
+class NullFrameCapture;
+class NullTexture;
+
+// Work item of the Null command queue: Either a command buffer to execute, a fence to signal, or a color buffer to capture.
+struct NullSubmission
+{
+    NullCommandBuffer*  commandBuffer;
+    NullFence*          fence;
+    std::uint64_t       fenceValue;
+    NullFrameCapture*   frameCapture;
+    NullTexture*        captureSource;
+};
+
+/*
+Bounded lock-free ring buffer for submissions to the Null command queue.
+Multiple threads can push submissions, but only the worker thread of the command queue pops them.
+Each slot has a sequence number that tells producers and the consumer whether the slot is free or occupied for their position.
+*/
+class NullSubmissionRing
+{
+
+    public:
+
+        static constexpr std::size_t capacity = 256;
+
+    public:
+
+        NullSubmissionRing()
+        {
+            for (std::size_t i = 0; i < capacity; ++i)
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        NullSubmissionRing(const NullSubmissionRing&) = delete;
+        NullSubmissionRing& operator = (const NullSubmissionRing&) = delete;
+
+        // Pushes the specified submission and returns its 1-based ticket. Returns 0 if the ring is full.
+        std::uint64_t Push(const NullSubmission& submission)
+        {
+            std::uint64_t pos = writePos_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Slot& slot = slots_[pos % capacity];
+                const std::uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+                if (seq == pos)
+                {
+                    /* Slot is free for this position, try to claim it */
+                    if (writePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        slot.submission = submission;
+                        slot.sequence.store(pos + 1);
+                        return pos + 1;
+                    }
+                }
+                else if (seq < pos)
+                {
+                    /* Slot still holds a submission from the previous round */
+                    return 0;
+                }
+                else
+                    pos = writePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Pops the next submission. Returns false if the ring is empty. Must only be called by the consumer thread.
+        bool Pop(NullSubmission& outSubmission)
+        {
+            Slot& slot = slots_[readPos_ % capacity];
+            if (slot.sequence.load(std::memory_order_acquire) != readPos_ + 1)
+                return false;
+            outSubmission = slot.submission;
+            slot.sequence.store(readPos_ + capacity, std::memory_order_release);
+            ++readPos_;
+            return true;
+        }
+
+        // Returns true if no submission is ready for the consumer.
+        bool IsEmpty() const
+        {
+            return (slots_[readPos_ % capacity].sequence.load() != readPos_ + 1);
+        }
+
+        // Returns the ticket of the most recently claimed slot.
+        std::uint64_t GetLastTicket() const
+        {
+            return writePos_.load();
+        }
+
+    private:
+
+        struct Slot
+        {
+            std::atomic<std::uint64_t>  sequence;
+            NullSubmission              submission;
+        };
+
+    private:
+
+        Slot                        slots_[capacity];
+        std::atomic<std::uint64_t>  writePos_   { 0 };
+        std::uint64_t               readPos_    = 0;    // Only accessed by the consumer thread
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
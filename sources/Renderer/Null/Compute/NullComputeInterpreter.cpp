@@ -0,0 +1,1861 @@
+/*
+ * NullComputeInterpreter.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "NullComputeInterpreter.h"
+#include "../Buffer/NullBuffer.h"
+#include "../Texture/NullTexture.h"
+#include "../Texture/NullSampler.h"
+#include "../RenderState/NullPipelineState.h"
+#include "../RenderState/NullPipelineLayout.h"
+#include "../RenderState/NullResourceHeap.h"
+#include "../../CheckedCast.h"
+#include "../../../Core/Threading.h"
+#include "../../../Core/Float16Compressor.h"
+#include <LLGL/ResourceHeapFlags.h>
+#include <LLGL/Utils/ForRange.h>
+#include <LLGL/Constants.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <limits>
+#include <cmath>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+static_assert(sizeof(NullComputePointer) <= NullComputeProgram::pointerWords * sizeof(std::uint32_t), "NullComputePointer exceeds pointer registers");
+static_assert(sizeof(NullComputeImage*) <= NullComputeProgram::handleWords * sizeof(std::uint32_t), "image handle exceeds handle registers");
+static_assert(sizeof(NullSampler*) <= NullComputeProgram::handleWords * sizeof(std::uint32_t), "sampler handle exceeds handle registers");
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "std::atomic<std::uint32_t> must not have additional storage");
+
+// Frame of a function call to return from.
+struct NullComputeCallFrame
+{
+    std::uint32_t returnPc;
+    std::uint32_t dst;
+    std::uint32_t n;
+};
+
+// Execution state of a single invocation.
+struct NullComputeInvocation
+{
+    std::uint32_t*                      regs    = nullptr;
+    std::uint32_t                       pc      = 0;
+    std::vector<NullComputeCallFrame>   frames;
+    bool                                done    = false;
+};
+
+
+/*
+ * Scalar helpers
+ */
+
+static inline float AsFloat(std::uint32_t u)
+{
+    float f;
+    ::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+static inline std::uint32_t AsUInt(float f)
+{
+    std::uint32_t u;
+    ::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+static inline std::int32_t AsInt(std::uint32_t u)
+{
+    return static_cast<std::int32_t>(u);
+}
+
+// Converts a float to a signed integer with saturation, since out of range conversions are undefined in C++.
+static std::int32_t FloatToSInt(float f)
+{
+    if (std::isnan(f))
+        return 0;
+    if (f >= 2147483647.0f)
+        return std::numeric_limits<std::int32_t>::max();
+    if (f <= -2147483648.0f)
+        return std::numeric_limits<std::int32_t>::min();
+    return static_cast<std::int32_t>(f);
+}
+
+// Converts a float to an unsigned integer with saturation.
+static std::uint32_t FloatToUInt(float f)
+{
+    if (!(f > 0.0f))
+        return 0;
+    if (f >= 4294967295.0f)
+        return std::numeric_limits<std::uint32_t>::max();
+    return static_cast<std::uint32_t>(f);
+}
+
+static std::uint32_t BitCount(std::uint32_t x)
+{
+    std::uint32_t n = 0;
+    for (; x != 0; x &= x - 1)
+        ++n;
+    return n;
+}
+
+static std::uint32_t BitReverse(std::uint32_t x)
+{
+    std::uint32_t y = 0;
+    for_range(i, 32u)
+    {
+        y = (y << 1) | (x & 1u);
+        x >>= 1;
+    }
+    return y;
+}
+
+static std::uint32_t FindLsb(std::uint32_t x)
+{
+    if (x == 0)
+        return ~0u;
+    std::uint32_t i = 0;
+    while ((x & 1u) == 0)
+    {
+        x >>= 1;
+        ++i;
+    }
+    return i;
+}
+
+static std::uint32_t FindMsb(std::uint32_t x)
+{
+    if (x == 0)
+        return ~0u;
+    std::uint32_t i = 31;
+    while ((x & 0x80000000u) == 0)
+    {
+        x <<= 1;
+        --i;
+    }
+    return i;
+}
+
+static std::uint32_t BitFieldExtract(std::uint32_t base, std::uint32_t offset, std::uint32_t count, bool signExtend)
+{
+    offset = std::min(offset, 32u);
+    count = std::min(count, 32u - offset);
+    if (count == 0)
+        return 0;
+    const std::uint32_t bits = (base << (32u - offset - count));
+    if (signExtend)
+        return static_cast<std::uint32_t>(AsInt(bits) >> (32u - count));
+    else
+        return (bits >> (32u - count));
+}
+
+static std::uint32_t SDiv(std::int32_t a, std::int32_t b)
+{
+    if (b == 0)
+        return 0;
+    if (a == std::numeric_limits<std::int32_t>::min() && b == -1)
+        return static_cast<std::uint32_t>(a);
+    return static_cast<std::uint32_t>(a / b);
+}
+
+static std::uint32_t SRem(std::int32_t a, std::int32_t b)
+{
+    if (b == 0 || b == -1)
+        return 0;
+    return static_cast<std::uint32_t>(a % b);
+}
+
+static std::uint32_t SMod(std::int32_t a, std::int32_t b)
+{
+    std::int32_t r = AsInt(SRem(a, b));
+    if (r != 0 && ((r < 0) != (b < 0)))
+        r += b;
+    return static_cast<std::uint32_t>(r);
+}
+
+static float FClamp(float x, float minVal, float maxVal)
+{
+    return std::fmin(std::fmax(x, minVal), maxVal);
+}
+
+
+/*
+ * Componentwise operations
+ */
+
+template <typename TFunc>
+static void UnaryOp(std::uint32_t* regs, const NullComputeInstr& instr, TFunc func)
+{
+    for_range(i, instr.n)
+        regs[instr.dst + i] = func(regs[instr.a + i]);
+}
+
+template <typename TFunc>
+static void BinaryOp(std::uint32_t* regs, const NullComputeInstr& instr, TFunc func)
+{
+    for_range(i, instr.n)
+        regs[instr.dst + i] = func(regs[instr.a + i], regs[instr.b + i]);
+}
+
+template <typename TFunc>
+static void TernaryOp(std::uint32_t* regs, const NullComputeInstr& instr, TFunc func)
+{
+    for_range(i, instr.n)
+        regs[instr.dst + i] = func(regs[instr.a + i], regs[instr.b + i], regs[instr.c + i]);
+}
+
+template <typename TFunc>
+static void UnaryFloatOp(std::uint32_t* regs, const NullComputeInstr& instr, TFunc func)
+{
+    for_range(i, instr.n)
+        regs[instr.dst + i] = AsUInt(func(AsFloat(regs[instr.a + i])));
+}
+
+template <typename TFunc>
+static void BinaryFloatOp(std::uint32_t* regs, const NullComputeInstr& instr, TFunc func)
+{
+    for_range(i, instr.n)
+        regs[instr.dst + i] = AsUInt(func(AsFloat(regs[instr.a + i]), AsFloat(regs[instr.b + i])));
+}
+
+template <typename TFunc>
+static void TernaryFloatOp(std::uint32_t* regs, const NullComputeInstr& instr, TFunc func)
+{
+    for_range(i, instr.n)
+        regs[instr.dst + i] = AsUInt(func(AsFloat(regs[instr.a + i]), AsFloat(regs[instr.b + i]), AsFloat(regs[instr.c + i])));
+}
+
+template <typename TFunc>
+static void CompareFloatOp(std::uint32_t* regs, const NullComputeInstr& instr, bool ordered, TFunc func)
+{
+    for_range(i, instr.n)
+    {
+        const float a = AsFloat(regs[instr.a + i]);
+        const float b = AsFloat(regs[instr.b + i]);
+        const bool unordered = (std::isnan(a) || std::isnan(b));
+        regs[instr.dst + i] = (unordered ? !ordered : func(a, b)) ? 1u : 0u;
+    }
+}
+
+static float Length(const std::uint32_t* v, std::uint32_t n)
+{
+    float sum = 0.0f;
+    for_range(i, n)
+        sum += AsFloat(v[i]) * AsFloat(v[i]);
+    return std::sqrt(sum);
+}
+
+
+/*
+ * Pointers and handles
+ */
+
+static inline NullComputePointer ReadPointer(const std::uint32_t* regs)
+{
+    NullComputePointer ptr;
+    ::memcpy(&ptr, regs, sizeof(ptr));
+    return ptr;
+}
+
+static inline void WritePointer(std::uint32_t* regs, const NullComputePointer& ptr)
+{
+    ::memcpy(regs, &ptr, sizeof(ptr));
+}
+
+static inline void WritePointer(std::uint32_t* regs, void* begin, std::size_t size)
+{
+    char* addr = reinterpret_cast<char*>(begin);
+    WritePointer(regs, NullComputePointer{ addr, addr + size });
+}
+
+// Returns the address of the pointer if the specified number of bytes is in bounds, or null otherwise.
+static inline char* Deref(const NullComputePointer& ptr, std::size_t size)
+{
+    return (ptr.addr != nullptr && size <= static_cast<std::size_t>(ptr.end - ptr.addr) ? ptr.addr : nullptr);
+}
+
+static inline std::atomic<std::uint32_t>* DerefAtomic(const std::uint32_t* regs)
+{
+    return reinterpret_cast<std::atomic<std::uint32_t>*>(Deref(ReadPointer(regs), sizeof(std::uint32_t)));
+}
+
+static inline const NullComputeImage* ReadImageHandle(const std::uint32_t* regs)
+{
+    const NullComputeImage* image;
+    ::memcpy(&image, regs, sizeof(image));
+    return image;
+}
+
+static inline const NullSampler* ReadSamplerHandle(const std::uint32_t* regs)
+{
+    const NullSampler* sampler;
+    ::memcpy(&sampler, regs, sizeof(sampler));
+    return sampler;
+}
+
+// Advances the pointer by the specified number of bytes. The pointer becomes invalid if it leaves its range.
+static inline void AdvancePointer(NullComputePointer& ptr, std::uint64_t offset)
+{
+    if (ptr.addr != nullptr && offset <= static_cast<std::uint64_t>(ptr.end - ptr.addr))
+        ptr.addr += static_cast<std::size_t>(offset);
+    else
+        ptr.addr = nullptr;
+}
+
+static void AccessChain(std::uint32_t* regs, const NullComputeInstr& instr, const std::uint32_t* params)
+{
+    NullComputePointer ptr = ReadPointer(regs + instr.a);
+
+    for_range(i, instr.c)
+    {
+        const std::uint32_t* step = params + instr.b + i * 4;
+        switch (static_cast<NullComputeAccessStep>(step[0]))
+        {
+            case NullComputeAccessStep::Offset:
+                AdvancePointer(ptr, static_cast<std::uint64_t>(step[1]) * 4);
+                break;
+
+            case NullComputeAccessStep::Index:
+            {
+                const std::uint32_t index = regs[step[1]];
+                if (index < step[3])
+                    AdvancePointer(ptr, static_cast<std::uint64_t>(index) * step[2] * 4);
+                else
+                    ptr.addr = nullptr;
+            }
+            break;
+
+            case NullComputeAccessStep::RuntimeIndex:
+                AdvancePointer(ptr, static_cast<std::uint64_t>(regs[step[1]]) * step[2] * 4);
+                break;
+        }
+    }
+
+    WritePointer(regs + instr.dst, ptr);
+}
+
+
+/*
+ * Image texels
+ */
+
+// Returns the number of components stored in the image format and their mapping to RGBA indices.
+static std::uint32_t GetComponentMapping(const ImageFormat format, int (&outMapping)[4])
+{
+    static const int mappings[][4] =
+    {
+        { 3, 0, 0, 0 }, // Alpha
+        { 0, 0, 0, 0 }, // R, Depth
+        { 0, 1, 0, 0 }, // RG
+        { 0, 1, 2, 0 }, // RGB
+        { 2, 1, 0, 0 }, // BGR
+        { 0, 1, 2, 3 }, // RGBA
+        { 2, 1, 0, 3 }, // BGRA
+        { 3, 0, 1, 2 }, // ARGB
+        { 3, 2, 1, 0 }, // ABGR
+    };
+
+    int index = 0;
+    std::uint32_t numComponents = 0;
+
+    switch (format)
+    {
+        case ImageFormat::Alpha:    index = 0; numComponents = 1; break;
+        case ImageFormat::R:        index = 1; numComponents = 1; break;
+        case ImageFormat::Depth:    index = 1; numComponents = 1; break;
+        case ImageFormat::RG:       index = 2; numComponents = 2; break;
+        case ImageFormat::RGB:      index = 3; numComponents = 3; break;
+        case ImageFormat::BGR:      index = 4; numComponents = 3; break;
+        case ImageFormat::RGBA:     index = 5; numComponents = 4; break;
+        case ImageFormat::BGRA:     index = 6; numComponents = 4; break;
+        case ImageFormat::ARGB:     index = 7; numComponents = 4; break;
+        case ImageFormat::ABGR:     index = 8; numComponents = 4; break;
+        default:                    return 0;
+    }
+
+    ::memcpy(outMapping, mappings[index], sizeof(outMapping));
+    return numComponents;
+}
+
+// Converts a value of the specified scalar type into a float.
+static float ScalarToFloat(std::uint32_t value, const NullComputeScalar scalar)
+{
+    switch (scalar)
+    {
+        case NullComputeScalar::Float:  return AsFloat(value);
+        case NullComputeScalar::SInt:   return static_cast<float>(AsInt(value));
+        default:                        return static_cast<float>(value);
+    }
+}
+
+// Converts a float into a value of the specified scalar type.
+static std::uint32_t FloatToScalar(float value, const NullComputeScalar scalar)
+{
+    switch (scalar)
+    {
+        case NullComputeScalar::Float:  return AsUInt(value);
+        case NullComputeScalar::SInt:   return static_cast<std::uint32_t>(FloatToSInt(value));
+        default:                        return FloatToUInt(value);
+    }
+}
+
+// Converts an integer into a value of the specified scalar type.
+static std::uint32_t IntToScalar(std::int64_t value, const NullComputeScalar scalar)
+{
+    if (scalar == NullComputeScalar::Float)
+        return AsUInt(static_cast<float>(value));
+    return static_cast<std::uint32_t>(value);
+}
+
+// Converts a value of the specified scalar type into an integer.
+static std::int64_t ScalarToInt(std::uint32_t value, const NullComputeScalar scalar)
+{
+    switch (scalar)
+    {
+        case NullComputeScalar::Float:  return FloatToSInt(AsFloat(value));
+        case NullComputeScalar::SInt:   return AsInt(value);
+        default:                        return value;
+    }
+}
+
+template <typename T>
+static T ReadComponent(const char* src)
+{
+    T value;
+    ::memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+template <typename T>
+static void WriteComponent(char* dst, T value)
+{
+    ::memcpy(dst, &value, sizeof(value));
+}
+
+template <typename T>
+static float NormalizeComponent(T value)
+{
+    const float maxValue = static_cast<float>(std::numeric_limits<T>::max());
+    return std::max(static_cast<float>(value) / maxValue, -1.0f);
+}
+
+template <typename T>
+static T DenormalizeComponent(float value)
+{
+    const float minValue = (std::numeric_limits<T>::is_signed ? -1.0f : 0.0f);
+    return static_cast<T>(std::round(FClamp(value, minValue, 1.0f) * static_cast<float>(std::numeric_limits<T>::max())));
+}
+
+static std::uint32_t DecodeComponent(const char* src, const DataType dataType, bool normalized, const NullComputeScalar scalar)
+{
+    switch (dataType)
+    {
+        case DataType::Int8:
+            return (normalized ? FloatToScalar(NormalizeComponent(ReadComponent<std::int8_t>(src)), scalar) : IntToScalar(ReadComponent<std::int8_t>(src), scalar));
+        case DataType::UInt8:
+            return (normalized ? FloatToScalar(NormalizeComponent(ReadComponent<std::uint8_t>(src)), scalar) : IntToScalar(ReadComponent<std::uint8_t>(src), scalar));
+        case DataType::Int16:
+            return (normalized ? FloatToScalar(NormalizeComponent(ReadComponent<std::int16_t>(src)), scalar) : IntToScalar(ReadComponent<std::int16_t>(src), scalar));
+        case DataType::UInt16:
+            return (normalized ? FloatToScalar(NormalizeComponent(ReadComponent<std::uint16_t>(src)), scalar) : IntToScalar(ReadComponent<std::uint16_t>(src), scalar));
+        case DataType::Int32:
+            return IntToScalar(ReadComponent<std::int32_t>(src), scalar);
+        case DataType::UInt32:
+            return IntToScalar(ReadComponent<std::uint32_t>(src), scalar);
+        case DataType::Float16:
+            return FloatToScalar(DecompressFloat16(ReadComponent<std::uint16_t>(src)), scalar);
+        case DataType::Float32:
+            return FloatToScalar(ReadComponent<float>(src), scalar);
+        default:
+            return 0;
+    }
+}
+
+static void EncodeComponent(char* dst, const DataType dataType, bool normalized, std::uint32_t value, const NullComputeScalar scalar)
+{
+    switch (dataType)
+    {
+        case DataType::Int8:
+            if (normalized)
+                WriteComponent(dst, DenormalizeComponent<std::int8_t>(ScalarToFloat(value, scalar)));
+            else
+                WriteComponent(dst, static_cast<std::int8_t>(ScalarToInt(value, scalar)));
+            break;
+        case DataType::UInt8:
+            if (normalized)
+                WriteComponent(dst, DenormalizeComponent<std::uint8_t>(ScalarToFloat(value, scalar)));
+            else
+                WriteComponent(dst, static_cast<std::uint8_t>(ScalarToInt(value, scalar)));
+            break;
+        case DataType::Int16:
+            if (normalized)
+                WriteComponent(dst, DenormalizeComponent<std::int16_t>(ScalarToFloat(value, scalar)));
+            else
+                WriteComponent(dst, static_cast<std::int16_t>(ScalarToInt(value, scalar)));
+            break;
+        case DataType::UInt16:
+            if (normalized)
+                WriteComponent(dst, DenormalizeComponent<std::uint16_t>(ScalarToFloat(value, scalar)));
+            else
+                WriteComponent(dst, static_cast<std::uint16_t>(ScalarToInt(value, scalar)));
+            break;
+        case DataType::Int32:
+        case DataType::UInt32:
+            WriteComponent(dst, static_cast<std::uint32_t>(ScalarToInt(value, scalar)));
+            break;
+        case DataType::Float16:
+            WriteComponent(dst, CompressFloat16(ScalarToFloat(value, scalar)));
+            break;
+        case DataType::Float32:
+            WriteComponent(dst, ScalarToFloat(value, scalar));
+            break;
+        default:
+            break;
+    }
+}
+
+// Returns the address of the texel at the specified coordinate, or null if the coordinate is out of bounds.
+static char* GetTexelAddress(const NullComputeImage& image, std::uint32_t mipLevel, const std::uint32_t* coords, std::uint32_t numCoords)
+{
+    if (mipLevel >= image.numMipLevels)
+        return nullptr;
+
+    std::int64_t pos[3] =
+    {
+        AsInt(coords[0]),
+        (numCoords > 1 ? AsInt(coords[1]) : 0),
+        (numCoords > 2 ? AsInt(coords[2]) : 0),
+    };
+
+    /* Map array layer of the texture view onto the image axis the layers are stored along */
+    if (image.layerAxis < 3)
+    {
+        if (pos[image.layerAxis] < 0 || pos[image.layerAxis] >= image.numArrayLayers)
+            return nullptr;
+        pos[image.layerAxis] += image.baseArrayLayer;
+    }
+
+    const std::uint32_t textureMipLevel = image.baseMipLevel + mipLevel;
+    const Extent3D& extent = image.texture->GetMipImageExtent(textureMipLevel);
+    if (pos[0] < 0 || pos[0] >= extent.width  ||
+        pos[1] < 0 || pos[1] >= extent.height ||
+        pos[2] < 0 || pos[2] >= extent.depth)
+    {
+        return nullptr;
+    }
+
+    return image.texture->GetTexelPtr(
+        textureMipLevel,
+        static_cast<std::uint32_t>(pos[0]),
+        static_cast<std::uint32_t>(pos[1]),
+        static_cast<std::uint32_t>(pos[2])
+    );
+}
+
+static void ReadTexel(const NullComputeImage* image, std::uint32_t mipLevel, const std::uint32_t* coords, std::uint32_t numCoords, const NullComputeScalar scalar, std::uint32_t (&outTexel)[4])
+{
+    /* Initialize texel with default values for missing components */
+    const std::uint32_t one = (scalar == NullComputeScalar::Float ? AsUInt(1.0f) : 1u);
+    outTexel[0] = 0;
+    outTexel[1] = 0;
+    outTexel[2] = 0;
+    outTexel[3] = one;
+
+    if (image == nullptr)
+        return;
+
+    const char* src = GetTexelAddress(*image, mipLevel, coords, numCoords);
+    if (src == nullptr)
+        return;
+
+    int mapping[4];
+    const FormatAttributes& attribs = *(image->formatAttribs);
+    const std::uint32_t numComponents = GetComponentMapping(attribs.format, mapping);
+    const std::size_t componentSize = DataTypeSize(attribs.dataType);
+    const bool normalized = ((attribs.flags & FormatFlags::IsNormalized) != 0);
+
+    for_range(i, numComponents)
+        outTexel[mapping[i]] = DecodeComponent(src + i * componentSize, attribs.dataType, normalized, scalar);
+}
+
+static void WriteTexel(const NullComputeImage* image, const std::uint32_t* coords, std::uint32_t numCoords, const std::uint32_t* texel, std::uint32_t numTexelComponents, const NullComputeScalar scalar)
+{
+    if (image == nullptr)
+        return;
+
+    char* dst = GetTexelAddress(*image, 0, coords, numCoords);
+    if (dst == nullptr)
+        return;
+
+    /* Fill missing components of the input texel with default values */
+    std::uint32_t rgba[4] = { 0, 0, 0, (scalar == NullComputeScalar::Float ? AsUInt(1.0f) : 1u) };
+    ::memcpy(rgba, texel, std::min(numTexelComponents, 4u) * sizeof(std::uint32_t));
+
+    int mapping[4];
+    const FormatAttributes& attribs = *(image->formatAttribs);
+    const std::uint32_t numComponents = GetComponentMapping(attribs.format, mapping);
+    const std::size_t componentSize = DataTypeSize(attribs.dataType);
+    const bool normalized = ((attribs.flags & FormatFlags::IsNormalized) != 0);
+
+    for_range(i, numComponents)
+        EncodeComponent(dst + i * componentSize, attribs.dataType, normalized, rgba[mapping[i]], scalar);
+}
+
+static void QueryImageSize(const NullComputeImage* image, std::uint32_t mipLevel, std::uint32_t* dst, std::uint32_t numComponents)
+{
+    std::uint32_t size[3] = { 0, 0, 0 };
+
+    if (image != nullptr && mipLevel < image->numMipLevels)
+    {
+        const Extent3D& extent = image->texture->GetMipImageExtent(image->baseMipLevel + mipLevel);
+        size[0] = extent.width;
+        size[1] = extent.height;
+        size[2] = extent.depth;
+
+        /* Replace layer component by number of array layers of the texture view */
+        if (image->layerAxis < 3)
+            size[image->layerAxis] = (image->type == TextureType::TextureCubeArray ? image->numArrayLayers / 6 : image->numArrayLayers);
+    }
+
+    ::memcpy(dst, size, std::min(numComponents, 3u) * sizeof(std::uint32_t));
+}
+
+// Samples the image of a combined image-sampler handle. Unbound samplers sample with the default sampler state.
+static void SampleImage(const std::uint32_t* regs, const NullComputeInstr& instr, const std::uint32_t* params, std::uint32_t (&outTexel)[4])
+{
+    static const NullSampler defaultSampler{ SamplerDescriptor{} };
+
+    float color[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+    if (const NullComputeImage* image = ReadImageHandle(regs + instr.a))
+    {
+        const NullSampler* sampler = ReadSamplerHandle(regs + instr.a + NullComputeProgram::handleWords);
+        if (sampler == nullptr)
+            sampler = &defaultSampler;
+
+        const NullSamplerImage samplerImage
+        {
+            image->texture,
+            image->type,
+            image->formatAttribs,
+            image->baseMipLevel,
+            image->numMipLevels,
+            image->baseArrayLayer,
+            image->numArrayLayers,
+        };
+
+        /* Coordinates are padded with zeros, since the sampler reads as many components as the view type requires */
+        float coords[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        ::memcpy(coords, regs + instr.b, std::min<std::uint32_t>(instr.n & 0xFF, 4u) * sizeof(float));
+
+        /* Read optional operands: { lod, bias, ddx, ddy, dref } */
+        const std::uint32_t* operands = params + instr.c;
+        float operandValues[3][4] = {};
+        auto ReadOperand = [regs, operands](int index, float* dst, std::uint32_t count) -> bool
+        {
+            if (operands[index] == NullComputeProgram::invalidRegister)
+                return false;
+            ::memcpy(dst, regs + operands[index], count * sizeof(float));
+            return true;
+        };
+
+        const float* compareRef = (ReadOperand(4, operandValues[0], 1) ? operandValues[0] : nullptr);
+
+        if (ReadOperand(2, operandValues[1], 3) && ReadOperand(3, operandValues[2], 3))
+            sampler->SampleGrad(samplerImage, coords, operandValues[1], operandValues[2], compareRef, color);
+        else
+        {
+            /* Without derivatives, the LOD bias of implicit LOD samples is applied to the base level */
+            float lod = 0.0f, bias = 0.0f;
+            ReadOperand(0, &lod, 1);
+            ReadOperand(1, &bias, 1);
+            sampler->SampleLod(samplerImage, coords, lod + bias, compareRef, color);
+        }
+    }
+
+    switch (static_cast<NullComputeScalar>(instr.type))
+    {
+        case NullComputeScalar::SInt:
+            for_range(i, 4)
+                outTexel[i] = static_cast<std::uint32_t>(static_cast<std::int32_t>(color[i]));
+            break;
+        case NullComputeScalar::UInt:
+            for_range(i, 4)
+                outTexel[i] = static_cast<std::uint32_t>(std::max(color[i], 0.0f));
+            break;
+        default:
+            ::memcpy(outTexel, color, sizeof(color));
+            break;
+    }
+}
+
+
+/*
+ * Interpreter loop
+ */
+
+// Executes a single instruction that does not alter the control flow.
+static inline void ExecuteInstr(std::uint32_t* regs, const NullComputeInstr& instr, const std::uint32_t* params)
+{
+    switch (instr.op)
+    {
+        /* ----- Data movement ----- */
+
+        case NullComputeOp::Nop:
+            break;
+
+        case NullComputeOp::Copy:
+            ::memmove(regs + instr.dst, regs + instr.a, instr.n * sizeof(std::uint32_t));
+            break;
+
+        case NullComputeOp::Load:
+        {
+            const std::size_t size = instr.n * sizeof(std::uint32_t);
+            if (const char* src = Deref(ReadPointer(regs + instr.a), size))
+                ::memcpy(regs + instr.dst, src, size);
+            else
+                ::memset(regs + instr.dst, 0, size);
+        }
+        break;
+
+        case NullComputeOp::Store:
+        {
+            const std::size_t size = instr.n * sizeof(std::uint32_t);
+            if (char* dst = Deref(ReadPointer(regs + instr.a), size))
+                ::memcpy(dst, regs + instr.b, size);
+        }
+        break;
+
+        case NullComputeOp::CopyMemory:
+        {
+            const std::size_t size = instr.n * sizeof(std::uint32_t);
+            if (char* dst = Deref(ReadPointer(regs + instr.a), size))
+            {
+                if (const char* src = Deref(ReadPointer(regs + instr.b), size))
+                    ::memmove(dst, src, size);
+                else
+                    ::memset(dst, 0, size);
+            }
+        }
+        break;
+
+        case NullComputeOp::AccessChain:
+            AccessChain(regs, instr, params);
+            break;
+
+        case NullComputeOp::ArrayLength:
+        {
+            const NullComputePointer ptr = ReadPointer(regs + instr.a);
+            const std::size_t size = (ptr.addr != nullptr ? static_cast<std::size_t>(ptr.end - ptr.addr) : 0);
+            const std::size_t offset = instr.b * sizeof(std::uint32_t);
+            regs[instr.dst] = (size > offset ? static_cast<std::uint32_t>((size - offset) / (instr.c * sizeof(std::uint32_t))) : 0u);
+        }
+        break;
+
+        case NullComputeOp::ExtractDynamic:
+        {
+            const std::uint32_t index = regs[instr.b];
+            regs[instr.dst] = (index < instr.n ? regs[instr.a + index] : 0u);
+        }
+        break;
+
+        case NullComputeOp::InsertDynamic:
+        {
+            const std::uint32_t index = regs[instr.c];
+            ::memmove(regs + instr.dst, regs + instr.a, instr.n * sizeof(std::uint32_t));
+            if (index < instr.n)
+                regs[instr.dst + index] = regs[instr.b];
+        }
+        break;
+
+        /* ----- Integer arithmetic ----- */
+
+        case NullComputeOp::IAdd:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return a + b; });
+            break;
+        case NullComputeOp::ISub:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return a - b; });
+            break;
+        case NullComputeOp::IMul:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return a * b; });
+            break;
+        case NullComputeOp::SDiv:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return SDiv(AsInt(a), AsInt(b)); });
+            break;
+        case NullComputeOp::UDiv:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return (b != 0 ? a / b : 0u); });
+            break;
+        case NullComputeOp::SRem:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return SRem(AsInt(a), AsInt(b)); });
+            break;
+        case NullComputeOp::SMod:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return SMod(AsInt(a), AsInt(b)); });
+            break;
+        case NullComputeOp::UMod:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return (b != 0 ? a % b : 0u); });
+            break;
+        case NullComputeOp::SNegate:
+            UnaryOp(regs, instr, [](std::uint32_t a) { return 0u - a; });
+            break;
+        case NullComputeOp::ShiftLeftLogical:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return a << (b & 31u); });
+            break;
+        case NullComputeOp::ShiftRightLogical:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return a >> (b & 31u); });
+            break;
+        case NullComputeOp::ShiftRightArithmetic:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return static_cast<std::uint32_t>(AsInt(a) >> (b & 31u)); });
+            break;
+        case NullComputeOp::BitwiseAnd:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return a & b; });
+            break;
+        case NullComputeOp::BitwiseOr:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return a | b; });
+            break;
+        case NullComputeOp::BitwiseXor:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return a ^ b; });
+            break;
+        case NullComputeOp::Not:
+            UnaryOp(regs, instr, [](std::uint32_t a) { return ~a; });
+            break;
+        case NullComputeOp::BitCount:
+            UnaryOp(regs, instr, BitCount);
+            break;
+        case NullComputeOp::BitReverse:
+            UnaryOp(regs, instr, BitReverse);
+            break;
+        case NullComputeOp::BitFieldSExtract:
+            TernaryOp(regs, instr, [](std::uint32_t base, std::uint32_t offset, std::uint32_t count) { return BitFieldExtract(base, offset, count, true); });
+            break;
+        case NullComputeOp::BitFieldUExtract:
+            TernaryOp(regs, instr, [](std::uint32_t base, std::uint32_t offset, std::uint32_t count) { return BitFieldExtract(base, offset, count, false); });
+            break;
+        case NullComputeOp::SAbs:
+            UnaryOp(regs, instr, [](std::uint32_t a) { return (AsInt(a) < 0 ? 0u - a : a); });
+            break;
+        case NullComputeOp::SSign:
+            UnaryOp(regs, instr, [](std::uint32_t a) { return static_cast<std::uint32_t>(AsInt(a) > 0 ? 1 : AsInt(a) < 0 ? -1 : 0); });
+            break;
+        case NullComputeOp::SMin:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return (AsInt(a) < AsInt(b) ? a : b); });
+            break;
+        case NullComputeOp::SMax:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return (AsInt(a) > AsInt(b) ? a : b); });
+            break;
+        case NullComputeOp::UMin:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return std::min(a, b); });
+            break;
+        case NullComputeOp::UMax:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return std::max(a, b); });
+            break;
+        case NullComputeOp::SClamp:
+            TernaryOp(regs, instr, [](std::uint32_t x, std::uint32_t lo, std::uint32_t hi) { return static_cast<std::uint32_t>(std::min(std::max(AsInt(x), AsInt(lo)), AsInt(hi))); });
+            break;
+        case NullComputeOp::UClamp:
+            TernaryOp(regs, instr, [](std::uint32_t x, std::uint32_t lo, std::uint32_t hi) { return std::min(std::max(x, lo), hi); });
+            break;
+        case NullComputeOp::FindILsb:
+            UnaryOp(regs, instr, FindLsb);
+            break;
+        case NullComputeOp::FindSMsb:
+            UnaryOp(regs, instr, [](std::uint32_t a) { return FindMsb(AsInt(a) < 0 ? ~a : a); });
+            break;
+        case NullComputeOp::FindUMsb:
+            UnaryOp(regs, instr, FindMsb);
+            break;
+
+        /* ----- Integer and boolean comparison ----- */
+
+        case NullComputeOp::IEqual:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return (a == b ? 1u : 0u); });
+            break;
+        case NullComputeOp::INotEqual:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return (a != b ? 1u : 0u); });
+            break;
+        case NullComputeOp::SLessThan:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return (AsInt(a) < AsInt(b) ? 1u : 0u); });
+            break;
+        case NullComputeOp::SLessThanEqual:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return (AsInt(a) <= AsInt(b) ? 1u : 0u); });
+            break;
+        case NullComputeOp::SGreaterThan:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return (AsInt(a) > AsInt(b) ? 1u : 0u); });
+            break;
+        case NullComputeOp::SGreaterThanEqual:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return (AsInt(a) >= AsInt(b) ? 1u : 0u); });
+            break;
+        case NullComputeOp::ULessThan:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return (a < b ? 1u : 0u); });
+            break;
+        case NullComputeOp::ULessThanEqual:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return (a <= b ? 1u : 0u); });
+            break;
+        case NullComputeOp::UGreaterThan:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return (a > b ? 1u : 0u); });
+            break;
+        case NullComputeOp::UGreaterThanEqual:
+            BinaryOp(regs, instr, [](std::uint32_t a, std::uint32_t b) { return (a >= b ? 1u : 0u); });
+            break;
+        case NullComputeOp::LogicalNot:
+            UnaryOp(regs, instr, [](std::uint32_t a) { return (a == 0 ? 1u : 0u); });
+            break;
+
+        case NullComputeOp::Any:
+        case NullComputeOp::All:
+        {
+            std::uint32_t numTrue = 0;
+            for_range(i, instr.n)
+                numTrue += (regs[instr.a + i] != 0 ? 1u : 0u);
+            regs[instr.dst] = (instr.op == NullComputeOp::Any ? numTrue > 0 : numTrue == instr.n) ? 1u : 0u;
+        }
+        break;
+
+        /* ----- Floating-point arithmetic ----- */
+
+        case NullComputeOp::FAdd:
+            BinaryFloatOp(regs, instr, [](float a, float b) { return a + b; });
+            break;
+        case NullComputeOp::FSub:
+            BinaryFloatOp(regs, instr, [](float a, float b) { return a - b; });
+            break;
+        case NullComputeOp::FMul:
+            BinaryFloatOp(regs, instr, [](float a, float b) { return a * b; });
+            break;
+        case NullComputeOp::FDiv:
+            BinaryFloatOp(regs, instr, [](float a, float b) { return a / b; });
+            break;
+        case NullComputeOp::FRem:
+            BinaryFloatOp(regs, instr, [](float a, float b) { return std::fmod(a, b); });
+            break;
+        case NullComputeOp::FMod:
+            BinaryFloatOp(regs, instr, [](float a, float b) { return a - b * std::floor(a / b); });
+            break;
+        case NullComputeOp::FNegate:
+            UnaryFloatOp(regs, instr, [](float a) { return -a; });
+            break;
+
+        case NullComputeOp::VectorTimesScalar:
+        {
+            const float s = AsFloat(regs[instr.b]);
+            for_range(i, instr.n)
+                regs[instr.dst + i] = AsUInt(AsFloat(regs[instr.a + i]) * s);
+        }
+        break;
+
+        case NullComputeOp::Dot:
+        {
+            float sum = 0.0f;
+            for_range(i, instr.n)
+                sum += AsFloat(regs[instr.a + i]) * AsFloat(regs[instr.b + i]);
+            regs[instr.dst] = AsUInt(sum);
+        }
+        break;
+
+        case NullComputeOp::MatrixTimesVector:
+        {
+            for_range(row, instr.n)
+            {
+                float sum = 0.0f;
+                for_range(col, instr.c)
+                    sum += AsFloat(regs[instr.a + col * instr.n + row]) * AsFloat(regs[instr.b + col]);
+                regs[instr.dst + row] = AsUInt(sum);
+            }
+        }
+        break;
+
+        case NullComputeOp::VectorTimesMatrix:
+        {
+            for_range(col, instr.n)
+            {
+                float sum = 0.0f;
+                for_range(row, instr.c)
+                    sum += AsFloat(regs[instr.a + row]) * AsFloat(regs[instr.b + col * instr.c + row]);
+                regs[instr.dst + col] = AsUInt(sum);
+            }
+        }
+        break;
+
+        case NullComputeOp::MatrixTimesMatrix:
+        {
+            const std::uint32_t rows = instr.n;
+            const std::uint32_t colsA = (instr.c & 0xFFFF);
+            const std::uint32_t colsB = (instr.c >> 16);
+            for_range(col, colsB)
+            {
+                for_range(row, rows)
+                {
+                    float sum = 0.0f;
+                    for_range(k, colsA)
+                        sum += AsFloat(regs[instr.a + k * rows + row]) * AsFloat(regs[instr.b + col * colsA + k]);
+                    regs[instr.dst + col * rows + row] = AsUInt(sum);
+                }
+            }
+        }
+        break;
+
+        /* ----- Floating-point comparison ----- */
+
+        case NullComputeOp::FOrdEqual:
+            CompareFloatOp(regs, instr, true, [](float a, float b) { return a == b; });
+            break;
+        case NullComputeOp::FOrdNotEqual:
+            CompareFloatOp(regs, instr, true, [](float a, float b) { return a != b; });
+            break;
+        case NullComputeOp::FOrdLessThan:
+            CompareFloatOp(regs, instr, true, [](float a, float b) { return a < b; });
+            break;
+        case NullComputeOp::FOrdLessThanEqual:
+            CompareFloatOp(regs, instr, true, [](float a, float b) { return a <= b; });
+            break;
+        case NullComputeOp::FOrdGreaterThan:
+            CompareFloatOp(regs, instr, true, [](float a, float b) { return a > b; });
+            break;
+        case NullComputeOp::FOrdGreaterThanEqual:
+            CompareFloatOp(regs, instr, true, [](float a, float b) { return a >= b; });
+            break;
+        case NullComputeOp::FUnordEqual:
+            CompareFloatOp(regs, instr, false, [](float a, float b) { return a == b; });
+            break;
+        case NullComputeOp::FUnordNotEqual:
+            CompareFloatOp(regs, instr, false, [](float a, float b) { return a != b; });
+            break;
+        case NullComputeOp::FUnordLessThan:
+            CompareFloatOp(regs, instr, false, [](float a, float b) { return a < b; });
+            break;
+        case NullComputeOp::FUnordLessThanEqual:
+            CompareFloatOp(regs, instr, false, [](float a, float b) { return a <= b; });
+            break;
+        case NullComputeOp::FUnordGreaterThan:
+            CompareFloatOp(regs, instr, false, [](float a, float b) { return a > b; });
+            break;
+        case NullComputeOp::FUnordGreaterThanEqual:
+            CompareFloatOp(regs, instr, false, [](float a, float b) { return a >= b; });
+            break;
+        case NullComputeOp::IsNan:
+            UnaryOp(regs, instr, [](std::uint32_t a) { return (std::isnan(AsFloat(a)) ? 1u : 0u); });
+            break;
+        case NullComputeOp::IsInf:
+            UnaryOp(regs, instr, [](std::uint32_t a) { return (std::isinf(AsFloat(a)) ? 1u : 0u); });
+            break;
+
+        /* ----- Conversion and selection ----- */
+
+        case NullComputeOp::ConvertFToS:
+            UnaryOp(regs, instr, [](std::uint32_t a) { return static_cast<std::uint32_t>(FloatToSInt(AsFloat(a))); });
+            break;
+        case NullComputeOp::ConvertFToU:
+            UnaryOp(regs, instr, [](std::uint32_t a) { return FloatToUInt(AsFloat(a)); });
+            break;
+        case NullComputeOp::ConvertSToF:
+            UnaryOp(regs, instr, [](std::uint32_t a) { return AsUInt(static_cast<float>(AsInt(a))); });
+            break;
+        case NullComputeOp::ConvertUToF:
+            UnaryOp(regs, instr, [](std::uint32_t a) { return AsUInt(static_cast<float>(a)); });
+            break;
+        case NullComputeOp::Select:
+            TernaryOp(regs, instr, [](std::uint32_t cond, std::uint32_t a, std::uint32_t b) { return (cond != 0 ? a : b); });
+            break;
+        case NullComputeOp::SelectScalar:
+            ::memmove(regs + instr.dst, regs + (regs[instr.a] != 0 ? instr.b : instr.c), instr.n * sizeof(std::uint32_t));
+            break;
+
+        /* ----- Extended instructions ----- */
+
+        case NullComputeOp::Round:
+            UnaryFloatOp(regs, instr, [](float a) { return std::round(a); });
+            break;
+        case NullComputeOp::RoundEven:
+            UnaryFloatOp(regs, instr, [](float a) { return std::nearbyint(a); });
+            break;
+        case NullComputeOp::Trunc:
+            UnaryFloatOp(regs, instr, [](float a) { return std::trunc(a); });
+            break;
+        case NullComputeOp::FAbs:
+            UnaryFloatOp(regs, instr, [](float a) { return std::fabs(a); });
+            break;
+        case NullComputeOp::FSign:
+            UnaryFloatOp(regs, instr, [](float a) { return (a > 0.0f ? 1.0f : a < 0.0f ? -1.0f : 0.0f); });
+            break;
+        case NullComputeOp::Floor:
+            UnaryFloatOp(regs, instr, [](float a) { return std::floor(a); });
+            break;
+        case NullComputeOp::Ceil:
+            UnaryFloatOp(regs, instr, [](float a) { return std::ceil(a); });
+            break;
+        case NullComputeOp::Fract:
+            UnaryFloatOp(regs, instr, [](float a) { return a - std::floor(a); });
+            break;
+        case NullComputeOp::Sqrt:
+            UnaryFloatOp(regs, instr, [](float a) { return std::sqrt(a); });
+            break;
+        case NullComputeOp::InverseSqrt:
+            UnaryFloatOp(regs, instr, [](float a) { return 1.0f / std::sqrt(a); });
+            break;
+        case NullComputeOp::Sin:
+            UnaryFloatOp(regs, instr, [](float a) { return std::sin(a); });
+            break;
+        case NullComputeOp::Cos:
+            UnaryFloatOp(regs, instr, [](float a) { return std::cos(a); });
+            break;
+        case NullComputeOp::Tan:
+            UnaryFloatOp(regs, instr, [](float a) { return std::tan(a); });
+            break;
+        case NullComputeOp::Asin:
+            UnaryFloatOp(regs, instr, [](float a) { return std::asin(a); });
+            break;
+        case NullComputeOp::Acos:
+            UnaryFloatOp(regs, instr, [](float a) { return std::acos(a); });
+            break;
+        case NullComputeOp::Atan:
+            UnaryFloatOp(regs, instr, [](float a) { return std::atan(a); });
+            break;
+        case NullComputeOp::Atan2:
+            BinaryFloatOp(regs, instr, [](float y, float x) { return std::atan2(y, x); });
+            break;
+        case NullComputeOp::Exp:
+            UnaryFloatOp(regs, instr, [](float a) { return std::exp(a); });
+            break;
+        case NullComputeOp::Exp2:
+            UnaryFloatOp(regs, instr, [](float a) { return std::exp2(a); });
+            break;
+        case NullComputeOp::Log:
+            UnaryFloatOp(regs, instr, [](float a) { return std::log(a); });
+            break;
+        case NullComputeOp::Log2:
+            UnaryFloatOp(regs, instr, [](float a) { return std::log2(a); });
+            break;
+        case NullComputeOp::Pow:
+            BinaryFloatOp(regs, instr, [](float a, float b) { return std::pow(a, b); });
+            break;
+        case NullComputeOp::FMin:
+            BinaryFloatOp(regs, instr, [](float a, float b) { return std::fmin(a, b); });
+            break;
+        case NullComputeOp::FMax:
+            BinaryFloatOp(regs, instr, [](float a, float b) { return std::fmax(a, b); });
+            break;
+        case NullComputeOp::FClamp:
+            TernaryFloatOp(regs, instr, FClamp);
+            break;
+        case NullComputeOp::FMix:
+            TernaryFloatOp(regs, instr, [](float x, float y, float a) { return x * (1.0f - a) + y * a; });
+            break;
+        case NullComputeOp::Step:
+            BinaryFloatOp(regs, instr, [](float edge, float x) { return (x < edge ? 0.0f : 1.0f); });
+            break;
+        case NullComputeOp::SmoothStep:
+            TernaryFloatOp(
+                regs, instr,
+                [](float edge0, float edge1, float x)
+                {
+                    const float t = FClamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+                    return t * t * (3.0f - 2.0f * t);
+                }
+            );
+            break;
+        case NullComputeOp::Fma:
+            TernaryFloatOp(regs, instr, [](float a, float b, float c) { return std::fma(a, b, c); });
+            break;
+
+        case NullComputeOp::Length:
+            regs[instr.dst] = AsUInt(Length(regs + instr.a, instr.n));
+            break;
+
+        case NullComputeOp::Distance:
+        {
+            float sum = 0.0f;
+            for_range(i, instr.n)
+            {
+                const float d = AsFloat(regs[instr.a + i]) - AsFloat(regs[instr.b + i]);
+                sum += d * d;
+            }
+            regs[instr.dst] = AsUInt(std::sqrt(sum));
+        }
+        break;
+
+        case NullComputeOp::Normalize:
+        {
+            const float invLength = 1.0f / Length(regs + instr.a, instr.n);
+            for_range(i, instr.n)
+                regs[instr.dst + i] = AsUInt(AsFloat(regs[instr.a + i]) * invLength);
+        }
+        break;
+
+        case NullComputeOp::Cross:
+        {
+            const float ax = AsFloat(regs[instr.a]), ay = AsFloat(regs[instr.a + 1]), az = AsFloat(regs[instr.a + 2]);
+            const float bx = AsFloat(regs[instr.b]), by = AsFloat(regs[instr.b + 1]), bz = AsFloat(regs[instr.b + 2]);
+            regs[instr.dst    ] = AsUInt(ay * bz - az * by);
+            regs[instr.dst + 1] = AsUInt(az * bx - ax * bz);
+            regs[instr.dst + 2] = AsUInt(ax * by - ay * bx);
+        }
+        break;
+
+        case NullComputeOp::PackHalf2x16:
+        {
+            const std::uint32_t lo = CompressFloat16(AsFloat(regs[instr.a]));
+            const std::uint32_t hi = CompressFloat16(AsFloat(regs[instr.a + 1]));
+            regs[instr.dst] = (lo | (hi << 16));
+        }
+        break;
+
+        case NullComputeOp::UnpackHalf2x16:
+        {
+            const std::uint32_t packed = regs[instr.a];
+            regs[instr.dst    ] = AsUInt(DecompressFloat16(static_cast<std::uint16_t>(packed & 0xFFFF)));
+            regs[instr.dst + 1] = AsUInt(DecompressFloat16(static_cast<std::uint16_t>(packed >> 16)));
+        }
+        break;
+
+        case NullComputeOp::PackUnorm4x8:
+        {
+            std::uint32_t packed = 0;
+            for_range(i, 4u)
+                packed |= (static_cast<std::uint32_t>(DenormalizeComponent<std::uint8_t>(AsFloat(regs[instr.a + i]))) << (i * 8));
+            regs[instr.dst] = packed;
+        }
+        break;
+
+        case NullComputeOp::UnpackUnorm4x8:
+        {
+            const std::uint32_t packed = regs[instr.a];
+            for_range(i, 4u)
+                regs[instr.dst + i] = AsUInt(NormalizeComponent(static_cast<std::uint8_t>(packed >> (i * 8))));
+        }
+        break;
+
+        /* ----- Atomics ----- */
+
+        case NullComputeOp::AtomicLoad:
+        {
+            auto* atomic = DerefAtomic(regs + instr.a);
+            regs[instr.dst] = (atomic != nullptr ? atomic->load() : 0u);
+        }
+        break;
+
+        case NullComputeOp::AtomicStore:
+        {
+            if (auto* atomic = DerefAtomic(regs + instr.a))
+                atomic->store(regs[instr.b]);
+        }
+        break;
+
+        case NullComputeOp::AtomicExchange:
+        {
+            auto* atomic = DerefAtomic(regs + instr.a);
+            regs[instr.dst] = (atomic != nullptr ? atomic->exchange(regs[instr.b]) : 0u);
+        }
+        break;
+
+        case NullComputeOp::AtomicCompareExchange:
+        {
+            std::uint32_t expected = regs[instr.c];
+            if (auto* atomic = DerefAtomic(regs + instr.a))
+                atomic->compare_exchange_strong(expected, regs[instr.b]);
+            else
+                expected = 0;
+            regs[instr.dst] = expected;
+        }
+        break;
+
+        case NullComputeOp::AtomicIAdd:
+        {
+            auto* atomic = DerefAtomic(regs + instr.a);
+            regs[instr.dst] = (atomic != nullptr ? atomic->fetch_add(regs[instr.b]) : 0u);
+        }
+        break;
+
+        case NullComputeOp::AtomicISub:
+        {
+            auto* atomic = DerefAtomic(regs + instr.a);
+            regs[instr.dst] = (atomic != nullptr ? atomic->fetch_sub(regs[instr.b]) : 0u);
+        }
+        break;
+
+        case NullComputeOp::AtomicAnd:
+        {
+            auto* atomic = DerefAtomic(regs + instr.a);
+            regs[instr.dst] = (atomic != nullptr ? atomic->fetch_and(regs[instr.b]) : 0u);
+        }
+        break;
+
+        case NullComputeOp::AtomicOr:
+        {
+            auto* atomic = DerefAtomic(regs + instr.a);
+            regs[instr.dst] = (atomic != nullptr ? atomic->fetch_or(regs[instr.b]) : 0u);
+        }
+        break;
+
+        case NullComputeOp::AtomicXor:
+        {
+            auto* atomic = DerefAtomic(regs + instr.a);
+            regs[instr.dst] = (atomic != nullptr ? atomic->fetch_xor(regs[instr.b]) : 0u);
+        }
+        break;
+
+        case NullComputeOp::AtomicSMin:
+        case NullComputeOp::AtomicUMin:
+        case NullComputeOp::AtomicSMax:
+        case NullComputeOp::AtomicUMax:
+        {
+            /* Min/max have no native atomic operation, so use a compare-exchange loop */
+            auto* atomic = DerefAtomic(regs + instr.a);
+            if (atomic == nullptr)
+            {
+                regs[instr.dst] = 0;
+                break;
+            }
+
+            const std::uint32_t value = regs[instr.b];
+            std::uint32_t prev = atomic->load();
+            for (;;)
+            {
+                std::uint32_t next = prev;
+                switch (instr.op)
+                {
+                    case NullComputeOp::AtomicSMin: next = (AsInt(value) < AsInt(prev) ? value : prev); break;
+                    case NullComputeOp::AtomicUMin: next = std::min(value, prev);                        break;
+                    case NullComputeOp::AtomicSMax: next = (AsInt(value) > AsInt(prev) ? value : prev); break;
+                    default:                        next = std::max(value, prev);                        break;
+                }
+                if (next == prev || atomic->compare_exchange_weak(prev, next))
+                    break;
+            }
+            regs[instr.dst] = prev;
+        }
+        break;
+
+        /* ----- Images ----- */
+
+        case NullComputeOp::ImageRead:
+        case NullComputeOp::ImageFetch:
+        {
+            std::uint32_t texel[4];
+            const std::uint32_t mipLevel = (instr.op == NullComputeOp::ImageFetch && instr.c != NullComputeProgram::invalidRegister ? regs[instr.c] : 0u);
+            ReadTexel(ReadImageHandle(regs + instr.a), mipLevel, regs + instr.b, (instr.n & 0xFF), static_cast<NullComputeScalar>(instr.type), texel);
+            ::memcpy(regs + instr.dst, texel, std::min<std::uint32_t>(instr.n >> 8, 4u) * sizeof(std::uint32_t));
+        }
+        break;
+
+        case NullComputeOp::ImageWrite:
+            WriteTexel(ReadImageHandle(regs + instr.a), regs + instr.b, (instr.n & 0xFF), regs + instr.c, (instr.n >> 8), static_cast<NullComputeScalar>(instr.type));
+            break;
+
+        case NullComputeOp::ImageQuerySize:
+        {
+            const std::uint32_t mipLevel = (instr.b != NullComputeProgram::invalidRegister ? regs[instr.b] : 0u);
+            QueryImageSize(ReadImageHandle(regs + instr.a), mipLevel, regs + instr.dst, instr.n);
+        }
+        break;
+
+        case NullComputeOp::ImageQueryLevels:
+        {
+            const NullComputeImage* image = ReadImageHandle(regs + instr.a);
+            regs[instr.dst] = (image != nullptr ? image->numMipLevels : 0u);
+        }
+        break;
+
+        case NullComputeOp::ImageSample:
+        {
+            std::uint32_t texel[4];
+            SampleImage(regs, instr, params, texel);
+            ::memcpy(regs + instr.dst, texel, std::min<std::uint32_t>(instr.n >> 8, 4u) * sizeof(std::uint32_t));
+        }
+        break;
+
+        default:
+            break;
+    }
+}
+
+void ExecuteNullComputeInstr(std::uint32_t* regs, const NullComputeInstr& instr, const std::uint32_t* params)
+{
+    ExecuteInstr(regs, instr, params);
+}
+
+// Runs the invocation until it finishes or reaches a barrier. Returns true if the invocation was suspended at a barrier.
+static bool RunInvocation(const NullComputeProgram& program, NullComputeInvocation& invocation)
+{
+    std::uint32_t* regs = invocation.regs;
+    const NullComputeInstr* instrs = program.instrs.data();
+    const std::uint32_t* params = program.params.data();
+    std::uint32_t pc = invocation.pc;
+
+    for (;;)
+    {
+        const NullComputeInstr& instr = instrs[pc++];
+        switch (instr.op)
+        {
+            /* ----- Control flow ----- */
+
+            case NullComputeOp::Branch:
+                pc = instr.a;
+                break;
+
+            case NullComputeOp::BranchConditional:
+                pc = (regs[instr.a] != 0 ? instr.b : instr.c);
+                break;
+
+            case NullComputeOp::Switch:
+            {
+                const std::uint32_t selector = regs[instr.a];
+                const std::uint32_t* cases = params + instr.b;
+                pc = cases[0];
+                for_range(i, instr.c)
+                {
+                    if (cases[1 + i * 2] == selector)
+                    {
+                        pc = cases[2 + i * 2];
+                        break;
+                    }
+                }
+            }
+            break;
+
+            case NullComputeOp::Call:
+            {
+                const std::uint32_t* args = params + instr.b;
+                for_range(i, instr.c)
+                    ::memmove(regs + args[i * 3], regs + args[i * 3 + 1], args[i * 3 + 2] * sizeof(std::uint32_t));
+                invocation.frames.push_back({ pc, instr.dst, instr.n });
+                pc = instr.a;
+            }
+            break;
+
+            case NullComputeOp::Return:
+            case NullComputeOp::ReturnValue:
+            {
+                if (invocation.frames.empty())
+                {
+                    /* Returned from entry point */
+                    invocation.done = true;
+                    return false;
+                }
+                const NullComputeCallFrame frame = invocation.frames.back();
+                invocation.frames.pop_back();
+                if (instr.op == NullComputeOp::ReturnValue && frame.n > 0)
+                    ::memmove(regs + frame.dst, regs + instr.a, frame.n * sizeof(std::uint32_t));
+                pc = frame.returnPc;
+            }
+            break;
+
+            case NullComputeOp::Barrier:
+                invocation.pc = pc;
+                return true;
+
+            case NullComputeOp::Kill:
+                invocation.done = true;
+                return false;
+
+            default:
+                ExecuteInstr(regs, instr, params);
+                break;
+        }
+    }
+}
+
+// Initializes the builtin variable at the specified offset if the program uses it.
+static void WriteBuiltin(std::uint32_t* memory, const NullComputeProgram& program, const NullComputeBuiltin builtin, const std::uint32_t* values, std::uint32_t count)
+{
+    const std::uint32_t offset = program.builtins[static_cast<int>(builtin)];
+    if (offset != NullComputeProgram::invalidRegister)
+        ::memcpy(memory + offset, values, count * sizeof(std::uint32_t));
+}
+
+// Initializes the invocation memory for the specified local invocation of a work group.
+static void InitInvocation(
+    NullComputeInvocation&      invocation,
+    const NullComputeProgram&   program,
+    const std::uint32_t*        initialMemory,
+    std::uint32_t*              workGroupMemory,
+    const std::uint32_t         (&numWorkGroups)[3],
+    const std::uint32_t         (&workGroupID)[3],
+    std::uint32_t               localIndex)
+{
+    std::uint32_t* memory = invocation.regs;
+    ::memcpy(memory, initialMemory, program.invocationMemory.size() * sizeof(std::uint32_t));
+
+    /* Pointers into invocation and work group memory refer to host addresses, so they must be initialized for each invocation */
+    for (const auto& range : program.privatePointers)
+        WritePointer(memory + range.reg, memory + range.offset, range.size * sizeof(std::uint32_t));
+    for (const auto& range : program.workGroupPointers)
+        WritePointer(memory + range.reg, workGroupMemory + range.offset, range.size * sizeof(std::uint32_t));
+
+    /* Write built-in input variables */
+    const std::uint32_t localID[3] =
+    {
+        localIndex % program.localSize[0],
+        (localIndex / program.localSize[0]) % program.localSize[1],
+        localIndex / (program.localSize[0] * program.localSize[1]),
+    };
+    const std::uint32_t globalID[3] =
+    {
+        workGroupID[0] * program.localSize[0] + localID[0],
+        workGroupID[1] * program.localSize[1] + localID[1],
+        workGroupID[2] * program.localSize[2] + localID[2],
+    };
+
+    WriteBuiltin(memory, program, NullComputeBuiltin::NumWorkGroups,        numWorkGroups,  3);
+    WriteBuiltin(memory, program, NullComputeBuiltin::WorkGroupID,          workGroupID,    3);
+    WriteBuiltin(memory, program, NullComputeBuiltin::LocalInvocationID,    localID,        3);
+    WriteBuiltin(memory, program, NullComputeBuiltin::GlobalInvocationID,   globalID,       3);
+    WriteBuiltin(memory, program, NullComputeBuiltin::LocalInvocationIndex, &localIndex,    1);
+
+    invocation.pc   = program.entryPointPc;
+    invocation.done = false;
+    invocation.frames.clear();
+}
+
+// Per-worker memory to run work groups.
+struct NullComputeWorkerState
+{
+    std::vector<std::uint32_t>          invocationMemory;
+    std::vector<std::uint32_t>          workGroupMemory;
+    std::vector<NullComputeInvocation>  invocations;
+    #ifdef LLGL_ENABLE_JIT_COMPILER
+    const NullComputeKernel*            kernel = nullptr;   // Native kernel to run invocations without barriers, or null to interpret them
+    #endif
+};
+
+static void RunWorkGroup(
+    const NullComputeProgram&   program,
+    const std::uint32_t*        initialMemory,
+    const std::uint32_t         (&numWorkGroups)[3],
+    const std::uint32_t         (&workGroupID)[3],
+    NullComputeWorkerState&     state)
+{
+    const std::uint32_t memorySize = static_cast<std::uint32_t>(program.invocationMemory.size());
+    const std::uint32_t numInvocations = program.localSize[0] * program.localSize[1] * program.localSize[2];
+
+    std::fill(state.workGroupMemory.begin(), state.workGroupMemory.end(), 0u);
+
+    if (program.hasBarriers)
+    {
+        /* Keep all invocations of the work group alive and run them in turns from one barrier to the next */
+        for_range(i, numInvocations)
+        {
+            state.invocations[i].regs = state.invocationMemory.data() + i * memorySize;
+            InitInvocation(state.invocations[i], program, initialMemory, state.workGroupMemory.data(), numWorkGroups, workGroupID, i);
+        }
+
+        for (bool anySuspended = true; anySuspended;)
+        {
+            anySuspended = false;
+            for (auto& invocation : state.invocations)
+            {
+                if (!invocation.done && RunInvocation(program, invocation))
+                    anySuspended = true;
+            }
+        }
+    }
+    else
+    {
+        /* Run invocations one after another and reuse the same invocation memory */
+        NullComputeInvocation& invocation = state.invocations.front();
+        invocation.regs = state.invocationMemory.data();
+        for_range(i, numInvocations)
+        {
+            InitInvocation(invocation, program, initialMemory, state.workGroupMemory.data(), numWorkGroups, workGroupID, i);
+            #ifdef LLGL_ENABLE_JIT_COMPILER
+            if (state.kernel != nullptr)
+            {
+                state.kernel->Run(invocation.regs);
+                continue;
+            }
+            #endif
+            RunInvocation(program, invocation);
+        }
+    }
+}
+
+void NullComputeInterpreter::SetPipelineState(const NullPipelineState* pipelineState)
+{
+    /* Graphics PSOs do not affect the compute state */
+    if (pipelineState != nullptr && !pipelineState->isGraphicsPSO)
+        pipelineState_ = pipelineState;
+}
+
+void NullComputeInterpreter::SetResourceHeap(NullResourceHeap* resourceHeap, std::uint32_t descriptorSet)
+{
+    resourceHeap_   = resourceHeap;
+    descriptorSet_  = descriptorSet;
+}
+
+void NullComputeInterpreter::SetResource(std::uint32_t descriptor, Resource* resource)
+{
+    if (descriptor >= resources_.size())
+        resources_.resize(descriptor + 1, nullptr);
+    resources_[descriptor] = resource;
+}
+
+void NullComputeInterpreter::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    if (pipelineState_ == nullptr)
+        return;
+
+    const NullComputeProgram* program = pipelineState_->GetComputeProgram();
+    if (program == nullptr || program->instrs.empty())
+        return;
+
+    const std::uint64_t numWorkGroups = static_cast<std::uint64_t>(numWorkGroupsX) * numWorkGroupsY * numWorkGroupsZ;
+    if (numWorkGroups == 0)
+        return;
+
+    ResolveBindings(*program);
+
+    const std::uint32_t numWorkGroupsXYZ[3] = { numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ };
+    const std::uint32_t numInvocations = program->localSize[0] * program->localSize[1] * program->localSize[2];
+    if (numInvocations == 0)
+        return;
+
+    numInvocations_ += numWorkGroups * numInvocations;
+
+    /* Distribute work groups across worker threads */
+    std::atomic<std::uint64_t> nextWorkGroup{ 0 };
+
+    const unsigned numWorkers = static_cast<unsigned>(std::max<std::uint64_t>(1u, std::min<std::uint64_t>(std::thread::hardware_concurrency(), numWorkGroups)));
+
+    DoConcurrent(
+        [this, program, numWorkGroups, numInvocations, &numWorkGroupsXYZ, &nextWorkGroup](std::size_t /*worker*/)
+        {
+            NullComputeWorkerState state;
+            state.invocationMemory.resize(program->invocationMemory.size() * (program->hasBarriers ? numInvocations : 1u));
+            state.workGroupMemory.resize(program->workGroupMemorySize);
+            state.invocations.resize(program->hasBarriers ? numInvocations : 1u);
+            for (auto& invocation : state.invocations)
+                invocation.frames.reserve(program->maxCallDepth);
+            #ifdef LLGL_ENABLE_JIT_COMPILER
+            state.kernel = pipelineState_->GetComputeKernel();
+            #endif
+
+            for (std::uint64_t workGroup = nextWorkGroup++; workGroup < numWorkGroups; workGroup = nextWorkGroup++)
+            {
+                const std::uint32_t workGroupID[3] =
+                {
+                    static_cast<std::uint32_t>(workGroup % numWorkGroupsXYZ[0]),
+                    static_cast<std::uint32_t>((workGroup / numWorkGroupsXYZ[0]) % numWorkGroupsXYZ[1]),
+                    static_cast<std::uint32_t>(workGroup / (static_cast<std::uint64_t>(numWorkGroupsXYZ[0]) * numWorkGroupsXYZ[1])),
+                };
+                RunWorkGroup(*program, invocationMemory_.data(), numWorkGroupsXYZ, workGroupID, state);
+            }
+        },
+        numWorkers,
+        numWorkers,
+        1
+    );
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullComputeInterpreter::ResolveBindings(const NullComputeProgram& program)
+{
+    invocationMemory_ = program.invocationMemory;
+
+    /* Reserve handles and images up front, since binding points store their addresses */
+    const std::size_t numBindingPoints = program.bindingPoints.size();
+    handles_.assign(numBindingPoints * NullComputeProgram::handleWords * 2, 0u);
+    images_.clear();
+    images_.reserve(numBindingPoints);
+
+    for_range(i, numBindingPoints)
+    {
+        const NullComputeBindingPoint& bindingPoint = program.bindingPoints[i];
+        std::uint32_t* handle = &(handles_[i * NullComputeProgram::handleWords * 2]);
+
+        ResourceViewDescriptor tempView;
+        const ResourceViewDescriptor* resourceView = FindResourceView(bindingPoint, tempView);
+
+        switch (bindingPoint.type)
+        {
+            case NullComputeBindingType::Buffer:
+            {
+                /* Unbound buffers are out of bounds, i.e. loads return zero and stores are discarded */
+                WritePointer(invocationMemory_.data() + bindingPoint.reg, NullComputePointer{ nullptr, nullptr });
+                if (resourceView != nullptr)
+                    BindBuffer(bindingPoint.reg, *resourceView);
+            }
+            break;
+
+            case NullComputeBindingType::Image:
+            case NullComputeBindingType::SampledImage:
+            {
+                if (resourceView != nullptr)
+                    BindImage(handle, *resourceView);
+                if (bindingPoint.type == NullComputeBindingType::SampledImage)
+                {
+                    const NullSampler* sampler = FindSampler(bindingPoint);
+                    ::memcpy(handle + NullComputeProgram::handleWords, &sampler, sizeof(sampler));
+                }
+                const std::size_t numHandleWords = NullComputeProgram::handleWords * (bindingPoint.type == NullComputeBindingType::SampledImage ? 2 : 1);
+                WritePointer(invocationMemory_.data() + bindingPoint.reg, handle, numHandleWords * sizeof(std::uint32_t));
+            }
+            break;
+
+            case NullComputeBindingType::Sampler:
+            {
+                const NullSampler* sampler = FindSampler(bindingPoint);
+                ::memcpy(handle, &sampler, sizeof(sampler));
+                WritePointer(invocationMemory_.data() + bindingPoint.reg, handle, NullComputeProgram::handleWords * sizeof(std::uint32_t));
+            }
+            break;
+        }
+    }
+}
+
+const ResourceViewDescriptor* NullComputeInterpreter::FindResourceView(const NullComputeBindingPoint& bindingPoint, ResourceViewDescriptor& outTempView) const
+{
+    const PipelineLayout* pipelineLayout = pipelineState_->computeDesc.pipelineLayout;
+    if (pipelineLayout == nullptr)
+        return nullptr;
+
+    auto* pipelineLayoutNull = LLGL_CAST(const NullPipelineLayout*, pipelineLayout);
+    const auto& layoutDesc = pipelineLayoutNull->desc;
+
+    /* Sampler bindings may share their slot with the texture binding of a combined image-sampler */
+    const bool isSamplerBinding = (bindingPoint.type == NullComputeBindingType::Sampler);
+
+    /* Find binding in heap bindings first */
+    for_range(i, layoutDesc.heapBindings.size())
+    {
+        const BindingDescriptor& binding = layoutDesc.heapBindings[i];
+        if (binding.slot.index == bindingPoint.binding && binding.slot.set == bindingPoint.set && (binding.type == ResourceType::Sampler) == isSamplerBinding)
+        {
+            if (resourceHeap_ == nullptr)
+                return nullptr;
+            const ResourceViewDescriptor* resourceView = resourceHeap_->GetResourceView(descriptorSet_, static_cast<std::uint32_t>(i));
+            return (resourceView != nullptr && resourceView->resource != nullptr ? resourceView : nullptr);
+        }
+    }
+
+    /* Find binding in individual bindings */
+    for_range(i, layoutDesc.bindings.size())
+    {
+        const BindingDescriptor& binding = layoutDesc.bindings[i];
+        if (binding.slot.index == bindingPoint.binding && binding.slot.set == bindingPoint.set && (binding.type == ResourceType::Sampler) == isSamplerBinding)
+        {
+            if (i >= resources_.size() || resources_[i] == nullptr)
+                return nullptr;
+            outTempView = ResourceViewDescriptor{ resources_[i] };
+            return &outTempView;
+        }
+    }
+
+    return nullptr;
+}
+
+const NullSampler* NullComputeInterpreter::FindSampler(const NullComputeBindingPoint& bindingPoint) const
+{
+    /* Sampler resources take precedence over static samplers at the same slot */
+    NullComputeBindingPoint samplerBindingPoint = bindingPoint;
+    samplerBindingPoint.type = NullComputeBindingType::Sampler;
+
+    ResourceViewDescriptor tempView;
+    if (const ResourceViewDescriptor* resourceView = FindResourceView(samplerBindingPoint, tempView))
+    {
+        if (resourceView->resource->GetResourceType() == ResourceType::Sampler)
+            return LLGL_CAST(const NullSampler*, resourceView->resource);
+    }
+
+    if (const PipelineLayout* pipelineLayout = pipelineState_->computeDesc.pipelineLayout)
+    {
+        auto* pipelineLayoutNull = LLGL_CAST(const NullPipelineLayout*, pipelineLayout);
+        return pipelineLayoutNull->FindStaticSampler(BindingSlot{ bindingPoint.binding, bindingPoint.set });
+    }
+
+    return nullptr;
+}
+
+void NullComputeInterpreter::BindBuffer(std::uint32_t reg, const ResourceViewDescriptor& resourceView)
+{
+    if (resourceView.resource->GetResourceType() != ResourceType::Buffer)
+        return;
+
+    auto* bufferNull = LLGL_CAST(NullBuffer*, resourceView.resource);
+    const std::uint64_t bufferSize = bufferNull->desc.size;
+
+    /* Determine buffer range of the view; the offset is ignored for whole-size views */
+    std::uint64_t offset = 0, size = bufferSize;
+    if (resourceView.bufferView.size != Constants::wholeSize)
+    {
+        offset  = std::min(resourceView.bufferView.offset, bufferSize);
+        size    = std::min(resourceView.bufferView.size, bufferSize - offset);
+    }
+
+    WritePointer(invocationMemory_.data() + reg, bufferNull->GetBytesAt(offset), static_cast<std::size_t>(size));
+}
+
+void NullComputeInterpreter::BindImage(std::uint32_t* handle, const ResourceViewDescriptor& resourceView)
+{
+    if (resourceView.resource->GetResourceType() != ResourceType::Texture)
+        return;
+
+    auto* textureNull = LLGL_CAST(NullTexture*, resourceView.resource);
+    const TextureDescriptor& textureDesc = textureNull->desc;
+
+    /* Resolve pending fast clears before work groups access the texels concurrently */
+    textureNull->ResolveClears();
+
+    NullComputeImage image;
+    {
+        image.texture           = textureNull;
+        image.type              = textureDesc.type;
+        image.formatAttribs     = &(GetFormatAttribs(textureDesc.format));
+        image.baseMipLevel      = 0;
+        image.numMipLevels      = textureDesc.mipLevels;
+        image.baseArrayLayer    = 0;
+        image.numArrayLayers    = textureDesc.arrayLayers;
+    }
+
+    /* Apply texture view if specified; the view format is only honored if it has the same texel size */
+    const TextureViewDescriptor& textureView = resourceView.textureView;
+    if (textureView.format != Format::Undefined && textureView.subresource.numMipLevels > 0 && textureView.subresource.numArrayLayers > 0)
+    {
+        const FormatAttributes& viewFormatAttribs = GetFormatAttribs(textureView.format);
+        if (viewFormatAttribs.bitSize == image.formatAttribs->bitSize)
+            image.formatAttribs = &viewFormatAttribs;
+
+        image.type              = textureView.type;
+        image.baseMipLevel      = std::min(textureView.subresource.baseMipLevel, textureDesc.mipLevels);
+        image.numMipLevels      = std::min(textureView.subresource.numMipLevels, textureDesc.mipLevels - image.baseMipLevel);
+        image.baseArrayLayer    = std::min(textureView.subresource.baseArrayLayer, textureDesc.arrayLayers);
+        image.numArrayLayers    = std::min(textureView.subresource.numArrayLayers, textureDesc.arrayLayers - image.baseArrayLayer);
+    }
+
+    /* All array layers are stored along the Y-axis for 1D arrays and along the Z-axis otherwise */
+    switch (textureDesc.type)
+    {
+        case TextureType::Texture1DArray:
+            image.layerAxis = 1;
+            break;
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+        case TextureType::Texture2DMSArray:
+            image.layerAxis = 2;
+            break;
+        default:
+            image.layerAxis = 3;
+            break;
+    }
+
+    images_.push_back(image);
+
+    const NullComputeImage* imagePtr = &(images_.back());
+    ::memcpy(handle, &imagePtr, sizeof(imagePtr));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,102 @@
+/*
+ * NullComputeInterpreter.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_COMPUTE_INTERPRETER_H
+#define LLGL_NULL_COMPUTE_INTERPRETER_H
+
+
+#include "NullComputeProgram.h"
+#include <LLGL/Format.h>
+#include <LLGL/TextureFlags.h>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class Resource;
+class NullTexture;
+class NullSampler;
+class NullResourceHeap;
+class NullPipelineState;
+struct ResourceViewDescriptor;
+
+// Image view a compute program accesses via an image handle.
+struct NullComputeImage
+{
+    NullTexture*                texture;
+    TextureType                 type;           // Type of the texture view
+    const FormatAttributes*     formatAttribs;  // Format attributes of the texture view
+    std::uint32_t               baseMipLevel;
+    std::uint32_t               numMipLevels;
+    std::uint32_t               baseArrayLayer;
+    std::uint32_t               numArrayLayers;
+    int                         layerAxis;      // Image axis the array layers are stored along: 1 for 1D arrays, 2 for all other arrays, or 3 if not layered
+};
+
+// Executes a single instruction that does not alter the control flow. Native compute kernels use this for instructions without a native code path.
+void ExecuteNullComputeInstr(std::uint32_t* regs, const NullComputeInstr& instr, const std::uint32_t* params);
+
+/*
+Interpreter for compute programs of the Null renderer.
+Each dispatch resolves the resource bindings of the current pipeline state and runs the work groups in parallel.
+Invocations of a work group run one after another, unless the program has barriers,
+in which case all invocations are suspended at each barrier until the entire work group reached it.
+*/
+class NullComputeInterpreter
+{
+
+    public:
+
+        void SetPipelineState(const NullPipelineState* pipelineState);
+        void SetResourceHeap(NullResourceHeap* resourceHeap, std::uint32_t descriptorSet);
+        void SetResource(std::uint32_t descriptor, Resource* resource);
+
+        // Runs the compute program of the current pipeline state. This has no effect if the pipeline state has no compute program.
+        void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ);
+
+        // Returns the number of compute shader invocations of all dispatches.
+        inline std::uint64_t GetNumInvocations() const
+        {
+            return numInvocations_;
+        }
+
+    private:
+
+        void ResolveBindings(const NullComputeProgram& program);
+        const ResourceViewDescriptor* FindResourceView(const NullComputeBindingPoint& bindingPoint, ResourceViewDescriptor& outTempView) const;
+        const NullSampler* FindSampler(const NullComputeBindingPoint& bindingPoint) const;
+
+        void BindBuffer(std::uint32_t reg, const ResourceViewDescriptor& resourceView);
+        void BindImage(std::uint32_t* handle, const ResourceViewDescriptor& resourceView);
+
+    private:
+
+        const NullPipelineState*        pipelineState_      = nullptr;
+        NullResourceHeap*               resourceHeap_       = nullptr;
+        std::uint32_t                   descriptorSet_      = 0;
+        std::vector<Resource*>          resources_;                 // Resources bound with SetResource
+        std::uint64_t                   numInvocations_     = 0;    // Statistics for queries
+
+        /* Per-dispatch states */
+        std::vector<std::uint32_t>      invocationMemory_;          // Initial invocation memory with resolved binding points
+        std::vector<std::uint32_t>      handles_;                   // Image and sampler handles binding points refer to
+        std::vector<NullComputeImage>   images_;                    // Image views image handles refer to
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,892 @@
+/*
+ * NullComputeJIT.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifdef LLGL_ENABLE_JIT_COMPILER
+
+#include "NullComputeJIT.h"
+#include "NullComputeInterpreter.h"
+#include <LLGL/Platform/Platform.h>
+#include <LLGL/Utils/ForRange.h>
+#include <exception>
+#include <vector>
+
+#ifdef LLGL_ARCH_AMD64
+#   include "../../../JIT/Arch/AMD64/AMD64Assembler.h"
+#endif
+
+
+namespace LLGL
+{
+
+
+#ifdef LLGL_ARCH_AMD64
+
+using JIT::AMD64Assembler;
+using JIT::Reg;
+using JIT::CondCode;
+using JIT::ALUOp;
+using JIT::ShiftOp;
+using JIT::SSEOp;
+
+// Maximum size (in words) of the invocation memory, so that all register offsets fit into 32-bit displacements.
+static const std::size_t g_maxInvocationMemorySize = (0x7FFFFFFF / 4);
+
+/*
+Generates native code for a compute program. Each IR register is addressed relative to RBX, which holds the invocation memory.
+IR functions are compiled into native functions, so calls and returns map to CALL and RET instructions.
+The native stack holds the destination address for return values of each IR function call.
+*/
+class NullComputeCodeGenerator
+{
+
+    public:
+
+        NullComputeCodeGenerator(const NullComputeProgram& program);
+
+        std::unique_ptr<JITProgram> Generate();
+
+    private:
+
+        using Label = AMD64Assembler::Label;
+        using Mem   = AMD64Assembler::Mem;
+
+        static Mem RegMem(std::uint32_t reg, std::uint32_t component = 0);
+
+        bool EmitInstr(std::uint32_t pc);
+        void EmitFallback(const NullComputeInstr& instr);
+        void EmitCopy(std::uint32_t dst, std::uint32_t src, std::uint32_t n);
+        void EmitIntBinaryOp(const NullComputeInstr& instr, ALUOp op, SSEOp packedOp);
+        void EmitIntCompare(const NullComputeInstr& instr, CondCode cond);
+        void EmitIntMinMax(const NullComputeInstr& instr, CondCode cond);
+        void EmitShift(const NullComputeInstr& instr, ShiftOp op);
+        void EmitIntUnaryOp(const NullComputeInstr& instr, NullComputeOp op);
+        void EmitFloatBinaryOp(const NullComputeInstr& instr, SSEOp packedOp, SSEOp scalarOp);
+        void EmitFloatCompare(const NullComputeInstr& instr);
+        void EmitSelect(const NullComputeInstr& instr);
+        void EmitSelectScalar(const NullComputeInstr& instr);
+        void EmitVectorTimesScalar(const NullComputeInstr& instr);
+        void EmitDotProduct(std::uint32_t dst, std::uint32_t a, std::uint32_t aStride, std::uint32_t b, std::uint32_t bStride, std::uint32_t n);
+        void EmitLoad(const NullComputeInstr& instr);
+        void EmitStore(const NullComputeInstr& instr);
+        bool EmitAccessChain(const NullComputeInstr& instr);
+        void EmitBranch(std::uint32_t pc, std::uint32_t target);
+        void EmitCall(const NullComputeInstr& instr);
+        void EmitReturnValue(const NullComputeInstr& instr);
+
+    private:
+
+        const NullComputeProgram&   program_;
+        AMD64Assembler              asm_;
+        std::vector<Label>          labels_;    // Label for each instruction
+        Label                       epilogue_   = 0;
+
+};
+
+NullComputeCodeGenerator::NullComputeCodeGenerator(const NullComputeProgram& program) :
+    program_ { program }
+{
+}
+
+std::unique_ptr<JITProgram> NullComputeCodeGenerator::Generate()
+{
+    const std::size_t numInstrs = program_.instrs.size();
+
+    labels_.reserve(numInstrs);
+    for_range(i, numInstrs)
+        labels_.push_back(asm_.NewLabel());
+    epilogue_ = asm_.NewLabel();
+
+    /* Write prologue: keep invocation memory in RBX and call into the entry point function */
+    asm_.PushReg(Reg::RBP);
+    asm_.MovRegReg(Reg::RBP, Reg::RSP);
+    asm_.PushReg(Reg::RBX);
+    asm_.MovRegReg(Reg::RBX, AMD64Assembler::GetIntParamReg(0));
+    asm_.CallLabel(labels_[program_.entryPointPc]);
+
+    /* Write epilogue; a terminated invocation jumps here from any call depth, so the stack pointer is restored from RBP */
+    asm_.BindLabel(epilogue_);
+    asm_.Lea(Reg::RSP, Mem{ Reg::RBP, -8 });
+    asm_.PopReg(Reg::RBX);
+    asm_.PopReg(Reg::RBP);
+    asm_.RetNear();
+
+    for_range(pc, numInstrs)
+    {
+        asm_.BindLabel(labels_[pc]);
+        if (!EmitInstr(static_cast<std::uint32_t>(pc)))
+            return nullptr;
+    }
+
+    return asm_.FlushProgram();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+NullComputeCodeGenerator::Mem NullComputeCodeGenerator::RegMem(std::uint32_t reg, std::uint32_t component)
+{
+    return Mem{ Reg::RBX, static_cast<std::int32_t>((reg + component) * sizeof(std::uint32_t)) };
+}
+
+bool NullComputeCodeGenerator::EmitInstr(std::uint32_t pc)
+{
+    const NullComputeInstr& instr = program_.instrs[pc];
+    switch (instr.op)
+    {
+        /* ----- Data movement ----- */
+
+        case NullComputeOp::Nop:
+            break;
+
+        case NullComputeOp::Copy:
+            EmitCopy(instr.dst, instr.a, instr.n);
+            break;
+
+        case NullComputeOp::Load:
+            EmitLoad(instr);
+            break;
+
+        case NullComputeOp::Store:
+            EmitStore(instr);
+            break;
+
+        case NullComputeOp::AccessChain:
+            if (!EmitAccessChain(instr))
+                EmitFallback(instr);
+            break;
+
+        /* ----- Integer arithmetic ----- */
+
+        case NullComputeOp::IAdd:
+            EmitIntBinaryOp(instr, ALUOp::Add, SSEOp::PAddD);
+            break;
+        case NullComputeOp::ISub:
+            EmitIntBinaryOp(instr, ALUOp::Sub, SSEOp::PSubD);
+            break;
+        case NullComputeOp::BitwiseAnd:
+            EmitIntBinaryOp(instr, ALUOp::And, SSEOp::PAnd);
+            break;
+        case NullComputeOp::BitwiseOr:
+            EmitIntBinaryOp(instr, ALUOp::Or, SSEOp::POr);
+            break;
+        case NullComputeOp::BitwiseXor:
+            EmitIntBinaryOp(instr, ALUOp::Xor, SSEOp::PXor);
+            break;
+
+        case NullComputeOp::IMul:
+            for_range(i, instr.n)
+            {
+                asm_.MovRegMem(Reg::EAX, RegMem(instr.a, i));
+                asm_.IMulRegMem(Reg::EAX, RegMem(instr.b, i));
+                asm_.MovMemReg(RegMem(instr.dst, i), Reg::EAX);
+            }
+            break;
+
+        case NullComputeOp::ShiftLeftLogical:
+            EmitShift(instr, ShiftOp::Shl);
+            break;
+        case NullComputeOp::ShiftRightLogical:
+            EmitShift(instr, ShiftOp::Shr);
+            break;
+        case NullComputeOp::ShiftRightArithmetic:
+            EmitShift(instr, ShiftOp::Sar);
+            break;
+
+        case NullComputeOp::Not:
+        case NullComputeOp::SNegate:
+        case NullComputeOp::LogicalNot:
+        case NullComputeOp::FNegate:
+        case NullComputeOp::FAbs:
+            EmitIntUnaryOp(instr, instr.op);
+            break;
+
+        case NullComputeOp::SMin:
+            EmitIntMinMax(instr, CondCode::G);
+            break;
+        case NullComputeOp::SMax:
+            EmitIntMinMax(instr, CondCode::L);
+            break;
+        case NullComputeOp::UMin:
+            EmitIntMinMax(instr, CondCode::A);
+            break;
+        case NullComputeOp::UMax:
+            EmitIntMinMax(instr, CondCode::B);
+            break;
+
+        /* ----- Integer comparison ----- */
+
+        case NullComputeOp::IEqual:
+            EmitIntCompare(instr, CondCode::E);
+            break;
+        case NullComputeOp::INotEqual:
+            EmitIntCompare(instr, CondCode::NE);
+            break;
+        case NullComputeOp::SLessThan:
+            EmitIntCompare(instr, CondCode::L);
+            break;
+        case NullComputeOp::SLessThanEqual:
+            EmitIntCompare(instr, CondCode::LE);
+            break;
+        case NullComputeOp::SGreaterThan:
+            EmitIntCompare(instr, CondCode::G);
+            break;
+        case NullComputeOp::SGreaterThanEqual:
+            EmitIntCompare(instr, CondCode::GE);
+            break;
+        case NullComputeOp::ULessThan:
+            EmitIntCompare(instr, CondCode::B);
+            break;
+        case NullComputeOp::ULessThanEqual:
+            EmitIntCompare(instr, CondCode::BE);
+            break;
+        case NullComputeOp::UGreaterThan:
+            EmitIntCompare(instr, CondCode::A);
+            break;
+        case NullComputeOp::UGreaterThanEqual:
+            EmitIntCompare(instr, CondCode::AE);
+            break;
+
+        /* ----- Floating-point arithmetic ----- */
+
+        case NullComputeOp::FAdd:
+            EmitFloatBinaryOp(instr, SSEOp::AddPS, SSEOp::AddSS);
+            break;
+        case NullComputeOp::FSub:
+            EmitFloatBinaryOp(instr, SSEOp::SubPS, SSEOp::SubSS);
+            break;
+        case NullComputeOp::FMul:
+            EmitFloatBinaryOp(instr, SSEOp::MulPS, SSEOp::MulSS);
+            break;
+        case NullComputeOp::FDiv:
+            EmitFloatBinaryOp(instr, SSEOp::DivPS, SSEOp::DivSS);
+            break;
+
+        case NullComputeOp::Sqrt:
+            for (std::uint32_t i = 0; i < instr.n; ++i)
+            {
+                if (instr.n - i >= 4)
+                {
+                    asm_.SSERegMem(SSEOp::MovUPS, Reg::XMM0, RegMem(instr.a, i));
+                    asm_.SSERegReg(SSEOp::SqrtPS, Reg::XMM0, Reg::XMM0);
+                    asm_.SSEMemReg(SSEOp::MovUPS, RegMem(instr.dst, i), Reg::XMM0);
+                    i += 3;
+                }
+                else
+                {
+                    asm_.SSERegMem(SSEOp::SqrtSS, Reg::XMM0, RegMem(instr.a, i));
+                    asm_.SSEMemReg(SSEOp::MovSS, RegMem(instr.dst, i), Reg::XMM0);
+                }
+            }
+            break;
+
+        case NullComputeOp::VectorTimesScalar:
+            EmitVectorTimesScalar(instr);
+            break;
+
+        case NullComputeOp::Dot:
+            EmitDotProduct(instr.dst, instr.a, 1, instr.b, 1, instr.n);
+            break;
+
+        case NullComputeOp::MatrixTimesVector:
+            for_range(row, instr.n)
+                EmitDotProduct(instr.dst + row, instr.a + row, instr.n, instr.b, 1, instr.c);
+            break;
+
+        case NullComputeOp::VectorTimesMatrix:
+            for_range(col, instr.n)
+                EmitDotProduct(instr.dst + col, instr.a, 1, instr.b + col * instr.c, 1, instr.c);
+            break;
+
+        /* ----- Floating-point comparison ----- */
+
+        case NullComputeOp::FOrdEqual:
+        case NullComputeOp::FOrdNotEqual:
+        case NullComputeOp::FOrdLessThan:
+        case NullComputeOp::FOrdLessThanEqual:
+        case NullComputeOp::FOrdGreaterThan:
+        case NullComputeOp::FOrdGreaterThanEqual:
+        case NullComputeOp::FUnordEqual:
+        case NullComputeOp::FUnordNotEqual:
+        case NullComputeOp::FUnordLessThan:
+        case NullComputeOp::FUnordLessThanEqual:
+        case NullComputeOp::FUnordGreaterThan:
+        case NullComputeOp::FUnordGreaterThanEqual:
+        case NullComputeOp::IsNan:
+            EmitFloatCompare(instr);
+            break;
+
+        /* ----- Conversion and selection ----- */
+
+        case NullComputeOp::ConvertSToF:
+        case NullComputeOp::ConvertUToF:
+            for_range(i, instr.n)
+            {
+                /* Unsigned values are converted from the zero-extended 64-bit register */
+                asm_.MovRegMem(Reg::EAX, RegMem(instr.a, i));
+                asm_.CvtSI2SS(Reg::XMM0, (instr.op == NullComputeOp::ConvertUToF ? Reg::RAX : Reg::EAX));
+                asm_.SSEMemReg(SSEOp::MovSS, RegMem(instr.dst, i), Reg::XMM0);
+            }
+            break;
+
+        case NullComputeOp::Select:
+            EmitSelect(instr);
+            break;
+
+        case NullComputeOp::SelectScalar:
+            EmitSelectScalar(instr);
+            break;
+
+        /* ----- Control flow ----- */
+
+        case NullComputeOp::Branch:
+            EmitBranch(pc, instr.a);
+            break;
+
+        case NullComputeOp::BranchConditional:
+            asm_.MovRegMem(Reg::EAX, RegMem(instr.a));
+            asm_.TestRegReg(Reg::EAX, Reg::EAX);
+            asm_.Jcc(CondCode::NE, labels_[instr.b]);
+            EmitBranch(pc, instr.c);
+            break;
+
+        case NullComputeOp::Switch:
+        {
+            const std::uint32_t* cases = program_.params.data() + instr.b;
+            asm_.MovRegMem(Reg::EAX, RegMem(instr.a));
+            for_range(i, instr.c)
+            {
+                asm_.ALURegImm32(ALUOp::Cmp, Reg::EAX, cases[1 + i * 2]);
+                asm_.Jcc(CondCode::E, labels_[cases[2 + i * 2]]);
+            }
+            EmitBranch(pc, cases[0]);
+        }
+        break;
+
+        case NullComputeOp::Call:
+            EmitCall(instr);
+            break;
+
+        case NullComputeOp::Return:
+            asm_.RetNear();
+            break;
+
+        case NullComputeOp::ReturnValue:
+            EmitReturnValue(instr);
+            break;
+
+        case NullComputeOp::Kill:
+            asm_.Jmp(epilogue_);
+            break;
+
+        case NullComputeOp::Barrier:
+            /* Barriers require suspending invocations, which is only supported by the interpreter */
+            return false;
+
+        default:
+            EmitFallback(instr);
+            break;
+    }
+    return true;
+}
+
+void NullComputeCodeGenerator::EmitFallback(const NullComputeInstr& instr)
+{
+    /* Let the interpreter execute this instruction; the invocation memory is the only state, so nothing needs to be spilled */
+    asm_.MovRegReg(AMD64Assembler::GetIntParamReg(0), Reg::RBX);
+    asm_.MovRegImm(AMD64Assembler::GetIntParamReg(1), reinterpret_cast<std::uint64_t>(&instr));
+    asm_.MovRegImm(AMD64Assembler::GetIntParamReg(2), reinterpret_cast<std::uint64_t>(program_.params.data()));
+    asm_.CallAddr(reinterpret_cast<const void*>(&ExecuteNullComputeInstr));
+}
+
+void NullComputeCodeGenerator::EmitCopy(std::uint32_t dst, std::uint32_t src, std::uint32_t n)
+{
+    if (dst == src || n == 0)
+        return;
+
+    if (dst > src && dst < src + n)
+    {
+        /* Copy overlapping ranges backwards */
+        for (std::uint32_t i = n; i > 0; --i)
+        {
+            asm_.MovRegMem(Reg::EAX, RegMem(src, i - 1));
+            asm_.MovMemReg(RegMem(dst, i - 1), Reg::EAX);
+        }
+    }
+    else
+    {
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            if (n - i >= 4)
+            {
+                asm_.SSERegMem(SSEOp::MovUPS, Reg::XMM0, RegMem(src, i));
+                asm_.SSEMemReg(SSEOp::MovUPS, RegMem(dst, i), Reg::XMM0);
+                i += 3;
+            }
+            else
+            {
+                asm_.MovRegMem(Reg::EAX, RegMem(src, i));
+                asm_.MovMemReg(RegMem(dst, i), Reg::EAX);
+            }
+        }
+    }
+}
+
+void NullComputeCodeGenerator::EmitIntBinaryOp(const NullComputeInstr& instr, ALUOp op, SSEOp packedOp)
+{
+    for (std::uint32_t i = 0; i < instr.n; ++i)
+    {
+        if (instr.n - i >= 4)
+        {
+            /* Packed SSE instructions require aligned memory operands, so both operands are loaded first */
+            asm_.SSERegMem(SSEOp::MovUPS, Reg::XMM0, RegMem(instr.a, i));
+            asm_.SSERegMem(SSEOp::MovUPS, Reg::XMM1, RegMem(instr.b, i));
+            asm_.SSERegReg(packedOp, Reg::XMM0, Reg::XMM1);
+            asm_.SSEMemReg(SSEOp::MovUPS, RegMem(instr.dst, i), Reg::XMM0);
+            i += 3;
+        }
+        else
+        {
+            asm_.MovRegMem(Reg::EAX, RegMem(instr.a, i));
+            asm_.ALURegMem(op, Reg::EAX, RegMem(instr.b, i));
+            asm_.MovMemReg(RegMem(instr.dst, i), Reg::EAX);
+        }
+    }
+}
+
+void NullComputeCodeGenerator::EmitIntCompare(const NullComputeInstr& instr, CondCode cond)
+{
+    for_range(i, instr.n)
+    {
+        asm_.MovRegMem(Reg::EAX, RegMem(instr.a, i));
+        asm_.ALURegMem(ALUOp::Cmp, Reg::EAX, RegMem(instr.b, i));
+        asm_.SetCC(cond, Reg::EAX);
+        asm_.MovZXRegReg8(Reg::EAX, Reg::EAX);
+        asm_.MovMemReg(RegMem(instr.dst, i), Reg::EAX);
+    }
+}
+
+void NullComputeCodeGenerator::EmitIntMinMax(const NullComputeInstr& instr, CondCode cond)
+{
+    /* Replace first operand by second operand if the condition is met */
+    for_range(i, instr.n)
+    {
+        asm_.MovRegMem(Reg::EAX, RegMem(instr.a, i));
+        asm_.ALURegMem(ALUOp::Cmp, Reg::EAX, RegMem(instr.b, i));
+        asm_.CMovRegMem(cond, Reg::EAX, RegMem(instr.b, i));
+        asm_.MovMemReg(RegMem(instr.dst, i), Reg::EAX);
+    }
+}
+
+void NullComputeCodeGenerator::EmitShift(const NullComputeInstr& instr, ShiftOp op)
+{
+    /* Shift instructions mask the shift count with 31, just like the interpreter */
+    for_range(i, instr.n)
+    {
+        asm_.MovRegMem(Reg::EAX, RegMem(instr.a, i));
+        asm_.MovRegMem(Reg::ECX, RegMem(instr.b, i));
+        asm_.ShiftRegCL(op, Reg::EAX);
+        asm_.MovMemReg(RegMem(instr.dst, i), Reg::EAX);
+    }
+}
+
+void NullComputeCodeGenerator::EmitIntUnaryOp(const NullComputeInstr& instr, NullComputeOp op)
+{
+    for_range(i, instr.n)
+    {
+        asm_.MovRegMem(Reg::EAX, RegMem(instr.a, i));
+        switch (op)
+        {
+            case NullComputeOp::Not:
+                asm_.NotReg(Reg::EAX);
+                break;
+            case NullComputeOp::SNegate:
+                asm_.NegReg(Reg::EAX);
+                break;
+            case NullComputeOp::LogicalNot:
+                asm_.TestRegReg(Reg::EAX, Reg::EAX);
+                asm_.SetCC(CondCode::E, Reg::EAX);
+                asm_.MovZXRegReg8(Reg::EAX, Reg::EAX);
+                break;
+            case NullComputeOp::FNegate:
+                asm_.ALURegImm32(ALUOp::Xor, Reg::EAX, 0x80000000u);
+                break;
+            case NullComputeOp::FAbs:
+                asm_.ALURegImm32(ALUOp::And, Reg::EAX, 0x7FFFFFFFu);
+                break;
+            default:
+                break;
+        }
+        asm_.MovMemReg(RegMem(instr.dst, i), Reg::EAX);
+    }
+}
+
+void NullComputeCodeGenerator::EmitFloatBinaryOp(const NullComputeInstr& instr, SSEOp packedOp, SSEOp scalarOp)
+{
+    for (std::uint32_t i = 0; i < instr.n; ++i)
+    {
+        if (instr.n - i >= 4)
+        {
+            asm_.SSERegMem(SSEOp::MovUPS, Reg::XMM0, RegMem(instr.a, i));
+            asm_.SSERegMem(SSEOp::MovUPS, Reg::XMM1, RegMem(instr.b, i));
+            asm_.SSERegReg(packedOp, Reg::XMM0, Reg::XMM1);
+            asm_.SSEMemReg(SSEOp::MovUPS, RegMem(instr.dst, i), Reg::XMM0);
+            i += 3;
+        }
+        else
+        {
+            asm_.SSERegMem(SSEOp::MovSS, Reg::XMM0, RegMem(instr.a, i));
+            asm_.SSERegMem(scalarOp, Reg::XMM0, RegMem(instr.b, i));
+            asm_.SSEMemReg(SSEOp::MovSS, RegMem(instr.dst, i), Reg::XMM0);
+        }
+    }
+}
+
+void NullComputeCodeGenerator::EmitFloatCompare(const NullComputeInstr& instr)
+{
+    /*
+    UCOMISS sets ZF, PF, and CF for unordered operands, so 'above' conditions are false for NaN.
+    Less-than comparisons swap their operands, and unordered comparisons negate the complementary ordered comparison.
+    */
+    bool swapOperands = false, negate = false;
+    CondCode cond = CondCode::A;
+
+    switch (instr.op)
+    {
+        case NullComputeOp::FOrdGreaterThan:        cond = CondCode::A;                                     break;
+        case NullComputeOp::FOrdGreaterThanEqual:   cond = CondCode::AE;                                    break;
+        case NullComputeOp::FOrdLessThan:           cond = CondCode::A;     swapOperands = true;            break;
+        case NullComputeOp::FOrdLessThanEqual:      cond = CondCode::AE;    swapOperands = true;            break;
+        case NullComputeOp::FUnordGreaterThan:      cond = CondCode::AE;    swapOperands = true;    negate = true;  break;
+        case NullComputeOp::FUnordGreaterThanEqual: cond = CondCode::A;     swapOperands = true;    negate = true;  break;
+        case NullComputeOp::FUnordLessThan:         cond = CondCode::AE;                            negate = true;  break;
+        case NullComputeOp::FUnordLessThanEqual:    cond = CondCode::A;                             negate = true;  break;
+        default:                                                                                    break;
+    }
+
+    for_range(i, instr.n)
+    {
+        const Mem lhs = RegMem(swapOperands ? instr.b : instr.a, i);
+        const Mem rhs = RegMem(swapOperands ? instr.a : instr.b, i);
+
+        asm_.SSERegMem(SSEOp::MovSS, Reg::XMM0, lhs);
+
+        switch (instr.op)
+        {
+            case NullComputeOp::IsNan:
+                asm_.SSERegReg(SSEOp::UComISS, Reg::XMM0, Reg::XMM0);
+                asm_.SetCC(CondCode::P, Reg::EAX);
+                asm_.MovZXRegReg8(Reg::EAX, Reg::EAX);
+                break;
+
+            case NullComputeOp::FOrdEqual:
+            case NullComputeOp::FOrdNotEqual:
+            case NullComputeOp::FUnordNotEqual:
+            {
+                /* Combine ZF with PF to distinguish unordered operands */
+                const bool isUnord = (instr.op == NullComputeOp::FUnordNotEqual);
+                asm_.SSERegMem(SSEOp::UComISS, Reg::XMM0, rhs);
+                asm_.SetCC((instr.op == NullComputeOp::FOrdEqual ? CondCode::E : CondCode::NE), Reg::EAX);
+                asm_.SetCC((isUnord ? CondCode::P : CondCode::NP), Reg::ECX);
+                asm_.MovZXRegReg8(Reg::EAX, Reg::EAX);
+                asm_.MovZXRegReg8(Reg::ECX, Reg::ECX);
+                asm_.ALURegReg((isUnord ? ALUOp::Or : ALUOp::And), Reg::EAX, Reg::ECX);
+            }
+            break;
+
+            case NullComputeOp::FUnordEqual:
+                asm_.SSERegMem(SSEOp::UComISS, Reg::XMM0, rhs);
+                asm_.SetCC(CondCode::E, Reg::EAX);
+                asm_.MovZXRegReg8(Reg::EAX, Reg::EAX);
+                break;
+
+            default:
+                asm_.SSERegMem(SSEOp::UComISS, Reg::XMM0, rhs);
+                asm_.SetCC(cond, Reg::EAX);
+                asm_.MovZXRegReg8(Reg::EAX, Reg::EAX);
+                if (negate)
+                    asm_.ALURegImm32(ALUOp::Xor, Reg::EAX, 1);
+                break;
+        }
+
+        asm_.MovMemReg(RegMem(instr.dst, i), Reg::EAX);
+    }
+}
+
+void NullComputeCodeGenerator::EmitSelect(const NullComputeInstr& instr)
+{
+    for_range(i, instr.n)
+    {
+        asm_.MovRegMem(Reg::ECX, RegMem(instr.a, i));
+        asm_.MovRegMem(Reg::EAX, RegMem(instr.b, i));
+        asm_.TestRegReg(Reg::ECX, Reg::ECX);
+        asm_.CMovRegMem(CondCode::E, Reg::EAX, RegMem(instr.c, i));
+        asm_.MovMemReg(RegMem(instr.dst, i), Reg::EAX);
+    }
+}
+
+void NullComputeCodeGenerator::EmitSelectScalar(const NullComputeInstr& instr)
+{
+    const Label elseLabel = asm_.NewLabel();
+    const Label endLabel = asm_.NewLabel();
+
+    asm_.MovRegMem(Reg::EAX, RegMem(instr.a));
+    asm_.TestRegReg(Reg::EAX, Reg::EAX);
+    asm_.Jcc(CondCode::E, elseLabel);
+    EmitCopy(instr.dst, instr.b, instr.n);
+    asm_.Jmp(endLabel);
+    asm_.BindLabel(elseLabel);
+    EmitCopy(instr.dst, instr.c, instr.n);
+    asm_.BindLabel(endLabel);
+}
+
+void NullComputeCodeGenerator::EmitVectorTimesScalar(const NullComputeInstr& instr)
+{
+    /* Broadcast scalar into all components of XMM1 */
+    asm_.SSERegMem(SSEOp::MovSS, Reg::XMM1, RegMem(instr.b));
+    asm_.ShufPS(Reg::XMM1, Reg::XMM1, 0x00);
+
+    for (std::uint32_t i = 0; i < instr.n; ++i)
+    {
+        if (instr.n - i >= 4)
+        {
+            asm_.SSERegMem(SSEOp::MovUPS, Reg::XMM0, RegMem(instr.a, i));
+            asm_.SSERegReg(SSEOp::MulPS, Reg::XMM0, Reg::XMM1);
+            asm_.SSEMemReg(SSEOp::MovUPS, RegMem(instr.dst, i), Reg::XMM0);
+            i += 3;
+        }
+        else
+        {
+            asm_.SSERegMem(SSEOp::MovSS, Reg::XMM0, RegMem(instr.a, i));
+            asm_.SSERegReg(SSEOp::MulSS, Reg::XMM0, Reg::XMM1);
+            asm_.SSEMemReg(SSEOp::MovSS, RegMem(instr.dst, i), Reg::XMM0);
+        }
+    }
+}
+
+void NullComputeCodeGenerator::EmitDotProduct(std::uint32_t dst, std::uint32_t a, std::uint32_t aStride, std::uint32_t b, std::uint32_t bStride, std::uint32_t n)
+{
+    /* Accumulate products in the same order as the interpreter to get identical results */
+    asm_.SSERegReg(SSEOp::XorPS, Reg::XMM0, Reg::XMM0);
+    for_range(i, n)
+    {
+        asm_.SSERegMem(SSEOp::MovSS, Reg::XMM1, RegMem(a, i * aStride));
+        asm_.SSERegMem(SSEOp::MulSS, Reg::XMM1, RegMem(b, i * bStride));
+        asm_.SSERegReg(SSEOp::AddSS, Reg::XMM0, Reg::XMM1);
+    }
+    asm_.SSEMemReg(SSEOp::MovSS, RegMem(dst), Reg::XMM0);
+}
+
+void NullComputeCodeGenerator::EmitLoad(const NullComputeInstr& instr)
+{
+    const Label zeroLabel = asm_.NewLabel();
+    const Label endLabel = asm_.NewLabel();
+
+    /* Check pointer range: RSI = address, RAX = end - address */
+    asm_.MovRegMem(Reg::RSI, RegMem(instr.a));
+    asm_.TestRegReg(Reg::RSI, Reg::RSI);
+    asm_.Jcc(CondCode::E, zeroLabel);
+    asm_.MovRegMem(Reg::RAX, RegMem(instr.a, 2));
+    asm_.ALURegReg(ALUOp::Sub, Reg::RAX, Reg::RSI);
+    asm_.ALURegImm32(ALUOp::Cmp, Reg::RAX, instr.n * sizeof(std::uint32_t));
+    asm_.Jcc(CondCode::B, zeroLabel);
+
+    for_range(i, instr.n)
+    {
+        asm_.MovRegMem(Reg::ECX, Mem{ Reg::RSI, static_cast<std::int32_t>(i * sizeof(std::uint32_t)) });
+        asm_.MovMemReg(RegMem(instr.dst, i), Reg::ECX);
+    }
+    asm_.Jmp(endLabel);
+
+    /* Out of bounds loads return zero */
+    asm_.BindLabel(zeroLabel);
+    for_range(i, instr.n)
+        asm_.MovMemImm32(RegMem(instr.dst, i), 0);
+
+    asm_.BindLabel(endLabel);
+}
+
+void NullComputeCodeGenerator::EmitStore(const NullComputeInstr& instr)
+{
+    const Label endLabel = asm_.NewLabel();
+
+    /* Out of bounds stores are discarded */
+    asm_.MovRegMem(Reg::RSI, RegMem(instr.a));
+    asm_.TestRegReg(Reg::RSI, Reg::RSI);
+    asm_.Jcc(CondCode::E, endLabel);
+    asm_.MovRegMem(Reg::RAX, RegMem(instr.a, 2));
+    asm_.ALURegReg(ALUOp::Sub, Reg::RAX, Reg::RSI);
+    asm_.ALURegImm32(ALUOp::Cmp, Reg::RAX, instr.n * sizeof(std::uint32_t));
+    asm_.Jcc(CondCode::B, endLabel);
+
+    for_range(i, instr.n)
+    {
+        asm_.MovRegMem(Reg::ECX, RegMem(instr.b, i));
+        asm_.MovMemReg(Mem{ Reg::RSI, static_cast<std::int32_t>(i * sizeof(std::uint32_t)) }, Reg::ECX);
+    }
+
+    asm_.BindLabel(endLabel);
+}
+
+bool NullComputeCodeGenerator::EmitAccessChain(const NullComputeInstr& instr)
+{
+    const std::uint32_t* steps = program_.params.data() + instr.b;
+
+    /* Byte offsets and strides must fit into 32-bit immediates */
+    for_range(i, instr.c)
+    {
+        const std::uint32_t* step = steps + i * 4;
+        const std::uint32_t words = (static_cast<NullComputeAccessStep>(step[0]) == NullComputeAccessStep::Offset ? step[1] : step[2]);
+        if (words > g_maxInvocationMemorySize)
+            return false;
+    }
+
+    const Label oobLabel = asm_.NewLabel();
+    const Label endLabel = asm_.NewLabel();
+
+    /* RSI = address, RDI = end */
+    asm_.MovRegMem(Reg::RSI, RegMem(instr.a));
+    asm_.MovRegMem(Reg::RDI, RegMem(instr.a, 2));
+    asm_.TestRegReg(Reg::RSI, Reg::RSI);
+    asm_.Jcc(CondCode::E, oobLabel);
+
+    for_range(i, instr.c)
+    {
+        const std::uint32_t* step = steps + i * 4;
+        switch (static_cast<NullComputeAccessStep>(step[0]))
+        {
+            case NullComputeAccessStep::Offset:
+            {
+                if (step[1] == 0)
+                    break;
+                const std::uint32_t offset = step[1] * sizeof(std::uint32_t);
+                asm_.MovRegReg(Reg::RAX, Reg::RDI);
+                asm_.ALURegReg(ALUOp::Sub, Reg::RAX, Reg::RSI);
+                asm_.ALURegImm32(ALUOp::Cmp, Reg::RAX, offset);
+                asm_.Jcc(CondCode::B, oobLabel);
+                asm_.ALURegImm32(ALUOp::Add, Reg::RSI, offset);
+            }
+            break;
+
+            case NullComputeAccessStep::Index:
+            case NullComputeAccessStep::RuntimeIndex:
+            {
+                /* Load index zero-extended into RAX and check array length for fixed-size arrays */
+                asm_.MovRegMem(Reg::EAX, RegMem(step[1]));
+                if (static_cast<NullComputeAccessStep>(step[0]) == NullComputeAccessStep::Index)
+                {
+                    asm_.ALURegImm32(ALUOp::Cmp, Reg::EAX, step[3]);
+                    asm_.Jcc(CondCode::AE, oobLabel);
+                }
+                asm_.IMulRegRegImm32(Reg::RAX, Reg::RAX, static_cast<std::int32_t>(step[2] * sizeof(std::uint32_t)));
+                asm_.MovRegReg(Reg::RDX, Reg::RDI);
+                asm_.ALURegReg(ALUOp::Sub, Reg::RDX, Reg::RSI);
+                asm_.ALURegReg(ALUOp::Cmp, Reg::RAX, Reg::RDX);
+                asm_.Jcc(CondCode::A, oobLabel);
+                asm_.ALURegReg(ALUOp::Add, Reg::RSI, Reg::RAX);
+            }
+            break;
+        }
+    }
+
+    asm_.MovMemReg(RegMem(instr.dst), Reg::RSI);
+    asm_.MovMemReg(RegMem(instr.dst, 2), Reg::RDI);
+    asm_.Jmp(endLabel);
+
+    /* Out of bounds pointers have a null address */
+    asm_.BindLabel(oobLabel);
+    asm_.MovMemImm32(RegMem(instr.dst), 0, true);
+    asm_.MovMemReg(RegMem(instr.dst, 2), Reg::RDI);
+
+    asm_.BindLabel(endLabel);
+    return true;
+}
+
+void NullComputeCodeGenerator::EmitBranch(std::uint32_t pc, std::uint32_t target)
+{
+    /* Fall through to the next instruction */
+    if (target != pc + 1)
+        asm_.Jmp(labels_[target]);
+}
+
+void NullComputeCodeGenerator::EmitCall(const NullComputeInstr& instr)
+{
+    /* Copy arguments into parameter registers */
+    const std::uint32_t* args = program_.params.data() + instr.b;
+    for_range(i, instr.c)
+        EmitCopy(args[i * 3], args[i * 3 + 1], args[i * 3 + 2]);
+
+    /* Pass destination address for the return value on the stack, which also keeps the stack 16-byte aligned within the callee */
+    asm_.Lea(Reg::RAX, RegMem(instr.dst));
+    asm_.PushReg(Reg::RAX);
+    asm_.CallLabel(labels_[instr.a]);
+    asm_.ALURegImm32(ALUOp::Add, Reg::RSP, 8);
+}
+
+void NullComputeCodeGenerator::EmitReturnValue(const NullComputeInstr& instr)
+{
+    /* Destination address was pushed by the caller right before the return address */
+    asm_.MovRegMem(Reg::RAX, Mem{ Reg::RSP, 8 });
+    for_range(i, instr.n)
+    {
+        asm_.MovRegMem(Reg::ECX, RegMem(instr.a, i));
+        asm_.MovMemReg(Mem{ Reg::RAX, static_cast<std::int32_t>(i * sizeof(std::uint32_t)) }, Reg::ECX);
+    }
+    asm_.RetNear();
+}
+
+#endif // /LLGL_ARCH_AMD64
+
+
+/*
+ * NullComputeKernel class
+ */
+
+std::unique_ptr<NullComputeKernel> NullComputeKernel::Compile(const NullComputeProgram& program)
+{
+    #ifdef LLGL_ARCH_AMD64
+
+    /* Barriers are only supported by the interpreter */
+    if (program.hasBarriers || program.instrs.empty() || program.invocationMemory.size() > g_maxInvocationMemorySize)
+        return nullptr;
+
+    try
+    {
+        NullComputeCodeGenerator generator{ program };
+        if (auto jitProgram = generator.Generate())
+            return std::unique_ptr<NullComputeKernel>(new NullComputeKernel(std::move(jitProgram)));
+    }
+    catch (const std::exception&)
+    {
+        /* Fall back to interpreter if executable memory cannot be allocated */
+    }
+
+    #endif // /LLGL_ARCH_AMD64
+
+    return nullptr;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+NullComputeKernel::NullComputeKernel(std::unique_ptr<JITProgram>&& program) :
+    program_    { std::move(program)                                            },
+    entryPoint_ { reinterpret_cast<EntryPoint>(program_->GetEntryPoint())       }
+{
+}
+
+
+} // /namespace LLGL
+
+#endif // /LLGL_ENABLE_JIT_COMPILER
+
+
+
+// ================================================================================
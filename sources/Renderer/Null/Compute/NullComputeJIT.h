@@ -0,0 +1,71 @@
+/*
+ * NullComputeJIT.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_COMPUTE_JIT_H
+#define LLGL_NULL_COMPUTE_JIT_H
+
+
+#ifdef LLGL_ENABLE_JIT_COMPILER
+
+
+#include "NullComputeProgram.h"
+#include "../../../JIT/JITProgram.h"
+#include <memory>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Native compute kernel that is compiled from a NullComputeProgram once per pipeline state.
+The kernel runs a single invocation on the same invocation memory layout the interpreter uses,
+so both can be used interchangeably. Instructions without a native code path are delegated to the interpreter.
+*/
+class NullComputeKernel
+{
+
+    public:
+
+        // Function signature of the native entry point.
+        typedef void (*EntryPoint)(std::uint32_t* invocationMemory);
+
+    public:
+
+        // Compiles the specified program into native code. Returns null if the program or the CPU architecture is not supported.
+        static std::unique_ptr<NullComputeKernel> Compile(const NullComputeProgram& program);
+
+        // Runs a single invocation with the specified invocation memory.
+        inline void Run(std::uint32_t* invocationMemory) const
+        {
+            entryPoint_(invocationMemory);
+        }
+
+    private:
+
+        NullComputeKernel(std::unique_ptr<JITProgram>&& program);
+
+    private:
+
+        std::unique_ptr<JITProgram> program_;
+        EntryPoint                  entryPoint_ = nullptr;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif // /LLGL_ENABLE_JIT_COMPILER
+
+
+#endif
+
+
+
+// ================================================================================
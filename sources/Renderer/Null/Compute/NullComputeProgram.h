@@ -0,0 +1,312 @@
+/*
+ * NullComputeProgram.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_COMPUTE_PROGRAM_H
+#define LLGL_NULL_COMPUTE_PROGRAM_H
+
+
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Opcodes of the register based intermediate representation SPIR-V compute shaders are translated into.
+enum class NullComputeOp : std::uint8_t
+{
+    /* Data movement */
+    Nop,
+    Copy,                   // dst[0..n) = a[0..n)
+    Load,                   // dst[0..n) = *ptr(a); loads zeros if the pointer is out of bounds
+    Store,                  // *ptr(a) = b[0..n); discarded if the pointer is out of bounds
+    CopyMemory,             // *ptr(a) = *ptr(b) with n words
+    AccessChain,            // dst = ptr(a) advanced by the access chain steps params[b..b+c*4)
+    ArrayLength,            // dst = (end(a) - addr(a) - b words) / c words
+    ExtractDynamic,         // dst = a[b] for b < n, zero otherwise
+    InsertDynamic,          // dst = a; dst[c] = b for c < n
+
+    /* Integer arithmetic */
+    IAdd,
+    ISub,
+    IMul,
+    SDiv,
+    UDiv,
+    SRem,
+    SMod,
+    UMod,
+    SNegate,
+    ShiftLeftLogical,
+    ShiftRightLogical,
+    ShiftRightArithmetic,
+    BitwiseAnd,
+    BitwiseOr,
+    BitwiseXor,
+    Not,
+    BitCount,
+    BitReverse,
+    BitFieldSExtract,
+    BitFieldUExtract,
+    SAbs,
+    SSign,
+    SMin,
+    SMax,
+    UMin,
+    UMax,
+    SClamp,
+    UClamp,
+    FindILsb,
+    FindSMsb,
+    FindUMsb,
+
+    /* Integer and boolean comparison */
+    IEqual,
+    INotEqual,
+    SLessThan,
+    SLessThanEqual,
+    SGreaterThan,
+    SGreaterThanEqual,
+    ULessThan,
+    ULessThanEqual,
+    UGreaterThan,
+    UGreaterThanEqual,
+    LogicalNot,
+    Any,
+    All,
+
+    /* Floating-point arithmetic */
+    FAdd,
+    FSub,
+    FMul,
+    FDiv,
+    FRem,
+    FMod,
+    FNegate,
+    VectorTimesScalar,      // dst[i] = a[i] * b[0]
+    Dot,                    // dst[0] = sum(a[i] * b[i])
+    MatrixTimesVector,      // dst[0..n) = a * b with a matrix of c columns
+    VectorTimesMatrix,      // dst[0..n) = a * b with a matrix of c rows
+    MatrixTimesMatrix,      // dst = a * b with n rows, (c & 0xFFFF) columns in a, and (c >> 16) columns in b
+
+    /* Floating-point comparison */
+    FOrdEqual,
+    FOrdNotEqual,
+    FOrdLessThan,
+    FOrdLessThanEqual,
+    FOrdGreaterThan,
+    FOrdGreaterThanEqual,
+    FUnordEqual,
+    FUnordNotEqual,
+    FUnordLessThan,
+    FUnordLessThanEqual,
+    FUnordGreaterThan,
+    FUnordGreaterThanEqual,
+    IsNan,
+    IsInf,
+
+    /* Conversion and selection */
+    ConvertFToS,
+    ConvertFToU,
+    ConvertSToF,
+    ConvertUToF,
+    Select,                 // dst[i] = (a[i] ? b[i] : c[i])
+    SelectScalar,           // dst[0..n) = (a[0] ? b[0..n) : c[0..n))
+
+    /* Extended instructions (GLSL.std.450) */
+    Round,
+    RoundEven,
+    Trunc,
+    FAbs,
+    FSign,
+    Floor,
+    Ceil,
+    Fract,
+    Sqrt,
+    InverseSqrt,
+    Sin,
+    Cos,
+    Tan,
+    Asin,
+    Acos,
+    Atan,
+    Atan2,
+    Exp,
+    Exp2,
+    Log,
+    Log2,
+    Pow,
+    FMin,
+    FMax,
+    FClamp,
+    FMix,
+    Step,
+    SmoothStep,
+    Fma,
+    Length,
+    Distance,
+    Normalize,
+    Cross,
+    PackHalf2x16,
+    UnpackHalf2x16,
+    PackUnorm4x8,
+    UnpackUnorm4x8,
+
+    /* Atomics: dst = old value, a = pointer, b = value, c = comparator */
+    AtomicLoad,
+    AtomicStore,
+    AtomicExchange,
+    AtomicCompareExchange,
+    AtomicIAdd,
+    AtomicISub,
+    AtomicSMin,
+    AtomicUMin,
+    AtomicSMax,
+    AtomicUMax,
+    AtomicAnd,
+    AtomicOr,
+    AtomicXor,
+
+    /* Images: a = image handle, b = coordinate with (n & 0xFF) components, texel with (n >> 8) components, type = NullComputeScalar */
+    ImageRead,              // dst = texel
+    ImageWrite,             // texel = c
+    ImageFetch,             // dst = texel of MIP-map level c (or 0 if c is invalidRegister)
+    ImageQuerySize,         // dst[0..n) = extent of MIP-map level b (or 0 if b is invalidRegister)
+    ImageQueryLevels,       // dst[0] = number of MIP-map levels
+    ImageSample,            // dst = filtered texel of the image and sampler handles a; params[c..c+5) = { lod, bias, ddx, ddy, dref } registers or invalidRegister
+
+    /* Control flow */
+    Branch,                 // pc = a
+    BranchConditional,      // pc = (a[0] ? b : c)
+    Switch,                 // pc = case of a[0] in params[b..b+1+c*2)
+    Call,                   // pc = a; arguments in params[b..b+c*3); return value into dst[0..n)
+    Return,
+    ReturnValue,            // Returns a[0..n)
+    Barrier,                // Suspends the invocation until all invocations of the work group reached the barrier
+    Kill,                   // Terminates the invocation
+};
+
+// Scalar component type for image instructions.
+enum class NullComputeScalar : std::uint8_t
+{
+    Float,
+    SInt,
+    UInt,
+};
+
+// Kinds of access chain steps stored in the program parameters.
+enum class NullComputeAccessStep : std::uint32_t
+{
+    Offset,         // { Offset, words, 0, 0 }
+    Index,          // { Index, indexRegister, strideWords, length }
+    RuntimeIndex,   // { RuntimeIndex, indexRegister, strideWords, 0 }; length is determined by the pointer range
+};
+
+// Built-in input variables of compute shaders.
+enum class NullComputeBuiltin
+{
+    NumWorkGroups,
+    WorkGroupID,
+    LocalInvocationID,
+    GlobalInvocationID,
+    LocalInvocationIndex,
+    Count,
+};
+
+// Resource types a binding point can refer to.
+enum class NullComputeBindingType
+{
+    Buffer,         // Uniform or storage buffer; pointer to the buffer range
+    Image,          // Storage or sampled image; pointer to an image handle
+    SampledImage,   // Combined image-sampler; pointer to an image and sampler handle
+    Sampler,        // Sampler state; pointer to a sampler handle
+};
+
+// Single instruction of the intermediate representation. Operands are word offsets into the register file unless noted otherwise.
+struct NullComputeInstr
+{
+    NullComputeOp   op;
+    std::uint8_t    type;   // Operation specific type, e.g. NullComputeScalar for image instructions
+    std::uint16_t   n;      // Number of components or words
+    std::uint32_t   dst;
+    std::uint32_t   a;
+    std::uint32_t   b;
+    std::uint32_t   c;
+};
+
+// Memory range a pointer register refers to. A null address denotes an out of bounds pointer.
+struct NullComputePointer
+{
+    char* addr;
+    char* end;
+};
+
+// Pointer register that is initialized with a memory range for each invocation.
+struct NullComputeMemoryRange
+{
+    std::uint32_t reg;      // Pointer register
+    std::uint32_t offset;   // Word offset into the invocation memory or work group memory
+    std::uint32_t size;     // Size (in words) of the memory range
+};
+
+// Pointer register that is initialized with a resource binding for each dispatch.
+struct NullComputeBindingPoint
+{
+    std::uint32_t           reg;        // Pointer register
+    std::uint32_t           set;        // SPIR-V descriptor set
+    std::uint32_t           binding;    // SPIR-V binding
+    NullComputeBindingType  type;
+};
+
+/*
+Compute shader program for the Null renderer translated from a SPIR-V module.
+Each SSA value of the module is assigned a fixed location in a register file of 32-bit words.
+Since SPIR-V does not allow recursion, function variables are allocated statically as well.
+Each invocation owns a contiguous block of memory that starts with the register file followed by its private variables.
+Pointers are stored in registers as a pair of host addresses for the begin and end of the addressable range,
+so that out of bounds accesses can be detected without knowledge of the underlying resource.
+*/
+class NullComputeProgram
+{
+
+    public:
+
+        // Invalid register index to denote unused optional operands.
+        static constexpr std::uint32_t invalidRegister = ~0u;
+
+        // Number of words a pointer occupies in the register file.
+        static constexpr std::uint32_t pointerWords = 4;
+
+        // Number of words an image or sampler handle occupies in the register file.
+        static constexpr std::uint32_t handleWords = 2;
+
+    public:
+
+        std::vector<NullComputeInstr>           instrs;
+        std::vector<std::uint32_t>              params;                 // Extended operands of access chains, switches, function calls, and image samples
+        std::vector<std::uint32_t>              invocationMemory;       // Initial register file and private memory of each invocation
+        std::vector<NullComputeMemoryRange>     privatePointers;        // Pointers into the invocation memory
+        std::vector<NullComputeMemoryRange>     workGroupPointers;      // Pointers into the work group memory
+        std::vector<NullComputeBindingPoint>    bindingPoints;
+        std::uint32_t                           builtins[static_cast<int>(NullComputeBuiltin::Count)];  // Word offsets into the invocation memory or invalidRegister
+        std::uint32_t                           workGroupMemorySize     = 0;    // Size (in words) of the work group memory
+        std::uint32_t                           entryPointPc            = 0;
+        std::uint32_t                           maxCallDepth            = 1;
+        std::uint32_t                           localSize[3]            = { 1, 1, 1 };
+        bool                                    hasBarriers             = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,1829 @@
+/*
+ * NullComputeTranslator.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "NullComputeTranslator.h"
+#include "../../SPIRV/SpirvModule.h"
+#include "../../SPIRV/SpirvInstructionInfo.h"
+#include <spirv/1.2/GLSL.std.450.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+using Op = spv::Op;
+
+constexpr std::uint32_t NullComputeProgram::invalidRegister;
+constexpr std::uint32_t NullComputeProgram::pointerWords;
+constexpr std::uint32_t NullComputeProgram::handleWords;
+
+// Maximum number of words a single instruction can move, limited by NullComputeInstr::n.
+static constexpr std::uint32_t g_maxInstrWords = 0xFFFF;
+
+static std::uint64_t MakeMemberKey(spv::Id structType, std::uint32_t member)
+{
+    return ((static_cast<std::uint64_t>(structType) << 32) | member);
+}
+
+// Maps componentwise SPIR-V instructions to their IR opcode and returns the number of operands, or 0 if the instruction is not componentwise.
+static int GetComponentwiseOp(const Op opcode, NullComputeOp& outOp)
+{
+    switch (opcode)
+    {
+        /* Unary instructions */
+        case Op::OpSNegate:                 outOp = NullComputeOp::SNegate;                 return 1;
+        case Op::OpFNegate:                 outOp = NullComputeOp::FNegate;                 return 1;
+        case Op::OpNot:                     outOp = NullComputeOp::Not;                     return 1;
+        case Op::OpLogicalNot:              outOp = NullComputeOp::LogicalNot;              return 1;
+        case Op::OpIsNan:                   outOp = NullComputeOp::IsNan;                   return 1;
+        case Op::OpIsInf:                   outOp = NullComputeOp::IsInf;                   return 1;
+        case Op::OpConvertFToS:             outOp = NullComputeOp::ConvertFToS;             return 1;
+        case Op::OpConvertFToU:             outOp = NullComputeOp::ConvertFToU;             return 1;
+        case Op::OpConvertSToF:             outOp = NullComputeOp::ConvertSToF;             return 1;
+        case Op::OpConvertUToF:             outOp = NullComputeOp::ConvertUToF;             return 1;
+        case Op::OpBitCount:                outOp = NullComputeOp::BitCount;                return 1;
+        case Op::OpBitReverse:              outOp = NullComputeOp::BitReverse;              return 1;
+
+        /* Binary instructions */
+        case Op::OpIAdd:                    outOp = NullComputeOp::IAdd;                    return 2;
+        case Op::OpISub:                    outOp = NullComputeOp::ISub;                    return 2;
+        case Op::OpIMul:                    outOp = NullComputeOp::IMul;                    return 2;
+        case Op::OpSDiv:                    outOp = NullComputeOp::SDiv;                    return 2;
+        case Op::OpUDiv:                    outOp = NullComputeOp::UDiv;                    return 2;
+        case Op::OpSRem:                    outOp = NullComputeOp::SRem;                    return 2;
+        case Op::OpSMod:                    outOp = NullComputeOp::SMod;                    return 2;
+        case Op::OpUMod:                    outOp = NullComputeOp::UMod;                    return 2;
+        case Op::OpShiftLeftLogical:        outOp = NullComputeOp::ShiftLeftLogical;        return 2;
+        case Op::OpShiftRightLogical:       outOp = NullComputeOp::ShiftRightLogical;       return 2;
+        case Op::OpShiftRightArithmetic:    outOp = NullComputeOp::ShiftRightArithmetic;    return 2;
+        case Op::OpBitwiseAnd:              outOp = NullComputeOp::BitwiseAnd;              return 2;
+        case Op::OpBitwiseOr:               outOp = NullComputeOp::BitwiseOr;               return 2;
+        case Op::OpBitwiseXor:              outOp = NullComputeOp::BitwiseXor;              return 2;
+        case Op::OpLogicalAnd:              outOp = NullComputeOp::BitwiseAnd;              return 2;
+        case Op::OpLogicalOr:               outOp = NullComputeOp::BitwiseOr;               return 2;
+        case Op::OpLogicalEqual:            outOp = NullComputeOp::IEqual;                  return 2;
+        case Op::OpLogicalNotEqual:         outOp = NullComputeOp::INotEqual;               return 2;
+        case Op::OpIEqual:                  outOp = NullComputeOp::IEqual;                  return 2;
+        case Op::OpINotEqual:               outOp = NullComputeOp::INotEqual;               return 2;
+        case Op::OpSLessThan:               outOp = NullComputeOp::SLessThan;               return 2;
+        case Op::OpSLessThanEqual:          outOp = NullComputeOp::SLessThanEqual;          return 2;
+        case Op::OpSGreaterThan:            outOp = NullComputeOp::SGreaterThan;            return 2;
+        case Op::OpSGreaterThanEqual:       outOp = NullComputeOp::SGreaterThanEqual;       return 2;
+        case Op::OpULessThan:               outOp = NullComputeOp::ULessThan;               return 2;
+        case Op::OpULessThanEqual:          outOp = NullComputeOp::ULessThanEqual;          return 2;
+        case Op::OpUGreaterThan:            outOp = NullComputeOp::UGreaterThan;            return 2;
+        case Op::OpUGreaterThanEqual:       outOp = NullComputeOp::UGreaterThanEqual;       return 2;
+        case Op::OpFAdd:                    outOp = NullComputeOp::FAdd;                    return 2;
+        case Op::OpFSub:                    outOp = NullComputeOp::FSub;                    return 2;
+        case Op::OpFMul:                    outOp = NullComputeOp::FMul;                    return 2;
+        case Op::OpFDiv:                    outOp = NullComputeOp::FDiv;                    return 2;
+        case Op::OpFRem:                    outOp = NullComputeOp::FRem;                    return 2;
+        case Op::OpFMod:                    outOp = NullComputeOp::FMod;                    return 2;
+        case Op::OpFOrdEqual:               outOp = NullComputeOp::FOrdEqual;               return 2;
+        case Op::OpFOrdNotEqual:            outOp = NullComputeOp::FOrdNotEqual;            return 2;
+        case Op::OpFOrdLessThan:            outOp = NullComputeOp::FOrdLessThan;            return 2;
+        case Op::OpFOrdLessThanEqual:       outOp = NullComputeOp::FOrdLessThanEqual;       return 2;
+        case Op::OpFOrdGreaterThan:         outOp = NullComputeOp::FOrdGreaterThan;         return 2;
+        case Op::OpFOrdGreaterThanEqual:    outOp = NullComputeOp::FOrdGreaterThanEqual;    return 2;
+        case Op::OpFUnordEqual:             outOp = NullComputeOp::FUnordEqual;             return 2;
+        case Op::OpFUnordNotEqual:          outOp = NullComputeOp::FUnordNotEqual;          return 2;
+        case Op::OpFUnordLessThan:          outOp = NullComputeOp::FUnordLessThan;          return 2;
+        case Op::OpFUnordLessThanEqual:     outOp = NullComputeOp::FUnordLessThanEqual;     return 2;
+        case Op::OpFUnordGreaterThan:       outOp = NullComputeOp::FUnordGreaterThan;       return 2;
+        case Op::OpFUnordGreaterThanEqual:  outOp = NullComputeOp::FUnordGreaterThanEqual;  return 2;
+
+        /* Ternary instructions */
+        case Op::OpBitFieldSExtract:        outOp = NullComputeOp::BitFieldSExtract;        return 3;
+        case Op::OpBitFieldUExtract:        outOp = NullComputeOp::BitFieldUExtract;        return 3;
+
+        default:                                                                            return 0;
+    }
+}
+
+// Maps GLSL.std.450 extended instructions to their IR opcode and returns the number of operands, or 0 if the instruction is not supported.
+static int GetGLSLStd450Op(std::uint32_t instruction, NullComputeOp& outOp)
+{
+    switch (instruction)
+    {
+        case GLSLstd450Round:           outOp = NullComputeOp::Round;           return 1;
+        case GLSLstd450RoundEven:       outOp = NullComputeOp::RoundEven;       return 1;
+        case GLSLstd450Trunc:           outOp = NullComputeOp::Trunc;           return 1;
+        case GLSLstd450FAbs:            outOp = NullComputeOp::FAbs;            return 1;
+        case GLSLstd450SAbs:            outOp = NullComputeOp::SAbs;            return 1;
+        case GLSLstd450FSign:           outOp = NullComputeOp::FSign;           return 1;
+        case GLSLstd450SSign:           outOp = NullComputeOp::SSign;           return 1;
+        case GLSLstd450Floor:           outOp = NullComputeOp::Floor;           return 1;
+        case GLSLstd450Ceil:            outOp = NullComputeOp::Ceil;            return 1;
+        case GLSLstd450Fract:           outOp = NullComputeOp::Fract;           return 1;
+        case GLSLstd450Sin:             outOp = NullComputeOp::Sin;             return 1;
+        case GLSLstd450Cos:             outOp = NullComputeOp::Cos;             return 1;
+        case GLSLstd450Tan:             outOp = NullComputeOp::Tan;             return 1;
+        case GLSLstd450Asin:            outOp = NullComputeOp::Asin;            return 1;
+        case GLSLstd450Acos:            outOp = NullComputeOp::Acos;            return 1;
+        case GLSLstd450Atan:            outOp = NullComputeOp::Atan;            return 1;
+        case GLSLstd450Atan2:           outOp = NullComputeOp::Atan2;           return 2;
+        case GLSLstd450Pow:             outOp = NullComputeOp::Pow;             return 2;
+        case GLSLstd450Exp:             outOp = NullComputeOp::Exp;             return 1;
+        case GLSLstd450Log:             outOp = NullComputeOp::Log;             return 1;
+        case GLSLstd450Exp2:            outOp = NullComputeOp::Exp2;            return 1;
+        case GLSLstd450Log2:            outOp = NullComputeOp::Log2;            return 1;
+        case GLSLstd450Sqrt:            outOp = NullComputeOp::Sqrt;            return 1;
+        case GLSLstd450InverseSqrt:     outOp = NullComputeOp::InverseSqrt;     return 1;
+        case GLSLstd450FMin:            outOp = NullComputeOp::FMin;            return 2;
+        case GLSLstd450UMin:            outOp = NullComputeOp::UMin;            return 2;
+        case GLSLstd450SMin:            outOp = NullComputeOp::SMin;            return 2;
+        case GLSLstd450FMax:            outOp = NullComputeOp::FMax;            return 2;
+        case GLSLstd450UMax:            outOp = NullComputeOp::UMax;            return 2;
+        case GLSLstd450SMax:            outOp = NullComputeOp::SMax;            return 2;
+        case GLSLstd450FClamp:          outOp = NullComputeOp::FClamp;          return 3;
+        case GLSLstd450UClamp:          outOp = NullComputeOp::UClamp;          return 3;
+        case GLSLstd450SClamp:          outOp = NullComputeOp::SClamp;          return 3;
+        case GLSLstd450FMix:            outOp = NullComputeOp::FMix;            return 3;
+        case GLSLstd450Step:            outOp = NullComputeOp::Step;            return 2;
+        case GLSLstd450SmoothStep:      outOp = NullComputeOp::SmoothStep;      return 3;
+        case GLSLstd450Fma:             outOp = NullComputeOp::Fma;             return 3;
+        case GLSLstd450PackUnorm4x8:    outOp = NullComputeOp::PackUnorm4x8;    return 1;
+        case GLSLstd450PackHalf2x16:    outOp = NullComputeOp::PackHalf2x16;    return 1;
+        case GLSLstd450UnpackHalf2x16:  outOp = NullComputeOp::UnpackHalf2x16;  return 1;
+        case GLSLstd450UnpackUnorm4x8:  outOp = NullComputeOp::UnpackUnorm4x8;  return 1;
+        case GLSLstd450Length:          outOp = NullComputeOp::Length;          return 1;
+        case GLSLstd450Distance:        outOp = NullComputeOp::Distance;        return 2;
+        case GLSLstd450Cross:           outOp = NullComputeOp::Cross;           return 2;
+        case GLSLstd450Normalize:       outOp = NullComputeOp::Normalize;       return 1;
+        case GLSLstd450FindILsb:        outOp = NullComputeOp::FindILsb;        return 1;
+        case GLSLstd450FindSMsb:        outOp = NullComputeOp::FindSMsb;        return 1;
+        case GLSLstd450FindUMsb:        outOp = NullComputeOp::FindUMsb;        return 1;
+        case GLSLstd450NMin:            outOp = NullComputeOp::FMin;            return 2;
+        case GLSLstd450NMax:            outOp = NullComputeOp::FMax;            return 2;
+        case GLSLstd450NClamp:          outOp = NullComputeOp::FClamp;          return 3;
+        default:                                                                return 0;
+    }
+}
+
+// Maps SPIR-V atomic instructions to their IR opcode.
+static bool GetAtomicOp(const Op opcode, NullComputeOp& outOp)
+{
+    switch (opcode)
+    {
+        case Op::OpAtomicExchange:  outOp = NullComputeOp::AtomicExchange;  return true;
+        case Op::OpAtomicIAdd:      outOp = NullComputeOp::AtomicIAdd;      return true;
+        case Op::OpAtomicISub:      outOp = NullComputeOp::AtomicISub;      return true;
+        case Op::OpAtomicSMin:      outOp = NullComputeOp::AtomicSMin;      return true;
+        case Op::OpAtomicUMin:      outOp = NullComputeOp::AtomicUMin;      return true;
+        case Op::OpAtomicSMax:      outOp = NullComputeOp::AtomicSMax;      return true;
+        case Op::OpAtomicUMax:      outOp = NullComputeOp::AtomicUMax;      return true;
+        case Op::OpAtomicAnd:       outOp = NullComputeOp::AtomicAnd;       return true;
+        case Op::OpAtomicOr:        outOp = NullComputeOp::AtomicOr;        return true;
+        case Op::OpAtomicXor:       outOp = NullComputeOp::AtomicXor;       return true;
+        default:                                                            return false;
+    }
+}
+
+static bool MapBuiltin(std::uint32_t builtin, NullComputeBuiltin& outBuiltin)
+{
+    switch (static_cast<spv::BuiltIn>(builtin))
+    {
+        case spv::BuiltIn::NumWorkgroups:           outBuiltin = NullComputeBuiltin::NumWorkGroups;         return true;
+        case spv::BuiltIn::WorkgroupId:             outBuiltin = NullComputeBuiltin::WorkGroupID;           return true;
+        case spv::BuiltIn::LocalInvocationId:       outBuiltin = NullComputeBuiltin::LocalInvocationID;     return true;
+        case spv::BuiltIn::GlobalInvocationId:      outBuiltin = NullComputeBuiltin::GlobalInvocationID;    return true;
+        case spv::BuiltIn::LocalInvocationIndex:    outBuiltin = NullComputeBuiltin::LocalInvocationIndex;  return true;
+        default:                                                                                            return false;
+    }
+}
+
+bool NullComputeTranslator::Translate(
+    const ArrayView<std::uint32_t>& words,
+    const char*                     entryPoint,
+    NullComputeProgram&             outProgram,
+    std::string&                    outError)
+{
+    SpirvModuleView module{ words };
+
+    SpirvHeader header;
+    if (module.ReadHeader(header) != SpirvResult::Success)
+    {
+        outError = "invalid SPIR-V module header";
+        return false;
+    }
+
+    program_ = &outProgram;
+    values_.resize(header.idBound);
+    std::fill(std::begin(outProgram.builtins), std::end(outProgram.builtins), NullComputeProgram::invalidRegister);
+
+    try
+    {
+        /* Parse declarations and collect the instructions of all functions */
+        Function* func = nullptr;
+        bool hasEntryPoint = false;
+
+        for (SpirvInstruction instr : module)
+        {
+            if (instr.opcode == Op::OpFunction)
+            {
+                currentFunc_ = instr.result;
+                func = &(functions_[instr.result]);
+            }
+
+            if (func != nullptr)
+            {
+                func->instrs.push_back(instr);
+                if (instr.opcode == Op::OpFunctionEnd)
+                    func = nullptr;
+            }
+            else if (instr.opcode == Op::OpEntryPoint)
+            {
+                /* Select first compute entry point with matching name */
+                if (!hasEntryPoint &&
+                    static_cast<spv::ExecutionModel>(instr.GetUInt32(0)) == spv::ExecutionModel::GLCompute &&
+                    (entryPoint == nullptr || *entryPoint == '\0' || ::strcmp(instr.GetString(2), entryPoint) == 0))
+                {
+                    entryPointFunc_ = instr.GetUInt32(1);
+                    hasEntryPoint = true;
+                }
+            }
+            else if (!ParseDeclaration(instr))
+                break;
+        }
+
+        if (error_.empty() && !hasEntryPoint)
+            Fail(std::string("no compute entry point found: ") + (entryPoint != nullptr ? entryPoint : ""));
+
+        /* Allocate registers for all functions first, since calls and phi instructions can refer to values defined later */
+        for (auto& it : functions_)
+        {
+            if (!error_.empty())
+                break;
+            currentFunc_ = it.first;
+            AllocFunctionRegisters(it.second);
+        }
+
+        /* Translate instructions of all functions */
+        for (auto& it : functions_)
+        {
+            if (!error_.empty())
+                break;
+            currentFunc_ = it.first;
+            EmitFunction(it.second);
+        }
+
+        if (error_.empty())
+            ResolveLabels();
+    }
+    catch (const std::exception& e)
+    {
+        Fail(e.what());
+    }
+
+    if (!error_.empty())
+    {
+        outError = error_;
+        return false;
+    }
+
+    Finalize(outProgram);
+
+    return true;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullComputeTranslator::Fail(const std::string& message)
+{
+    if (error_.empty())
+        error_ = message;
+}
+
+bool NullComputeTranslator::ParseDeclaration(const SpirvInstruction& instr)
+{
+    if (instr.result >= values_.size())
+    {
+        Fail("SPIR-V result ID out of bounds");
+        return false;
+    }
+
+    switch (instr.opcode)
+    {
+        case Op::OpExtInstImport:
+            if (::strcmp(instr.GetString(0), "GLSL.std.450") == 0)
+                glslStd450_ = instr.result;
+            return true;
+
+        case Op::OpExecutionMode:
+            if (instr.GetUInt32(0) == entryPointFunc_ &&
+                static_cast<spv::ExecutionMode>(instr.GetUInt32(1)) == spv::ExecutionMode::LocalSize &&
+                !hasWorkGroupSize_)
+            {
+                program_->localSize[0] = instr.GetUInt32(2);
+                program_->localSize[1] = instr.GetUInt32(3);
+                program_->localSize[2] = instr.GetUInt32(4);
+            }
+            return true;
+
+        case Op::OpDecorate:
+        case Op::OpMemberDecorate:
+            return ParseDecoration(instr);
+
+        case Op::OpTypeVoid:
+        case Op::OpTypeBool:
+        case Op::OpTypeInt:
+        case Op::OpTypeFloat:
+        case Op::OpTypeVector:
+        case Op::OpTypeMatrix:
+        case Op::OpTypeArray:
+        case Op::OpTypeRuntimeArray:
+        case Op::OpTypeStruct:
+        case Op::OpTypePointer:
+        case Op::OpTypeFunction:
+        case Op::OpTypeImage:
+        case Op::OpTypeSampler:
+        case Op::OpTypeSampledImage:
+            return ParseType(instr);
+
+        case Op::OpConstantTrue:
+        case Op::OpConstantFalse:
+        case Op::OpConstant:
+        case Op::OpConstantComposite:
+        case Op::OpConstantNull:
+        case Op::OpSpecConstantTrue:
+        case Op::OpSpecConstantFalse:
+        case Op::OpSpecConstant:
+        case Op::OpSpecConstantComposite:
+        case Op::OpUndef:
+            return ParseConstant(instr);
+
+        case Op::OpSpecConstantOp:
+            Fail("specialization constant operations are not supported");
+            return false;
+
+        case Op::OpVariable:
+            return ParseGlobalVariable(instr);
+
+        default:
+            /* Ignore capabilities, debug information, and other meta data */
+            return true;
+    }
+}
+
+bool NullComputeTranslator::ParseDecoration(const SpirvInstruction& instr)
+{
+    if (instr.opcode == Op::OpDecorate)
+    {
+        const spv::Id target = instr.GetUInt32(0);
+        if (target >= values_.size())
+            return true;
+
+        auto& value = values_[target];
+        switch (static_cast<spv::Decoration>(instr.GetUInt32(1)))
+        {
+            case spv::Decoration::DescriptorSet:
+                value.set = instr.GetUInt32(2);
+                break;
+            case spv::Decoration::Binding:
+                value.binding = instr.GetUInt32(2);
+                break;
+            case spv::Decoration::BuiltIn:
+                value.builtin = instr.GetUInt32(2);
+                break;
+            case spv::Decoration::ArrayStride:
+                value.arrayStride = instr.GetUInt32(2);
+                break;
+            default:
+                break;
+        }
+    }
+    else
+    {
+        const std::uint64_t key = MakeMemberKey(instr.GetUInt32(0), instr.GetUInt32(1));
+        switch (static_cast<spv::Decoration>(instr.GetUInt32(2)))
+        {
+            case spv::Decoration::Offset:
+                if (instr.GetUInt32(3) % 4 != 0)
+                {
+                    Fail("struct member offsets must be a multiple of 4 bytes");
+                    return false;
+                }
+                memberOffsets_[key] = instr.GetUInt32(3) / 4;
+                break;
+            case spv::Decoration::MatrixStride:
+                matrixStrides_[key] = instr.GetUInt32(3);
+                break;
+            case spv::Decoration::RowMajor:
+                Fail("row-major matrices are not supported");
+                return false;
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+bool NullComputeTranslator::ParseType(const SpirvInstruction& instr)
+{
+    Type type;
+
+    switch (instr.opcode)
+    {
+        case Op::OpTypeVoid:
+        case Op::OpTypeFunction:
+            break;
+
+        case Op::OpTypeBool:
+            type.kind   = TypeKind::Bool;
+            type.size   = 1;
+            break;
+
+        case Op::OpTypeInt:
+            if (instr.GetUInt32(0) != 32)
+            {
+                Fail("only 32-bit integer types are supported");
+                return false;
+            }
+            type.kind       = TypeKind::Int;
+            type.isSigned   = (instr.GetUInt32(1) != 0);
+            type.size       = 1;
+            break;
+
+        case Op::OpTypeFloat:
+            if (instr.GetUInt32(0) != 32)
+            {
+                Fail("only 32-bit floating-point types are supported");
+                return false;
+            }
+            type.kind   = TypeKind::Float;
+            type.size   = 1;
+            break;
+
+        case Op::OpTypeVector:
+        case Op::OpTypeMatrix:
+            type.kind           = (instr.opcode == Op::OpTypeVector ? TypeKind::Vector : TypeKind::Matrix);
+            type.elementType    = instr.GetUInt32(0);
+            type.length         = instr.GetUInt32(1);
+            type.stride         = GetTypeSize(type.elementType);
+            type.size           = type.length * type.stride;
+            break;
+
+        case Op::OpTypeArray:
+        case Op::OpTypeRuntimeArray:
+        {
+            type.elementType    = instr.GetUInt32(0);
+            type.stride         = (values_[instr.result].arrayStride > 0 ? values_[instr.result].arrayStride / 4 : GetTypeSize(type.elementType));
+            if (instr.opcode == Op::OpTypeArray)
+            {
+                const spv::Id lengthId = instr.GetUInt32(1);
+                if (lengthId >= values_.size() || !values_[lengthId].isConstant)
+                {
+                    Fail("array length must be a constant");
+                    return false;
+                }
+                type.kind   = TypeKind::Array;
+                type.length = values_[lengthId].constant;
+                type.size   = type.length * type.stride;
+            }
+            else
+                type.kind = TypeKind::RuntimeArray;
+        }
+        break;
+
+        case Op::OpTypeStruct:
+        {
+            type.kind = TypeKind::Struct;
+            std::uint32_t offset = 0;
+            for_range(i, instr.numOperands)
+            {
+                const spv::Id memberType = instr.operands[i];
+                const std::uint32_t memberSize = GetTypeSize(memberType);
+                const std::uint64_t key = MakeMemberKey(instr.result, i);
+
+                /* Use explicit member offset if specified */
+                auto offsetIt = memberOffsets_.find(key);
+                if (offsetIt != memberOffsets_.end())
+                    offset = offsetIt->second;
+
+                /* Matrices are only supported with tightly packed columns */
+                auto strideIt = matrixStrides_.find(key);
+                if (strideIt != matrixStrides_.end())
+                {
+                    const Type* matrixType = FindType(memberType);
+                    while (matrixType != nullptr && matrixType->kind == TypeKind::Array)
+                        matrixType = FindType(matrixType->elementType);
+                    if (matrixType != nullptr && strideIt->second != matrixType->stride * 4)
+                    {
+                        Fail("only tightly packed matrix columns are supported");
+                        return false;
+                    }
+                }
+
+                type.memberTypes.push_back(memberType);
+                type.memberOffsets.push_back(offset);
+                offset += memberSize;
+                type.size = std::max(type.size, offset);
+            }
+        }
+        break;
+
+        case Op::OpTypePointer:
+            type.kind           = TypeKind::Pointer;
+            type.storageClass   = static_cast<spv::StorageClass>(instr.GetUInt32(0));
+            type.elementType    = instr.GetUInt32(1);
+            type.size           = NullComputeProgram::pointerWords;
+            break;
+
+        case Op::OpTypeImage:
+            type.kind           = TypeKind::Image;
+            type.elementType    = instr.GetUInt32(0);
+            type.dim            = static_cast<spv::Dim>(instr.GetUInt32(1));
+            type.arrayed        = (instr.GetUInt32(3) != 0);
+            type.size           = NullComputeProgram::handleWords;
+            break;
+
+        case Op::OpTypeSampler:
+            type.kind           = TypeKind::Sampler;
+            type.size           = NullComputeProgram::handleWords;
+            break;
+
+        case Op::OpTypeSampledImage:
+            type.kind           = TypeKind::SampledImage;
+            type.elementType    = instr.GetUInt32(0);
+            type.size           = NullComputeProgram::handleWords * 2;
+            break;
+
+        default:
+            return true;
+    }
+
+    types_[instr.result] = std::move(type);
+    return true;
+}
+
+bool NullComputeTranslator::ParseConstant(const SpirvInstruction& instr)
+{
+    const std::uint32_t size = GetTypeSize(instr.type);
+    const std::uint32_t reg = AllocRegister(size);
+
+    auto& value = values_[instr.result];
+    value.type  = instr.type;
+    value.reg   = reg;
+
+    switch (instr.opcode)
+    {
+        case Op::OpConstantTrue:
+        case Op::OpSpecConstantTrue:
+            value.isConstant    = true;
+            value.constant      = 1;
+            registers_[reg]     = 1;
+            break;
+
+        case Op::OpConstantFalse:
+        case Op::OpSpecConstantFalse:
+            value.isConstant    = true;
+            value.constant      = 0;
+            registers_[reg]     = 0;
+            break;
+
+        case Op::OpConstant:
+        case Op::OpSpecConstant:
+            if (size != 1)
+            {
+                Fail("only 32-bit constants are supported");
+                return false;
+            }
+            value.isConstant    = true;
+            value.constant      = instr.GetUInt32(0);
+            registers_[reg]     = value.constant;
+            break;
+
+        case Op::OpConstantComposite:
+        case Op::OpSpecConstantComposite:
+        {
+            const Type* type = FindType(instr.type);
+            if (type == nullptr)
+                return false;
+
+            std::uint32_t offset = 0;
+            for_range(i, instr.numOperands)
+            {
+                const auto& constituent = values_.at(instr.operands[i]);
+                const std::uint32_t constituentSize = GetTypeSize(constituent.type);
+                if (type->kind == TypeKind::Struct)
+                    offset = type->memberOffsets.at(i);
+                else if (type->kind == TypeKind::Array || type->kind == TypeKind::Matrix)
+                    offset = i * type->stride;
+                std::copy_n(registers_.begin() + constituent.reg, constituentSize, registers_.begin() + reg + offset);
+                offset += constituentSize;
+            }
+
+            /* Work group size can be overridden by a built-in constant */
+            if (static_cast<spv::BuiltIn>(values_[instr.result].builtin) == spv::BuiltIn::WorkgroupSize && size == 3)
+            {
+                std::copy_n(registers_.begin() + reg, 3, program_->localSize);
+                hasWorkGroupSize_ = true;
+            }
+        }
+        break;
+
+        default:
+            /* OpConstantNull and OpUndef are zero initialized */
+            break;
+    }
+
+    return true;
+}
+
+bool NullComputeTranslator::ParseGlobalVariable(const SpirvInstruction& instr)
+{
+    const Type* pointerType = FindType(instr.type);
+    if (pointerType == nullptr || pointerType->kind != TypeKind::Pointer)
+    {
+        Fail("variable must be of pointer type");
+        return false;
+    }
+
+    const Type* type = FindType(pointerType->elementType);
+    if (type == nullptr)
+        return false;
+
+    auto& value = values_[instr.result];
+    value.type  = instr.type;
+    value.reg   = AllocRegister(NullComputeProgram::pointerWords);
+
+    const auto storageClass = static_cast<spv::StorageClass>(instr.GetUInt32(0));
+    switch (storageClass)
+    {
+        case spv::StorageClass::Uniform:
+        case spv::StorageClass::StorageBuffer:
+        {
+            if (type->kind != TypeKind::Struct)
+            {
+                Fail("arrays of buffers are not supported");
+                return false;
+            }
+            program_->bindingPoints.push_back({ value.reg, value.set, value.binding, NullComputeBindingType::Buffer });
+        }
+        break;
+
+        case spv::StorageClass::UniformConstant:
+        {
+            NullComputeBindingType bindingType;
+            switch (type->kind)
+            {
+                case TypeKind::Image:           bindingType = NullComputeBindingType::Image;        break;
+                case TypeKind::SampledImage:    bindingType = NullComputeBindingType::SampledImage; break;
+                case TypeKind::Sampler:         bindingType = NullComputeBindingType::Sampler;      break;
+                default:
+                    Fail("arrays of images and samplers are not supported");
+                    return false;
+            }
+            program_->bindingPoints.push_back({ value.reg, value.set, value.binding, bindingType });
+        }
+        break;
+
+        case spv::StorageClass::Input:
+        {
+            NullComputeBuiltin builtin;
+            if (!MapBuiltin(value.builtin, builtin))
+            {
+                Fail("unsupported input variable; only compute shader built-ins are supported");
+                return false;
+            }
+            const std::uint32_t offset = AllocPrivateMemory(type->size);
+            program_->builtins[static_cast<int>(builtin)] = offset;
+            program_->privatePointers.push_back({ value.reg, offset, type->size });
+        }
+        break;
+
+        case spv::StorageClass::Private:
+        case spv::StorageClass::Output:
+        {
+            const std::uint32_t offset = AllocPrivateMemory(type->size);
+            if (instr.numOperands > 1)
+            {
+                const auto& initializer = values_.at(instr.GetUInt32(1));
+                std::copy_n(registers_.begin() + initializer.reg, type->size, privateMemory_.begin() + offset);
+            }
+            program_->privatePointers.push_back({ value.reg, offset, type->size });
+        }
+        break;
+
+        case spv::StorageClass::Workgroup:
+        {
+            program_->workGroupPointers.push_back({ value.reg, program_->workGroupMemorySize, type->size });
+            program_->workGroupMemorySize += type->size;
+        }
+        break;
+
+        case spv::StorageClass::PushConstant:
+            Fail("push constants are not supported");
+            return false;
+
+        default:
+            Fail("unsupported storage class of global variable");
+            return false;
+    }
+
+    return true;
+}
+
+bool NullComputeTranslator::AllocFunctionRegisters(Function& func)
+{
+    for (const auto& instr : func.instrs)
+    {
+        if (instr.result >= values_.size())
+        {
+            Fail("SPIR-V result ID out of bounds");
+            return false;
+        }
+
+        switch (instr.opcode)
+        {
+            case Op::OpFunction:
+                break;
+
+            case Op::OpLabel:
+                currentLabel_ = instr.result;
+                break;
+
+            case Op::OpFunctionParameter:
+            {
+                const std::uint32_t size = GetTypeSize(instr.type);
+                values_[instr.result].type  = instr.type;
+                values_[instr.result].reg   = AllocRegister(size);
+                func.paramRegs.push_back(values_[instr.result].reg);
+                func.paramSizes.push_back(size);
+            }
+            break;
+
+            case Op::OpPhi:
+            {
+                const std::uint32_t size = GetTypeSize(instr.type);
+                values_[instr.result].type  = instr.type;
+                values_[instr.result].reg   = AllocRegister(size);
+                phis_[currentLabel_].push_back({ values_[instr.result].reg, AllocRegister(size), size, instr });
+            }
+            break;
+
+            default:
+            {
+                if (instr.result != 0 && instr.type != 0)
+                {
+                    const std::uint32_t size = GetTypeSize(instr.type);
+                    values_[instr.result].type = instr.type;
+                    if (size > 0)
+                        values_[instr.result].reg = AllocRegister(size);
+                }
+            }
+            break;
+        }
+    }
+    return error_.empty();
+}
+
+bool NullComputeTranslator::EmitFunction(Function& func)
+{
+    func.pc = static_cast<std::uint32_t>(program_->instrs.size());
+    for (const auto& instr : func.instrs)
+    {
+        if (!EmitInstruction(instr))
+            return false;
+    }
+    return true;
+}
+
+bool NullComputeTranslator::EmitInstruction(const SpirvInstruction& instr)
+{
+    std::uint32_t dst = (instr.result < values_.size() ? values_[instr.result].reg : NullComputeProgram::invalidRegister);
+    std::uint32_t regs[3] = {};
+
+    /* Componentwise arithmetic, logical, and conversion instructions */
+    NullComputeOp op;
+    if (int numOperands = GetComponentwiseOp(instr.opcode, op))
+    {
+        for_range(i, numOperands)
+        {
+            if (!GetRegister(instr.GetUInt32(i), regs[i]))
+                return false;
+        }
+        Emit(op, GetComponentCount(instr.type), dst, regs[0], regs[1], regs[2]);
+        return true;
+    }
+
+    /* Atomic read-modify-write instructions: <pointer> <scope> <semantics> <value> */
+    if (GetAtomicOp(instr.opcode, op))
+    {
+        if (!GetRegister(instr.GetUInt32(0), regs[0]) || !GetRegister(instr.GetUInt32(3), regs[1]))
+            return false;
+        Emit(op, 1, dst, regs[0], regs[1]);
+        return true;
+    }
+
+    switch (instr.opcode)
+    {
+        case Op::OpFunction:
+        case Op::OpFunctionParameter:
+        case Op::OpFunctionEnd:
+        case Op::OpNop:
+        case Op::OpLine:
+        case Op::OpNoLine:
+        case Op::OpSelectionMerge:
+        case Op::OpLoopMerge:
+        case Op::OpMemoryBarrier:
+        case Op::OpUndef:
+            break;
+
+        case Op::OpLabel:
+            labelPcs_[instr.result] = static_cast<std::uint32_t>(program_->instrs.size());
+            currentLabel_ = instr.result;
+            break;
+
+        case Op::OpPhi:
+        {
+            auto& phis = phis_[currentLabel_];
+            auto it = std::find_if(phis.begin(), phis.end(), [dst](const Phi& phi) { return (phi.reg == dst); });
+            if (it != phis.end())
+                EmitCopy(it->reg, it->tempReg, it->size);
+        }
+        break;
+
+        case Op::OpVariable:
+        {
+            const Type* pointerType = FindType(instr.type);
+            if (pointerType == nullptr)
+                return false;
+
+            /* Function variables are allocated statically, since SPIR-V does not allow recursion */
+            const std::uint32_t size = GetTypeSize(pointerType->elementType);
+            const std::uint32_t offset = AllocPrivateMemory(size);
+            program_->privatePointers.push_back({ dst, offset, size });
+
+            /* Initialize variable each time the function is entered */
+            if (instr.numOperands > 1)
+            {
+                if (!GetRegister(instr.GetUInt32(1), regs[0]))
+                    return false;
+                Emit(NullComputeOp::Store, size, NullComputeProgram::invalidRegister, dst, regs[0]);
+            }
+        }
+        break;
+
+        case Op::OpLoad:
+        {
+            if (!GetRegister(instr.GetUInt32(0), regs[0]))
+                return false;
+            Emit(NullComputeOp::Load, GetTypeSize(instr.type), dst, regs[0]);
+        }
+        break;
+
+        case Op::OpStore:
+        {
+            const spv::Id object = instr.GetUInt32(1);
+            if (!GetRegister(instr.GetUInt32(0), regs[0]) || !GetRegister(object, regs[1]))
+                return false;
+            Emit(NullComputeOp::Store, GetTypeSize(values_[object].type), NullComputeProgram::invalidRegister, regs[0], regs[1]);
+        }
+        break;
+
+        case Op::OpCopyMemory:
+        {
+            const Type* pointerType = FindValueType(instr.GetUInt32(0));
+            if (pointerType == nullptr || !GetRegister(instr.GetUInt32(0), regs[0]) || !GetRegister(instr.GetUInt32(1), regs[1]))
+                return false;
+            Emit(NullComputeOp::CopyMemory, GetTypeSize(pointerType->elementType), NullComputeProgram::invalidRegister, regs[0], regs[1]);
+        }
+        break;
+
+        case Op::OpAccessChain:
+        case Op::OpInBoundsAccessChain:
+            return EmitAccessChain(instr);
+
+        case Op::OpArrayLength:
+        {
+            const Type* pointerType = FindValueType(instr.GetUInt32(0));
+            const Type* structType = (pointerType != nullptr ? FindType(pointerType->elementType) : nullptr);
+            const std::uint32_t member = instr.GetUInt32(1);
+            if (structType == nullptr || member >= structType->memberTypes.size() || !GetRegister(instr.GetUInt32(0), regs[0]))
+                return false;
+            const Type* arrayType = FindType(structType->memberTypes[member]);
+            if (arrayType == nullptr || arrayType->stride == 0)
+                return false;
+            Emit(NullComputeOp::ArrayLength, 1, dst, regs[0], structType->memberOffsets[member], arrayType->stride);
+        }
+        break;
+
+        case Op::OpCopyObject:
+        case Op::OpBitcast:
+        case Op::OpSConvert:
+        case Op::OpUConvert:
+        case Op::OpFConvert:
+        {
+            /* All scalar types are 32 bits wide, so conversions between them are plain copies */
+            if (!GetRegister(instr.GetUInt32(0), regs[0]))
+                return false;
+            EmitCopy(dst, regs[0], GetTypeSize(instr.type));
+        }
+        break;
+
+        case Op::OpCompositeConstruct:
+        case Op::OpCompositeExtract:
+        case Op::OpCompositeInsert:
+        case Op::OpVectorShuffle:
+        case Op::OpVectorExtractDynamic:
+        case Op::OpVectorInsertDynamic:
+            return EmitComposite(instr);
+
+        case Op::OpSelect:
+        {
+            const spv::Id condition = instr.GetUInt32(0);
+            if (!GetRegister(condition, regs[0]) || !GetRegister(instr.GetUInt32(1), regs[1]) || !GetRegister(instr.GetUInt32(2), regs[2]))
+                return false;
+            if (GetComponentCount(values_[condition].type) > 1)
+                Emit(NullComputeOp::Select, GetComponentCount(instr.type), dst, regs[0], regs[1], regs[2]);
+            else
+                Emit(NullComputeOp::SelectScalar, GetTypeSize(instr.type), dst, regs[0], regs[1], regs[2]);
+        }
+        break;
+
+        case Op::OpAny:
+        case Op::OpAll:
+        case Op::OpDot:
+        {
+            const spv::Id vector = instr.GetUInt32(0);
+            if (!GetRegister(vector, regs[0]))
+                return false;
+            if (instr.opcode == Op::OpDot && !GetRegister(instr.GetUInt32(1), regs[1]))
+                return false;
+            const NullComputeOp op = (instr.opcode == Op::OpAny ? NullComputeOp::Any : instr.opcode == Op::OpAll ? NullComputeOp::All : NullComputeOp::Dot);
+            Emit(op, GetComponentCount(values_[vector].type), dst, regs[0], regs[1]);
+        }
+        break;
+
+        case Op::OpVectorTimesScalar:
+        case Op::OpMatrixTimesScalar:
+        {
+            if (!GetRegister(instr.GetUInt32(0), regs[0]) || !GetRegister(instr.GetUInt32(1), regs[1]))
+                return false;
+            Emit(NullComputeOp::VectorTimesScalar, GetTypeSize(instr.type), dst, regs[0], regs[1]);
+        }
+        break;
+
+        case Op::OpMatrixTimesVector:
+        case Op::OpVectorTimesMatrix:
+        case Op::OpMatrixTimesMatrix:
+        {
+            const spv::Id lhs = instr.GetUInt32(0);
+            const spv::Id rhs = instr.GetUInt32(1);
+            if (!GetRegister(lhs, regs[0]) || !GetRegister(rhs, regs[1]))
+                return false;
+
+            const Type* lhsType = FindValueType(lhs);
+            const Type* rhsType = FindValueType(rhs);
+            if (lhsType == nullptr || rhsType == nullptr)
+                return false;
+
+            if (instr.opcode == Op::OpMatrixTimesVector)
+                Emit(NullComputeOp::MatrixTimesVector, GetComponentCount(instr.type), dst, regs[0], regs[1], lhsType->length);
+            else if (instr.opcode == Op::OpVectorTimesMatrix)
+                Emit(NullComputeOp::VectorTimesMatrix, GetComponentCount(instr.type), dst, regs[0], regs[1], lhsType->length);
+            else
+                Emit(NullComputeOp::MatrixTimesMatrix, lhsType->stride, dst, regs[0], regs[1], (lhsType->length | (rhsType->length << 16)));
+        }
+        break;
+
+        case Op::OpExtInst:
+            return EmitExtInstruction(instr);
+
+        case Op::OpControlBarrier:
+            Emit(NullComputeOp::Barrier, 0, NullComputeProgram::invalidRegister);
+            program_->hasBarriers = true;
+            break;
+
+        case Op::OpAtomicLoad:
+        {
+            if (!GetRegister(instr.GetUInt32(0), regs[0]))
+                return false;
+            Emit(NullComputeOp::AtomicLoad, 1, dst, regs[0]);
+        }
+        break;
+
+        case Op::OpAtomicStore:
+        {
+            if (!GetRegister(instr.GetUInt32(0), regs[0]) || !GetRegister(instr.GetUInt32(3), regs[1]))
+                return false;
+            Emit(NullComputeOp::AtomicStore, 1, NullComputeProgram::invalidRegister, regs[0], regs[1]);
+        }
+        break;
+
+        case Op::OpAtomicIIncrement:
+        case Op::OpAtomicIDecrement:
+        {
+            if (!GetRegister(instr.GetUInt32(0), regs[0]))
+                return false;
+            if (oneRegister_ == NullComputeProgram::invalidRegister)
+            {
+                oneRegister_ = AllocRegister(1);
+                registers_[oneRegister_] = 1;
+            }
+            const NullComputeOp op = (instr.opcode == Op::OpAtomicIIncrement ? NullComputeOp::AtomicIAdd : NullComputeOp::AtomicISub);
+            Emit(op, 1, dst, regs[0], oneRegister_);
+        }
+        break;
+
+        case Op::OpAtomicCompareExchange:
+        {
+            /* <pointer> <scope> <equal semantics> <unequal semantics> <value> <comparator> */
+            if (!GetRegister(instr.GetUInt32(0), regs[0]) || !GetRegister(instr.GetUInt32(4), regs[1]) || !GetRegister(instr.GetUInt32(5), regs[2]))
+                return false;
+            Emit(NullComputeOp::AtomicCompareExchange, 1, dst, regs[0], regs[1], regs[2]);
+        }
+        break;
+
+        case Op::OpImage:
+        case Op::OpSampledImage:
+        case Op::OpImageRead:
+        case Op::OpImageWrite:
+        case Op::OpImageFetch:
+        case Op::OpImageQuerySize:
+        case Op::OpImageQuerySizeLod:
+        case Op::OpImageQueryLevels:
+        case Op::OpImageSampleImplicitLod:
+        case Op::OpImageSampleExplicitLod:
+        case Op::OpImageSampleDrefImplicitLod:
+        case Op::OpImageSampleDrefExplicitLod:
+            return EmitImageInstruction(instr);
+
+        case Op::OpBranch:
+        {
+            const spv::Id label = instr.GetUInt32(0);
+            if (!EmitPhiCopies(label))
+                return false;
+            EmitBranchTarget(label, false, static_cast<std::uint32_t>(program_->instrs.size()), 0);
+            Emit(NullComputeOp::Branch, 0, NullComputeProgram::invalidRegister);
+        }
+        break;
+
+        case Op::OpBranchConditional:
+        {
+            if (!GetRegister(instr.GetUInt32(0), regs[0]))
+                return false;
+
+            /* Branch into separate blocks for the phi copies of each edge */
+            const std::uint32_t branchIndex = static_cast<std::uint32_t>(program_->instrs.size());
+            Emit(NullComputeOp::BranchConditional, 0, NullComputeProgram::invalidRegister, regs[0]);
+
+            for_range(i, 2)
+            {
+                const spv::Id label = instr.GetUInt32(1 + i);
+                if (phis_.find(label) != phis_.end())
+                {
+                    (i == 0 ? program_->instrs[branchIndex].b : program_->instrs[branchIndex].c) = static_cast<std::uint32_t>(program_->instrs.size());
+                    if (!EmitPhiCopies(label))
+                        return false;
+                    EmitBranchTarget(label, false, static_cast<std::uint32_t>(program_->instrs.size()), 0);
+                    Emit(NullComputeOp::Branch, 0, NullComputeProgram::invalidRegister);
+                }
+                else
+                    EmitBranchTarget(label, false, branchIndex, 1 + i);
+            }
+        }
+        break;
+
+        case Op::OpSwitch:
+        {
+            /* <selector> <default> { <literal> <label> } */
+            if (!GetRegister(instr.GetUInt32(0), regs[0]))
+                return false;
+
+            const std::uint32_t numCases = (instr.numOperands - 2) / 2;
+            const std::uint32_t paramIndex = static_cast<std::uint32_t>(program_->params.size());
+            program_->params.resize(paramIndex + 1 + numCases * 2);
+
+            Emit(NullComputeOp::Switch, 0, NullComputeProgram::invalidRegister, regs[0], paramIndex, numCases);
+
+            for_range(i, numCases + 1)
+            {
+                const std::uint32_t labelOperand = (i == 0 ? 1 : i * 2 + 1);
+                const std::uint32_t targetParam = (i == 0 ? paramIndex : paramIndex + i * 2);
+                if (i > 0)
+                    program_->params[targetParam - 1] = instr.GetUInt32(i * 2);
+
+                const spv::Id label = instr.GetUInt32(labelOperand);
+                if (phis_.find(label) != phis_.end())
+                {
+                    program_->params[targetParam] = static_cast<std::uint32_t>(program_->instrs.size());
+                    if (!EmitPhiCopies(label))
+                        return false;
+                    EmitBranchTarget(label, false, static_cast<std::uint32_t>(program_->instrs.size()), 0);
+                    Emit(NullComputeOp::Branch, 0, NullComputeProgram::invalidRegister);
+                }
+                else
+                    EmitBranchTarget(label, true, targetParam, 0);
+            }
+        }
+        break;
+
+        case Op::OpReturn:
+            Emit(NullComputeOp::Return, 0, NullComputeProgram::invalidRegister);
+            break;
+
+        case Op::OpReturnValue:
+        {
+            const spv::Id value = instr.GetUInt32(0);
+            if (!GetRegister(value, regs[0]))
+                return false;
+            Emit(NullComputeOp::ReturnValue, GetTypeSize(values_[value].type), NullComputeProgram::invalidRegister, regs[0]);
+        }
+        break;
+
+        case Op::OpKill:
+        case Op::OpUnreachable:
+            Emit(NullComputeOp::Kill, 0, NullComputeProgram::invalidRegister);
+            break;
+
+        case Op::OpFunctionCall:
+        {
+            /* <function> { <argument> } */
+            auto it = functions_.find(instr.GetUInt32(0));
+            if (it == functions_.end() || it->second.paramRegs.size() != instr.numOperands - 1)
+            {
+                Fail("invalid function call");
+                return false;
+            }
+
+            const Function& callee = it->second;
+            const std::uint32_t numArgs = instr.numOperands - 1;
+            const std::uint32_t paramIndex = static_cast<std::uint32_t>(program_->params.size());
+
+            for_range(i, numArgs)
+            {
+                std::uint32_t argReg = 0;
+                if (!GetRegister(instr.GetUInt32(1 + i), argReg))
+                    return false;
+                program_->params.push_back(callee.paramRegs[i]);
+                program_->params.push_back(argReg);
+                program_->params.push_back(callee.paramSizes[i]);
+            }
+
+            callFixups_.push_back({ static_cast<std::uint32_t>(program_->instrs.size()), it->first });
+            Emit(NullComputeOp::Call, GetTypeSize(instr.type), dst, 0, paramIndex, numArgs);
+        }
+        break;
+
+        case Op::OpImageGather:
+        case Op::OpImageDrefGather:
+            Fail("image gather is not supported");
+            return false;
+
+        default:
+            Fail("unsupported SPIR-V instruction (opcode " + std::to_string(static_cast<std::uint32_t>(instr.opcode)) + ")");
+            return false;
+    }
+
+    return error_.empty();
+}
+
+bool NullComputeTranslator::EmitExtInstruction(const SpirvInstruction& instr)
+{
+    /* <set> <instruction> { <operand> } */
+    const std::uint32_t instruction = instr.GetUInt32(1);
+
+    NullComputeOp op;
+    const int numOperands = (instr.GetUInt32(0) == glslStd450_ ? GetGLSLStd450Op(instruction, op) : 0);
+    if (numOperands == 0)
+    {
+        Fail("unsupported extended instruction (" + std::to_string(instruction) + ")");
+        return false;
+    }
+
+    std::uint32_t regs[3] = {};
+    for_range(i, numOperands)
+    {
+        if (!GetRegister(instr.GetUInt32(2 + i), regs[i]))
+            return false;
+    }
+
+    /* Geometric functions operate on the components of their operands, all others on the components of their result */
+    std::uint32_t n = GetComponentCount(instr.type);
+    if (op == NullComputeOp::Length || op == NullComputeOp::Distance)
+        n = GetComponentCount(values_[instr.GetUInt32(2)].type);
+
+    Emit(op, n, values_[instr.result].reg, regs[0], regs[1], regs[2]);
+    return true;
+}
+
+bool NullComputeTranslator::EmitAccessChain(const SpirvInstruction& instr)
+{
+    /* <base> { <index> } */
+    const spv::Id base = instr.GetUInt32(0);
+
+    std::uint32_t baseReg = 0;
+    if (!GetRegister(base, baseReg))
+        return false;
+
+    const Type* pointerType = FindValueType(base);
+    if (pointerType == nullptr)
+        return false;
+
+    const std::uint32_t dst = values_[instr.result].reg;
+    const std::uint32_t paramIndex = static_cast<std::uint32_t>(program_->params.size());
+    std::uint32_t numSteps = 0;
+    std::uint32_t offset = 0;
+
+    auto FlushOffset = [&]()
+    {
+        if (offset > 0)
+        {
+            program_->params.insert(program_->params.end(), { static_cast<std::uint32_t>(NullComputeAccessStep::Offset), offset, 0, 0 });
+            ++numSteps;
+            offset = 0;
+        }
+    };
+
+    spv::Id typeId = pointerType->elementType;
+
+    for_subrange(i, 1u, instr.numOperands)
+    {
+        const Type* type = FindType(typeId);
+        if (type == nullptr)
+            return false;
+
+        const spv::Id index = instr.operands[i];
+        if (index >= values_.size())
+            return false;
+
+        const Value& indexValue = values_[index];
+
+        switch (type->kind)
+        {
+            case TypeKind::Struct:
+            {
+                if (!indexValue.isConstant || indexValue.constant >= type->memberTypes.size())
+                {
+                    Fail("invalid struct member index in access chain");
+                    return false;
+                }
+                offset += type->memberOffsets[indexValue.constant];
+                typeId = type->memberTypes[indexValue.constant];
+            }
+            break;
+
+            case TypeKind::Vector:
+            case TypeKind::Matrix:
+            case TypeKind::Array:
+            {
+                if (indexValue.isConstant && indexValue.constant < type->length)
+                {
+                    /* Fold constant indices into the offset */
+                    offset += indexValue.constant * type->stride;
+                }
+                else
+                {
+                    FlushOffset();
+                    std::uint32_t indexReg = 0;
+                    if (!GetRegister(index, indexReg))
+                        return false;
+                    program_->params.insert(program_->params.end(), { static_cast<std::uint32_t>(NullComputeAccessStep::Index), indexReg, type->stride, type->length });
+                    ++numSteps;
+                }
+                typeId = type->elementType;
+            }
+            break;
+
+            case TypeKind::RuntimeArray:
+            {
+                FlushOffset();
+                std::uint32_t indexReg = 0;
+                if (!GetRegister(index, indexReg))
+                    return false;
+                program_->params.insert(program_->params.end(), { static_cast<std::uint32_t>(NullComputeAccessStep::RuntimeIndex), indexReg, type->stride, 0 });
+                ++numSteps;
+                typeId = type->elementType;
+            }
+            break;
+
+            default:
+                Fail("invalid access chain");
+                return false;
+        }
+    }
+
+    FlushOffset();
+
+    if (numSteps > 0)
+        Emit(NullComputeOp::AccessChain, 0, dst, baseReg, paramIndex, numSteps);
+    else
+        EmitCopy(dst, baseReg, NullComputeProgram::pointerWords);
+
+    return true;
+}
+
+bool NullComputeTranslator::EmitComposite(const SpirvInstruction& instr)
+{
+    const std::uint32_t dst = values_[instr.result].reg;
+
+    switch (instr.opcode)
+    {
+        case Op::OpCompositeConstruct:
+        {
+            const Type* type = FindType(instr.type);
+            if (type == nullptr)
+                return false;
+
+            std::uint32_t offset = 0;
+            for_range(i, instr.numOperands)
+            {
+                const spv::Id constituent = instr.operands[i];
+                std::uint32_t reg = 0;
+                if (!GetRegister(constituent, reg))
+                    return false;
+
+                const std::uint32_t size = GetTypeSize(values_[constituent].type);
+                if (type->kind == TypeKind::Struct)
+                    offset = type->memberOffsets.at(i);
+                else if (type->kind == TypeKind::Array || type->kind == TypeKind::Matrix)
+                    offset = i * type->stride;
+
+                EmitCopy(dst + offset, reg, size);
+                offset += size;
+            }
+        }
+        break;
+
+        case Op::OpCompositeExtract:
+        {
+            /* <composite> { <literal index> } */
+            const spv::Id composite = instr.GetUInt32(0);
+            std::uint32_t reg = 0, offset = 0;
+            spv::Id typeId = 0;
+            if (!GetRegister(composite, reg) ||
+                !GetCompositeOffset(values_[composite].type, instr.operands + 1, instr.numOperands - 1, offset, typeId))
+            {
+                return false;
+            }
+            EmitCopy(dst, reg + offset, GetTypeSize(instr.type));
+        }
+        break;
+
+        case Op::OpCompositeInsert:
+        {
+            /* <object> <composite> { <literal index> } */
+            const spv::Id object = instr.GetUInt32(0);
+            const spv::Id composite = instr.GetUInt32(1);
+            std::uint32_t objectReg = 0, compositeReg = 0, offset = 0;
+            spv::Id typeId = 0;
+            if (!GetRegister(object, objectReg) ||
+                !GetRegister(composite, compositeReg) ||
+                !GetCompositeOffset(values_[composite].type, instr.operands + 2, instr.numOperands - 2, offset, typeId))
+            {
+                return false;
+            }
+            EmitCopy(dst, compositeReg, GetTypeSize(instr.type));
+            EmitCopy(dst + offset, objectReg, GetTypeSize(values_[object].type));
+        }
+        break;
+
+        case Op::OpVectorShuffle:
+        {
+            /* <vector 1> <vector 2> { <component literal> } */
+            const spv::Id vector1 = instr.GetUInt32(0);
+            std::uint32_t regs[2] = {};
+            if (!GetRegister(vector1, regs[0]) || !GetRegister(instr.GetUInt32(1), regs[1]))
+                return false;
+
+            const std::uint32_t numComponents1 = GetComponentCount(values_[vector1].type);
+            for_subrange(i, 2u, instr.numOperands)
+            {
+                /* Component 0xFFFFFFFF denotes an undefined result */
+                const std::uint32_t component = instr.operands[i];
+                if (component == 0xFFFFFFFF)
+                    continue;
+                if (component < numComponents1)
+                    EmitCopy(dst + i - 2, regs[0] + component, 1);
+                else
+                    EmitCopy(dst + i - 2, regs[1] + component - numComponents1, 1);
+            }
+        }
+        break;
+
+        case Op::OpVectorExtractDynamic:
+        {
+            const spv::Id vector = instr.GetUInt32(0);
+            std::uint32_t regs[2] = {};
+            if (!GetRegister(vector, regs[0]) || !GetRegister(instr.GetUInt32(1), regs[1]))
+                return false;
+            Emit(NullComputeOp::ExtractDynamic, GetComponentCount(values_[vector].type), dst, regs[0], regs[1]);
+        }
+        break;
+
+        case Op::OpVectorInsertDynamic:
+        {
+            std::uint32_t regs[3] = {};
+            if (!GetRegister(instr.GetUInt32(0), regs[0]) || !GetRegister(instr.GetUInt32(1), regs[1]) || !GetRegister(instr.GetUInt32(2), regs[2]))
+                return false;
+            Emit(NullComputeOp::InsertDynamic, GetComponentCount(instr.type), dst, regs[0], regs[1], regs[2]);
+        }
+        break;
+
+        default:
+            return false;
+    }
+
+    return error_.empty();
+}
+
+bool NullComputeTranslator::EmitImageInstruction(const SpirvInstruction& instr)
+{
+    const std::uint32_t dst = (instr.result != 0 ? values_[instr.result].reg : NullComputeProgram::invalidRegister);
+
+    std::uint32_t imageReg = 0;
+    if (!GetRegister(instr.GetUInt32(0), imageReg))
+        return false;
+
+    /* Combined image-samplers are split into their image and sampler handles */
+    if (instr.opcode == Op::OpImage)
+    {
+        EmitCopy(dst, imageReg, NullComputeProgram::handleWords);
+        return true;
+    }
+    if (instr.opcode == Op::OpSampledImage)
+    {
+        std::uint32_t samplerReg = 0;
+        if (!GetRegister(instr.GetUInt32(1), samplerReg))
+            return false;
+        EmitCopy(dst, imageReg, NullComputeProgram::handleWords);
+        EmitCopy(dst + NullComputeProgram::handleWords, samplerReg, NullComputeProgram::handleWords);
+        return true;
+    }
+    if (instr.opcode == Op::OpImageSampleImplicitLod        ||
+        instr.opcode == Op::OpImageSampleExplicitLod        ||
+        instr.opcode == Op::OpImageSampleDrefImplicitLod    ||
+        instr.opcode == Op::OpImageSampleDrefExplicitLod)
+    {
+        return EmitImageSample(instr, dst, imageReg);
+    }
+
+    const Type* imageType = FindValueType(instr.GetUInt32(0));
+    if (imageType == nullptr || imageType->kind != TypeKind::Image)
+    {
+        Fail("image instruction requires an image operand");
+        return false;
+    }
+
+    switch (instr.opcode)
+    {
+        case Op::OpImageQuerySize:
+        case Op::OpImageQuerySizeLod:
+        {
+            std::uint32_t lodReg = NullComputeProgram::invalidRegister;
+            if (instr.opcode == Op::OpImageQuerySizeLod && !GetRegister(instr.GetUInt32(1), lodReg))
+                return false;
+            Emit(NullComputeOp::ImageQuerySize, GetComponentCount(instr.type), dst, imageReg, lodReg);
+        }
+        break;
+
+        case Op::OpImageQueryLevels:
+            Emit(NullComputeOp::ImageQueryLevels, 1, dst, imageReg);
+            break;
+
+        default:
+        {
+            /* Determine scalar type of texels by the sampled type of the image */
+            NullComputeScalar scalar = NullComputeScalar::Float;
+            if (!IsFloatType(imageType->elementType))
+                scalar = (IsSignedType(imageType->elementType) ? NullComputeScalar::SInt : NullComputeScalar::UInt);
+
+            const spv::Id coord = instr.GetUInt32(1);
+            std::uint32_t coordReg = 0;
+            if (!GetRegister(coord, coordReg))
+                return false;
+
+            const std::uint32_t numCoords = GetComponentCount(values_[coord].type);
+
+            if (instr.opcode == Op::OpImageWrite)
+            {
+                /* <image> <coordinate> <texel> */
+                const spv::Id texel = instr.GetUInt32(2);
+                std::uint32_t texelReg = 0;
+                if (!GetRegister(texel, texelReg))
+                    return false;
+                const std::uint32_t numTexels = GetComponentCount(values_[texel].type);
+                Emit(NullComputeOp::ImageWrite, (numCoords | (numTexels << 8)), NullComputeProgram::invalidRegister, imageReg, coordReg, texelReg, static_cast<std::uint8_t>(scalar));
+            }
+            else
+            {
+                /* <image> <coordinate> [<image operands> { <operand> }] */
+                std::uint32_t lodReg = NullComputeProgram::invalidRegister;
+                if (instr.opcode == Op::OpImageFetch && instr.numOperands > 3 && (instr.GetUInt32(2) & static_cast<std::uint32_t>(spv::ImageOperandsMask::Lod)) != 0)
+                {
+                    /* Lod is the first operand after the mask, since Bias (the only lower bit) is not allowed for fetches */
+                    if (!GetRegister(instr.GetUInt32(3), lodReg))
+                        return false;
+                }
+                const std::uint32_t numTexels = GetComponentCount(instr.type);
+                const NullComputeOp op = (instr.opcode == Op::OpImageFetch ? NullComputeOp::ImageFetch : NullComputeOp::ImageRead);
+                Emit(op, (numCoords | (numTexels << 8)), dst, imageReg, coordReg, lodReg, static_cast<std::uint8_t>(scalar));
+            }
+        }
+        break;
+    }
+
+    return true;
+}
+
+bool NullComputeTranslator::EmitImageSample(const SpirvInstruction& instr, std::uint32_t dst, std::uint32_t imageReg)
+{
+    /* <sampled image> <coordinate> [<dref>] [<image operands> { <operand> }] */
+    const bool isDref = (instr.opcode == Op::OpImageSampleDrefImplicitLod || instr.opcode == Op::OpImageSampleDrefExplicitLod);
+
+    const spv::Id coord = instr.GetUInt32(1);
+    std::uint32_t coordReg = 0;
+    if (!GetRegister(coord, coordReg))
+        return false;
+
+    /*
+    Operand registers: { lod, bias, ddx, ddy, dref }.
+    Compute shaders have no implicit derivatives, so implicit LOD samples the base level plus LOD bias.
+    */
+    std::uint32_t operandRegs[5] =
+    {
+        NullComputeProgram::invalidRegister,
+        NullComputeProgram::invalidRegister,
+        NullComputeProgram::invalidRegister,
+        NullComputeProgram::invalidRegister,
+        NullComputeProgram::invalidRegister,
+    };
+
+    std::uint32_t operand = 2;
+    if (isDref && !GetRegister(instr.GetUInt32(operand++), operandRegs[4]))
+        return false;
+
+    if (operand < instr.numOperands)
+    {
+        /* Image operands follow the mask in the order of their bits */
+        const std::uint32_t mask = instr.GetUInt32(operand++);
+        const std::uint32_t unsupportedMask =
+        (
+            static_cast<std::uint32_t>(spv::ImageOperandsMask::ConstOffset)     |
+            static_cast<std::uint32_t>(spv::ImageOperandsMask::Offset)          |
+            static_cast<std::uint32_t>(spv::ImageOperandsMask::ConstOffsets)    |
+            static_cast<std::uint32_t>(spv::ImageOperandsMask::Sample)
+        );
+        if ((mask & unsupportedMask) != 0)
+        {
+            Fail("image sample operands with offsets are not supported");
+            return false;
+        }
+        if ((mask & static_cast<std::uint32_t>(spv::ImageOperandsMask::Bias)) != 0 && !GetRegister(instr.GetUInt32(operand++), operandRegs[1]))
+            return false;
+        if ((mask & static_cast<std::uint32_t>(spv::ImageOperandsMask::Lod)) != 0 && !GetRegister(instr.GetUInt32(operand++), operandRegs[0]))
+            return false;
+        if ((mask & static_cast<std::uint32_t>(spv::ImageOperandsMask::Grad)) != 0)
+        {
+            if (!GetRegister(instr.GetUInt32(operand++), operandRegs[2]) || !GetRegister(instr.GetUInt32(operand++), operandRegs[3]))
+                return false;
+        }
+    }
+
+    const std::uint32_t paramIndex = static_cast<std::uint32_t>(program_->params.size());
+    program_->params.insert(program_->params.end(), std::begin(operandRegs), std::end(operandRegs));
+
+    NullComputeScalar scalar = NullComputeScalar::Float;
+    if (!IsFloatType(instr.type))
+        scalar = (IsSignedType(instr.type) ? NullComputeScalar::SInt : NullComputeScalar::UInt);
+
+    const std::uint32_t numCoords = GetComponentCount(values_[coord].type);
+    const std::uint32_t numTexels = GetComponentCount(instr.type);
+    Emit(NullComputeOp::ImageSample, (numCoords | (numTexels << 8)), dst, imageReg, coordReg, paramIndex, static_cast<std::uint8_t>(scalar));
+
+    return true;
+}
+
+bool NullComputeTranslator::EmitPhiCopies(spv::Id label)
+{
+    auto it = phis_.find(label);
+    if (it == phis_.end())
+        return true;
+
+    for (const auto& phi : it->second)
+    {
+        /* Find incoming value of the current block: { <value> <parent> } */
+        bool found = false;
+        for (std::uint32_t i = 0; i + 1 < phi.instr.numOperands; i += 2)
+        {
+            if (phi.instr.operands[i + 1] == currentLabel_)
+            {
+                std::uint32_t reg = 0;
+                if (!GetRegister(phi.instr.operands[i], reg))
+                    return false;
+                EmitCopy(phi.tempReg, reg, phi.size);
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+        {
+            Fail("missing incoming value of phi instruction");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void NullComputeTranslator::EmitBranchTarget(spv::Id label, bool inParams, std::uint32_t index, int operand)
+{
+    labelFixups_.push_back({ inParams, index, operand, label });
+}
+
+bool NullComputeTranslator::ResolveLabels()
+{
+    for (const auto& fixup : labelFixups_)
+    {
+        auto it = labelPcs_.find(fixup.label);
+        if (it == labelPcs_.end())
+        {
+            Fail("branch to undefined label");
+            return false;
+        }
+
+        if (fixup.inParams)
+            program_->params[fixup.index] = it->second;
+        else
+        {
+            auto& instr = program_->instrs[fixup.index];
+            (fixup.operand == 0 ? instr.a : fixup.operand == 1 ? instr.b : instr.c) = it->second;
+        }
+    }
+
+    for (const auto& fixup : callFixups_)
+        program_->instrs[fixup.first].a = functions_[fixup.second].pc;
+
+    return true;
+}
+
+void NullComputeTranslator::Finalize(NullComputeProgram& outProgram)
+{
+    /* Private memory is stored after the register file */
+    const std::uint32_t numRegisters = static_cast<std::uint32_t>(registers_.size());
+
+    outProgram.invocationMemory = std::move(registers_);
+    outProgram.invocationMemory.insert(outProgram.invocationMemory.end(), privateMemory_.begin(), privateMemory_.end());
+
+    for (auto& range : outProgram.privatePointers)
+        range.offset += numRegisters;
+
+    for (auto& offset : outProgram.builtins)
+    {
+        if (offset != NullComputeProgram::invalidRegister)
+            offset += numRegisters;
+    }
+
+    outProgram.entryPointPc = functions_[entryPointFunc_].pc;
+    outProgram.maxCallDepth = std::max(1u, static_cast<std::uint32_t>(functions_.size()));
+}
+
+std::uint32_t NullComputeTranslator::AllocRegister(std::uint32_t size)
+{
+    const std::uint32_t reg = static_cast<std::uint32_t>(registers_.size());
+    registers_.resize(registers_.size() + size, 0);
+    return reg;
+}
+
+std::uint32_t NullComputeTranslator::AllocPrivateMemory(std::uint32_t size)
+{
+    const std::uint32_t offset = static_cast<std::uint32_t>(privateMemory_.size());
+    privateMemory_.resize(privateMemory_.size() + size, 0);
+    return offset;
+}
+
+void NullComputeTranslator::Emit(NullComputeOp op, std::uint32_t n, std::uint32_t dst, std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint8_t type)
+{
+    if (n > g_maxInstrWords)
+    {
+        Fail("value exceeds the maximum size of " + std::to_string(g_maxInstrWords) + " words");
+        return;
+    }
+    NullComputeInstr instr;
+    {
+        instr.op    = op;
+        instr.type  = type;
+        instr.n     = static_cast<std::uint16_t>(n);
+        instr.dst   = dst;
+        instr.a     = a;
+        instr.b     = b;
+        instr.c     = c;
+    }
+    program_->instrs.push_back(instr);
+}
+
+void NullComputeTranslator::EmitCopy(std::uint32_t dst, std::uint32_t src, std::uint32_t size)
+{
+    if (size > 0 && dst != src)
+        Emit(NullComputeOp::Copy, size, dst, src);
+}
+
+const NullComputeTranslator::Type* NullComputeTranslator::FindType(spv::Id id) const
+{
+    auto it = types_.find(id);
+    if (it != types_.end())
+        return &(it->second);
+    const_cast<NullComputeTranslator*>(this)->Fail("undefined SPIR-V type ID " + std::to_string(id));
+    return nullptr;
+}
+
+const NullComputeTranslator::Type* NullComputeTranslator::FindValueType(spv::Id id) const
+{
+    return (id < values_.size() ? FindType(values_[id].type) : nullptr);
+}
+
+std::uint32_t NullComputeTranslator::GetTypeSize(spv::Id id) const
+{
+    const Type* type = FindType(id);
+    return (type != nullptr ? type->size : 0);
+}
+
+std::uint32_t NullComputeTranslator::GetComponentCount(spv::Id id) const
+{
+    const Type* type = FindType(id);
+    return (type != nullptr && type->kind == TypeKind::Vector ? type->length : 1);
+}
+
+bool NullComputeTranslator::IsFloatType(spv::Id id) const
+{
+    const Type* type = FindType(id);
+    if (type != nullptr && type->kind == TypeKind::Vector)
+        type = FindType(type->elementType);
+    return (type != nullptr && type->kind == TypeKind::Float);
+}
+
+bool NullComputeTranslator::IsSignedType(spv::Id id) const
+{
+    const Type* type = FindType(id);
+    if (type != nullptr && type->kind == TypeKind::Vector)
+        type = FindType(type->elementType);
+    return (type != nullptr && type->isSigned);
+}
+
+bool NullComputeTranslator::GetRegister(spv::Id id, std::uint32_t& outReg)
+{
+    if (id < values_.size() && values_[id].reg != NullComputeProgram::invalidRegister)
+    {
+        outReg = values_[id].reg;
+        return true;
+    }
+    Fail("undefined SPIR-V value ID " + std::to_string(id));
+    return false;
+}
+
+bool NullComputeTranslator::GetCompositeOffset(spv::Id typeId, const spv::Id* indices, std::uint32_t numIndices, std::uint32_t& outOffset, spv::Id& outTypeId)
+{
+    outOffset = 0;
+    for_range(i, numIndices)
+    {
+        const Type* type = FindType(typeId);
+        if (type == nullptr)
+            return false;
+
+        const std::uint32_t index = indices[i];
+        if (type->kind == TypeKind::Struct)
+        {
+            if (index >= type->memberTypes.size())
+                return false;
+            outOffset += type->memberOffsets[index];
+            typeId = type->memberTypes[index];
+        }
+        else if (type->kind == TypeKind::Vector || type->kind == TypeKind::Matrix || type->kind == TypeKind::Array)
+        {
+            if (index >= type->length)
+            {
+                Fail("composite index out of bounds");
+                return false;
+            }
+            outOffset += index * type->stride;
+            typeId = type->elementType;
+        }
+        else
+        {
+            Fail("invalid composite type");
+            return false;
+        }
+    }
+    outTypeId = typeId;
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,182 @@
+/*
+ * NullComputeTranslator.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_COMPUTE_TRANSLATOR_H
+#define LLGL_NULL_COMPUTE_TRANSLATOR_H
+
+
+#include "NullComputeProgram.h"
+#include "../../SPIRV/SpirvInstruction.h"
+#include <LLGL/Container/ArrayView.h>
+#include <string>
+#include <vector>
+#include <map>
+
+
+namespace LLGL
+{
+
+
+// Translates SPIR-V compute shader modules into the intermediate representation of NullComputeProgram.
+class NullComputeTranslator
+{
+
+    public:
+
+        // Translates the SPIR-V module for the specified entry point (or the first compute entry point if null or empty).
+        // Returns false and writes the reason into 'outError' on failure.
+        bool Translate(
+            const ArrayView<std::uint32_t>& words,
+            const char*                     entryPoint,
+            NullComputeProgram&             outProgram,
+            std::string&                    outError
+        );
+
+    private:
+
+        enum class TypeKind
+        {
+            Void,
+            Bool,
+            Int,
+            Float,
+            Vector,
+            Matrix,
+            Array,
+            RuntimeArray,
+            Struct,
+            Pointer,
+            Function,
+            Image,
+            Sampler,
+            SampledImage,
+        };
+
+        struct Type
+        {
+            TypeKind                    kind            = TypeKind::Void;
+            bool                        isSigned        = false;
+            std::uint32_t               size            = 0;    // Size (in words)
+            std::uint32_t               elementType     = 0;    // Component, column, element, pointee, or sampled type
+            std::uint32_t               length          = 0;    // Number of components, columns, or array elements
+            std::uint32_t               stride          = 0;    // Stride (in words) between components, columns, or array elements
+            spv::StorageClass           storageClass    = spv::StorageClass::Function;
+            spv::Dim                    dim             = spv::Dim::Dim2D;
+            bool                        arrayed         = false;
+            std::vector<std::uint32_t>  memberTypes;
+            std::vector<std::uint32_t>  memberOffsets;          // Offsets (in words) of struct members
+        };
+
+        struct Value
+        {
+            std::uint32_t   type        = 0;
+            std::uint32_t   reg         = NullComputeProgram::invalidRegister;
+            bool            isConstant  = false;
+            std::uint32_t   constant    = 0;    // Scalar value of 32-bit constants
+            std::uint32_t   set         = 0;
+            std::uint32_t   binding     = NullComputeProgram::invalidRegister;
+            std::uint32_t   builtin     = NullComputeProgram::invalidRegister;
+            std::uint32_t   arrayStride = 0;
+        };
+
+        struct Phi
+        {
+            std::uint32_t       reg;
+            std::uint32_t       tempReg;    // Written by the predecessor blocks
+            std::uint32_t       size;
+            SpirvInstruction    instr;
+        };
+
+        struct Function
+        {
+            std::vector<SpirvInstruction>   instrs;
+            std::vector<std::uint32_t>      paramRegs;
+            std::vector<std::uint32_t>      paramSizes;
+            std::uint32_t                   pc          = 0;
+        };
+
+        struct LabelFixup
+        {
+            bool            inParams;   // Patch params[index] instead of an instruction operand
+            std::uint32_t   index;
+            int             operand;    // 0 for 'a', 1 for 'b', 2 for 'c'
+            spv::Id         label;
+        };
+
+    private:
+
+        void Fail(const std::string& message);
+
+        bool ParseDeclaration(const SpirvInstruction& instr);
+        bool ParseDecoration(const SpirvInstruction& instr);
+        bool ParseType(const SpirvInstruction& instr);
+        bool ParseConstant(const SpirvInstruction& instr);
+        bool ParseGlobalVariable(const SpirvInstruction& instr);
+
+        bool AllocFunctionRegisters(Function& func);
+        bool EmitFunction(Function& func);
+        bool EmitInstruction(const SpirvInstruction& instr);
+        bool EmitExtInstruction(const SpirvInstruction& instr);
+        bool EmitAccessChain(const SpirvInstruction& instr);
+        bool EmitComposite(const SpirvInstruction& instr);
+        bool EmitImageInstruction(const SpirvInstruction& instr);
+        bool EmitImageSample(const SpirvInstruction& instr, std::uint32_t dst, std::uint32_t imageReg);
+        bool EmitPhiCopies(spv::Id label);
+        void EmitBranchTarget(spv::Id label, bool inParams, std::uint32_t index, int operand);
+        bool ResolveLabels();
+        void Finalize(NullComputeProgram& outProgram);
+
+        std::uint32_t AllocRegister(std::uint32_t size);
+        std::uint32_t AllocPrivateMemory(std::uint32_t size);
+
+        void Emit(NullComputeOp op, std::uint32_t n, std::uint32_t dst, std::uint32_t a = 0, std::uint32_t b = 0, std::uint32_t c = 0, std::uint8_t type = 0);
+        void EmitCopy(std::uint32_t dst, std::uint32_t src, std::uint32_t size);
+
+        const Type* FindType(spv::Id id) const;
+        const Type* FindValueType(spv::Id id) const;
+        std::uint32_t GetTypeSize(spv::Id id) const;
+        std::uint32_t GetComponentCount(spv::Id id) const;
+        bool IsFloatType(spv::Id id) const;
+        bool IsSignedType(spv::Id id) const;
+
+        bool GetRegister(spv::Id id, std::uint32_t& outReg);
+        bool GetCompositeOffset(spv::Id typeId, const spv::Id* indices, std::uint32_t numIndices, std::uint32_t& outOffset, spv::Id& outTypeId);
+
+    private:
+
+        NullComputeProgram*                 program_            = nullptr;
+        std::string                         error_;
+
+        std::vector<Value>                  values_;
+        std::map<spv::Id, Type>             types_;
+        std::map<std::uint64_t, std::uint32_t> memberOffsets_;  // Key: (struct ID << 32 | member index)
+        std::map<std::uint64_t, std::uint32_t> matrixStrides_;  // Key: (struct ID << 32 | member index)
+        std::map<spv::Id, Function>         functions_;
+        std::map<spv::Id, std::vector<Phi>> phis_;              // Key: label of the block the phi instructions belong to
+        std::map<spv::Id, std::uint32_t>    labelPcs_;
+        std::vector<LabelFixup>             labelFixups_;
+        std::vector<std::pair<std::uint32_t, spv::Id>> callFixups_;  // Call instructions and their target function
+        std::vector<std::uint32_t>          registers_;         // Initial values of the register file
+        std::vector<std::uint32_t>          privateMemory_;     // Initial values of private variables
+        std::uint32_t                       oneRegister_        = NullComputeProgram::invalidRegister;
+        spv::Id                             glslStd450_         = 0;
+        spv::Id                             entryPointFunc_     = 0;
+        spv::Id                             currentFunc_        = 0;
+        spv::Id                             currentLabel_       = 0;
+        bool                                hasWorkGroupSize_   = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,278 @@
+/*
+ * NullFrameCapture.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "NullFrameCapture.h"
+#include "Texture/NullTexture.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+
+
+namespace LLGL
+{
+
+
+NullFrameCapture::NullFrameCapture(const RendererConfigurationNull& config) :
+    format_   { config.frameCaptureFormat                                          },
+    path_     { config.frameCapturePath != nullptr ? config.frameCapturePath : "" },
+    callback_ { config.frameCaptureCallback                                        },
+    frames_   { std::max(1u, config.frameCaptureRingSize)                          },
+    encoder_  { &NullFrameCapture::RunEncoder, this                                }
+{
+}
+
+NullFrameCapture::~NullFrameCapture()
+{
+    /* Let encoder thread finish all frames in flight before it quits */
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        quit_ = true;
+    }
+    frameSignal_.notify_one();
+    encoder_.join();
+}
+
+void NullFrameCapture::Capture(NullTexture& colorBuffer)
+{
+    const Extent3D extent = colorBuffer.GetMipExtent(0);
+
+    std::unique_lock<std::mutex> lock{ mutex_ };
+
+    /* Wait for a free frame in the ring */
+    slotSignal_.wait(lock, [this]() -> bool { return (numFrames_ < frames_.size()); });
+
+    /* Copy color buffer into the frame; the encoder thread does not touch frames that are not in flight */
+    auto& frame = frames_[(firstFrame_ + numFrames_) % frames_.size()];
+    {
+        frame.index         = frameCounter_++;
+        frame.extent.width  = extent.width;
+        frame.extent.height = extent.height;
+        frame.pixels.resize(static_cast<std::size_t>(extent.width) * extent.height * 4);
+    }
+    TextureRegion region;
+    {
+        region.subresource.numMipLevels     = 1;
+        region.subresource.numArrayLayers   = 1;
+        region.extent                       = extent;
+    }
+    const DstImageDescriptor dstImageDesc{ ImageFormat::RGBA, DataType::UInt8, frame.pixels.data(), frame.pixels.size() };
+    colorBuffer.Read(region, dstImageDesc);
+
+    ++numFrames_;
+    lock.unlock();
+    frameSignal_.notify_one();
+}
+
+void NullFrameCapture::Flush()
+{
+    std::unique_lock<std::mutex> lock{ mutex_ };
+    slotSignal_.wait(lock, [this]() -> bool { return (numFrames_ == 0); });
+}
+
+bool NullFrameCapture::IsEnabled(const RendererConfigurationNull& config)
+{
+    return (config.frameCaptureFormat != NullFrameCaptureFormat::None || config.frameCaptureCallback);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullFrameCapture::RunEncoder()
+{
+    for (;;)
+    {
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        frameSignal_.wait(lock, [this]() -> bool { return (numFrames_ > 0 || quit_); });
+        if (numFrames_ == 0)
+            break;
+
+        /* Encode oldest frame without holding the lock, so the render thread can capture the next frame meanwhile */
+        const Frame& frame = frames_[firstFrame_];
+        lock.unlock();
+        EncodeFrame(frame);
+        lock.lock();
+
+        firstFrame_ = (firstFrame_ + 1) % frames_.size();
+        --numFrames_;
+        lock.unlock();
+        slotSignal_.notify_all();
+    }
+}
+
+static void WriteBigEndian32(std::vector<std::uint8_t>& dst, std::uint32_t value)
+{
+    dst.push_back(static_cast<std::uint8_t>(value >> 24));
+    dst.push_back(static_cast<std::uint8_t>(value >> 16));
+    dst.push_back(static_cast<std::uint8_t>(value >>  8));
+    dst.push_back(static_cast<std::uint8_t>(value      ));
+}
+
+static std::uint32_t UpdatePNGCrc32(std::uint32_t crc, const std::uint8_t* data, std::size_t size)
+{
+    static std::uint32_t table[256];
+    static const bool tableInitialized = []() -> bool
+    {
+        for_range(i, 256u)
+        {
+            std::uint32_t c = i;
+            for_range(bit, 8)
+                c = ((c & 1u) != 0 ? 0xEDB88320u ^ (c >> 1) : (c >> 1));
+            table[i] = c;
+        }
+        return true;
+    }();
+    (void)tableInitialized;
+
+    crc = ~crc;
+    for_range(i, size)
+        crc = table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void WritePNGChunk(std::ofstream& file, const char* type, const std::vector<std::uint8_t>& data)
+{
+    std::vector<std::uint8_t> chunk;
+    chunk.reserve(data.size() + 12);
+    WriteBigEndian32(chunk, static_cast<std::uint32_t>(data.size()));
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+
+    /* CRC covers chunk type and data, but not the length */
+    WriteBigEndian32(chunk, UpdatePNGCrc32(0, chunk.data() + 4, chunk.size() - 4));
+
+    file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+}
+
+// Writes the frame as PNG file with a zlib stream of uncompressed (stored) deflate blocks.
+static void WritePNGFile(std::ofstream& file, std::uint32_t width, std::uint32_t height, const std::uint8_t* pixels)
+{
+    static const std::uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    /* Write header chunk: 8 bits per component, color type 6 (RGBA), default compression, filter, and no interlace */
+    std::vector<std::uint8_t> header;
+    WriteBigEndian32(header, width);
+    WriteBigEndian32(header, height);
+    header.insert(header.end(), { 8, 6, 0, 0, 0 });
+    WritePNGChunk(file, "IHDR", header);
+
+    /* Prepend filter type 0 (none) to each scanline */
+    const std::size_t rowSize = static_cast<std::size_t>(width) * 4;
+    std::vector<std::uint8_t> scanlines;
+    scanlines.reserve((rowSize + 1) * height);
+    for_range(y, height)
+    {
+        scanlines.push_back(0);
+        scanlines.insert(scanlines.end(), pixels + y * rowSize, pixels + (y + 1) * rowSize);
+    }
+
+    /* Wrap scanlines into stored deflate blocks of at most 65535 bytes each */
+    constexpr std::size_t maxBlockSize = 0xFFFF;
+    std::vector<std::uint8_t> stream;
+    stream.reserve(scanlines.size() + (scanlines.size() / maxBlockSize + 1) * 5 + 6);
+    stream.push_back(0x78);
+    stream.push_back(0x01);
+
+    std::uint32_t adlerA = 1, adlerB = 0;
+    std::size_t offset = 0;
+    do
+    {
+        const std::size_t   blockSize   = std::min(maxBlockSize, scanlines.size() - offset);
+        const bool          isFinal     = (offset + blockSize == scanlines.size());
+        stream.push_back(isFinal ? 1 : 0);
+        stream.push_back(static_cast<std::uint8_t>(blockSize));
+        stream.push_back(static_cast<std::uint8_t>(blockSize >> 8));
+        stream.push_back(static_cast<std::uint8_t>(~blockSize));
+        stream.push_back(static_cast<std::uint8_t>(~blockSize >> 8));
+        stream.insert(stream.end(), scanlines.begin() + offset, scanlines.begin() + offset + blockSize);
+
+        for_subrange(i, offset, offset + blockSize)
+        {
+            adlerA = (adlerA + scanlines[i]) % 65521u;
+            adlerB = (adlerB + adlerA) % 65521u;
+        }
+
+        offset += blockSize;
+    }
+    while (offset < scanlines.size());
+
+    WriteBigEndian32(stream, (adlerB << 16) | adlerA);
+
+    WritePNGChunk(file, "IDAT", stream);
+    WritePNGChunk(file, "IEND", {});
+}
+
+static void WritePPMFile(std::ofstream& file, std::uint32_t width, std::uint32_t height, const std::uint8_t* pixels)
+{
+    const std::string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    /* Drop alpha channel */
+    const std::size_t numPixels = static_cast<std::size_t>(width) * height;
+    std::vector<std::uint8_t> rgb(numPixels * 3);
+    for_range(i, numPixels)
+    {
+        rgb[i*3    ] = pixels[i*4    ];
+        rgb[i*3 + 1] = pixels[i*4 + 1];
+        rgb[i*3 + 2] = pixels[i*4 + 2];
+    }
+    file.write(reinterpret_cast<const char*>(rgb.data()), static_cast<std::streamsize>(rgb.size()));
+}
+
+static const char* GetFrameCaptureFileExtension(const NullFrameCaptureFormat format)
+{
+    switch (format)
+    {
+        case NullFrameCaptureFormat::Raw:   return ".raw";
+        case NullFrameCaptureFormat::PPM:   return ".ppm";
+        case NullFrameCaptureFormat::PNG:   return ".png";
+        default:                            return "";
+    }
+}
+
+void NullFrameCapture::EncodeFrame(const Frame& frame)
+{
+    if (format_ != NullFrameCaptureFormat::None)
+    {
+        /* Build filename from path prefix and zero-padded frame index */
+        char frameIndex[32];
+        std::snprintf(frameIndex, sizeof(frameIndex), "%06llu", static_cast<unsigned long long>(frame.index));
+        const std::string filename = path_ + frameIndex + GetFrameCaptureFileExtension(format_);
+
+        std::ofstream file{ filename, std::ios::out | std::ios::binary };
+        if (file.good())
+        {
+            switch (format_)
+            {
+                case NullFrameCaptureFormat::Raw:
+                    file.write(reinterpret_cast<const char*>(frame.pixels.data()), static_cast<std::streamsize>(frame.pixels.size()));
+                    break;
+                case NullFrameCaptureFormat::PPM:
+                    WritePPMFile(file, frame.extent.width, frame.extent.height, frame.pixels.data());
+                    break;
+                case NullFrameCaptureFormat::PNG:
+                    WritePNGFile(file, frame.extent.width, frame.extent.height, frame.pixels.data());
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    if (callback_)
+        callback_(frame.index, frame.extent.width, frame.extent.height, frame.pixels.data());
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,96 @@
+/*
+ * NullFrameCapture.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_FRAME_CAPTURE_H
+#define LLGL_NULL_FRAME_CAPTURE_H
+
+
+#include <LLGL/RendererConfiguration.h>
+#include <LLGL/Types.h>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class NullTexture;
+
+/*
+Captures presented frames of the Null renderer.
+Each captured frame is copied into a ring of frame buffers by the worker thread of the command queue and encoded by a background thread,
+so the command queue only waits if all frames of the ring are still in flight.
+*/
+class NullFrameCapture
+{
+
+    public:
+
+        NullFrameCapture(const RendererConfigurationNull& config);
+        ~NullFrameCapture();
+
+        NullFrameCapture(const NullFrameCapture&) = delete;
+        NullFrameCapture& operator = (const NullFrameCapture&) = delete;
+
+        // Copies the specified color buffer into the next frame of the ring and hands it over to the encoder thread.
+        void Capture(NullTexture& colorBuffer);
+
+        // Blocks until all captured frames have been encoded.
+        void Flush();
+
+        // Returns true if the specified configuration enables frame capture.
+        static bool IsEnabled(const RendererConfigurationNull& config);
+
+    private:
+
+        struct Frame
+        {
+            std::uint64_t               index   = 0;
+            Extent2D                    extent;
+            std::vector<std::uint8_t>   pixels;         // RGBA8 pixel data without row padding
+        };
+
+    private:
+
+        void RunEncoder();
+        void EncodeFrame(const Frame& frame);
+
+    private:
+
+        const NullFrameCaptureFormat    format_;
+        const std::string               path_;
+        const NullFrameCaptureCallback  callback_;
+
+        std::vector<Frame>              frames_;
+        std::size_t                     firstFrame_     = 0;        // Index of the oldest frame in flight
+        std::size_t                     numFrames_      = 0;        // Number of frames in flight
+        bool                            encoding_       = false;    // True while the encoder thread works on the oldest frame
+        bool                            quit_           = false;
+        std::uint64_t                   frameCounter_   = 0;
+
+        std::mutex                      mutex_;
+        std::condition_variable         frameSignal_;               // Wakes up the encoder thread
+        std::condition_variable         slotSignal_;                // Wakes up threads waiting for a free frame
+
+        std::thread                     encoder_;                   // Declared last, so all states are initialized before the thread starts
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,7 +6,10 @@
  */
 
 #include "NullRenderSystem.h"
+#include "NullSerialization.h"
+#include "../RenderSystemUtils.h"
 #include "../../Core/CoreUtils.h"
+#include "../../Core/Exception.h"
 #include <LLGL/Utils/ForRange.h>
 #include <limits.h>
 
@@ -55,13 +58,17 @@ static void InitNullRendererFeatures(RenderingFeatures& features)
     features.hasGeometryShaders             = false;
     features.hasTessellationShaders         = false;
     features.hasTessellatorStage            = false;
+    #ifdef LLGL_ENABLE_SPIRV_REFLECT
+    features.hasComputeShaders              = true;
+    #else
     features.hasComputeShaders              = false;
+    #endif
     features.hasInstancing                  = true;
     features.hasOffsetInstancing            = true;
     features.hasIndirectDrawing             = true;
     features.hasViewportArrays              = true;
     features.hasConservativeRasterization   = false;
-    features.hasStreamOutputs               = false;
+    features.hasStreamOutputs               = true;
     features.hasLogicOp                     = true;
     features.hasPipelineStatistics          = true;
     features.hasRenderCondition             = true;
@@ -76,13 +83,22 @@ static void InitNullRendererLimits(RenderingLimits& limits)
     limits.max2DTextureSize                 = UINT16_MAX;
     limits.max3DTextureSize                 = 1024u;
     limits.maxCubeTextureSize               = UINT16_MAX;
-    limits.maxAnisotropy                    = 0;
+    limits.maxAnisotropy                    = NullSampler::maxAnisotropy;
+    #ifdef LLGL_ENABLE_SPIRV_REFLECT
+    limits.maxComputeShaderWorkGroups[0]    = UINT16_MAX;
+    limits.maxComputeShaderWorkGroups[1]    = UINT16_MAX;
+    limits.maxComputeShaderWorkGroups[2]    = UINT16_MAX;
+    limits.maxComputeShaderWorkGroupSize[0] = 1024u;
+    limits.maxComputeShaderWorkGroupSize[1] = 1024u;
+    limits.maxComputeShaderWorkGroupSize[2] = 64u;
+    #else
     limits.maxComputeShaderWorkGroups[0]    = 0;
     limits.maxComputeShaderWorkGroups[1]    = 0;
     limits.maxComputeShaderWorkGroups[2]    = 0;
     limits.maxComputeShaderWorkGroupSize[0] = 0;
     limits.maxComputeShaderWorkGroupSize[1] = 0;
     limits.maxComputeShaderWorkGroupSize[2] = 0;
+    #endif
     limits.maxViewports                     = LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS;
     limits.maxViewportSize[0]               = UINT32_MAX;
     limits.maxViewportSize[1]               = UINT32_MAX;
@@ -119,19 +135,35 @@ NullRenderSystem::NullRenderSystem(const RenderSystemDescriptor& renderSystemDes
     desc_         { renderSystemDesc               },
     commandQueue_ { MakeUnique<NullCommandQueue>() }
 {
+    /* Enable frame capture and the performance model if the renderer configuration requests it */
+    if (auto rendererConfigNull = GetRendererConfiguration<RendererConfigurationNull>(renderSystemDesc))
+    {
+        if (NullFrameCapture::IsEnabled(*rendererConfigNull))
+            frameCapture_ = MakeUnique<NullFrameCapture>(*rendererConfigNull);
+        if (NullPerformanceReporter::IsEnabled(*rendererConfigNull))
+            performanceReporter_ = MakeUnique<NullPerformanceReporter>(*rendererConfigNull);
+    }
+
     SetRendererInfo(GetNullRenderInfo());
     SetRenderingCaps(GetNullRenderingCaps());
 }
 
+NullRenderSystem::~NullRenderSystem()
+{
+    /* Finish all submissions before any hardware object is destroyed */
+    commandQueue_->WaitIdle();
+}
+
 /* ----- Swap-chain ----- */
 
 SwapChain* NullRenderSystem::CreateSwapChain(const SwapChainDescriptor& swapChainDesc, const std::shared_ptr<Surface>& surface)
 {
-    return swapChains_.emplace<NullSwapChain>(swapChainDesc, surface);
+    return swapChains_.emplace<NullSwapChain>(swapChainDesc, surface, *commandQueue_, frameCapture_.get());
 }
 
 void NullRenderSystem::Release(SwapChain& swapChain)
 {
+    commandQueue_->WaitIdle();
     swapChains_.erase(&swapChain);
 }
 
@@ -146,11 +178,12 @@ CommandQueue* NullRenderSystem::GetCommandQueue()
 
 CommandBuffer* NullRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& commandBufferDesc)
 {
-    return commandBuffers_.emplace<NullCommandBuffer>(commandBufferDesc);
+    return commandBuffers_.emplace<NullCommandBuffer>(*commandQueue_, commandBufferDesc, performanceReporter_.get());
 }
 
 void NullRenderSystem::Release(CommandBuffer& commandBuffer)
 {
+    commandQueue_->WaitIdle();
     commandBuffers_.erase(&commandBuffer);
 }
 
@@ -171,34 +204,40 @@ BufferArray* NullRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffe
 
 void NullRenderSystem::Release(Buffer& buffer)
 {
+    commandQueue_->WaitIdle();
     buffers_.erase(&buffer);
 }
 
 void NullRenderSystem::Release(BufferArray& bufferArray)
 {
+    commandQueue_->WaitIdle();
     bufferArrays_.erase(&bufferArray);
 }
 
 void NullRenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const void* data, std::uint64_t dataSize)
 {
+    commandQueue_->WaitIdle();
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     bufferNull.Write(offset, data, dataSize);
 }
 
 void NullRenderSystem::ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data, std::uint64_t dataSize)
 {
+    commandQueue_->WaitIdle();
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     bufferNull.Read(offset, data, dataSize);
 }
 
 void* NullRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
+    commandQueue_->WaitIdle();
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     return bufferNull.Map(access, 0, bufferNull.desc.size);
 }
 
 void* NullRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
 {
+    commandQueue_->WaitIdle();
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     return bufferNull.Map(access, offset, length);
 }
@@ -218,17 +257,20 @@ Texture* NullRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, c
 
 void NullRenderSystem::Release(Texture& texture)
 {
+    commandQueue_->WaitIdle();
     textures_.erase(&texture);
 }
 
 void NullRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
+    commandQueue_->WaitIdle();
     auto& textureNull = LLGL_CAST(NullTexture&, texture);
     textureNull.Write(textureRegion, imageDesc);
 }
 
 void NullRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
 {
+    commandQueue_->WaitIdle();
     auto& textureNull = LLGL_CAST(NullTexture&, texture);
     textureNull.Read(textureRegion, imageDesc);
 }
@@ -242,6 +284,7 @@ Sampler* NullRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
 
 void NullRenderSystem::Release(Sampler& sampler)
 {
+    commandQueue_->WaitIdle();
     samplers_.erase(&sampler);
 }
 
@@ -254,11 +297,13 @@ ResourceHeap* NullRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor&
 
 void NullRenderSystem::Release(ResourceHeap& resourceHeap)
 {
+    commandQueue_->WaitIdle();
     resourceHeaps_.erase(&resourceHeap);
 }
 
 std::uint32_t NullRenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
 {
+    commandQueue_->WaitIdle();
     auto& resourceHeapNull = LLGL_CAST(NullResourceHeap&, resourceHeap);
     return resourceHeapNull.WriteResourceViews(firstDescriptor, resourceViews);
 }
@@ -272,6 +317,7 @@ RenderPass* NullRenderSystem::CreateRenderPass(const RenderPassDescriptor& rende
 
 void NullRenderSystem::Release(RenderPass& renderPass)
 {
+    commandQueue_->WaitIdle();
     renderPasses_.erase(&renderPass);
 }
 
@@ -284,6 +330,7 @@ RenderTarget* NullRenderSystem::CreateRenderTarget(const RenderTargetDescriptor&
 
 void NullRenderSystem::Release(RenderTarget& renderTarget)
 {
+    commandQueue_->WaitIdle();
     renderTargets_.erase(&renderTarget);
 }
 
@@ -296,6 +343,7 @@ Shader* NullRenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
 
 void NullRenderSystem::Release(Shader& shader)
 {
+    commandQueue_->WaitIdle();
     shaders_.erase(&shader);
 }
 
@@ -308,6 +356,7 @@ PipelineLayout* NullRenderSystem::CreatePipelineLayout(const PipelineLayoutDescr
 
 void NullRenderSystem::Release(PipelineLayout& pipelineLayout)
 {
+    commandQueue_->WaitIdle();
     pipelineLayouts_.erase(&pipelineLayout);
 }
 
@@ -315,21 +364,56 @@ void NullRenderSystem::Release(PipelineLayout& pipelineLayout)
 
 PipelineState* NullRenderSystem::CreatePipelineState(const Blob& serializedCache)
 {
-    return nullptr;//TODO
+    Serialization::Deserializer reader{ serializedCache };
+    NullPipelineCache cache;
+
+    /* Read type of PSO */
+    auto seg = reader.ReadSegment();
+    if (seg.ident == Serialization::NullIdent_GraphicsPSOIdent)
+    {
+        /* Create graphics PSO from cache */
+        GraphicsPipelineDescriptor pipelineStateDesc;
+        Serialization::NullReadGraphicsPSO(reader, pipelineStateDesc, cache);
+        return pipelineStates_.emplace<NullPipelineState>(pipelineStateDesc, std::move(cache));
+    }
+    else if (seg.ident == Serialization::NullIdent_ComputePSOIdent)
+    {
+        /* Create compute PSO from cache */
+        ComputePipelineDescriptor pipelineStateDesc;
+        Serialization::NullReadComputePSO(reader, pipelineStateDesc, cache);
+        return pipelineStates_.emplace<NullPipelineState>(pipelineStateDesc, std::move(cache));
+    }
+
+    LLGL_TRAP("serialized cache does not denote a Null graphics or compute PSO");
 }
 
 PipelineState* NullRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
 {
-    return pipelineStates_.emplace<NullPipelineState>(pipelineStateDesc);
+    NullPipelineState* pipelineState = pipelineStates_.emplace<NullPipelineState>(pipelineStateDesc);
+    if (serializedCache != nullptr)
+    {
+        Serialization::Serializer writer;
+        Serialization::NullWritePSO(writer, *pipelineState);
+        *serializedCache = writer.Finalize();
+    }
+    return pipelineState;
 }
 
 PipelineState* NullRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
 {
-    return pipelineStates_.emplace<NullPipelineState>(pipelineStateDesc);
+    NullPipelineState* pipelineState = pipelineStates_.emplace<NullPipelineState>(pipelineStateDesc);
+    if (serializedCache != nullptr)
+    {
+        Serialization::Serializer writer;
+        Serialization::NullWritePSO(writer, *pipelineState);
+        *serializedCache = writer.Finalize();
+    }
+    return pipelineState;
 }
 
 void NullRenderSystem::Release(PipelineState& pipelineState)
 {
+    commandQueue_->WaitIdle();
     pipelineStates_.erase(&pipelineState);
 }
 
@@ -342,6 +426,7 @@ QueryHeap* NullRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& queryHea
 
 void NullRenderSystem::Release(QueryHeap& queryHeap)
 {
+    commandQueue_->WaitIdle();
     queryHeaps_.erase(&queryHeap);
 }
 
@@ -354,6 +439,7 @@ Fence* NullRenderSystem::CreateFence()
 
 void NullRenderSystem::Release(Fence& fence)
 {
+    commandQueue_->WaitIdle();
     fences_.erase(&fence);
 }
 
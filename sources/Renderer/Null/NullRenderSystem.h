@@ -26,6 +26,8 @@
 #include "Texture/NullRenderTarget.h"
 #include "Texture/NullSampler.h"
 
+#include "NullFrameCapture.h"
+
 #include "../ContainerTypes.h"
 
 
@@ -39,6 +41,7 @@ class NullRenderSystem final : public RenderSystem
     public:
 
         NullRenderSystem(const RenderSystemDescriptor& renderSystemDesc);
+        ~NullRenderSystem();
 
         /* ----- Swap-chain ------ */
 
@@ -143,6 +146,8 @@ class NullRenderSystem final : public RenderSystem
         /* ----- Common objects ----- */
 
         const RenderSystemDescriptor            desc_;
+        std::unique_ptr<NullFrameCapture>       frameCapture_;
+        std::unique_ptr<NullPerformanceReporter> performanceReporter_;
 
         /* ----- Hardware object containers ----- */
 
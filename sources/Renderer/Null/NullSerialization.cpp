@@ -0,0 +1,388 @@
+/*
+ * NullSerialization.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "NullSerialization.h"
+#include "Shader/NullShader.h"
+#include "RenderState/NullPipelineLayout.h"
+#include "../CheckedCast.h"
+#include "../../Core/CoreUtils.h"
+
+
+namespace LLGL
+{
+
+namespace Serialization
+{
+
+
+/* ----- Arrays ----- */
+
+template <typename T>
+static void WriteArray(Serializer& writer, const std::vector<T>& data)
+{
+    writer.WriteTyped(static_cast<std::uint32_t>(data.size()));
+    writer.Write(data.data(), data.size() * sizeof(T));
+}
+
+template <typename T>
+static void ReadArray(Deserializer& reader, std::vector<T>& outData)
+{
+    std::uint32_t count = 0;
+    reader.ReadTyped(count);
+    outData.resize(count);
+    reader.Read(outData.data(), outData.size() * sizeof(T));
+}
+
+
+/* ----- Shaders ----- */
+
+static void WriteVertexAttribs(Serializer& writer, const std::vector<VertexAttribute>& attribs)
+{
+    writer.WriteTyped(static_cast<std::uint32_t>(attribs.size()));
+    for (const VertexAttribute& attrib : attribs)
+    {
+        writer.WriteCString(attrib.name.c_str());
+        writer.WriteTyped(attrib.format);
+        writer.WriteTyped(attrib.location);
+        writer.WriteTyped(attrib.semanticIndex);
+        writer.WriteTyped(attrib.systemValue);
+        writer.WriteTyped(attrib.slot);
+        writer.WriteTyped(attrib.offset);
+        writer.WriteTyped(attrib.stride);
+        writer.WriteTyped(attrib.instanceDivisor);
+    }
+}
+
+static void ReadVertexAttribs(Deserializer& reader, std::vector<VertexAttribute>& outAttribs)
+{
+    std::uint32_t count = 0;
+    reader.ReadTyped(count);
+    outAttribs.resize(count);
+    for (VertexAttribute& attrib : outAttribs)
+    {
+        attrib.name = reader.ReadCString();
+        reader.ReadTyped(attrib.format);
+        reader.ReadTyped(attrib.location);
+        reader.ReadTyped(attrib.semanticIndex);
+        reader.ReadTyped(attrib.systemValue);
+        reader.ReadTyped(attrib.slot);
+        reader.ReadTyped(attrib.offset);
+        reader.ReadTyped(attrib.stride);
+        reader.ReadTyped(attrib.instanceDivisor);
+    }
+}
+
+static void WriteFragmentAttribs(Serializer& writer, const std::vector<FragmentAttribute>& attribs)
+{
+    writer.WriteTyped(static_cast<std::uint32_t>(attribs.size()));
+    for (const FragmentAttribute& attrib : attribs)
+    {
+        writer.WriteCString(attrib.name.c_str());
+        writer.WriteTyped(attrib.format);
+        writer.WriteTyped(attrib.location);
+        writer.WriteTyped(attrib.systemValue);
+    }
+}
+
+static void ReadFragmentAttribs(Deserializer& reader, std::vector<FragmentAttribute>& outAttribs)
+{
+    std::uint32_t count = 0;
+    reader.ReadTyped(count);
+    outAttribs.resize(count);
+    for (FragmentAttribute& attrib : outAttribs)
+    {
+        attrib.name = reader.ReadCString();
+        reader.ReadTyped(attrib.format);
+        reader.ReadTyped(attrib.location);
+        reader.ReadTyped(attrib.systemValue);
+    }
+}
+
+static void NullWriteSegmentShader(Serializer& writer, const NullIdent ident, const Shader* shader)
+{
+    if (shader == nullptr)
+        return;
+
+    auto* shaderNull = LLGL_CAST(const NullShader*, shader);
+    const ShaderDescriptor& shaderDesc = shaderNull->desc;
+
+    writer.Begin(ident);
+    {
+        writer.WriteTyped(shaderDesc.type);
+        writer.WriteCString(shaderNull->GetEntryPoint().c_str());
+        WriteVertexAttribs(writer, shaderDesc.vertex.inputAttribs);
+        WriteVertexAttribs(writer, shaderDesc.vertex.outputAttribs);
+        WriteFragmentAttribs(writer, shaderDesc.fragment.outputAttribs);
+        writer.WriteTyped(shaderDesc.compute.workGroupSize);
+        WriteArray(writer, shaderNull->GetBinary());
+    }
+    writer.End();
+}
+
+static std::unique_ptr<NullShader> NullReadSegmentShader(Deserializer& reader, const NullIdent ident)
+{
+    if (reader.BeginOnMatch(ident).ident != ident)
+        return nullptr;
+
+    ShaderDescriptor shaderDesc;
+    std::vector<std::uint32_t> binary;
+    {
+        reader.ReadTyped(shaderDesc.type);
+        shaderDesc.entryPoint = reader.ReadCString();
+        ReadVertexAttribs(reader, shaderDesc.vertex.inputAttribs);
+        ReadVertexAttribs(reader, shaderDesc.vertex.outputAttribs);
+        ReadFragmentAttribs(reader, shaderDesc.fragment.outputAttribs);
+        reader.ReadTyped(shaderDesc.compute.workGroupSize);
+        ReadArray(reader, binary);
+    }
+    reader.End();
+
+    /* Shader copies the binary, so the descriptor can refer to the temporary buffer */
+    if (!binary.empty())
+    {
+        shaderDesc.source       = reinterpret_cast<const char*>(binary.data());
+        shaderDesc.sourceSize   = binary.size() * sizeof(std::uint32_t);
+        shaderDesc.sourceType   = ShaderSourceType::BinaryBuffer;
+    }
+
+    return MakeUnique<NullShader>(shaderDesc);
+}
+
+
+/* ----- Pipeline layouts ----- */
+
+static void WriteBindings(Serializer& writer, const std::vector<BindingDescriptor>& bindings)
+{
+    writer.WriteTyped(static_cast<std::uint32_t>(bindings.size()));
+    for (const BindingDescriptor& binding : bindings)
+    {
+        writer.WriteCString(binding.name.c_str());
+        writer.WriteTyped(binding.type);
+        writer.WriteTyped(binding.bindFlags);
+        writer.WriteTyped(binding.stageFlags);
+        writer.WriteTyped(binding.slot);
+        writer.WriteTyped(binding.arraySize);
+    }
+}
+
+static void ReadBindings(Deserializer& reader, std::vector<BindingDescriptor>& outBindings)
+{
+    std::uint32_t count = 0;
+    reader.ReadTyped(count);
+    outBindings.resize(count);
+    for (BindingDescriptor& binding : outBindings)
+    {
+        binding.name = reader.ReadCString();
+        reader.ReadTyped(binding.type);
+        reader.ReadTyped(binding.bindFlags);
+        reader.ReadTyped(binding.stageFlags);
+        reader.ReadTyped(binding.slot);
+        reader.ReadTyped(binding.arraySize);
+    }
+}
+
+// Only the bindings are serialized since the Null renderer ignores static samplers and uniforms.
+static void NullWriteSegmentPipelineLayout(Serializer& writer, const PipelineLayout* pipelineLayout)
+{
+    if (pipelineLayout == nullptr)
+        return;
+
+    auto* pipelineLayoutNull = LLGL_CAST(const NullPipelineLayout*, pipelineLayout);
+
+    writer.Begin(NullIdent_PipelineLayout);
+    {
+        WriteBindings(writer, pipelineLayoutNull->desc.heapBindings);
+        WriteBindings(writer, pipelineLayoutNull->desc.bindings);
+    }
+    writer.End();
+}
+
+static std::unique_ptr<NullPipelineLayout> NullReadSegmentPipelineLayout(Deserializer& reader)
+{
+    if (reader.BeginOnMatch(NullIdent_PipelineLayout).ident != NullIdent_PipelineLayout)
+        return nullptr;
+
+    PipelineLayoutDescriptor layoutDesc;
+    {
+        ReadBindings(reader, layoutDesc.heapBindings);
+        ReadBindings(reader, layoutDesc.bindings);
+    }
+    reader.End();
+
+    return MakeUnique<NullPipelineLayout>(layoutDesc);
+}
+
+
+/* ----- Compute programs ----- */
+
+#ifdef LLGL_ENABLE_SPIRV_REFLECT
+
+static void NullWriteSegmentComputeProgram(Serializer& writer, const NullComputeProgram* program)
+{
+    if (program == nullptr)
+        return;
+
+    writer.Begin(NullIdent_ComputeProgram);
+    {
+        WriteArray(writer, program->instrs);
+        WriteArray(writer, program->params);
+        WriteArray(writer, program->invocationMemory);
+        WriteArray(writer, program->privatePointers);
+        WriteArray(writer, program->workGroupPointers);
+        WriteArray(writer, program->bindingPoints);
+        writer.Write(program->builtins, sizeof(program->builtins));
+        writer.WriteTyped(program->workGroupMemorySize);
+        writer.WriteTyped(program->entryPointPc);
+        writer.WriteTyped(program->maxCallDepth);
+        writer.Write(program->localSize, sizeof(program->localSize));
+        writer.WriteTyped(program->hasBarriers);
+    }
+    writer.End();
+}
+
+static std::unique_ptr<NullComputeProgram> NullReadSegmentComputeProgram(Deserializer& reader)
+{
+    if (reader.BeginOnMatch(NullIdent_ComputeProgram).ident != NullIdent_ComputeProgram)
+        return nullptr;
+
+    auto program = MakeUnique<NullComputeProgram>();
+    {
+        ReadArray(reader, program->instrs);
+        ReadArray(reader, program->params);
+        ReadArray(reader, program->invocationMemory);
+        ReadArray(reader, program->privatePointers);
+        ReadArray(reader, program->workGroupPointers);
+        ReadArray(reader, program->bindingPoints);
+        reader.Read(program->builtins, sizeof(program->builtins));
+        reader.ReadTyped(program->workGroupMemorySize);
+        reader.ReadTyped(program->entryPointPc);
+        reader.ReadTyped(program->maxCallDepth);
+        reader.Read(program->localSize, sizeof(program->localSize));
+        reader.ReadTyped(program->hasBarriers);
+    }
+    reader.End();
+
+    return program;
+}
+
+#endif // /LLGL_ENABLE_SPIRV_REFLECT
+
+
+/* ----- Pipeline states ----- */
+
+static void NullWriteGraphicsPSO(Serializer& writer, const GraphicsPipelineDescriptor& desc)
+{
+    /* Write graphics PSO identifier */
+    writer.Begin(NullIdent_GraphicsPSOIdent);
+    writer.End();
+
+    /* Write fixed function states */
+    writer.Begin(NullIdent_GraphicsDesc);
+    {
+        writer.WriteTyped(desc.primitiveTopology);
+        writer.WriteTyped(desc.depth);
+        writer.WriteTyped(desc.stencil);
+        writer.WriteTyped(desc.rasterizer);
+        writer.WriteTyped(desc.blend);
+        writer.WriteTyped(desc.tessellation);
+    }
+    writer.End();
+
+    /* Write static viewports and scissors */
+    writer.Begin(NullIdent_StaticState);
+    {
+        WriteArray(writer, desc.viewports);
+        WriteArray(writer, desc.scissors);
+    }
+    writer.End();
+
+    /* Write objects the descriptor refers to */
+    NullWriteSegmentPipelineLayout(writer, desc.pipelineLayout);
+    NullWriteSegmentShader(writer, NullIdent_VS, desc.vertexShader);
+    NullWriteSegmentShader(writer, NullIdent_FS, desc.fragmentShader);
+}
+
+static void NullWriteComputePSO(Serializer& writer, const NullPipelineState& pipelineState)
+{
+    const ComputePipelineDescriptor& desc = pipelineState.computeDesc;
+
+    /* Write compute PSO identifier */
+    writer.Begin(NullIdent_ComputePSOIdent);
+    writer.End();
+
+    /* Write objects the descriptor refers to */
+    NullWriteSegmentPipelineLayout(writer, desc.pipelineLayout);
+    NullWriteSegmentShader(writer, NullIdent_CS, desc.computeShader);
+
+    /* Write translated compute program, so restoring the PSO does not have to translate the SPIR-V module again */
+    #ifdef LLGL_ENABLE_SPIRV_REFLECT
+    NullWriteSegmentComputeProgram(writer, pipelineState.GetComputeProgram());
+    #endif
+}
+
+void NullWritePSO(Serializer& writer, const NullPipelineState& pipelineState)
+{
+    if (pipelineState.isGraphicsPSO)
+        NullWriteGraphicsPSO(writer, pipelineState.graphicsDesc);
+    else
+        NullWriteComputePSO(writer, pipelineState);
+}
+
+void NullReadGraphicsPSO(Deserializer& reader, GraphicsPipelineDescriptor& outDesc, NullPipelineCache& outCache)
+{
+    /* Read fixed function states */
+    reader.Begin(NullIdent_GraphicsDesc);
+    {
+        reader.ReadTyped(outDesc.primitiveTopology);
+        reader.ReadTyped(outDesc.depth);
+        reader.ReadTyped(outDesc.stencil);
+        reader.ReadTyped(outDesc.rasterizer);
+        reader.ReadTyped(outDesc.blend);
+        reader.ReadTyped(outDesc.tessellation);
+    }
+    reader.End();
+
+    /* Read static viewports and scissors */
+    reader.Begin(NullIdent_StaticState);
+    {
+        ReadArray(reader, outDesc.viewports);
+        ReadArray(reader, outDesc.scissors);
+    }
+    reader.End();
+
+    /* Restore objects the descriptor refers to */
+    outCache.pipelineLayout = NullReadSegmentPipelineLayout(reader);
+    outCache.vertexShader   = NullReadSegmentShader(reader, NullIdent_VS);
+    outCache.fragmentShader = NullReadSegmentShader(reader, NullIdent_FS);
+
+    outDesc.pipelineLayout  = outCache.pipelineLayout.get();
+    outDesc.vertexShader    = outCache.vertexShader.get();
+    outDesc.fragmentShader  = outCache.fragmentShader.get();
+}
+
+void NullReadComputePSO(Deserializer& reader, ComputePipelineDescriptor& outDesc, NullPipelineCache& outCache)
+{
+    /* Restore objects the descriptor refers to */
+    outCache.pipelineLayout = NullReadSegmentPipelineLayout(reader);
+    outCache.computeShader  = NullReadSegmentShader(reader, NullIdent_CS);
+
+    outDesc.pipelineLayout  = outCache.pipelineLayout.get();
+    outDesc.computeShader   = outCache.computeShader.get();
+
+    #ifdef LLGL_ENABLE_SPIRV_REFLECT
+    outCache.computeProgram = NullReadSegmentComputeProgram(reader);
+    #endif
+}
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
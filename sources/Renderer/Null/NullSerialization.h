@@ -0,0 +1,63 @@
+/*
+ * NullSerialization.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_SERIALIZATION_H
+#define LLGL_NULL_SERIALIZATION_H
+
+
+#include "../Serialization.h"
+#include "RenderState/NullPipelineState.h"
+#include <LLGL/RenderSystemFlags.h>
+
+
+namespace LLGL
+{
+
+namespace Serialization
+{
+
+
+/* ----- Enumerations ----- */
+
+// Segment identifiers for Null serialization.
+enum NullIdent : IdentType
+{
+    NullIdent_ReservedNull = (RendererID::Null << 8),
+    NullIdent_GraphicsPSOIdent,
+    NullIdent_ComputePSOIdent,
+    NullIdent_GraphicsDesc,     // PrimitiveTopology; DepthDescriptor; StencilDescriptor; RasterizerDescriptor; BlendDescriptor; TessellationDescriptor
+    NullIdent_StaticState,      // uint32; Viewport[n]; uint32; Scissor[n]
+    NullIdent_PipelineLayout,   // uint32; BindingDescriptor[n]; uint32; BindingDescriptor[n]
+    NullIdent_VS,               // ShaderType; entry point; VertexShaderAttributes; FragmentShaderAttributes; uint32; uint32[n]
+    NullIdent_FS,               // See NullIdent_VS
+    NullIdent_CS,               // See NullIdent_VS
+    NullIdent_ComputeProgram,   // NullComputeProgram
+};
+
+
+/* ----- Functions ----- */
+
+// Writes the descriptor of the specified PSO including the shaders and pipeline layout it refers to, and the translated compute program if there is one.
+void NullWritePSO(Serializer& writer, const NullPipelineState& pipelineState);
+
+// Reads a graphics PSO descriptor. All objects the descriptor refers to are restored into the output cache.
+void NullReadGraphicsPSO(Deserializer& reader, GraphicsPipelineDescriptor& outDesc, NullPipelineCache& outCache);
+
+// Reads a compute PSO descriptor. All objects the descriptor refers to are restored into the output cache.
+void NullReadComputePSO(Deserializer& reader, ComputePipelineDescriptor& outDesc, NullPipelineCache& outCache);
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,6 +6,9 @@
  */
 
 #include "NullSwapChain.h"
+#include "NullFrameCapture.h"
+#include "Command/NullCommandQueue.h"
+#include "../../Core/CoreUtils.h"
 
 
 namespace LLGL
@@ -35,13 +38,21 @@ static Format ChooseDepthStencilFormat(int depthBits, int stencilBits)
     }
 }
 
-NullSwapChain::NullSwapChain(const SwapChainDescriptor& desc, const std::shared_ptr<Surface>& surface) :
+NullSwapChain::NullSwapChain(
+    const SwapChainDescriptor&      desc,
+    const std::shared_ptr<Surface>& surface,
+    NullCommandQueue&               commandQueue,
+    NullFrameCapture*               frameCapture)
+:
     SwapChain           { desc                                                       },
-    samples_            { desc.samples                                               },
+    commandQueue_       { commandQueue                                               },
+    frameCapture_       { frameCapture                                               },
+    samples_            { NullTexture::ClampSamples(desc.samples)                    },
     colorFormat_        { ChooseColorFormat(desc.colorBits)                          },
     depthStencilFormat_ { ChooseDepthStencilFormat(desc.depthBits, desc.stencilBits) }
 {
     SetOrCreateSurface(surface, desc.resolution, desc.fullscreen, nullptr);
+    CreateBuffers(GetResolution());
 }
 
 void NullSwapChain::SetName(const char* name)
@@ -54,7 +65,9 @@ void NullSwapChain::SetName(const char* name)
 
 void NullSwapChain::Present()
 {
-    // dummy
+    /* Capture back buffer on the worker thread of the command queue once all submitted commands have been executed */
+    if (frameCapture_ != nullptr)
+        commandQueue_.SubmitFrameCapture(*frameCapture_, *colorBuffer_);
 }
 
 std::uint32_t NullSwapChain::GetSamples() const
@@ -83,12 +96,46 @@ const RenderPass* NullSwapChain::GetRenderPass() const
     return renderPass_;
 }
 
-bool NullSwapChain::ResizeBuffersPrimary(const Extent2D& /*resolution*/)
+bool NullSwapChain::ResizeBuffersPrimary(const Extent2D& resolution)
 {
+    /* Wait for pending submissions that may still render into the old buffers before they are released */
+    commandQueue_.WaitIdle();
+    CreateBuffers(resolution);
     return true;
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+static std::unique_ptr<NullTexture> MakeSwapChainBuffer(const Extent2D& resolution, const Format format, long bindFlags, std::uint32_t samples = 1)
+{
+    TextureDescriptor textureDesc;
+    {
+        textureDesc.type            = (samples > 1 ? TextureType::Texture2DMS : TextureType::Texture2D);
+        textureDesc.bindFlags       = bindFlags;
+        textureDesc.miscFlags       = 0;
+        textureDesc.format          = format;
+        textureDesc.extent.width    = resolution.width;
+        textureDesc.extent.height   = resolution.height;
+        textureDesc.mipLevels       = 1;
+        textureDesc.samples         = samples;
+    }
+    return MakeUnique<NullTexture>(textureDesc);
+}
+
+void NullSwapChain::CreateBuffers(const Extent2D& resolution)
+{
+    /* Multi-sampled swap-chains render into a multi-sampled color buffer that is resolved into the presented color buffer */
+    colorBuffer_ = MakeSwapChainBuffer(resolution, colorFormat_, BindFlags::ColorAttachment);
+    if (samples_ > 1)
+        colorBufferMS_ = MakeSwapChainBuffer(resolution, colorFormat_, BindFlags::ColorAttachment, samples_);
+    if (depthStencilFormat_ != Format::Undefined)
+        depthStencilBuffer_ = MakeSwapChainBuffer(resolution, depthStencilFormat_, BindFlags::DepthStencilAttachment, samples_);
+}
+
+
 } // /namespace LLGL
 
 
@@ -10,6 +10,8 @@
 
 
 #include <LLGL/SwapChain.h>
+#include "Texture/NullTexture.h"
+#include <memory>
 #include <string>
 
 
@@ -17,12 +19,20 @@ namespace LLGL
 {
 
 
+class NullCommandQueue;
+class NullFrameCapture;
+
 class NullSwapChain final : public SwapChain
 {
 
     public:
 
-        NullSwapChain(const SwapChainDescriptor& desc, const std::shared_ptr<Surface>& surface);
+        NullSwapChain(
+            const SwapChainDescriptor&          desc,
+            const std::shared_ptr<Surface>&     surface,
+            NullCommandQueue&                   commandQueue,
+            NullFrameCapture*                   frameCapture
+        );
 
     public:
 
@@ -39,12 +49,37 @@ class NullSwapChain final : public SwapChain
 
         const RenderPass* GetRenderPass() const override;
 
+    public:
+
+        // Returns the color buffer this swap-chain presents.
+        inline NullTexture* GetColorBuffer() const
+        {
+            return colorBuffer_.get();
+        }
+
+        // Returns the multi-sampled color buffer this swap-chain renders into, or null if it renders into the color buffer directly.
+        inline NullTexture* GetMultiSampledColorBuffer() const
+        {
+            return colorBufferMS_.get();
+        }
+
+        // Returns the depth-stencil buffer or null if this swap-chain has no depth-stencil format. It has the same number of samples as the swap-chain.
+        inline NullTexture* GetDepthStencilBuffer() const
+        {
+            return depthStencilBuffer_.get();
+        }
+
     private:
 
         bool ResizeBuffersPrimary(const Extent2D& resolution) override;
 
+        void CreateBuffers(const Extent2D& resolution);
+
     private:
 
+        NullCommandQueue&   commandQueue_;
+        NullFrameCapture*   frameCapture_       = nullptr;
+
         std::string         label_;
         std::uint32_t       samples_            = 1;
         Format              colorFormat_        = Format::Undefined;
@@ -52,6 +87,10 @@ class NullSwapChain final : public SwapChain
         std::uint32_t       vsyncInterval_      = 0;
         const RenderPass*   renderPass_         = nullptr;
 
+        std::unique_ptr<NullTexture> colorBuffer_;
+        std::unique_ptr<NullTexture> colorBufferMS_;
+        std::unique_ptr<NullTexture> depthStencilBuffer_;
+
 };
 
 
@@ -0,0 +1,456 @@
+/*
+ * NullRasterTile.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "NullRasterTile.h"
+#include "../Texture/NullTexture.h"
+#include "../../TextureUtils.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <cmath>
+#include <string.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* ----- Color space conversion ----- */
+
+static float SRGBToLinear(float c)
+{
+    return (c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f));
+}
+
+static float LinearToSRGB(float c)
+{
+    return (c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f);
+}
+
+// Returns the lookup table to convert 8-bit sRGB values into linear space.
+static const float* GetSRGBToLinearTable()
+{
+    static const struct SRGBTable
+    {
+        SRGBTable()
+        {
+            for_range(i, 256)
+                values[i] = SRGBToLinear(static_cast<float>(i) / 255.0f);
+        }
+        float values[256];
+    }
+    table;
+    return table.values;
+}
+
+static float Saturate(float x)
+{
+    return (x > 0.0f ? (x < 1.0f ? x : 1.0f) : 0.0f);
+}
+
+static std::uint8_t FloatToUNorm8(float x)
+{
+    return static_cast<std::uint8_t>(Saturate(x) * 255.0f + 0.5f);
+}
+
+/* ----- Attachment addressing ----- */
+
+// Returns a pointer to the texel at (x, y) of the attachment's MIP-map level and array layer.
+static char* GetAttachmentTexelPtr(const NullAttachment& attachment, std::int32_t x, std::int32_t y)
+{
+    const auto  type    = attachment.texture->GetType();
+    const auto  layer   = static_cast<std::int32_t>(attachment.arrayLayer);
+    const bool  isLayer = (type == TextureType::Texture3D || attachment.texture->GetNumSamples() > 1);
+    const auto  offset  = (isLayer ? Offset3D{ x, y, layer } : CalcTextureOffset(type, Offset3D{ x, y, 0 }, attachment.arrayLayer));
+    return attachment.texture->GetTexelPtr(
+        attachment.mipLevel,
+        static_cast<std::uint32_t>(offset.x),
+        static_cast<std::uint32_t>(offset.y),
+        static_cast<std::uint32_t>(offset.z)
+    );
+}
+
+static std::size_t GetTileRowStride(const NullAttachment& attachment)
+{
+    return attachment.texture->GetTexelRowStride(attachment.mipLevel);
+}
+
+/* ----- Color tiles ----- */
+
+bool IsColorTileFormatSupported(const Format format)
+{
+    const auto& formatAttribs = GetFormatAttribs(format);
+    return ((formatAttribs.flags & (FormatFlags::IsCompressed | FormatFlags::IsPacked | FormatFlags::HasDepth | FormatFlags::HasStencil)) == 0);
+}
+
+static void LoadColorTexelsRGBA8(const char* srcRow, std::size_t rowStride, const NullTileRect& rect, float* dst, bool isBGRA, bool isSRGB)
+{
+    const float*        lut         = GetSRGBToLinearTable();
+    const int           r           = (isBGRA ? 2 : 0);
+    const int           b           = (isBGRA ? 0 : 2);
+
+    for_range(y, rect.height)
+    {
+        auto src = reinterpret_cast<const std::uint8_t*>(srcRow);
+        for_range(x, rect.width)
+        {
+            if (isSRGB)
+            {
+                dst[0] = lut[src[r]];
+                dst[1] = lut[src[1]];
+                dst[2] = lut[src[b]];
+            }
+            else
+            {
+                dst[0] = static_cast<float>(src[r]) / 255.0f;
+                dst[1] = static_cast<float>(src[1]) / 255.0f;
+                dst[2] = static_cast<float>(src[b]) / 255.0f;
+            }
+            dst[3] = static_cast<float>(src[3]) / 255.0f;
+            src += 4;
+            dst += 4;
+        }
+        srcRow += rowStride;
+    }
+}
+
+static void StoreColorTexelsRGBA8(char* dstRow, std::size_t rowStride, const NullTileRect& rect, const float* src, bool isBGRA, bool isSRGB)
+{
+    const int           r           = (isBGRA ? 2 : 0);
+    const int           b           = (isBGRA ? 0 : 2);
+
+    for_range(y, rect.height)
+    {
+        auto dst = reinterpret_cast<std::uint8_t*>(dstRow);
+        for_range(x, rect.width)
+        {
+            if (isSRGB)
+            {
+                dst[r] = FloatToUNorm8(LinearToSRGB(Saturate(src[0])));
+                dst[1] = FloatToUNorm8(LinearToSRGB(Saturate(src[1])));
+                dst[b] = FloatToUNorm8(LinearToSRGB(Saturate(src[2])));
+            }
+            else
+            {
+                dst[r] = FloatToUNorm8(src[0]);
+                dst[1] = FloatToUNorm8(src[1]);
+                dst[b] = FloatToUNorm8(src[2]);
+            }
+            dst[3] = FloatToUNorm8(src[3]);
+            src += 4;
+            dst += 4;
+        }
+        dstRow += rowStride;
+    }
+}
+
+static void LoadColorTexelsRGBA32Float(const char* srcRow, std::size_t rowStride, const NullTileRect& rect, float* dst)
+{
+    const std::size_t rowSize = sizeof(float) * 4 * static_cast<std::size_t>(rect.width);
+
+    for_range(y, rect.height)
+    {
+        ::memcpy(dst, srcRow, rowSize);
+        dst     += rect.width * 4;
+        srcRow  += rowStride;
+    }
+}
+
+static void StoreColorTexelsRGBA32Float(char* dstRow, std::size_t rowStride, const NullTileRect& rect, const float* src)
+{
+    const std::size_t rowSize = sizeof(float) * 4 * static_cast<std::size_t>(rect.width);
+
+    for_range(y, rect.height)
+    {
+        ::memcpy(dstRow, src, rowSize);
+        src     += rect.width * 4;
+        dstRow  += rowStride;
+    }
+}
+
+// Converts a row of texels between the specified image formats. Returns without conversion if both formats are equal.
+static void ConvertTexelRow(const SrcImageDescriptor& srcImageDesc, const DstImageDescriptor& dstImageDesc)
+{
+    if (!ConvertImageBuffer(srcImageDesc, dstImageDesc))
+        ::memcpy(dstImageDesc.data, srcImageDesc.data, std::min(srcImageDesc.dataSize, dstImageDesc.dataSize));
+}
+
+static void LoadColorTexels(const Format format, const char* srcRow, std::size_t rowStride, const NullTileRect& rect, float* dst)
+{
+    switch (format)
+    {
+        case Format::RGBA8UNorm:
+            LoadColorTexelsRGBA8(srcRow, rowStride, rect, dst, false, false);
+            break;
+        case Format::RGBA8UNorm_sRGB:
+            LoadColorTexelsRGBA8(srcRow, rowStride, rect, dst, false, true);
+            break;
+        case Format::BGRA8UNorm:
+            LoadColorTexelsRGBA8(srcRow, rowStride, rect, dst, true, false);
+            break;
+        case Format::BGRA8UNorm_sRGB:
+            LoadColorTexelsRGBA8(srcRow, rowStride, rect, dst, true, true);
+            break;
+        case Format::RGBA32Float:
+            LoadColorTexelsRGBA32Float(srcRow, rowStride, rect, dst);
+            break;
+        default:
+        {
+            /* Convert tile region row by row with generic image conversion */
+            const auto& formatAttribs   = GetFormatAttribs(format);
+            const auto  width           = static_cast<std::size_t>(rect.width);
+            const auto  rowSize         = width * formatAttribs.bitSize / 8;
+            float*      dstRow          = dst;
+
+            for_range(y, rect.height)
+            {
+                const SrcImageDescriptor srcImageDesc{ formatAttribs.format, formatAttribs.dataType, srcRow, rowSize };
+                const DstImageDescriptor dstImageDesc{ ImageFormat::RGBA, DataType::Float32, dstRow, width * sizeof(float) * 4 };
+                ConvertTexelRow(srcImageDesc, dstImageDesc);
+                srcRow += rowStride;
+                dstRow += width * 4;
+            }
+
+            if ((formatAttribs.flags & FormatFlags::IsColorSpace_sRGB) != 0)
+            {
+                const auto numPixels = static_cast<std::size_t>(rect.width * rect.height);
+                for_range(i, numPixels)
+                {
+                    dst[i*4 + 0] = SRGBToLinear(dst[i*4 + 0]);
+                    dst[i*4 + 1] = SRGBToLinear(dst[i*4 + 1]);
+                    dst[i*4 + 2] = SRGBToLinear(dst[i*4 + 2]);
+                }
+            }
+        }
+        break;
+    }
+}
+
+static void StoreColorTexels(const Format format, char* dstRow, std::size_t rowStride, const NullTileRect& rect, const float* src)
+{
+    switch (format)
+    {
+        case Format::RGBA8UNorm:
+            StoreColorTexelsRGBA8(dstRow, rowStride, rect, src, false, false);
+            break;
+        case Format::RGBA8UNorm_sRGB:
+            StoreColorTexelsRGBA8(dstRow, rowStride, rect, src, false, true);
+            break;
+        case Format::BGRA8UNorm:
+            StoreColorTexelsRGBA8(dstRow, rowStride, rect, src, true, false);
+            break;
+        case Format::BGRA8UNorm_sRGB:
+            StoreColorTexelsRGBA8(dstRow, rowStride, rect, src, true, true);
+            break;
+        case Format::RGBA32Float:
+            StoreColorTexelsRGBA32Float(dstRow, rowStride, rect, src);
+            break;
+        default:
+        {
+            /* Convert tile region row by row with generic image conversion */
+            const auto  numPixels       = static_cast<std::size_t>(rect.width * rect.height);
+            const auto& formatAttribs   = GetFormatAttribs(format);
+            const auto  width           = static_cast<std::size_t>(rect.width);
+            const auto  rowSize         = width * formatAttribs.bitSize / 8;
+            std::vector<float> converted;
+
+            if ((formatAttribs.flags & FormatFlags::IsNormalized) != 0)
+            {
+                /* Clamp values to the normalized range and apply sRGB encoding if necessary */
+                const bool isSRGB = ((formatAttribs.flags & FormatFlags::IsColorSpace_sRGB) != 0);
+                converted.resize(numPixels * 4);
+                for_range(i, numPixels * 4)
+                {
+                    const float value = Saturate(src[i]);
+                    converted[i] = (isSRGB && (i % 4) != 3 ? LinearToSRGB(value) : value);
+                }
+                src = converted.data();
+            }
+
+            for_range(y, rect.height)
+            {
+                const SrcImageDescriptor srcImageDesc{ ImageFormat::RGBA, DataType::Float32, src, width * sizeof(float) * 4 };
+                const DstImageDescriptor dstImageDesc{ formatAttribs.format, formatAttribs.dataType, dstRow, rowSize };
+                ConvertTexelRow(srcImageDesc, dstImageDesc);
+                src     += width * 4;
+                dstRow  += rowStride;
+            }
+        }
+        break;
+    }
+}
+
+void LoadColorTile(const NullAttachment& attachment, const NullTileRect& rect, float* dst)
+{
+    LoadColorTexels(
+        attachment.texture->GetFormat(),
+        GetAttachmentTexelPtr(attachment, rect.x, rect.y),
+        GetTileRowStride(attachment),
+        rect,
+        dst
+    );
+}
+
+void StoreColorTile(const NullAttachment& attachment, const NullTileRect& rect, const float* src)
+{
+    StoreColorTexels(
+        attachment.texture->GetFormat(),
+        GetAttachmentTexelPtr(attachment, rect.x, rect.y),
+        GetTileRowStride(attachment),
+        rect,
+        src
+    );
+}
+
+/* ----- Depth-stencil tiles ----- */
+
+static void LoadDepthStencilTexels(const Format format, const char* srcRow, std::size_t rowStride, const NullTileRect& rect, float* dstDepth, std::uint8_t* dstStencil)
+{
+    for_range(y, rect.height)
+    {
+        for_range(x, rect.width)
+        {
+            switch (format)
+            {
+                case Format::D16UNorm:
+                {
+                    const auto value = reinterpret_cast<const std::uint16_t*>(srcRow)[x];
+                    *dstDepth++     = static_cast<float>(value) / 65535.0f;
+                    *dstStencil++   = 0;
+                }
+                break;
+
+                case Format::D24UNormS8UInt:
+                {
+                    /* Depth is stored in the lower 24 bits and stencil in the upper 8 bits */
+                    const auto value = reinterpret_cast<const std::uint32_t*>(srcRow)[x];
+                    *dstDepth++     = static_cast<float>(value & 0x00FFFFFFu) / 16777215.0f;
+                    *dstStencil++   = static_cast<std::uint8_t>(value >> 24);
+                }
+                break;
+
+                case Format::D32Float:
+                {
+                    *dstDepth++     = reinterpret_cast<const float*>(srcRow)[x];
+                    *dstStencil++   = 0;
+                }
+                break;
+
+                case Format::D32FloatS8X24UInt:
+                {
+                    /* Depth is stored in the first 32 bits and stencil in the next 8 bits */
+                    const char* texel = srcRow + x * 8;
+                    ::memcpy(dstDepth++, texel, sizeof(float));
+                    *dstStencil++ = static_cast<std::uint8_t>(texel[4]);
+                }
+                break;
+
+                default:
+                {
+                    *dstDepth++     = 1.0f;
+                    *dstStencil++   = 0;
+                }
+                break;
+            }
+        }
+        srcRow += rowStride;
+    }
+}
+
+static void StoreDepthStencilTexels(const Format format, char* dstRow, std::size_t rowStride, const NullTileRect& rect, const float* srcDepth, const std::uint8_t* srcStencil)
+{
+    for_range(y, rect.height)
+    {
+        for_range(x, rect.width)
+        {
+            const float         depth   = Saturate(*srcDepth++);
+            const std::uint8_t  stencil = *srcStencil++;
+
+            switch (format)
+            {
+                case Format::D16UNorm:
+                {
+                    reinterpret_cast<std::uint16_t*>(dstRow)[x] = static_cast<std::uint16_t>(depth * 65535.0f + 0.5f);
+                }
+                break;
+
+                case Format::D24UNormS8UInt:
+                {
+                    /* Scale in double precision, since 16777215.5 rounds up to 2^24 in single precision and would overflow into the stencil bits */
+                    const auto depthBits = static_cast<std::uint32_t>(static_cast<double>(depth) * 16777215.0 + 0.5);
+                    reinterpret_cast<std::uint32_t*>(dstRow)[x] = (depthBits | (static_cast<std::uint32_t>(stencil) << 24));
+                }
+                break;
+
+                case Format::D32Float:
+                {
+                    reinterpret_cast<float*>(dstRow)[x] = depth;
+                }
+                break;
+
+                case Format::D32FloatS8X24UInt:
+                {
+                    char* texel = dstRow + x * 8;
+                    ::memcpy(texel, &depth, sizeof(float));
+                    texel[4] = static_cast<char>(stencil);
+                }
+                break;
+
+                default:
+                break;
+            }
+        }
+        dstRow += rowStride;
+    }
+}
+
+void LoadDepthStencilTile(const NullAttachment& attachment, const NullTileRect& rect, float* dstDepth, std::uint8_t* dstStencil)
+{
+    LoadDepthStencilTexels(
+        attachment.texture->GetFormat(),
+        GetAttachmentTexelPtr(attachment, rect.x, rect.y),
+        GetTileRowStride(attachment),
+        rect,
+        dstDepth,
+        dstStencil
+    );
+}
+
+void StoreDepthStencilTile(const NullAttachment& attachment, const NullTileRect& rect, const float* srcDepth, const std::uint8_t* srcStencil)
+{
+    StoreDepthStencilTexels(
+        attachment.texture->GetFormat(),
+        GetAttachmentTexelPtr(attachment, rect.x, rect.y),
+        GetTileRowStride(attachment),
+        rect,
+        srcDepth,
+        srcStencil
+    );
+}
+
+/* ----- Clear texels ----- */
+
+static const NullTileRect g_texelRect{ 0, 0, 1, 1 };
+
+void EncodeColorClearTexel(const Format format, const float (&color)[4], char* texel, float (&outColor)[4])
+{
+    StoreColorTexels(format, texel, 0, g_texelRect, color);
+    LoadColorTexels(format, texel, 0, g_texelRect, outColor);
+}
+
+void EncodeDepthStencilClearTexel(const Format format, float depth, std::uint8_t stencil, char* texel, float& outDepth, std::uint8_t& outStencil)
+{
+    StoreDepthStencilTexels(format, texel, 0, g_texelRect, &depth, &stencil);
+    LoadDepthStencilTexels(format, texel, 0, g_texelRect, &outDepth, &outStencil);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
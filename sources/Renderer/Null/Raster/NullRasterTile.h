@@ -0,0 +1,61 @@
+/*
+ * NullRasterTile.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_RASTER_TILE_H
+#define LLGL_NULL_RASTER_TILE_H
+
+
+#include "../Texture/NullRenderTarget.h"
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Screen space rectangle of a rasterizer tile. Tile buffers are tightly packed with a row stride of 'width'.
+Rectangles must not cross the storage tiles of tiled attachments (see NullTexture::tileSize).
+*/
+struct NullTileRect
+{
+    std::int32_t x;
+    std::int32_t y;
+    std::int32_t width;
+    std::int32_t height;
+};
+
+// Returns true if the color attachment's format can be loaded into and stored from a tile buffer.
+bool IsColorTileFormatSupported(const Format format);
+
+// Loads the tile region of the specified color attachment into an RGBA buffer of 32-bit floats. sRGB formats are converted into linear space.
+void LoadColorTile(const NullAttachment& attachment, const NullTileRect& rect, float* dst);
+
+// Stores the RGBA buffer of 32-bit floats into the tile region of the specified color attachment.
+void StoreColorTile(const NullAttachment& attachment, const NullTileRect& rect, const float* src);
+
+// Loads the tile region of the specified depth-stencil attachment. Formats without stencil component load zeros into 'dstStencil'.
+void LoadDepthStencilTile(const NullAttachment& attachment, const NullTileRect& rect, float* dstDepth, std::uint8_t* dstStencil);
+
+// Stores the depth and stencil buffers into the tile region of the specified depth-stencil attachment.
+void StoreDepthStencilTile(const NullAttachment& attachment, const NullTileRect& rect, const float* srcDepth, const std::uint8_t* srcStencil);
+
+// Encodes the clear color into a single texel of the specified format and returns the color as it is loaded back into a tile buffer.
+void EncodeColorClearTexel(const Format format, const float (&color)[4], char* texel, float (&outColor)[4]);
+
+// Encodes the clear depth and stencil values into a single texel of the specified format and returns the values as they are loaded back into tile buffers.
+void EncodeDepthStencilClearTexel(const Format format, float depth, std::uint8_t stencil, char* texel, float& outDepth, std::uint8_t& outStencil);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
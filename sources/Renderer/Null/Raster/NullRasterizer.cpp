@@ -0,0 +1,2317 @@
+/*
+ * NullRasterizer.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "NullRasterizer.h"
+#include "../Buffer/NullBuffer.h"
+#include "../Shader/NullShader.h"
+#include "../Texture/NullTexture.h"
+#include "../RenderState/NullPipelineState.h"
+#include "../../CheckedCast.h"
+#include "../../../Core/Threading.h"
+#include "../../../Core/Float16Compressor.h"
+#include "../../../Core/CompilerExtensions.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <string.h>
+#include <thread>
+
+#ifdef LLGL_HAS_SSE2
+#   include <emmintrin.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+// Number of sub-pixel bits for fixed-point screen coordinates.
+static constexpr std::int32_t   g_subPixelBits          = 4;
+static constexpr std::int32_t   g_subPixelScale         = (1 << g_subPixelBits);
+
+/*
+Standard multi-sample patterns in sub-pixel units relative to the pixel center (see D3D11_STANDARD_MULTISAMPLE_PATTERN).
+The sub-pixel precision matches the 1/16 pixel grid of these patterns.
+*/
+static_assert(g_subPixelScale == 16, "standard sample patterns require 4 bits sub-pixel precision");
+
+static const std::int8_t g_samplePattern1[1][2] = { { 0, 0 } };
+static const std::int8_t g_samplePattern2[2][2] = { { 4, 4 }, { -4, -4 } };
+static const std::int8_t g_samplePattern4[4][2] = { { -2, -6 }, { 6, -2 }, { -6, 2 }, { 2, 6 } };
+static const std::int8_t g_samplePattern8[8][2] =
+{
+    { 1, -3 }, { -1, 3 }, { 5, 1 }, { -3, -5 }, { -5, 5 }, { -7, -1 }, { 3, 7 }, { 7, -7 }
+};
+static const std::int8_t g_samplePattern16[16][2] =
+{
+    { 1, 1 }, { -1, -3 }, { -3, 2 }, { 4, -1 }, { -5, -2 }, { 2, 5 }, { 5, 3 }, { 3, -5 },
+    { -2, 6 }, { 0, -7 }, { -4, -6 }, { -6, 4 }, { -8, 0 }, { 7, -4 }, { 6, 7 }, { -7, -8 }
+};
+
+// Returns the sample pattern for the specified number of samples, which must be a power of two up to NullTexture::maxSamples.
+static const std::int8_t (*GetSamplePattern(std::uint32_t numSamples))[2]
+{
+    switch (numSamples)
+    {
+        case 2:     return g_samplePattern2;
+        case 4:     return g_samplePattern4;
+        case 8:     return g_samplePattern8;
+        case 16:    return g_samplePattern16;
+        default:    return g_samplePattern1;
+    }
+}
+
+// Maximum number of binned triangles before the rasterizer flushes in the middle of a render pass.
+static constexpr std::size_t    g_maxBinnedTriangles    = (1u << 20);
+
+// Minimum number of vertices per worker thread for the vertex stage.
+static constexpr unsigned       g_minVerticesPerThread  = 4096;
+
+// Minimum number of primitives per worker thread for stream output.
+static constexpr unsigned       g_minPrimitivesPerThread= 2048;
+
+/* ----- Vertex fetch ----- */
+
+static float ReadVertexComponent(const DataType dataType, bool normalized, const char* src)
+{
+    switch (dataType)
+    {
+        case DataType::Int8:
+        {
+            std::int8_t value;
+            ::memcpy(&value, src, sizeof(value));
+            return (normalized ? std::max(static_cast<float>(value) / 127.0f, -1.0f) : static_cast<float>(value));
+        }
+        case DataType::UInt8:
+        {
+            std::uint8_t value;
+            ::memcpy(&value, src, sizeof(value));
+            return (normalized ? static_cast<float>(value) / 255.0f : static_cast<float>(value));
+        }
+        case DataType::Int16:
+        {
+            std::int16_t value;
+            ::memcpy(&value, src, sizeof(value));
+            return (normalized ? std::max(static_cast<float>(value) / 32767.0f, -1.0f) : static_cast<float>(value));
+        }
+        case DataType::UInt16:
+        {
+            std::uint16_t value;
+            ::memcpy(&value, src, sizeof(value));
+            return (normalized ? static_cast<float>(value) / 65535.0f : static_cast<float>(value));
+        }
+        case DataType::Int32:
+        {
+            std::int32_t value;
+            ::memcpy(&value, src, sizeof(value));
+            return static_cast<float>(value);
+        }
+        case DataType::UInt32:
+        {
+            std::uint32_t value;
+            ::memcpy(&value, src, sizeof(value));
+            return static_cast<float>(value);
+        }
+        case DataType::Float16:
+        {
+            std::uint16_t value;
+            ::memcpy(&value, src, sizeof(value));
+            return DecompressFloat16(value);
+        }
+        case DataType::Float32:
+        {
+            float value;
+            ::memcpy(&value, src, sizeof(value));
+            return value;
+        }
+        case DataType::Float64:
+        {
+            double value;
+            ::memcpy(&value, src, sizeof(value));
+            return static_cast<float>(value);
+        }
+        default:
+            return 0.0f;
+    }
+}
+
+// Reads the specified vertex attribute; Missing components keep their values from 'outValue'.
+static void ReadVertexAttribute(
+    const VertexAttribute&      attrib,
+    std::uint32_t               index,
+    std::size_t                 numVertexBuffers,
+    const NullBuffer* const *   vertexBuffers,
+    float                       (&outValue)[4])
+{
+    if (attrib.slot >= numVertexBuffers || vertexBuffers[attrib.slot] == nullptr)
+        return;
+
+    const auto& formatAttribs = GetFormatAttribs(attrib.format);
+    if ((formatAttribs.flags & (FormatFlags::IsCompressed | FormatFlags::IsPacked)) != 0 || formatAttribs.dataType == DataType::Undefined)
+        return;
+
+    /* Check for out-of-bounds */
+    const NullBuffer*   buffer          = vertexBuffers[attrib.slot];
+    const std::uint64_t componentSize   = DataTypeSize(formatAttribs.dataType);
+    const std::uint64_t offset          = static_cast<std::uint64_t>(attrib.offset) + static_cast<std::uint64_t>(attrib.stride) * index;
+    if (offset + componentSize * formatAttribs.components > buffer->desc.size)
+        return;
+
+    const char* src         = buffer->GetBytesAt(offset);
+    const bool  normalized  = ((formatAttribs.flags & FormatFlags::IsNormalized) != 0);
+
+    for_range(i, std::min<std::uint32_t>(formatAttribs.components, 4u))
+        outValue[i] = ReadVertexComponent(formatAttribs.dataType, normalized, src + componentSize * i);
+
+    if (formatAttribs.format == ImageFormat::BGRA || formatAttribs.format == ImageFormat::BGR)
+        std::swap(outValue[0], outValue[2]);
+}
+
+template <typename T>
+static void WriteVertexInteger(double value, char* dst)
+{
+    const double minValue = static_cast<double>(std::numeric_limits<T>::lowest());
+    const double maxValue = static_cast<double>(std::numeric_limits<T>::max());
+    const T intValue = static_cast<T>(std::max(minValue, std::min(value, maxValue)));
+    ::memcpy(dst, &intValue, sizeof(intValue));
+}
+
+// Converts the value into the specified data type and writes it to 'dst'. Integer types are clamped to their range.
+static void WriteVertexComponent(const DataType dataType, bool normalized, float value, char* dst)
+{
+    switch (dataType)
+    {
+        case DataType::Int8:
+            WriteVertexInteger<std::int8_t>(normalized ? std::round(value * 127.0f) : value, dst);
+            break;
+        case DataType::UInt8:
+            WriteVertexInteger<std::uint8_t>(normalized ? std::round(value * 255.0f) : value, dst);
+            break;
+        case DataType::Int16:
+            WriteVertexInteger<std::int16_t>(normalized ? std::round(value * 32767.0f) : value, dst);
+            break;
+        case DataType::UInt16:
+            WriteVertexInteger<std::uint16_t>(normalized ? std::round(value * 65535.0f) : value, dst);
+            break;
+        case DataType::Int32:
+            WriteVertexInteger<std::int32_t>(value, dst);
+            break;
+        case DataType::UInt32:
+            WriteVertexInteger<std::uint32_t>(value, dst);
+            break;
+        case DataType::Float16:
+        {
+            const std::uint16_t halfValue = CompressFloat16(value);
+            ::memcpy(dst, &halfValue, sizeof(halfValue));
+        }
+        break;
+        case DataType::Float32:
+            ::memcpy(dst, &value, sizeof(value));
+            break;
+        case DataType::Float64:
+        {
+            const double doubleValue = value;
+            ::memcpy(dst, &doubleValue, sizeof(doubleValue));
+        }
+        break;
+        default:
+            break;
+    }
+}
+
+// Writes the RGBA value in the format of the specified stream-output attribute. The attribute offset denotes the first component that is written.
+static void WriteVertexAttribute(const VertexAttribute& attrib, const float* value, char* dst)
+{
+    const auto& formatAttribs = GetFormatAttribs(attrib.format);
+
+    float components[4] = { value[0], value[1], value[2], value[3] };
+    if (formatAttribs.format == ImageFormat::BGRA || formatAttribs.format == ImageFormat::BGR)
+        std::swap(components[0], components[2]);
+
+    const std::uint32_t componentSize   = static_cast<std::uint32_t>(DataTypeSize(formatAttribs.dataType));
+    const std::uint32_t firstComponent  = std::min(attrib.offset, 3u);
+    const std::uint32_t numComponents   = std::min<std::uint32_t>(formatAttribs.components, 4u - firstComponent);
+    const bool          normalized      = ((formatAttribs.flags & FormatFlags::IsNormalized) != 0);
+
+    for_range(i, numComponents)
+        WriteVertexComponent(formatAttribs.dataType, normalized, components[firstComponent + i], dst + componentSize * i);
+}
+
+static std::uint32_t GetAttributeIndex(const VertexAttribute& attrib, std::uint32_t vertex, std::uint32_t instance, std::uint32_t firstInstance)
+{
+    if (attrib.instanceDivisor > 0)
+        return firstInstance + instance / attrib.instanceDivisor;
+    else
+        return vertex;
+}
+
+static bool ContainsCaseInsensitive(const char* str, const char* substr)
+{
+    for (; *str != '\0'; ++str)
+    {
+        std::size_t i = 0;
+        while (substr[i] != '\0' && std::tolower(static_cast<unsigned char>(str[i])) == substr[i])
+            ++i;
+        if (substr[i] == '\0')
+            return true;
+    }
+    return false;
+}
+
+/* ----- Fixed-function operations ----- */
+
+template <typename T>
+static bool CompareValues(const CompareOp op, T src, T dst)
+{
+    switch (op)
+    {
+        case CompareOp::NeverPass:      return false;
+        case CompareOp::Less:           return (src <  dst);
+        case CompareOp::Equal:          return (src == dst);
+        case CompareOp::LessEqual:      return (src <= dst);
+        case CompareOp::Greater:        return (src >  dst);
+        case CompareOp::NotEqual:       return (src != dst);
+        case CompareOp::GreaterEqual:   return (src >= dst);
+        case CompareOp::AlwaysPass:     return true;
+    }
+    return true;
+}
+
+// Returns true if no depth value in the range [srcMin, srcMax] can pass the depth test against any value in the range [dstMin, dstMax].
+static bool IsDepthRangeRejected(const CompareOp op, float srcMin, float srcMax, float dstMin, float dstMax)
+{
+    switch (op)
+    {
+        case CompareOp::NeverPass:      return true;
+        case CompareOp::Less:           return (srcMin >= dstMax);
+        case CompareOp::Equal:          return (srcMax < dstMin || srcMin > dstMax);
+        case CompareOp::LessEqual:      return (srcMin > dstMax);
+        case CompareOp::Greater:        return (srcMax <= dstMin);
+        case CompareOp::GreaterEqual:   return (srcMax < dstMin);
+        default:                        return false;
+    }
+}
+
+static std::uint8_t ApplyStencilOp(const StencilOp op, std::uint8_t value, std::uint8_t reference)
+{
+    switch (op)
+    {
+        case StencilOp::Keep:       return value;
+        case StencilOp::Zero:       return 0;
+        case StencilOp::Replace:    return reference;
+        case StencilOp::IncClamp:   return (value < 0xFF ? value + 1 : value);
+        case StencilOp::DecClamp:   return (value > 0 ? value - 1 : value);
+        case StencilOp::Invert:     return static_cast<std::uint8_t>(~value);
+        case StencilOp::IncWrap:    return static_cast<std::uint8_t>(value + 1);
+        case StencilOp::DecWrap:    return static_cast<std::uint8_t>(value - 1);
+    }
+    return value;
+}
+
+static void WriteStencil(const StencilOp op, std::uint8_t reference, std::uint8_t writeMask, std::uint8_t& dst)
+{
+    if (op != StencilOp::Keep)
+        dst = static_cast<std::uint8_t>((dst & ~writeMask) | (ApplyStencilOp(op, dst, reference) & writeMask));
+}
+
+// Returns true if fragments that fail the depth test with the specified stencil face have no side effects, i.e. they can be rejected before the stencil test.
+static bool IsStencilFaceSideEffectFree(const StencilDescriptor& stencilDesc, const StencilFaceDescriptor& face)
+{
+    return
+    (
+        !stencilDesc.testEnabled ||
+        (face.writeMask & 0xFF) == 0 ||
+        (face.stencilFailOp == StencilOp::Keep && face.depthFailOp == StencilOp::Keep)
+    );
+}
+
+static void GetBlendFactor(const BlendOp op, const float src[4], const float dst[4], const float constant[4], float (&outFactor)[4])
+{
+    switch (op)
+    {
+        case BlendOp::Zero:
+            outFactor[0] = outFactor[1] = outFactor[2] = outFactor[3] = 0.0f;
+            break;
+        case BlendOp::One:
+            outFactor[0] = outFactor[1] = outFactor[2] = outFactor[3] = 1.0f;
+            break;
+        case BlendOp::SrcColor:
+        case BlendOp::Src1Color:
+            for_range(i, 4) { outFactor[i] = src[i]; }
+            break;
+        case BlendOp::InvSrcColor:
+        case BlendOp::InvSrc1Color:
+            for_range(i, 4) { outFactor[i] = 1.0f - src[i]; }
+            break;
+        case BlendOp::SrcAlpha:
+        case BlendOp::Src1Alpha:
+            outFactor[0] = outFactor[1] = outFactor[2] = outFactor[3] = src[3];
+            break;
+        case BlendOp::InvSrcAlpha:
+        case BlendOp::InvSrc1Alpha:
+            outFactor[0] = outFactor[1] = outFactor[2] = outFactor[3] = 1.0f - src[3];
+            break;
+        case BlendOp::DstColor:
+            for_range(i, 4) { outFactor[i] = dst[i]; }
+            break;
+        case BlendOp::InvDstColor:
+            for_range(i, 4) { outFactor[i] = 1.0f - dst[i]; }
+            break;
+        case BlendOp::DstAlpha:
+            outFactor[0] = outFactor[1] = outFactor[2] = outFactor[3] = dst[3];
+            break;
+        case BlendOp::InvDstAlpha:
+            outFactor[0] = outFactor[1] = outFactor[2] = outFactor[3] = 1.0f - dst[3];
+            break;
+        case BlendOp::SrcAlphaSaturate:
+            outFactor[0] = outFactor[1] = outFactor[2] = std::min(src[3], 1.0f - dst[3]);
+            outFactor[3] = 1.0f;
+            break;
+        case BlendOp::BlendFactor:
+            for_range(i, 4) { outFactor[i] = constant[i]; }
+            break;
+        case BlendOp::InvBlendFactor:
+            for_range(i, 4) { outFactor[i] = 1.0f - constant[i]; }
+            break;
+    }
+}
+
+static float BlendComponent(const BlendArithmetic arithmetic, float src, float srcFactor, float dst, float dstFactor)
+{
+    switch (arithmetic)
+    {
+        case BlendArithmetic::Add:          return (src*srcFactor + dst*dstFactor);
+        case BlendArithmetic::Subtract:     return (src*srcFactor - dst*dstFactor);
+        case BlendArithmetic::RevSubtract:  return (dst*dstFactor - src*srcFactor);
+        case BlendArithmetic::Min:          return std::min(src, dst);
+        case BlendArithmetic::Max:          return std::max(src, dst);
+    }
+    return src;
+}
+
+static void BlendAndWriteColor(const BlendTargetDescriptor& target, const float constant[4], const float src[4], float* dst)
+{
+    float result[4];
+
+    if (target.blendEnabled)
+    {
+        float srcColorFactor[4], dstColorFactor[4], srcAlphaFactor[4], dstAlphaFactor[4];
+        GetBlendFactor(target.srcColor, src, dst, constant, srcColorFactor);
+        GetBlendFactor(target.dstColor, src, dst, constant, dstColorFactor);
+        GetBlendFactor(target.srcAlpha, src, dst, constant, srcAlphaFactor);
+        GetBlendFactor(target.dstAlpha, src, dst, constant, dstAlphaFactor);
+
+        for_range(i, 3)
+            result[i] = BlendComponent(target.colorArithmetic, src[i], srcColorFactor[i], dst[i], dstColorFactor[i]);
+        result[3] = BlendComponent(target.alphaArithmetic, src[3], srcAlphaFactor[3], dst[3], dstAlphaFactor[3]);
+    }
+    else
+    {
+        for_range(i, 4)
+            result[i] = src[i];
+    }
+
+    for_range(i, 4)
+    {
+        if ((target.colorMask & (1u << i)) != 0)
+            dst[i] = result[i];
+    }
+}
+
+// Returns the floor of the fixed-point value divided by the sub-pixel scale.
+// Returns the maximum offset of the edge function from the pixel center to any of the sample positions.
+static std::int64_t GetMaxSampleEdgeOffset(const std::int8_t (*samplePositions)[2], std::uint32_t numSamples, std::int64_t dx, std::int64_t dy)
+{
+    std::int64_t maxOffset = 0;
+    for_range(i, numSamples)
+        maxOffset = std::max(maxOffset, dx * samplePositions[i][1] - dy * samplePositions[i][0]);
+    return maxOffset;
+}
+
+static std::uint32_t CountSampleBits(std::uint32_t mask)
+{
+    std::uint32_t n = 0;
+    for (; mask != 0; mask &= mask - 1)
+        ++n;
+    return n;
+}
+
+static std::int32_t FixedFloor(std::int32_t x)
+{
+    return (x >= 0 ? x / g_subPixelScale : -((-x + g_subPixelScale - 1) / g_subPixelScale));
+}
+
+/* ----- Render passes ----- */
+
+constexpr std::int32_t NullRasterizer::tileSize;
+constexpr std::uint32_t NullRasterizer::invalidCostRecord;
+
+void NullRasterizer::BeginRenderPass(
+    std::uint32_t           numColorAttachments,
+    const NullAttachment*   colorAttachments,
+    const NullAttachment*   resolveAttachments,
+    const NullAttachment&   depthStencilAttachment,
+    const Extent2D&         resolution)
+{
+    Flush();
+
+    colorAttachments_       = SmallVector<NullAttachment>(colorAttachments, colorAttachments + numColorAttachments);
+    depthStencilAttachment_ = depthStencilAttachment;
+    resolution_             = resolution;
+
+    if (resolveAttachments != nullptr)
+        resolveAttachments_ = SmallVector<NullAttachment>(resolveAttachments, resolveAttachments + numColorAttachments);
+    else
+        resolveAttachments_ = SmallVector<NullAttachment>(numColorAttachments);
+
+    /* All attachments of a render pass have the same number of samples */
+    numSamples_ = 1;
+    for (const auto& attachment : colorAttachments_)
+    {
+        if (attachment.texture != nullptr)
+            numSamples_ = std::max(numSamples_, attachment.texture->GetNumSamples());
+    }
+    if (depthStencilAttachment_.texture != nullptr)
+        numSamples_ = std::max(numSamples_, depthStencilAttachment_.texture->GetNumSamples());
+
+    /* Ignore attachments with a mismatching number of samples, since their sample planes cannot be addressed */
+    for (auto& attachment : colorAttachments_)
+    {
+        if (attachment.texture != nullptr && attachment.texture->GetNumSamples() != numSamples_)
+            attachment.texture = nullptr;
+    }
+    if (depthStencilAttachment_.texture != nullptr && depthStencilAttachment_.texture->GetNumSamples() != numSamples_)
+        depthStencilAttachment_.texture = nullptr;
+
+    samplePositions_    = GetSamplePattern(numSamples_);
+    sampleSpread_[0]    = 0;
+    sampleSpread_[1]    = 0;
+
+    for_range(i, numSamples_)
+    {
+        sampleSpread_[0] = std::min<std::int32_t>({ sampleSpread_[0], samplePositions_[i][0], samplePositions_[i][1] });
+        sampleSpread_[1] = std::max<std::int32_t>({ sampleSpread_[1], samplePositions_[i][0], samplePositions_[i][1] });
+    }
+
+    /* Clamp render area to the extent of all attachments */
+    auto clampResolution = [this](const NullAttachment& attachment)
+    {
+        if (attachment.texture != nullptr)
+        {
+            const auto extent = attachment.texture->GetMipExtent(attachment.mipLevel);
+            resolution_.width  = std::min(resolution_.width,  extent.width);
+            resolution_.height = std::min(resolution_.height, extent.height);
+        }
+    };
+
+    for (const auto& attachment : colorAttachments_)
+        clampResolution(attachment);
+    clampResolution(depthStencilAttachment_);
+
+    /* Allocate one bin for each screen tile */
+    numTilesX_ = (static_cast<std::int32_t>(resolution_.width ) + tileSize - 1) / tileSize;
+    numTilesY_ = (static_cast<std::int32_t>(resolution_.height) + tileSize - 1) / tileSize;
+    tileBins_.resize(static_cast<std::size_t>(numTilesX_ * numTilesY_));
+    tileResolved_.assign(tileBins_.size(), 0);
+
+    /* Depth values are quantized when they are stored, so depth bounds of shaded tiles are widened by one quantization step */
+    if (HasDepthAttachment())
+    {
+        switch (depthStencilAttachment_.texture->GetFormat())
+        {
+            case Format::D16UNorm:          depthBoundsEpsilon_ = 1.0f / 65535.0f;      break;
+            case Format::D24UNormS8UInt:    depthBoundsEpsilon_ = 1.0f / 16777215.0f;   break;
+            default:                        depthBoundsEpsilon_ = 0.0f;                 break;
+        }
+    }
+
+    ResetTileDepthBounds();
+
+    drawStateDirty_ = true;
+}
+
+void NullRasterizer::EndRenderPass()
+{
+    Flush();
+    ResolveRemainingTiles();
+    colorAttachments_.clear();
+    resolveAttachments_.clear();
+    depthStencilAttachment_ = NullAttachment{};
+    numTilesX_ = 0;
+    numTilesY_ = 0;
+    tileDepthBounds_.clear();
+    tileResolved_.clear();
+}
+
+void NullRasterizer::Clear(long flags, const ClearValue& clearValue)
+{
+    Flush();
+
+    if ((flags & ClearFlags::Color) != 0)
+    {
+        for_range(i, colorAttachments_.size())
+            ClearColorAttachment(i, clearValue.color);
+
+        /* Resolve attachments are cleared together with their color attachments */
+        std::fill(tileResolved_.begin(), tileResolved_.end(), 1);
+    }
+
+    ClearDepthStencilAttachment(flags, clearValue.depth, clearValue.stencil);
+}
+
+void NullRasterizer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
+{
+    Flush();
+
+    for_range(i, numAttachments)
+    {
+        const auto& clear = attachments[i];
+        if ((clear.flags & ClearFlags::Color) != 0)
+        {
+            if (clear.colorAttachment < colorAttachments_.size())
+                ClearColorAttachment(clear.colorAttachment, clear.clearValue.color);
+        }
+        else
+            ClearDepthStencilAttachment(clear.flags, clear.clearValue.depth, clear.clearValue.stencil);
+    }
+}
+
+/* ----- States ----- */
+
+void NullRasterizer::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
+{
+    viewports_ = ArrayView<Viewport>{ viewports, numViewports };
+    drawStateDirty_ = true;
+}
+
+void NullRasterizer::SetScissors(std::uint32_t numScissors, const Scissor* scissors)
+{
+    scissors_ = ArrayView<Scissor>{ scissors, numScissors };
+    drawStateDirty_ = true;
+}
+
+void NullRasterizer::SetVertexBuffers(std::uint32_t numBuffers, const NullBuffer* const * buffers)
+{
+    vertexBuffers_ = ArrayView<const NullBuffer*>{ buffers, numBuffers };
+}
+
+void NullRasterizer::SetIndexBuffer(const NullBuffer* buffer, const Format format, std::uint64_t offset)
+{
+    indexBuffer_        = buffer;
+    indexFormat_        = format;
+    indexBufferOffset_  = offset;
+}
+
+void NullRasterizer::SetPipelineState(const NullPipelineState* pipelineState)
+{
+    if (pipelineState != nullptr && pipelineState->isGraphicsPSO)
+    {
+        pipelineState_ = pipelineState;
+        ResolveVertexLayout();
+        drawStateDirty_ = true;
+    }
+}
+
+void NullRasterizer::SetStencilReference(std::uint32_t reference, const StencilFace stencilFace)
+{
+    if (stencilFace != StencilFace::Back)
+        stencilReference_[0] = reference;
+    if (stencilFace != StencilFace::Front)
+        stencilReference_[1] = reference;
+    drawStateDirty_ = true;
+}
+
+void NullRasterizer::BeginStreamOutput(std::uint32_t numBuffers, NullBuffer* const * buffers)
+{
+    numStreamOutputTargets_ = std::min(numBuffers, LLGL_MAX_NUM_SO_BUFFERS);
+    for_range(i, numStreamOutputTargets_)
+    {
+        streamOutputTargets_[i].buffer      = buffers[i];
+        streamOutputTargets_[i].filledSize  = 0;
+    }
+}
+
+void NullRasterizer::EndStreamOutput()
+{
+    for_range(i, numStreamOutputTargets_)
+        streamOutputTargets_[i].buffer = nullptr;
+    numStreamOutputTargets_ = 0;
+}
+
+void NullRasterizer::SetCostRecord(std::uint32_t costRecord)
+{
+    costRecord_ = costRecord;
+}
+
+void NullRasterizer::ResetCostRecords()
+{
+    costRecord_ = invalidCostRecord;
+    costRecordFragments_.clear();
+}
+
+void NullRasterizer::ResetBindings()
+{
+    EndStreamOutput();
+
+    viewports_          = {};
+    scissors_           = {};
+    vertexBuffers_      = {};
+    indexBuffer_        = nullptr;
+    indexFormat_        = Format::R32UInt;
+    indexBufferOffset_  = 0;
+    pipelineState_      = nullptr;
+    positionAttrib_     = nullptr;
+    colorAttrib_        = nullptr;
+    drawStateDirty_     = true;
+
+    streamOutputAttribs_.clear();
+
+    stencilReference_[0] = 0;
+    stencilReference_[1] = 0;
+}
+
+/* ----- Drawing ----- */
+
+void NullRasterizer::Draw(const DrawIndirectArguments& args)
+{
+    const bool rasterize    = IsRasterizerEnabled();
+    const bool streamOutput = IsStreamOutputActive();
+
+    if ((!rasterize && !streamOutput) || args.numVertices == 0)
+        return;
+
+    if (rasterize)
+        UpdateDrawState();
+
+    statistics_.inputAssemblyVertices   += static_cast<std::uint64_t>(args.numVertices) * args.numInstances;
+    statistics_.vertexShaderInvocations += static_cast<std::uint64_t>(args.numVertices) * args.numInstances;
+
+    for_range(instance, args.numInstances)
+    {
+        FetchVertices(args.firstVertex, args.numVertices, instance, args.firstInstance);
+        if (streamOutput)
+            StreamOutputPrimitives(nullptr, args.numVertices, 0);
+        if (rasterize)
+            AssemblePrimitives(nullptr, args.numVertices, 0);
+    }
+}
+
+void NullRasterizer::DrawIndexed(const DrawIndexedIndirectArguments& args)
+{
+    const bool rasterize    = IsRasterizerEnabled();
+    const bool streamOutput = IsStreamOutputActive();
+
+    if ((!rasterize && !streamOutput) || indexBuffer_ == nullptr || args.numIndices == 0)
+        return;
+
+    /* Validate index buffer range */
+    const std::uint64_t indexSize   = (indexFormat_ == Format::R16UInt ? 2 : (indexFormat_ == Format::R8UInt ? 1 : 4));
+    const std::uint64_t offset      = indexBufferOffset_ + indexSize * args.firstIndex;
+    if (offset + indexSize * args.numIndices > indexBuffer_->desc.size)
+        return;
+
+    if (rasterize)
+        UpdateDrawState();
+
+    /* Read indices and determine the range of referenced vertices */
+    const char* src = indexBuffer_->GetBytesAt(offset);
+    std::int64_t minIndex = INT64_MAX, maxIndex = 0;
+
+    indices_.resize(args.numIndices);
+    for_range(i, args.numIndices)
+    {
+        std::int64_t index = 0;
+        switch (indexSize)
+        {
+            case 1: index = static_cast<std::uint8_t>(src[i]); break;
+            case 2: { std::uint16_t value; ::memcpy(&value, src + i*2, 2); index = value; } break;
+            case 4: { std::uint32_t value; ::memcpy(&value, src + i*4, 4); index = value; } break;
+        }
+        index = std::max<std::int64_t>(0, index + args.vertexOffset);
+        indices_[i] = static_cast<std::uint32_t>(index);
+        minIndex = std::min(minIndex, index);
+        maxIndex = std::max(maxIndex, index);
+    }
+
+    const auto baseIndex    = static_cast<std::uint32_t>(minIndex);
+    const auto numVertices  = static_cast<std::uint32_t>(maxIndex - minIndex + 1);
+
+    statistics_.inputAssemblyVertices   += static_cast<std::uint64_t>(args.numIndices) * args.numInstances;
+    statistics_.vertexShaderInvocations += static_cast<std::uint64_t>(numVertices) * args.numInstances;
+
+    for_range(instance, args.numInstances)
+    {
+        FetchVertices(baseIndex, numVertices, instance, args.firstInstance);
+        if (streamOutput)
+            StreamOutputPrimitives(indices_.data(), args.numIndices, baseIndex);
+        if (rasterize)
+            AssemblePrimitives(indices_.data(), args.numIndices, baseIndex);
+    }
+}
+
+void NullRasterizer::Flush()
+{
+    if (triangles_.empty())
+        return;
+
+    /* Shade tiles in parallel; each worker grabs the next tile until all tiles are shaded */
+    const std::uint32_t numTiles = static_cast<std::uint32_t>(tileBins_.size());
+    std::atomic<std::uint32_t> nextTile{ 0 };
+    std::atomic<std::uint64_t> numFragments{ 0 }, numSamplesPassed{ 0 };
+    std::mutex costRecordMutex;
+
+    const unsigned numWorkers = std::max(1u, std::min(std::thread::hardware_concurrency(), numTiles));
+
+    DoConcurrent(
+        [this, numTiles, &nextTile, &numFragments, &numSamplesPassed, &costRecordMutex](std::size_t /*worker*/)
+        {
+            TileBuffers buffers;
+            for (std::uint32_t tile = nextTile++; tile < numTiles; tile = nextTile++)
+            {
+                if (!tileBins_[tile].empty())
+                    ShadeTile(tile, buffers);
+            }
+            numFragments        += buffers.numFragments;
+            numSamplesPassed    += buffers.numSamplesPassed;
+
+            /* Merge fragment counters of cost records; workers only have counters if cost records are enabled */
+            if (!buffers.costRecordFragments.empty())
+            {
+                std::lock_guard<std::mutex> guard{ costRecordMutex };
+                if (costRecordFragments_.size() < buffers.costRecordFragments.size())
+                    costRecordFragments_.resize(buffers.costRecordFragments.size());
+                for_range(i, buffers.costRecordFragments.size())
+                {
+                    costRecordFragments_[i].rasterized  += buffers.costRecordFragments[i].rasterized;
+                    costRecordFragments_[i].shaded      += buffers.costRecordFragments[i].shaded;
+                }
+            }
+        },
+        numWorkers,
+        numWorkers,
+        1
+    );
+
+    statistics_.fragmentShaderInvocations   += numFragments.load();
+    samplesPassed_                          += numSamplesPassed.load();
+
+    /* Reset bins but keep their capacity for the next frame */
+    for (auto& bin : tileBins_)
+        bin.clear();
+
+    triangles_.clear();
+    drawStates_.clear();
+    drawStateDirty_ = true;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool NullRasterizer::IsRenderPassActive() const
+{
+    return (pipelineState_ != nullptr && numTilesX_ > 0 && numTilesY_ > 0);
+}
+
+bool NullRasterizer::IsRasterizerEnabled() const
+{
+    return (IsRenderPassActive() && !pipelineState_->graphicsDesc.rasterizer.discardEnabled);
+}
+
+bool NullRasterizer::IsStreamOutputActive() const
+{
+    return (pipelineState_ != nullptr && numStreamOutputTargets_ > 0 && !streamOutputAttribs_.empty());
+}
+
+void NullRasterizer::ResolveVertexLayout()
+{
+    positionAttrib_ = nullptr;
+    colorAttrib_    = nullptr;
+
+    auto vertexShader = pipelineState_->graphicsDesc.vertexShader;
+    if (vertexShader == nullptr)
+        return;
+
+    const auto& vertexShaderNull = LLGL_CAST(const NullShader&, *vertexShader);
+    const auto& inputAttribs = vertexShaderNull.desc.vertex.inputAttribs;
+
+    /* Find vertex attributes for position and color by system value or name */
+    for (const auto& attrib : inputAttribs)
+    {
+        if (positionAttrib_ == nullptr && (attrib.systemValue == SystemValue::Position || ContainsCaseInsensitive(attrib.name.c_str(), "pos")))
+            positionAttrib_ = &attrib;
+        else if (colorAttrib_ == nullptr && (ContainsCaseInsensitive(attrib.name.c_str(), "color") || ContainsCaseInsensitive(attrib.name.c_str(), "colour")))
+            colorAttrib_ = &attrib;
+    }
+
+    /* Fall back to first attribute for position */
+    if (positionAttrib_ == nullptr && !inputAttribs.empty() && &inputAttribs.front() != colorAttrib_)
+        positionAttrib_ = &inputAttribs.front();
+
+    ResolveStreamOutputLayout();
+}
+
+/*
+Null shaders are not executed, so each stream-output attribute captures the vertex input attribute with the same name and semantic index.
+Other attributes capture the clip-space position or color of the vertex stage if their names match, and zeros otherwise.
+*/
+void NullRasterizer::ResolveStreamOutputLayout()
+{
+    streamOutputAttribs_.clear();
+    for_range(i, LLGL_MAX_NUM_SO_BUFFERS)
+        streamOutputStrides_[i] = 0;
+
+    /* Output attributes are taken from the last vertex processing stage that declares them */
+    const auto& pipelineDesc = pipelineState_->graphicsDesc;
+    const std::vector<VertexAttribute>* outputAttribs = nullptr;
+
+    for (const Shader* shader : { pipelineDesc.geometryShader, pipelineDesc.vertexShader })
+    {
+        if (shader != nullptr)
+        {
+            const auto& shaderNull = LLGL_CAST(const NullShader&, *shader);
+            if (!shaderNull.desc.vertex.outputAttribs.empty())
+            {
+                outputAttribs = &(shaderNull.desc.vertex.outputAttribs);
+                break;
+            }
+        }
+    }
+
+    if (outputAttribs == nullptr || pipelineDesc.vertexShader == nullptr)
+        return;
+
+    const auto& inputAttribs = LLGL_CAST(const NullShader&, *pipelineDesc.vertexShader).desc.vertex.inputAttribs;
+
+    /* Attributes of each buffer are tightly packed in declaration order unless a larger stride is specified */
+    std::uint32_t packedStrides[LLGL_MAX_NUM_SO_BUFFERS] = {};
+
+    for (const auto& attrib : *outputAttribs)
+    {
+        const auto& formatAttribs = GetFormatAttribs(attrib.format);
+        if (attrib.slot >= LLGL_MAX_NUM_SO_BUFFERS ||
+            (formatAttribs.flags & (FormatFlags::IsCompressed | FormatFlags::IsPacked)) != 0 ||
+            formatAttribs.dataType == DataType::Undefined)
+        {
+            continue;
+        }
+
+        StreamOutputAttribute soAttrib;
+        {
+            soAttrib.outputAttrib   = &attrib;
+            soAttrib.inputAttrib    = nullptr;
+            soAttrib.source         = StreamOutputAttribute::Source::Zero;
+            soAttrib.offset         = packedStrides[attrib.slot];
+        }
+
+        for (const auto& inputAttrib : inputAttribs)
+        {
+            if (inputAttrib.name == attrib.name && inputAttrib.semanticIndex == attrib.semanticIndex)
+            {
+                soAttrib.inputAttrib    = &inputAttrib;
+                soAttrib.source         = StreamOutputAttribute::Source::Input;
+                break;
+            }
+        }
+
+        if (soAttrib.inputAttrib == nullptr)
+        {
+            if (attrib.systemValue == SystemValue::Position || ContainsCaseInsensitive(attrib.name.c_str(), "pos"))
+                soAttrib.source = StreamOutputAttribute::Source::Position;
+            else if (ContainsCaseInsensitive(attrib.name.c_str(), "color") || ContainsCaseInsensitive(attrib.name.c_str(), "colour"))
+                soAttrib.source = StreamOutputAttribute::Source::Color;
+        }
+
+        streamOutputAttribs_.push_back(soAttrib);
+
+        packedStrides[attrib.slot] += static_cast<std::uint32_t>(DataTypeSize(formatAttribs.dataType)) * formatAttribs.components;
+        streamOutputStrides_[attrib.slot] = std::max(streamOutputStrides_[attrib.slot], attrib.stride);
+    }
+
+    for_range(i, LLGL_MAX_NUM_SO_BUFFERS)
+        streamOutputStrides_[i] = std::max(streamOutputStrides_[i], packedStrides[i]);
+}
+
+void NullRasterizer::UpdateDrawState()
+{
+    if (!drawStateDirty_)
+        return;
+
+    const auto& pipelineDesc = pipelineState_->graphicsDesc;
+
+    /* Select first viewport either from dynamic or static state */
+    if (!viewports_.empty())
+        viewport_ = viewports_.front();
+    else if (!pipelineDesc.viewports.empty())
+        viewport_ = pipelineDesc.viewports.front();
+    else
+        viewport_ = Viewport{ resolution_ };
+
+    DrawState state;
+    {
+        state.pipelineState = pipelineState_;
+
+        /* Intersect render area with viewport and scissor rectangle */
+        std::int32_t rect[4] =
+        {
+            std::max(0, static_cast<std::int32_t>(std::floor(viewport_.x))),
+            std::max(0, static_cast<std::int32_t>(std::floor(viewport_.y))),
+            std::min(static_cast<std::int32_t>(resolution_.width ), static_cast<std::int32_t>(std::ceil(viewport_.x + viewport_.width ))),
+            std::min(static_cast<std::int32_t>(resolution_.height), static_cast<std::int32_t>(std::ceil(viewport_.y + viewport_.height))),
+        };
+
+        if (pipelineDesc.rasterizer.scissorTestEnabled)
+        {
+            const Scissor* scissor = nullptr;
+            if (!scissors_.empty())
+                scissor = &(scissors_.front());
+            else if (!pipelineDesc.scissors.empty())
+                scissor = &(pipelineDesc.scissors.front());
+
+            if (scissor != nullptr)
+            {
+                rect[0] = std::max(rect[0], scissor->x);
+                rect[1] = std::max(rect[1], scissor->y);
+                rect[2] = std::min(rect[2], scissor->x + scissor->width);
+                rect[3] = std::min(rect[3], scissor->y + scissor->height);
+            }
+        }
+
+        for_range(i, 4)
+            state.scissorRect[i] = rect[i];
+
+        /* Resolve stencil reference values either from dynamic or static state */
+        const auto& stencilDesc = pipelineDesc.stencil;
+        const StencilFaceDescriptor* faces[2] = { &(stencilDesc.front), &(stencilDesc.back) };
+
+        for_range(i, 2)
+        {
+            const std::uint32_t reference = (stencilDesc.referenceDynamic ? stencilReference_[i] : faces[i]->reference);
+            state.stencilReference[i]   = static_cast<std::uint8_t>(reference & 0xFF);
+            state.depthRejectable[i]    = (pipelineDesc.depth.testEnabled && IsStencilFaceSideEffectFree(stencilDesc, *faces[i]));
+        }
+    }
+    drawStates_.push_back(state);
+
+    drawStateDirty_ = false;
+}
+
+void NullRasterizer::FetchVertices(
+    std::uint32_t   firstVertex,
+    std::uint32_t   numVertices,
+    std::uint32_t   instance,
+    std::uint32_t   firstInstance)
+{
+    vertices_.resize(numVertices);
+
+    /* Capture the vertex outputs for stream output alongside the position and color */
+    const std::size_t numStreamOutputAttribs = (IsStreamOutputActive() ? streamOutputAttribs_.size() : 0);
+    streamOutputValues_.resize(numVertices * numStreamOutputAttribs * 4);
+
+    DoConcurrentRange(
+        [&](std::size_t begin, std::size_t end)
+        {
+            for_subrange(i, begin, end)
+            {
+                Vertex& vertex = vertices_[i];
+                const auto vertexIndex = static_cast<std::uint32_t>(firstVertex + i);
+
+                vertex.position[0] = 0.0f;
+                vertex.position[1] = 0.0f;
+                vertex.position[2] = 0.0f;
+                vertex.position[3] = 1.0f;
+
+                vertex.color[0] = 1.0f;
+                vertex.color[1] = 1.0f;
+                vertex.color[2] = 1.0f;
+                vertex.color[3] = 1.0f;
+
+                if (positionAttrib_ != nullptr)
+                {
+                    const auto index = GetAttributeIndex(*positionAttrib_, vertexIndex, instance, firstInstance);
+                    ReadVertexAttribute(*positionAttrib_, index, vertexBuffers_.size(), vertexBuffers_.data(), vertex.position);
+                }
+                if (colorAttrib_ != nullptr)
+                {
+                    const auto index = GetAttributeIndex(*colorAttrib_, vertexIndex, instance, firstInstance);
+                    ReadVertexAttribute(*colorAttrib_, index, vertexBuffers_.size(), vertexBuffers_.data(), vertex.color);
+                }
+
+                for_range(j, numStreamOutputAttribs)
+                {
+                    const StreamOutputAttribute& soAttrib = streamOutputAttribs_[j];
+                    float (&value)[4] = *reinterpret_cast<float(*)[4]>(&(streamOutputValues_[(i * numStreamOutputAttribs + j) * 4]));
+
+                    switch (soAttrib.source)
+                    {
+                        case StreamOutputAttribute::Source::Position:
+                            ::memcpy(value, vertex.position, sizeof(value));
+                            break;
+                        case StreamOutputAttribute::Source::Color:
+                            ::memcpy(value, vertex.color, sizeof(value));
+                            break;
+                        case StreamOutputAttribute::Source::Input:
+                        {
+                            value[0] = 0.0f;
+                            value[1] = 0.0f;
+                            value[2] = 0.0f;
+                            value[3] = 1.0f;
+                            const auto index = GetAttributeIndex(*soAttrib.inputAttrib, vertexIndex, instance, firstInstance);
+                            ReadVertexAttribute(*soAttrib.inputAttrib, index, vertexBuffers_.size(), vertexBuffers_.data(), value);
+                        }
+                        break;
+                        default:
+                            std::fill(value, value + 4, 0.0f);
+                            break;
+                    }
+                }
+            }
+        },
+        numVertices,
+        Constants::maxThreadCount,
+        g_minVerticesPerThread
+    );
+}
+
+void NullRasterizer::AssemblePrimitives(const std::uint32_t* indices, std::uint32_t numIndices, std::uint32_t baseIndex)
+{
+    auto GetVertex = [this, indices, baseIndex](std::uint32_t i) -> const Vertex&
+    {
+        return vertices_[indices != nullptr ? indices[i] - baseIndex : i];
+    };
+
+    switch (pipelineState_->graphicsDesc.primitiveTopology)
+    {
+        case PrimitiveTopology::TriangleList:
+        {
+            statistics_.inputAssemblyPrimitives += numIndices / 3;
+            for (std::uint32_t i = 0; i + 2 < numIndices; i += 3)
+                ClipAndSetupTriangle(GetVertex(i), GetVertex(i + 1), GetVertex(i + 2));
+        }
+        break;
+
+        case PrimitiveTopology::TriangleStrip:
+        {
+            statistics_.inputAssemblyPrimitives += (numIndices > 2 ? numIndices - 2 : 0);
+            /* Swap every other triangle to keep a consistent winding order */
+            for (std::uint32_t i = 0; i + 2 < numIndices; ++i)
+            {
+                if (i % 2 == 0)
+                    ClipAndSetupTriangle(GetVertex(i), GetVertex(i + 1), GetVertex(i + 2));
+                else
+                    ClipAndSetupTriangle(GetVertex(i + 1), GetVertex(i), GetVertex(i + 2));
+            }
+        }
+        break;
+
+        default:
+        {
+            /* Point and line primitives are not supported by the software rasterizer */
+        }
+        break;
+    }
+
+    if (triangles_.size() >= g_maxBinnedTriangles)
+    {
+        Flush();
+        UpdateDrawState();
+    }
+}
+
+void NullRasterizer::StreamOutputPrimitives(const std::uint32_t* indices, std::uint32_t numIndices, std::uint32_t baseIndex)
+{
+    /* Strips are written as lists; every other triangle of a strip is swapped to keep a consistent winding order */
+    std::uint32_t numPrimitiveVertices = 0, numPrimitives = 0;
+    bool isStrip = false;
+
+    switch (pipelineState_->graphicsDesc.primitiveTopology)
+    {
+        case PrimitiveTopology::PointList:
+            numPrimitiveVertices    = 1;
+            numPrimitives           = numIndices;
+            break;
+        case PrimitiveTopology::LineList:
+            numPrimitiveVertices    = 2;
+            numPrimitives           = numIndices / 2;
+            break;
+        case PrimitiveTopology::LineStrip:
+            numPrimitiveVertices    = 2;
+            numPrimitives           = (numIndices > 1 ? numIndices - 1 : 0);
+            isStrip                 = true;
+            break;
+        case PrimitiveTopology::TriangleList:
+            numPrimitiveVertices    = 3;
+            numPrimitives           = numIndices / 3;
+            break;
+        case PrimitiveTopology::TriangleStrip:
+            numPrimitiveVertices    = 3;
+            numPrimitives           = (numIndices > 2 ? numIndices - 2 : 0);
+            isStrip                 = true;
+            break;
+        default:
+            /* Primitives with adjacency and patches are consumed by later shader stages, which are not executed */
+            return;
+    }
+
+    streamOutputPrimitivesNeeded_ += numPrimitives;
+
+    /* Only write as many primitives as fit into all bound buffers */
+    std::uint64_t numWritten = numPrimitives;
+    std::uint64_t baseOffsets[LLGL_MAX_NUM_SO_BUFFERS] = {};
+
+    for_range(i, numStreamOutputTargets_)
+    {
+        const StreamOutputTarget& target = streamOutputTargets_[i];
+        if (target.buffer == nullptr || streamOutputStrides_[i] == 0)
+            continue;
+
+        const std::uint64_t bufferSize      = target.buffer->desc.size;
+        const std::uint64_t filledSize      = target.filledSize.load();
+        const std::uint64_t primitiveSize   = static_cast<std::uint64_t>(streamOutputStrides_[i]) * numPrimitiveVertices;
+
+        baseOffsets[i]  = filledSize;
+        numWritten      = std::min(numWritten, (filledSize < bufferSize ? (bufferSize - filledSize) / primitiveSize : 0));
+    }
+
+    if (numWritten == 0)
+        return;
+
+    streamOutputPrimitivesWritten_ += numWritten;
+
+    auto GetVertexIndex = [indices, baseIndex, numPrimitiveVertices, isStrip](std::size_t primitive, std::uint32_t vertex) -> std::size_t
+    {
+        std::size_t i = primitive * numPrimitiveVertices + vertex;
+        if (isStrip)
+            i = primitive + (numPrimitiveVertices == 3 && primitive % 2 == 1 && vertex < 2 ? 1 - vertex : vertex);
+        return (indices != nullptr ? indices[i] - baseIndex : i);
+    };
+
+    /*
+    Write primitives in parallel and append them to the buffers by advancing the atomic counters with the size each worker has written.
+    Each primitive is written at an offset derived from its index, so the primitive order is the same as with serial processing.
+    */
+    const std::size_t numStreamOutputAttribs = streamOutputAttribs_.size();
+
+    DoConcurrentRange(
+        [&](std::size_t begin, std::size_t end)
+        {
+            for_subrange(primitive, begin, end)
+            {
+                for_range(vertex, numPrimitiveVertices)
+                {
+                    const std::size_t   vertexIndex = GetVertexIndex(primitive, vertex);
+                    const float*        values      = &(streamOutputValues_[vertexIndex * numStreamOutputAttribs * 4]);
+                    const std::uint64_t outputIndex = static_cast<std::uint64_t>(primitive) * numPrimitiveVertices + vertex;
+
+                    for_range(j, numStreamOutputAttribs)
+                    {
+                        const StreamOutputAttribute&    soAttrib    = streamOutputAttribs_[j];
+                        const std::uint32_t             slot        = soAttrib.outputAttrib->slot;
+                        NullBuffer*                     buffer      = (slot < numStreamOutputTargets_ ? streamOutputTargets_[slot].buffer : nullptr);
+
+                        if (buffer != nullptr)
+                        {
+                            const std::uint64_t offset = baseOffsets[slot] + outputIndex * streamOutputStrides_[slot] + soAttrib.offset;
+                            WriteVertexAttribute(*soAttrib.outputAttrib, values + j * 4, buffer->GetBytesAt(offset));
+                        }
+                    }
+                }
+            }
+
+            for_range(i, numStreamOutputTargets_)
+            {
+                if (streamOutputTargets_[i].buffer != nullptr)
+                    streamOutputTargets_[i].filledSize += static_cast<std::uint64_t>(end - begin) * numPrimitiveVertices * streamOutputStrides_[i];
+            }
+        },
+        static_cast<std::size_t>(numWritten),
+        Constants::maxThreadCount,
+        g_minPrimitivesPerThread
+    );
+}
+
+// Returns the signed distance of the clip-space position to the specified frustum plane (ZeroToOne clipping range).
+static float GetClipDistance(const float (&position)[4], int plane)
+{
+    switch (plane)
+    {
+        case 0:  return position[3] + position[0];
+        case 1:  return position[3] - position[0];
+        case 2:  return position[3] + position[1];
+        case 3:  return position[3] - position[1];
+        case 4:  return position[2];
+        default: return position[3] - position[2];
+    }
+}
+
+void NullRasterizer::ClipAndSetupTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2)
+{
+    ++statistics_.clippingInvocations;
+
+    /* Determine clip codes */
+    unsigned outCodes[3] = { 0, 0, 0 };
+    const Vertex* triangle[3] = { &v0, &v1, &v2 };
+
+    for_range(i, 3)
+    {
+        for_range(plane, 6)
+        {
+            if (GetClipDistance(triangle[i]->position, plane) < 0.0f)
+                outCodes[i] |= (1u << plane);
+        }
+    }
+
+    /* Reject triangle if all vertices are outside of the same plane */
+    if ((outCodes[0] & outCodes[1] & outCodes[2]) != 0)
+        return;
+
+    /* Setup triangle directly if it's entirely inside the view frustum */
+    if ((outCodes[0] | outCodes[1] | outCodes[2]) == 0)
+    {
+        SetupTriangle(v0, v1, v2);
+        return;
+    }
+
+    /* Clip polygon against each frustum plane */
+    Vertex polygons[2][9];
+    int numVertices = 3;
+    polygons[0][0] = v0;
+    polygons[0][1] = v1;
+    polygons[0][2] = v2;
+
+    int current = 0;
+    for_range(plane, 6)
+    {
+        if (((outCodes[0] | outCodes[1] | outCodes[2]) & (1u << plane)) == 0)
+            continue;
+
+        const Vertex*   input       = polygons[current];
+        Vertex*         output      = polygons[1 - current];
+        int             numOutput   = 0;
+
+        for_range(i, numVertices)
+        {
+            const Vertex&   a   = input[i];
+            const Vertex&   b   = input[(i + 1) % numVertices];
+            const float     da  = GetClipDistance(a.position, plane);
+            const float     db  = GetClipDistance(b.position, plane);
+
+            if (da >= 0.0f)
+                output[numOutput++] = a;
+
+            if ((da >= 0.0f) != (db >= 0.0f))
+            {
+                /* Interpolate intersection with clipping plane */
+                const float t = da / (da - db);
+                Vertex& v = output[numOutput++];
+                for_range(c, 4)
+                {
+                    v.position[c]   = a.position[c] + (b.position[c] - a.position[c]) * t;
+                    v.color[c]      = a.color[c]    + (b.color[c]    - a.color[c]   ) * t;
+                }
+            }
+        }
+
+        numVertices = numOutput;
+        current = 1 - current;
+
+        if (numVertices < 3)
+            return;
+    }
+
+    /* Triangulate clipped polygon as triangle fan */
+    for_subrange(i, 1, numVertices - 1)
+        SetupTriangle(polygons[current][0], polygons[current][i], polygons[current][i + 1]);
+}
+
+void NullRasterizer::SetupTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2)
+{
+    const auto&     pipelineDesc    = pipelineState_->graphicsDesc;
+    const Vertex*   vertices[3]     = { &v0, &v1, &v2 };
+
+    ++statistics_.clippingPrimitives;
+
+    Triangle triangle;
+    triangle.drawState  = static_cast<std::uint32_t>(drawStates_.size() - 1);
+    triangle.costRecord = costRecord_;
+
+    /* Transform vertices into window space */
+    for_range(i, 3)
+    {
+        const auto& position = vertices[i]->position;
+        if (!(position[3] > 0.0f))
+            return;
+
+        const float invW = 1.0f / position[3];
+        const float x = viewport_.x + (position[0] * invW * 0.5f + 0.5f) * viewport_.width;
+        const float y = viewport_.y + (0.5f - position[1] * invW * 0.5f) * viewport_.height;
+
+        triangle.x[i]       = static_cast<std::int32_t>(std::floor(x * g_subPixelScale + 0.5f));
+        triangle.y[i]       = static_cast<std::int32_t>(std::floor(y * g_subPixelScale + 0.5f));
+        triangle.z[i]       = viewport_.minDepth + position[2] * invW * (viewport_.maxDepth - viewport_.minDepth);
+        triangle.invW[i]    = invW;
+
+        for_range(c, 4)
+            triangle.colorOverW[i][c] = vertices[i]->color[c] * invW;
+    }
+
+    /* Determine facing; The window-space Y-axis points downwards, so a negative area means counter-clockwise */
+    std::int64_t area =
+    (
+        static_cast<std::int64_t>(triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) -
+        static_cast<std::int64_t>(triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0])
+    );
+
+    if (area == 0)
+        return;
+
+    const bool isFrontFacing = ((area < 0) == pipelineDesc.rasterizer.frontCCW);
+    if ((pipelineDesc.rasterizer.cullMode == CullMode::Back && !isFrontFacing) ||
+        (pipelineDesc.rasterizer.cullMode == CullMode::Front && isFrontFacing))
+    {
+        return;
+    }
+
+    /* Ensure clockwise order so all edge functions are positive inside the triangle */
+    if (area < 0)
+    {
+        std::swap(triangle.x[1], triangle.x[2]);
+        std::swap(triangle.y[1], triangle.y[2]);
+        std::swap(triangle.z[1], triangle.z[2]);
+        std::swap(triangle.invW[1], triangle.invW[2]);
+        std::swap(triangle.colorOverW[1], triangle.colorOverW[2]);
+        area = -area;
+    }
+
+    triangle.invArea        = 1.0f / static_cast<float>(area);
+    triangle.zBounds[0]     = std::min({ triangle.z[0], triangle.z[1], triangle.z[2] });
+    triangle.zBounds[1]     = std::max({ triangle.z[0], triangle.z[1], triangle.z[2] });
+    triangle.frontFacing    = isFrontFacing;
+
+    /* Apply top-left fill rule: pixels on edges that are neither top nor left edges are excluded */
+    for_range(i, 3)
+    {
+        const int           j       = (i + 1) % 3;
+        const int           k       = (i + 2) % 3;
+        const std::int32_t  dx      = triangle.x[k] - triangle.x[j];
+        const std::int32_t  dy      = triangle.y[k] - triangle.y[j];
+        const bool          topLeft = (dy < 0 || (dy == 0 && dx > 0));
+        triangle.bias[i] = (topLeft ? 0 : -1);
+    }
+
+    /* Determine pixel bounds with sample points around pixel centers */
+    const auto& scissorRect = drawStates_.back().scissorRect;
+    const std::int32_t halfPixel = g_subPixelScale / 2;
+    const std::int32_t minSpread = sampleSpread_[0];
+    const std::int32_t maxSpread = sampleSpread_[1];
+
+    triangle.bounds[0] = std::max(scissorRect[0],     FixedFloor(std::min({ triangle.x[0], triangle.x[1], triangle.x[2] }) - halfPixel - maxSpread + g_subPixelScale - 1));
+    triangle.bounds[1] = std::max(scissorRect[1],     FixedFloor(std::min({ triangle.y[0], triangle.y[1], triangle.y[2] }) - halfPixel - maxSpread + g_subPixelScale - 1));
+    triangle.bounds[2] = std::min(scissorRect[2] - 1, FixedFloor(std::max({ triangle.x[0], triangle.x[1], triangle.x[2] }) - halfPixel - minSpread));
+    triangle.bounds[3] = std::min(scissorRect[3] - 1, FixedFloor(std::max({ triangle.y[0], triangle.y[1], triangle.y[2] }) - halfPixel - minSpread));
+
+    if (triangle.bounds[0] > triangle.bounds[2] || triangle.bounds[1] > triangle.bounds[3])
+        return;
+
+    triangles_.push_back(triangle);
+    BinTriangle(static_cast<std::uint32_t>(triangles_.size() - 1));
+}
+
+void NullRasterizer::BinTriangle(std::uint32_t triangleIndex)
+{
+    const Triangle&     triangle    = triangles_[triangleIndex];
+    const DrawState&    drawState   = drawStates_[triangle.drawState];
+    const auto&         depthDesc   = drawState.pipelineState->graphicsDesc.depth;
+
+    const bool depthTest    = (HasDepthAttachment() && depthDesc.testEnabled);
+    const bool depthReject  = (depthTest && drawState.depthRejectable[triangle.frontFacing ? 0 : 1]);
+    const bool depthWrite   = (depthTest && depthDesc.writeEnabled);
+
+    const std::int32_t tileMinX = triangle.bounds[0] / tileSize;
+    const std::int32_t tileMinY = triangle.bounds[1] / tileSize;
+    const std::int32_t tileMaxX = triangle.bounds[2] / tileSize;
+    const std::int32_t tileMaxY = triangle.bounds[3] / tileSize;
+
+    const bool testTileEdges = (tileMinX != tileMaxX || tileMinY != tileMaxY);
+
+    for_subrange(tileY, tileMinY, tileMaxY + 1)
+    {
+        for_subrange(tileX, tileMinX, tileMaxX + 1)
+        {
+            if (testTileEdges)
+            {
+                /* Reject tile if it is entirely outside of any edge; Test the tile corner with the largest edge function value */
+                bool outside = false;
+                for_range(i, 3)
+                {
+                    const int           j   = (i + 1) % 3;
+                    const int           k   = (i + 2) % 3;
+                    const std::int64_t  dx  = triangle.x[k] - triangle.x[j];
+                    const std::int64_t  dy  = triangle.y[k] - triangle.y[j];
+                    const std::int64_t  px  = static_cast<std::int64_t>(dy < 0 ? (tileX + 1) * tileSize - 1 : tileX * tileSize) * g_subPixelScale + g_subPixelScale/2;
+                    const std::int64_t  py  = static_cast<std::int64_t>(dx > 0 ? (tileY + 1) * tileSize - 1 : tileY * tileSize) * g_subPixelScale + g_subPixelScale/2;
+                    const std::int64_t  ofs = GetMaxSampleEdgeOffset(samplePositions_, numSamples_, dx, dy);
+                    if (dx * (py - triangle.y[j]) - dy * (px - triangle.x[j]) + triangle.bias[i] + ofs < 0)
+                    {
+                        outside = true;
+                        break;
+                    }
+                }
+                if (outside)
+                    continue;
+            }
+
+            const std::int32_t tileIndex = tileY * numTilesX_ + tileX;
+
+            DepthBounds& bounds = tileDepthBounds_[tileIndex];
+            if (bounds.valid)
+            {
+                /* Reject tile if none of the triangle's fragments can pass the depth test against any depth value of this tile */
+                if (depthReject && IsDepthRangeRejected(depthDesc.compareOp, triangle.zBounds[0], triangle.zBounds[1], bounds.minDepth, bounds.maxDepth))
+                    continue;
+
+                /* Widen depth bounds by the depth range this triangle may write, so subsequent triangles of this batch are rejected conservatively */
+                if (depthWrite)
+                {
+                    bounds.minDepth = std::min(bounds.minDepth, triangle.zBounds[0]);
+                    bounds.maxDepth = std::max(bounds.maxDepth, triangle.zBounds[1]);
+                }
+            }
+
+            tileBins_[tileIndex].push_back(triangleIndex);
+        }
+    }
+}
+
+bool NullRasterizer::HasDepthAttachment() const
+{
+    return (depthStencilAttachment_.texture != nullptr && IsDepthFormat(depthStencilAttachment_.texture->GetFormat()));
+}
+
+bool NullRasterizer::HasStencilAttachment() const
+{
+    return (depthStencilAttachment_.texture != nullptr && IsStencilFormat(depthStencilAttachment_.texture->GetFormat()));
+}
+
+bool NullRasterizer::HasResolveAttachments() const
+{
+    for (const auto& attachment : resolveAttachments_)
+    {
+        if (attachment.texture != nullptr)
+            return true;
+    }
+    return false;
+}
+
+bool NullRasterizer::IsColorAttachmentSupported(std::size_t index) const
+{
+    const NullTexture* texture = colorAttachments_[index].texture;
+    return (texture != nullptr && IsColorTileFormatSupported(texture->GetFormat()));
+}
+
+// Returns the attachment that refers to the storage layer of the specified sample plane.
+NullAttachment NullRasterizer::GetSampleAttachment(const NullAttachment& attachment, std::uint32_t sample) const
+{
+    NullAttachment sampleAttachment = attachment;
+    if (attachment.texture != nullptr)
+        sampleAttachment.arrayLayer = attachment.texture->GetSampleLayer(attachment.arrayLayer, sample);
+    return sampleAttachment;
+}
+
+NullTileRect NullRasterizer::GetTileRect(std::uint32_t tileIndex) const
+{
+    const std::int32_t tileX = static_cast<std::int32_t>(tileIndex) % numTilesX_;
+    const std::int32_t tileY = static_cast<std::int32_t>(tileIndex) / numTilesX_;
+
+    NullTileRect rect;
+    {
+        rect.x      = tileX * tileSize;
+        rect.y      = tileY * tileSize;
+        rect.width  = std::min(tileSize, static_cast<std::int32_t>(resolution_.width ) - rect.x);
+        rect.height = std::min(tileSize, static_cast<std::int32_t>(resolution_.height) - rect.y);
+    }
+    return rect;
+}
+
+void NullRasterizer::ClearColorAttachment(std::size_t index, const float (&color)[4])
+{
+    if (!IsColorAttachmentSupported(index))
+        return;
+
+    const NullAttachment& attachment = colorAttachments_[index];
+    NullTexture* texture = attachment.texture;
+
+    char texel[NullTexture::maxClearTexelSize] = {};
+    float values[4];
+    EncodeColorClearTexel(texture->GetFormat(), color, texel, values);
+
+    for_range(sample, numSamples_)
+        texture->FastClear(attachment.mipLevel, texture->GetSampleLayer(attachment.arrayLayer, sample), texel, values);
+
+    /* Clear resolve attachment as well, since the resolved color of a cleared tile is the clear color */
+    if (index < resolveAttachments_.size())
+    {
+        const NullAttachment& resolveAttachment = resolveAttachments_[index];
+        if (NullTexture* resolveTexture = resolveAttachment.texture)
+        {
+            if (IsColorTileFormatSupported(resolveTexture->GetFormat()))
+            {
+                EncodeColorClearTexel(resolveTexture->GetFormat(), color, texel, values);
+                resolveTexture->FastClear(resolveAttachment.mipLevel, resolveAttachment.arrayLayer, texel, values);
+            }
+        }
+    }
+}
+
+void NullRasterizer::ClearDepthStencilAttachment(long flags, float depth, std::uint32_t stencil)
+{
+    NullTexture* texture = depthStencilAttachment_.texture;
+    if (texture == nullptr)
+        return;
+
+    const auto& formatAttribs   = GetFormatAttribs(texture->GetFormat());
+    const bool  hasDepth        = ((formatAttribs.flags & FormatFlags::HasDepth) != 0);
+    const bool  hasStencil      = ((formatAttribs.flags & FormatFlags::HasStencil) != 0);
+    const bool  clearDepth      = (hasDepth && (flags & ClearFlags::Depth) != 0);
+    const bool  clearStencil    = (hasStencil && (flags & ClearFlags::Stencil) != 0);
+
+    if (!clearDepth && !clearStencil)
+        return;
+
+    const std::uint32_t mipLevel        = depthStencilAttachment_.mipLevel;
+    const std::uint32_t arrayLayer      = depthStencilAttachment_.arrayLayer;
+    const std::uint8_t  stencilValue    = static_cast<std::uint8_t>(stencil & 0xFF);
+
+    if (clearDepth == hasDepth && clearStencil == hasStencil)
+    {
+        /* All components are cleared, so the attachment can be fast cleared */
+        char texel[NullTexture::maxClearTexelSize] = {};
+        float values[4] = {};
+        std::uint8_t encodedStencil = 0;
+        EncodeDepthStencilClearTexel(texture->GetFormat(), depth, stencilValue, texel, values[0], encodedStencil);
+        values[1] = static_cast<float>(encodedStencil);
+
+        for_range(sample, numSamples_)
+            texture->FastClear(mipLevel, texture->GetSampleLayer(arrayLayer, sample), texel, values);
+
+        ResetTileDepthBounds();
+    }
+    else
+    {
+        /* Only one component of a combined depth-stencil format is cleared, so the other component must be preserved texel by texel */
+        texture->ResolveClears(mipLevel);
+
+        const Extent3D extent = texture->GetMipExtent(mipLevel);
+        const std::size_t numPixels = static_cast<std::size_t>(tileSize) * tileSize;
+
+        std::vector<float>          depths(numPixels);
+        std::vector<std::uint8_t>   stencils(numPixels);
+
+        /* Clear attachment tile by tile, since tile rectangles must not cross the storage tiles of the attachment */
+        for_range(sample, numSamples_)
+        {
+            const NullAttachment sampleAttachment = GetSampleAttachment(depthStencilAttachment_, sample);
+
+            for (std::int32_t y = 0; y < static_cast<std::int32_t>(extent.height); y += tileSize)
+            {
+                for (std::int32_t x = 0; x < static_cast<std::int32_t>(extent.width); x += tileSize)
+                {
+                    const NullTileRect rect
+                    {
+                        x,
+                        y,
+                        std::min(tileSize, static_cast<std::int32_t>(extent.width) - x),
+                        std::min(tileSize, static_cast<std::int32_t>(extent.height) - y)
+                    };
+
+                    LoadDepthStencilTile(sampleAttachment, rect, depths.data(), stencils.data());
+
+                    if (clearDepth)
+                        std::fill(depths.begin(), depths.end(), depth);
+                    if (clearStencil)
+                        std::fill(stencils.begin(), stencils.end(), stencilValue);
+
+                    StoreDepthStencilTile(sampleAttachment, rect, depths.data(), stencils.data());
+                }
+            }
+        }
+
+        if (clearDepth)
+        {
+            const float clampedDepth = std::max(0.0f, std::min(depth, 1.0f));
+            for (auto& bounds : tileDepthBounds_)
+            {
+                bounds.minDepth = clampedDepth - depthBoundsEpsilon_;
+                bounds.maxDepth = clampedDepth + depthBoundsEpsilon_;
+                bounds.valid    = true;
+            }
+        }
+    }
+}
+
+void NullRasterizer::ResetTileDepthBounds()
+{
+    tileDepthBounds_.assign(tileBins_.size(), DepthBounds{});
+
+    if (!HasDepthAttachment())
+        return;
+
+    /* Tiles with a pending fast clear in all sample planes have a known depth range */
+    NullTexture* texture = depthStencilAttachment_.texture;
+
+    for_range(tileY, numTilesY_)
+    {
+        for_range(tileX, numTilesX_)
+        {
+            DepthBounds bounds;
+            bounds.valid = true;
+
+            for_range(sample, numSamples_)
+            {
+                const std::uint32_t sampleLayer = texture->GetSampleLayer(depthStencilAttachment_.arrayLayer, sample);
+                if (const float* clearValues = texture->GetTileClearValues(depthStencilAttachment_.mipLevel, sampleLayer, tileX, tileY))
+                {
+                    bounds.minDepth = (sample == 0 ? clearValues[0] : std::min(bounds.minDepth, clearValues[0]));
+                    bounds.maxDepth = (sample == 0 ? clearValues[0] : std::max(bounds.maxDepth, clearValues[0]));
+                }
+                else
+                {
+                    bounds.valid = false;
+                    break;
+                }
+            }
+
+            if (bounds.valid)
+                tileDepthBounds_[tileY * numTilesX_ + tileX] = bounds;
+        }
+    }
+}
+
+void NullRasterizer::InitBlockDepthBounds(const NullTileRect& rect, TileBuffers& buffers)
+{
+    buffers.numBlocksX = (rect.width + depthBlockSize - 1) / depthBlockSize;
+
+    const std::int32_t  numBlocksY  = (rect.height + depthBlockSize - 1) / depthBlockSize;
+    const std::size_t   numBlocks   = static_cast<std::size_t>(buffers.numBlocksX * numBlocksY);
+
+    buffers.blockMinDepths.resize(numBlocks);
+    buffers.blockMaxDepths.resize(numBlocks);
+
+    for_range(blockY, numBlocksY)
+    {
+        for_range(blockX, buffers.numBlocksX)
+            UpdateBlockDepthBounds(rect, blockX, blockY, buffers);
+    }
+
+    UpdateTileDepthBounds(buffers);
+}
+
+void NullRasterizer::StoreTileDepthBounds(std::uint32_t tileIndex, const TileBuffers& buffers)
+{
+    /* Depth values are clamped and quantized when they are stored into the attachment */
+    const DepthBounds& src = buffers.tileDepthBounds;
+    DepthBounds& dst = tileDepthBounds_[tileIndex];
+    dst.minDepth    = std::max(0.0f, std::min(src.minDepth, 1.0f)) - depthBoundsEpsilon_;
+    dst.maxDepth    = std::max(0.0f, std::min(src.maxDepth, 1.0f)) + depthBoundsEpsilon_;
+    dst.valid       = true;
+}
+
+void NullRasterizer::UpdateBlockDepthBounds(const NullTileRect& rect, std::int32_t blockX, std::int32_t blockY, TileBuffers& buffers)
+{
+    const std::int32_t  x0          = blockX * depthBlockSize;
+    const std::int32_t  y0          = blockY * depthBlockSize;
+    const std::int32_t  x1          = std::min(x0 + depthBlockSize, rect.width);
+    const std::int32_t  y1          = std::min(y0 + depthBlockSize, rect.height);
+    const std::size_t   numPixels   = static_cast<std::size_t>(rect.width * rect.height);
+    float               minDepth    = buffers.depths[y0 * rect.width + x0];
+    float               maxDepth    = minDepth;
+
+    /* Scan the block in all sample planes */
+    for (std::size_t plane = 0; plane < buffers.depths.size(); plane += numPixels)
+    {
+        for_subrange(y, y0, y1)
+        {
+            const float* row = &(buffers.depths[plane + y * rect.width]);
+            for_subrange(x, x0, x1)
+            {
+                minDepth = std::min(minDepth, row[x]);
+                maxDepth = std::max(maxDepth, row[x]);
+            }
+        }
+    }
+
+    const std::size_t block = static_cast<std::size_t>(blockY * buffers.numBlocksX + blockX);
+    buffers.blockMinDepths[block] = minDepth;
+    buffers.blockMaxDepths[block] = maxDepth;
+}
+
+void NullRasterizer::UpdateTileDepthBounds(TileBuffers& buffers)
+{
+    buffers.tileDepthBounds.minDepth    = *std::min_element(buffers.blockMinDepths.begin(), buffers.blockMinDepths.end());
+    buffers.tileDepthBounds.maxDepth    = *std::max_element(buffers.blockMaxDepths.begin(), buffers.blockMaxDepths.end());
+    buffers.tileDepthBounds.valid       = true;
+}
+
+static_assert(NullTexture::tileSize == static_cast<std::uint32_t>(NullRasterizer::tileSize), "storage and fast-clear tiles of Null textures must match rasterizer tiles");
+
+// Returns the pending clear value of the attachment tile, or null if the tile must be loaded from the attachment.
+const float* NullRasterizer::AcquireTileClearValues(const NullAttachment& attachment, const NullTileRect& rect, std::int32_t tileX, std::int32_t tileY)
+{
+    NullTexture*    texture     = attachment.texture;
+    const auto      mipLevel    = attachment.mipLevel;
+    const auto      arrayLayer  = attachment.arrayLayer;
+    const float*    clearValues = texture->GetTileClearValues(mipLevel, arrayLayer, tileX, tileY);
+
+    if (clearValues != nullptr)
+    {
+        /*
+        The entire tile buffer is stored back into the attachment, so the pending clear can be dropped if the tile buffer covers the entire texture tile.
+        Otherwise, the render area ends inside the texture tile and the texels outside of the render area must be resolved.
+        */
+        const Extent3D      extent      = texture->GetMipExtent(mipLevel);
+        const std::int32_t  tileWidth   = std::min(tileSize, static_cast<std::int32_t>(extent.width ) - rect.x);
+        const std::int32_t  tileHeight  = std::min(tileSize, static_cast<std::int32_t>(extent.height) - rect.y);
+
+        if (rect.width == tileWidth && rect.height == tileHeight)
+            texture->DiscardTileClear(mipLevel, arrayLayer, tileX, tileY);
+        else
+            texture->ResolveTileClear(mipLevel, arrayLayer, tileX, tileY);
+    }
+
+    return clearValues;
+}
+
+/*
+Loads all sample planes of the specified color attachment into 'dst' and clears the samples-equal flag of each pixel whose samples differ.
+If 'acquireClears' is false, pending clears of the attachment are left untouched, since the sample planes are not stored back.
+*/
+void NullRasterizer::LoadColorSamples(std::size_t index, const NullTileRect& rect, bool acquireClears, float* dst, TileBuffers& buffers)
+{
+    const NullAttachment&   attachment  = colorAttachments_[index];
+    const std::size_t       numPixels   = static_cast<std::size_t>(rect.width * rect.height);
+    const std::int32_t      tileX       = rect.x / tileSize;
+    const std::int32_t      tileY       = rect.y / tileSize;
+    const float*            firstClear  = nullptr;
+    bool                    allCleared  = true;
+
+    for_range(sample, numSamples_)
+    {
+        const NullAttachment sampleAttachment = GetSampleAttachment(attachment, sample);
+
+        const float* clearColor =
+        (
+            acquireClears
+                ? AcquireTileClearValues(sampleAttachment, rect, tileX, tileY)
+                : sampleAttachment.texture->GetTileClearValues(sampleAttachment.mipLevel, sampleAttachment.arrayLayer, tileX, tileY)
+        );
+
+        float* colors = dst + sample * numPixels * 4;
+        if (clearColor != nullptr)
+        {
+            for_range(j, numPixels)
+                ::memcpy(colors + j * 4, clearColor, sizeof(float) * 4);
+        }
+        else
+            LoadColorTile(sampleAttachment, rect, colors);
+
+        /* Sample planes that are cleared with the same color need no per-pixel comparison */
+        if (sample == 0)
+            firstClear = clearColor;
+        if (clearColor == nullptr || firstClear == nullptr || ::memcmp(clearColor, firstClear, sizeof(float) * 4) != 0)
+            allCleared = false;
+    }
+
+    if (numSamples_ > 1 && !allCleared)
+    {
+        for_range(pixel, numPixels)
+        {
+            if (buffers.samplesEqual[pixel] == 0)
+                continue;
+
+            for_subrange(sample, 1u, numSamples_)
+            {
+                if (::memcmp(dst + (sample * numPixels + pixel) * 4, dst + pixel * 4, sizeof(float) * 4) != 0)
+                {
+                    buffers.samplesEqual[pixel] = 0;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Stores all sample planes of the specified color attachment. Pixels with equal samples are expanded from sample 0 first.
+void NullRasterizer::StoreColorSamples(std::size_t index, const NullTileRect& rect, float* src, const TileBuffers& buffers)
+{
+    const NullAttachment&   attachment  = colorAttachments_[index];
+    const std::size_t       numPixels   = static_cast<std::size_t>(rect.width * rect.height);
+
+    if (numSamples_ > 1)
+    {
+        for_range(pixel, numPixels)
+        {
+            if (buffers.samplesEqual[pixel] != 0)
+            {
+                for_subrange(sample, 1u, numSamples_)
+                    ::memcpy(src + (sample * numPixels + pixel) * 4, src + pixel * 4, sizeof(float) * 4);
+            }
+        }
+    }
+
+    for_range(sample, numSamples_)
+        StoreColorTile(GetSampleAttachment(attachment, sample), rect, src + sample * numPixels * 4);
+}
+
+// Averages the sample planes of the specified color attachment and stores the result into its resolve attachment.
+void NullRasterizer::ResolveColorSamples(std::size_t index, const NullTileRect& rect, const float* src, TileBuffers& buffers)
+{
+    const NullAttachment& resolveAttachment = resolveAttachments_[index];
+    if (resolveAttachment.texture == nullptr || !IsColorTileFormatSupported(resolveAttachment.texture->GetFormat()))
+        return;
+
+    const std::size_t numPixels = static_cast<std::size_t>(rect.width * rect.height);
+    buffers.resolvedColors.resize(numPixels * 4);
+    float* dst = buffers.resolvedColors.data();
+
+    const float invNumSamples = 1.0f / static_cast<float>(numSamples_);
+
+    for_range(pixel, numPixels)
+    {
+        const float* sample0 = src + pixel * 4;
+        if (buffers.samplesEqual[pixel] != 0)
+        {
+            ::memcpy(dst + pixel * 4, sample0, sizeof(float) * 4);
+            continue;
+        }
+
+        #ifdef LLGL_HAS_SSE2
+
+        __m128 sum = _mm_loadu_ps(sample0);
+        for_subrange(sample, 1u, numSamples_)
+            sum = _mm_add_ps(sum, _mm_loadu_ps(src + (sample * numPixels + pixel) * 4));
+        _mm_storeu_ps(dst + pixel * 4, _mm_mul_ps(sum, _mm_set1_ps(invNumSamples)));
+
+        #else // LLGL_HAS_SSE2
+
+        float sum[4] = { sample0[0], sample0[1], sample0[2], sample0[3] };
+        for_subrange(sample, 1u, numSamples_)
+        {
+            const float* color = src + (sample * numPixels + pixel) * 4;
+            for_range(c, 4)
+                sum[c] += color[c];
+        }
+        for_range(c, 4)
+            dst[pixel * 4 + c] = sum[c] * invNumSamples;
+
+        #endif // /LLGL_HAS_SSE2
+    }
+
+    AcquireTileClearValues(resolveAttachment, rect, rect.x / tileSize, rect.y / tileSize);
+    StoreColorTile(resolveAttachment, rect, dst);
+}
+
+// Resolves a tile that was not shaded since the resolve attachments were last updated.
+void NullRasterizer::ResolveTile(std::uint32_t tileIndex, TileBuffers& buffers)
+{
+    const NullTileRect  rect        = GetTileRect(tileIndex);
+    const std::size_t   numPixels   = static_cast<std::size_t>(rect.width * rect.height);
+
+    buffers.colors.resize(numSamples_ * numPixels * 4);
+
+    for_range(i, colorAttachments_.size())
+    {
+        if (IsColorAttachmentSupported(i) && resolveAttachments_[i].texture != nullptr)
+        {
+            buffers.samplesEqual.assign(numPixels, 1);
+            LoadColorSamples(i, rect, false, buffers.colors.data(), buffers);
+            ResolveColorSamples(i, rect, buffers.colors.data(), buffers);
+        }
+    }
+
+    tileResolved_[tileIndex] = 1;
+}
+
+void NullRasterizer::ResolveRemainingTiles()
+{
+    if (!HasResolveAttachments())
+        return;
+
+    std::vector<std::uint32_t> tiles;
+    for_range(tile, static_cast<std::uint32_t>(tileResolved_.size()))
+    {
+        if (tileResolved_[tile] == 0)
+            tiles.push_back(tile);
+    }
+
+    if (tiles.empty())
+        return;
+
+    /* Resolve tiles in parallel like they are shaded */
+    const std::uint32_t numTiles = static_cast<std::uint32_t>(tiles.size());
+    std::atomic<std::uint32_t> nextTile{ 0 };
+
+    const unsigned numWorkers = std::max(1u, std::min(std::thread::hardware_concurrency(), numTiles));
+
+    DoConcurrent(
+        [this, numTiles, &tiles, &nextTile](std::size_t /*worker*/)
+        {
+            TileBuffers buffers;
+            for (std::uint32_t i = nextTile++; i < numTiles; i = nextTile++)
+                ResolveTile(tiles[i], buffers);
+        },
+        numWorkers,
+        numWorkers,
+        1
+    );
+}
+
+void NullRasterizer::ShadeTile(std::uint32_t tileIndex, TileBuffers& buffers)
+{
+    const NullTileRect  rect            = GetTileRect(tileIndex);
+    const std::int32_t  tileX           = rect.x / tileSize;
+    const std::int32_t  tileY           = rect.y / tileSize;
+    const std::size_t   numPixels       = static_cast<std::size_t>(rect.width * rect.height);
+    const std::size_t   numPlaneValues  = numSamples_ * numPixels;
+
+    /* Load attachments into tile buffers; tiles with a pending fast clear are filled with the clear value instead */
+    buffers.samplesEqual.assign(numPixels, 1);
+    buffers.colors.resize(colorAttachments_.size() * numPlaneValues * 4);
+    for_range(i, colorAttachments_.size())
+    {
+        if (IsColorAttachmentSupported(i))
+            LoadColorSamples(i, rect, true, &(buffers.colors[i * numPlaneValues * 4]), buffers);
+    }
+
+    buffers.depths.resize(numPlaneValues);
+    buffers.stencils.resize(numPlaneValues);
+    if (depthStencilAttachment_.texture != nullptr)
+    {
+        for_range(sample, numSamples_)
+        {
+            const NullAttachment    sampleAttachment    = GetSampleAttachment(depthStencilAttachment_, sample);
+            float*                  depths              = &(buffers.depths[sample * numPixels]);
+            std::uint8_t*           stencils            = &(buffers.stencils[sample * numPixels]);
+
+            if (const float* clearValues = AcquireTileClearValues(sampleAttachment, rect, tileX, tileY))
+            {
+                std::fill(depths, depths + numPixels, clearValues[0]);
+                std::fill(stencils, stencils + numPixels, static_cast<std::uint8_t>(clearValues[1]));
+            }
+            else
+                LoadDepthStencilTile(sampleAttachment, rect, depths, stencils);
+        }
+    }
+
+    const bool hasDepth = HasDepthAttachment();
+    if (hasDepth)
+        InitBlockDepthBounds(rect, buffers);
+
+    /* Rasterize triangles in submission order */
+    for (std::uint32_t triangleIndex : tileBins_[tileIndex])
+        RasterizeTriangle(triangles_[triangleIndex], rect, buffers);
+
+    if (hasDepth)
+        StoreTileDepthBounds(tileIndex, buffers);
+
+    /* Resolve multi-sampled color attachments while their samples are still in the tile buffers */
+    if (HasResolveAttachments())
+    {
+        for_range(i, colorAttachments_.size())
+        {
+            if (IsColorAttachmentSupported(i))
+                ResolveColorSamples(i, rect, &(buffers.colors[i * numPlaneValues * 4]), buffers);
+        }
+        tileResolved_[tileIndex] = 1;
+    }
+
+    /* Store tile buffers back into attachments */
+    for_range(i, colorAttachments_.size())
+    {
+        if (IsColorAttachmentSupported(i))
+            StoreColorSamples(i, rect, &(buffers.colors[i * numPlaneValues * 4]), buffers);
+    }
+
+    if (depthStencilAttachment_.texture != nullptr)
+    {
+        for_range(sample, numSamples_)
+        {
+            StoreDepthStencilTile(
+                GetSampleAttachment(depthStencilAttachment_, sample),
+                rect,
+                &(buffers.depths[sample * numPixels]),
+                &(buffers.stencils[sample * numPixels])
+            );
+        }
+    }
+}
+
+void NullRasterizer::RasterizeTriangle(const Triangle& triangle, const NullTileRect& rect, TileBuffers& buffers)
+{
+    const DrawState&    drawState       = drawStates_[triangle.drawState];
+    const auto&         pipelineDesc    = drawState.pipelineState->graphicsDesc;
+    const auto&         blendDesc       = pipelineDesc.blend;
+    const auto&         depthDesc       = pipelineDesc.depth;
+    const int           face            = (triangle.frontFacing ? 0 : 1);
+
+    /* Clip triangle bounds against tile */
+    const std::int32_t minX = std::max(triangle.bounds[0], rect.x);
+    const std::int32_t minY = std::max(triangle.bounds[1], rect.y);
+    const std::int32_t maxX = std::min(triangle.bounds[2], rect.x + rect.width  - 1);
+    const std::int32_t maxY = std::min(triangle.bounds[3], rect.y + rect.height - 1);
+
+    if (minX > maxX || minY > maxY)
+        return;
+
+    const bool depthTest    = (HasDepthAttachment() && depthDesc.testEnabled);
+    const bool depthWrite   = (depthTest && depthDesc.writeEnabled);
+    const bool depthReject  = (depthTest && drawState.depthRejectable[face]);
+
+    /* Reject triangle if none of its fragments can pass the depth test in this tile */
+    if (depthReject && IsDepthRangeRejected(depthDesc.compareOp, triangle.zBounds[0], triangle.zBounds[1], buffers.tileDepthBounds.minDepth, buffers.tileDepthBounds.maxDepth))
+        return;
+
+    /*
+    Setup edge functions at the first pixel center and their increments per pixel.
+    The edge function at each sample position is the value at the pixel center plus a constant offset per sample.
+    */
+    std::int64_t edgeOrigin[3], stepX[3], stepY[3], maxSampleOffset[3];
+    std::int64_t sampleOffsets[3][NullTexture::maxSamples];
+
+    for_range(i, 3)
+    {
+        const int           j   = (i + 1) % 3;
+        const int           k   = (i + 2) % 3;
+        const std::int64_t  dx  = triangle.x[k] - triangle.x[j];
+        const std::int64_t  dy  = triangle.y[k] - triangle.y[j];
+        const std::int64_t  px  = static_cast<std::int64_t>(minX) * g_subPixelScale + g_subPixelScale/2;
+        const std::int64_t  py  = static_cast<std::int64_t>(minY) * g_subPixelScale + g_subPixelScale/2;
+
+        edgeOrigin[i]       = dx * (py - triangle.y[j]) - dy * (px - triangle.x[j]) + triangle.bias[i];
+        stepX[i]            = -dy * g_subPixelScale;
+        stepY[i]            = dx * g_subPixelScale;
+        maxSampleOffset[i]  = GetMaxSampleEdgeOffset(samplePositions_, numSamples_, dx, dy);
+
+        for_range(sample, numSamples_)
+            sampleOffsets[i][sample] = dx * samplePositions_[sample][1] - dy * samplePositions_[sample][0];
+    }
+
+    /* Stencil states of the triangle's face; Only the lower 8 bits are used, since all stencil formats have 8 bits */
+    const auto&         stencilFace     = (triangle.frontFacing ? pipelineDesc.stencil.front : pipelineDesc.stencil.back);
+    const bool          stencilTest     = (HasStencilAttachment() && pipelineDesc.stencil.testEnabled);
+    const std::uint8_t  stencilRef      = drawState.stencilReference[face];
+    const std::uint8_t  stencilRead     = static_cast<std::uint8_t>(stencilFace.readMask & 0xFF);
+    const std::uint8_t  stencilWrite    = static_cast<std::uint8_t>(stencilFace.writeMask & 0xFF);
+
+    const std::size_t   numPixels       = static_cast<std::size_t>(rect.width * rect.height);
+    const std::size_t   numAttachments  = colorAttachments_.size();
+    const std::uint32_t numSamples      = numSamples_;
+    const std::uint32_t fullSampleMask  = (numSamples < 32 ? (1u << numSamples) - 1u : ~0u);
+    bool                depthWritten    = false;
+    std::uint64_t       numRasterized   = 0;
+    std::uint64_t       numShaded       = 0;
+
+    /* Traverse the triangle bounds in blocks of the coarse depth buffer */
+    const std::int32_t blockMinX = (minX - rect.x) / depthBlockSize;
+    const std::int32_t blockMinY = (minY - rect.y) / depthBlockSize;
+    const std::int32_t blockMaxX = (maxX - rect.x) / depthBlockSize;
+    const std::int32_t blockMaxY = (maxY - rect.y) / depthBlockSize;
+
+    for_subrange(blockY, blockMinY, blockMaxY + 1)
+    {
+        for_subrange(blockX, blockMinX, blockMaxX + 1)
+        {
+            const std::size_t block = static_cast<std::size_t>(blockY * buffers.numBlocksX + blockX);
+
+            /* Reject block if none of the triangle's fragments can pass the depth test in this block */
+            if (depthReject && IsDepthRangeRejected(depthDesc.compareOp, triangle.zBounds[0], triangle.zBounds[1], buffers.blockMinDepths[block], buffers.blockMaxDepths[block]))
+                continue;
+
+            /* Clip block against triangle bounds */
+            const std::int32_t x0 = std::max(minX, rect.x + blockX * depthBlockSize);
+            const std::int32_t y0 = std::max(minY, rect.y + blockY * depthBlockSize);
+            const std::int32_t x1 = std::min(maxX, rect.x + blockX * depthBlockSize + depthBlockSize - 1);
+            const std::int32_t y1 = std::min(maxY, rect.y + blockY * depthBlockSize + depthBlockSize - 1);
+
+            /* Reject block if it is entirely outside of any edge; Test the block corner and sample with the largest edge function value */
+            std::int64_t edgeRow[3];
+            bool outside = false;
+
+            for_range(i, 3)
+            {
+                edgeRow[i] = edgeOrigin[i] + (x0 - minX) * stepX[i] + (y0 - minY) * stepY[i];
+                const std::int64_t maxEdge = edgeRow[i] + std::max<std::int64_t>(0, (x1 - x0) * stepX[i]) + std::max<std::int64_t>(0, (y1 - y0) * stepY[i]) + maxSampleOffset[i];
+                if (maxEdge < 0)
+                {
+                    outside = true;
+                    break;
+                }
+            }
+
+            if (outside)
+                continue;
+
+            bool blockDepthWritten = false;
+
+            for_subrange(y, y0, y1 + 1)
+            {
+                std::int64_t edge[3] = { edgeRow[0], edgeRow[1], edgeRow[2] };
+
+                for_subrange(x, x0, x1 + 1)
+                {
+                    /* Determine sample coverage; Pixels are skipped early if no sample can be inside */
+                    std::uint32_t coverage = 0;
+                    if (edge[0] + maxSampleOffset[0] >= 0 && edge[1] + maxSampleOffset[1] >= 0 && edge[2] + maxSampleOffset[2] >= 0)
+                    {
+                        for_range(sample, numSamples)
+                        {
+                            if (((edge[0] + sampleOffsets[0][sample]) | (edge[1] + sampleOffsets[1][sample]) | (edge[2] + sampleOffsets[2][sample])) >= 0)
+                                coverage |= (1u << sample);
+                        }
+                    }
+
+                    if (coverage != 0)
+                    {
+                        const std::size_t pixel = static_cast<std::size_t>((y - rect.y) * rect.width + (x - rect.x));
+                        ++numRasterized;
+
+                        /* Run stencil and depth tests per sample */
+                        std::uint32_t passMask = 0;
+
+                        for_range(sample, numSamples)
+                        {
+                            if ((coverage & (1u << sample)) == 0)
+                                continue;
+
+                            const std::size_t sampleIndex = sample * numPixels + pixel;
+
+                            /* Stencil test */
+                            std::uint8_t& dstStencil = buffers.stencils[sampleIndex];
+                            bool stencilPassed = true;
+                            if (stencilTest)
+                            {
+                                stencilPassed = CompareValues<std::uint8_t>(stencilFace.compareOp, stencilRef & stencilRead, dstStencil & stencilRead);
+                                if (!stencilPassed)
+                                    WriteStencil(stencilFace.stencilFailOp, stencilRef, stencilWrite, dstStencil);
+                            }
+
+                            if (!stencilPassed)
+                                continue;
+
+                            /* Compute barycentric coordinates at the sample position without fill rule bias */
+                            const float b1 = static_cast<float>(edge[1] + sampleOffsets[1][sample] - triangle.bias[1]) * triangle.invArea;
+                            const float b2 = static_cast<float>(edge[2] + sampleOffsets[2][sample] - triangle.bias[2]) * triangle.invArea;
+                            const float b0 = 1.0f - b1 - b2;
+
+                            /* Depth test; Interpolated depth is clamped to the triangle's depth range, so the coarse depth buffer is conservative */
+                            const float z = std::max(triangle.zBounds[0], std::min(b0 * triangle.z[0] + b1 * triangle.z[1] + b2 * triangle.z[2], triangle.zBounds[1]));
+                            float& dstDepth = buffers.depths[sampleIndex];
+                            const bool depthPassed = (!depthTest || CompareValues(depthDesc.compareOp, z, dstDepth));
+
+                            if (stencilTest)
+                                WriteStencil((depthPassed ? stencilFace.depthPassOp : stencilFace.depthFailOp), stencilRef, stencilWrite, dstStencil);
+
+                            if (depthPassed)
+                            {
+                                passMask |= (1u << sample);
+                                if (depthWrite)
+                                {
+                                    dstDepth = z;
+                                    blockDepthWritten = true;
+                                }
+                            }
+                        }
+
+                        if (passMask != 0)
+                        {
+                            buffers.numSamplesPassed += CountSampleBits(passMask);
+                            ++numShaded;
+
+                            /* Interpolate color once per pixel at the pixel center with perspective correction */
+                            const float b1 = static_cast<float>(edge[1] - triangle.bias[1]) * triangle.invArea;
+                            const float b2 = static_cast<float>(edge[2] - triangle.bias[2]) * triangle.invArea;
+                            const float b0 = 1.0f - b1 - b2;
+                            const float w = 1.0f / (b0 * triangle.invW[0] + b1 * triangle.invW[1] + b2 * triangle.invW[2]);
+
+                            float color[4];
+                            for_range(c, 4)
+                                color[c] = (b0 * triangle.colorOverW[0][c] + b1 * triangle.colorOverW[1][c] + b2 * triangle.colorOverW[2][c]) * w;
+
+                            /* Pixels whose samples remain equal are only blended once; otherwise, they are expanded into all sample planes first */
+                            std::uint8_t& samplesEqual = buffers.samplesEqual[pixel];
+                            const bool blendOnce = (samplesEqual != 0 && passMask == fullSampleMask);
+
+                            if (!blendOnce && samplesEqual != 0)
+                            {
+                                for_range(i, numAttachments)
+                                {
+                                    float* colors = &(buffers.colors[i * numSamples * numPixels * 4]);
+                                    for_subrange(sample, 1u, numSamples)
+                                        ::memcpy(colors + (sample * numPixels + pixel) * 4, colors + pixel * 4, sizeof(float) * 4);
+                                }
+                                samplesEqual = 0;
+                            }
+
+                            /* Blend color into all color attachments */
+                            for_range(i, numAttachments)
+                            {
+                                const auto& target = blendDesc.targets[blendDesc.independentBlendEnabled ? i : 0];
+                                float* colors = &(buffers.colors[i * numSamples * numPixels * 4]);
+
+                                if (blendOnce)
+                                    BlendAndWriteColor(target, blendDesc.blendFactor, color, colors + pixel * 4);
+                                else
+                                {
+                                    for_range(sample, numSamples)
+                                    {
+                                        if ((passMask & (1u << sample)) != 0)
+                                            BlendAndWriteColor(target, blendDesc.blendFactor, color, colors + (sample * numPixels + pixel) * 4);
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    for_range(i, 3)
+                        edge[i] += stepX[i];
+                }
+
+                for_range(i, 3)
+                    edgeRow[i] += stepY[i];
+            }
+
+            /* Update coarse depth buffer for this block */
+            if (blockDepthWritten)
+            {
+                UpdateBlockDepthBounds(rect, blockX, blockY, buffers);
+                depthWritten = true;
+            }
+        }
+    }
+
+    if (depthWritten)
+        UpdateTileDepthBounds(buffers);
+
+    buffers.numFragments += numRasterized;
+
+    if (triangle.costRecord != invalidCostRecord)
+    {
+        if (buffers.costRecordFragments.size() <= triangle.costRecord)
+            buffers.costRecordFragments.resize(triangle.costRecord + 1);
+        buffers.costRecordFragments[triangle.costRecord].rasterized += numRasterized;
+        buffers.costRecordFragments[triangle.costRecord].shaded     += numShaded;
+    }
+}
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,354 @@
+/*
+ * NullRasterizer.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_RASTERIZER_H
+#define LLGL_NULL_RASTERIZER_H
+
+
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/IndirectArguments.h>
+#include <LLGL/QueryHeapFlags.h>
+#include <LLGL/CommandBufferFlags.h>
+#include <LLGL/Container/SmallVector.h>
+#include <LLGL/Container/ArrayView.h>
+#include <LLGL/StaticLimits.h>
+#include "NullRasterTile.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class NullBuffer;
+class NullPipelineState;
+
+/*
+Tile based software rasterizer for the Null renderer.
+Draw commands run the vertex stage and bin the resulting triangles into screen tiles.
+All binned tiles are shaded in parallel once the rasterizer is flushed, i.e. at the end of a render pass.
+Since Null shaders are not executed, the vertex stage interprets the vertex attributes as clip-space position and color.
+Depth testing is accelerated by a hierarchical depth buffer: the min/max depth of each screen tile rejects entire triangles at binning time,
+and the min/max depth of each block within a tile rejects blocks of fragments while the tile is shaded.
+Multi-sampled attachments are rasterized with the standard sample patterns; coverage, depth, and stencil are evaluated per sample, color once per pixel.
+Pixels whose samples all have the same color are only blended and resolved once.
+While stream-output buffers are bound, the outputs of the vertex stage are appended to them for each assembled primitive, with or without an active render pass.
+*/
+class NullRasterizer
+{
+
+    public:
+
+        // Width and height (in pixels) of each screen tile.
+        static constexpr std::int32_t tileSize = 64;
+
+        // Cost record index that disables per-draw fragment counters.
+        static constexpr std::uint32_t invalidCostRecord = ~0u;
+
+        // Fragment counters of a single cost record.
+        struct FragmentCounters
+        {
+            std::uint64_t rasterized    = 0; // Pixels covered by at least one sample
+            std::uint64_t shaded        = 0; // Pixels with at least one sample that passed the depth and stencil tests
+        };
+
+        // Width and height (in pixels) of each block of the coarse depth buffer within a screen tile.
+        static constexpr std::int32_t depthBlockSize = 8;
+
+    public:
+
+        /*
+        Binds the attachments of a new render pass. Previously binned triangles are flushed first.
+        Resolve attachments are optional with one entry for each color attachment; entries with a null texture are not resolved.
+        */
+        void BeginRenderPass(
+            std::uint32_t           numColorAttachments,
+            const NullAttachment*   colorAttachments,
+            const NullAttachment*   resolveAttachments,
+            const NullAttachment&   depthStencilAttachment,
+            const Extent2D&         resolution
+        );
+
+        // Flushes all binned triangles, resolves multi-sampled color attachments, and unbinds the attachments.
+        void EndRenderPass();
+
+        /*
+        Clears the attachments of the active render pass. Previously binned triangles are flushed first.
+        Attachments are only marked as cleared; tiles are written once they are shaded or the texture is accessed otherwise.
+        */
+        void Clear(long flags, const ClearValue& clearValue);
+        void ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments);
+
+        /*
+        Binding arrays are not copied, since they refer to immutable state blocks of the command buffer that is executed.
+        Call ResetBindings before the rasterizer is used for another execution, so it does not refer to released state blocks.
+        */
+        void SetViewports(std::uint32_t numViewports, const Viewport* viewports);
+        void SetScissors(std::uint32_t numScissors, const Scissor* scissors);
+        void SetVertexBuffers(std::uint32_t numBuffers, const NullBuffer* const * buffers);
+        void SetIndexBuffer(const NullBuffer* buffer, const Format format, std::uint64_t offset);
+        void SetPipelineState(const NullPipelineState* pipelineState);
+        void SetStencilReference(std::uint32_t reference, const StencilFace stencilFace);
+
+        /*
+        Binds the stream-output buffers. Each buffer is written from the beginning and subsequent draw commands append to it.
+        Primitives that do not fit into all buffers are dropped, but still count as needed primitives.
+        */
+        void BeginStreamOutput(std::uint32_t numBuffers, NullBuffer* const * buffers);
+        void EndStreamOutput();
+
+        // Resets all dynamic states and bindings.
+        void ResetBindings();
+
+        /*
+        Assigns the fragments of subsequent draw commands to the specified cost record until another record is set.
+        Fragment counters of cost records are only complete once the rasterizer is flushed.
+        */
+        void SetCostRecord(std::uint32_t costRecord);
+
+        // Clears the fragment counters of all cost records.
+        void ResetCostRecords();
+
+        // Returns the fragment counters of all cost records that have been flushed; records without fragments may be missing at the end.
+        inline const std::vector<FragmentCounters>& GetCostRecordFragments() const
+        {
+            return costRecordFragments_;
+        }
+
+        void Draw(const DrawIndirectArguments& args);
+        void DrawIndexed(const DrawIndexedIndirectArguments& args);
+
+        // Shades all binned tiles in parallel and writes the results into the attachments.
+        void Flush();
+
+        // Returns the pipeline statistics accumulated over all draw commands. Fragment counts only include flushed triangles.
+        inline const QueryPipelineStatistics& GetStatistics() const
+        {
+            return statistics_;
+        }
+
+        // Returns the number of fragments that passed the depth and stencil tests. This only includes flushed triangles.
+        inline std::uint64_t GetSamplesPassed() const
+        {
+            return samplesPassed_;
+        }
+
+        // Returns the number of primitives that were written to stream-output buffers.
+        inline std::uint64_t GetStreamOutputPrimitivesWritten() const
+        {
+            return streamOutputPrimitivesWritten_;
+        }
+
+        // Returns the number of primitives that would have been written to stream-output buffers if they had not overflowed.
+        inline std::uint64_t GetStreamOutputPrimitivesNeeded() const
+        {
+            return streamOutputPrimitivesNeeded_;
+        }
+
+    private:
+
+        // Output of the vertex stage.
+        struct Vertex
+        {
+            float position[4]; // Clip-space position
+            float color[4];
+        };
+
+        // Snapshot of the states a triangle is rasterized with. Per-face arrays are indexed by 0 for front faces and 1 for back faces.
+        struct DrawState
+        {
+            const NullPipelineState*    pipelineState;
+            std::int32_t                scissorRect[4];         // minX, minY, maxX, maxY (exclusive)
+            std::uint8_t                stencilReference[2];
+            bool                        depthRejectable[2];     // True if fragments that fail the depth test have no side effects
+        };
+
+        // Range of depth values in a region of the depth buffer.
+        struct DepthBounds
+        {
+            float   minDepth    = 0.0f;
+            float   maxDepth    = 1.0f;
+            bool    valid       = false;
+        };
+
+        // Triangle in screen space after setup.
+        struct Triangle
+        {
+            std::int32_t    x[3];           // Fixed-point X coordinates with 4 bits sub-pixel precision
+            std::int32_t    y[3];           // Fixed-point Y coordinates with 4 bits sub-pixel precision
+            std::int64_t    bias[3];        // Edge function bias for the top-left fill rule
+            float           invArea;        // Reciprocal of the doubled triangle area in fixed-point units
+            float           z[3];           // Window-space depth
+            float           zBounds[2];     // Minimum and maximum window-space depth; interpolated depth values are clamped to this range
+            float           invW[3];        // Reciprocal clip-space W component
+            float           colorOverW[3][4];
+            std::int32_t    bounds[4];      // minX, minY, maxX, maxY (inclusive) in pixels
+            std::uint32_t   drawState;
+            std::uint32_t   costRecord;
+            bool            frontFacing;
+        };
+
+        // Vertex stage output that is captured into a stream-output buffer.
+        struct StreamOutputAttribute
+        {
+            enum class Source
+            {
+                Zero,
+                Position,
+                Color,
+                Input,  // Pass-through of a vertex input attribute
+            };
+
+            const VertexAttribute*  outputAttrib;
+            const VertexAttribute*  inputAttrib;
+            Source                  source;
+            std::uint32_t           offset;         // Byte offset within each vertex of the stream-output buffer
+        };
+
+        // Stream-output buffer with its append position.
+        struct StreamOutputTarget
+        {
+            NullBuffer*                 buffer      = nullptr;
+            std::atomic<std::uint64_t>  filledSize  { 0 };
+        };
+
+        // Per-worker tile buffers.
+        struct TileBuffers
+        {
+            std::vector<float>          colors;             // RGBA colors of each sample plane of each color attachment
+            std::vector<float>          depths;             // Depth values of each sample plane
+            std::vector<std::uint8_t>   stencils;           // Stencil values of each sample plane
+            std::vector<std::uint8_t>   samplesEqual;       // Non-zero for each pixel whose color samples are all equal; only sample 0 is up to date for these pixels
+            std::vector<float>          resolvedColors;
+            std::vector<float>          blockMinDepths;     // Coarse depth buffer with one entry per depthBlockSize x depthBlockSize block
+            std::vector<float>          blockMaxDepths;
+            std::int32_t                numBlocksX          = 0;
+            DepthBounds                 tileDepthBounds;
+            std::uint64_t               numFragments        = 0;
+            std::uint64_t               numSamplesPassed    = 0;
+            std::vector<FragmentCounters> costRecordFragments;
+        };
+
+    private:
+
+        bool IsRenderPassActive() const;
+        bool IsRasterizerEnabled() const;
+        bool IsStreamOutputActive() const;
+
+        void ResolveVertexLayout();
+        void ResolveStreamOutputLayout();
+        void UpdateDrawState();
+
+        void FetchVertices(
+            std::uint32_t   firstVertex,
+            std::uint32_t   numVertices,
+            std::uint32_t   instance,
+            std::uint32_t   firstInstance
+        );
+
+        void AssemblePrimitives(const std::uint32_t* indices, std::uint32_t numIndices, std::uint32_t baseIndex);
+        void StreamOutputPrimitives(const std::uint32_t* indices, std::uint32_t numIndices, std::uint32_t baseIndex);
+
+        void ClipAndSetupTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2);
+        void SetupTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2);
+        void BinTriangle(std::uint32_t triangleIndex);
+
+        bool HasDepthAttachment() const;
+        bool HasStencilAttachment() const;
+        bool HasResolveAttachments() const;
+        bool IsColorAttachmentSupported(std::size_t index) const;
+
+        NullAttachment GetSampleAttachment(const NullAttachment& attachment, std::uint32_t sample) const;
+        NullTileRect GetTileRect(std::uint32_t tileIndex) const;
+
+        void ClearColorAttachment(std::size_t index, const float (&color)[4]);
+        void ClearDepthStencilAttachment(long flags, float depth, std::uint32_t stencil);
+
+        void ResetTileDepthBounds();
+        void InitBlockDepthBounds(const NullTileRect& rect, TileBuffers& buffers);
+        void StoreTileDepthBounds(std::uint32_t tileIndex, const TileBuffers& buffers);
+
+        static void UpdateBlockDepthBounds(const NullTileRect& rect, std::int32_t blockX, std::int32_t blockY, TileBuffers& buffers);
+        static void UpdateTileDepthBounds(TileBuffers& buffers);
+
+        const float* AcquireTileClearValues(const NullAttachment& attachment, const NullTileRect& rect, std::int32_t tileX, std::int32_t tileY);
+
+        void LoadColorSamples(std::size_t index, const NullTileRect& rect, bool acquireClears, float* dst, TileBuffers& buffers);
+        void StoreColorSamples(std::size_t index, const NullTileRect& rect, float* src, const TileBuffers& buffers);
+        void ResolveColorSamples(std::size_t index, const NullTileRect& rect, const float* src, TileBuffers& buffers);
+        void ResolveTile(std::uint32_t tileIndex, TileBuffers& buffers);
+        void ResolveRemainingTiles();
+
+        void ShadeTile(std::uint32_t tileIndex, TileBuffers& buffers);
+        void RasterizeTriangle(const Triangle& triangle, const NullTileRect& rect, TileBuffers& buffers);
+
+    private:
+
+        /* Render pass states */
+        SmallVector<NullAttachment>         colorAttachments_;
+        SmallVector<NullAttachment>         resolveAttachments_;
+        NullAttachment                      depthStencilAttachment_;
+        Extent2D                            resolution_;
+        std::uint32_t                       numSamples_             = 1;
+        const std::int8_t                   (*samplePositions_)[2]  = nullptr;
+        std::int32_t                        sampleSpread_[2]        = { 0, 0 };     // Minimum and maximum sample offset from the pixel center in sub-pixel units
+        std::vector<std::uint8_t>           tileResolved_;                          // Non-zero for each tile whose resolve attachments are up to date
+        std::int32_t                        numTilesX_              = 0;
+        std::int32_t                        numTilesY_              = 0;
+        std::vector<DepthBounds>            tileDepthBounds_;
+        float                               depthBoundsEpsilon_     = 0.0f;
+
+        /* Dynamic states */
+        ArrayView<Viewport>                 viewports_;
+        ArrayView<Scissor>                  scissors_;
+        ArrayView<const NullBuffer*>        vertexBuffers_;
+        const NullBuffer*                   indexBuffer_            = nullptr;
+        Format                              indexFormat_            = Format::R32UInt;
+        std::uint64_t                       indexBufferOffset_      = 0;
+        const NullPipelineState*            pipelineState_          = nullptr;
+        const VertexAttribute*              positionAttrib_         = nullptr;
+        const VertexAttribute*              colorAttrib_            = nullptr;
+        Viewport                            viewport_;
+        std::uint32_t                       stencilReference_[2]    = { 0, 0 };
+        bool                                drawStateDirty_         = true;
+
+        /* Stream-output states */
+        StreamOutputTarget                  streamOutputTargets_[LLGL_MAX_NUM_SO_BUFFERS];
+        std::uint32_t                       numStreamOutputTargets_ = 0;
+        std::vector<StreamOutputAttribute>  streamOutputAttribs_;
+        std::uint32_t                       streamOutputStrides_[LLGL_MAX_NUM_SO_BUFFERS] = {};
+        std::vector<float>                  streamOutputValues_;                    // RGBA values of each stream-output attribute of each fetched vertex
+
+        /* Binned primitives */
+        std::vector<Vertex>                 vertices_;
+        std::vector<std::uint32_t>          indices_;
+        std::vector<DrawState>              drawStates_;
+        std::vector<Triangle>               triangles_;
+        std::vector<std::vector<std::uint32_t>> tileBins_;
+
+        /* Statistics for queries */
+        QueryPipelineStatistics             statistics_;
+        std::uint64_t                       samplesPassed_          = 0;
+        std::uint64_t                       streamOutputPrimitivesWritten_  = 0;
+        std::uint64_t                       streamOutputPrimitivesNeeded_   = 0;
+        std::uint32_t                       costRecord_             = invalidCostRecord;
+        std::vector<FragmentCounters>       costRecordFragments_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
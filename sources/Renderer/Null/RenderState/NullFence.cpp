@@ -6,8 +6,9 @@
  */
 
 #include "NullFence.h"
-#include <thread>
 #include <chrono>
+#include <algorithm>
+#include <limits>
 
 
 namespace LLGL
@@ -22,20 +23,44 @@ void NullFence::SetName(const char* name)
         label_.clear();
 }
 
-void NullFence::Signal(std::uint64_t signal)
+NullFence::NullFence(std::uint64_t initialSignal) :
+    pendingSignal_ { initialSignal },
+    signal_        { initialSignal }
 {
-    signal_ = signal;
 }
 
-void NullFence::WaitForSignal(std::uint64_t signal)
+std::uint64_t NullFence::NextSignal()
 {
-    while (signal_ != signal)
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return ++pendingSignal_;
 }
 
-NullFence::NullFence(std::uint64_t initialSignal) :
-    signal_ { initialSignal }
+std::uint64_t NullFence::GetPendingSignal() const
+{
+    return pendingSignal_.load();
+}
+
+void NullFence::Signal(std::uint64_t signal)
+{
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        signal_ = std::max(signal_, signal);
+    }
+    signalCond_.notify_all();
+}
+
+bool NullFence::WaitForSignal(std::uint64_t signal, std::uint64_t timeout)
 {
+    std::unique_lock<std::mutex> lock{ mutex_ };
+    auto IsSignaled = [this, signal]() -> bool { return (signal_ >= signal); };
+
+    /* Timeouts beyond the range of the steady clock are treated as infinite */
+    if (timeout >= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max() / 2))
+    {
+        signalCond_.wait(lock, IsSignaled);
+        return true;
+    }
+
+    return signalCond_.wait_for(lock, std::chrono::nanoseconds(static_cast<std::int64_t>(timeout)), IsSignaled);
 }
 
 
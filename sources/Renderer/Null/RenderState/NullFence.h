@@ -12,6 +12,8 @@
 #include <LLGL/Fence.h>
 #include <string>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 
 namespace LLGL
@@ -26,17 +28,28 @@ class NullFence final : public Fence
         void SetName(const char* name) override;
 
     public:
-    
+
         NullFence(std::uint64_t initialSignal = 0);
-    
+
+        // Returns the next signal value this fence will be signaled with once it has been submitted.
+        std::uint64_t NextSignal();
+
+        // Returns the signal value of the most recent submission.
+        std::uint64_t GetPendingSignal() const;
+
+        // Signals the fence and wakes up all threads waiting for this or a lower signal value.
         void Signal(std::uint64_t signal);
 
-        void WaitForSignal(std::uint64_t signal);
+        // Blocks until the fence has been signaled with at least the specified value. Returns false if the timeout (in nanoseconds) expired.
+        bool WaitForSignal(std::uint64_t signal, std::uint64_t timeout);
 
     private:
 
         std::string             label_;
-        std::atomic_uint64_t    signal_;
+        std::atomic_uint64_t    pendingSignal_;
+        std::uint64_t           signal_;        // Guarded by mutex_
+        std::mutex              mutex_;
+        std::condition_variable signalCond_;
 
 };
 
@@ -6,6 +6,8 @@
  */
 
 #include "NullPipelineLayout.h"
+#include "../../../Core/CoreUtils.h"
+#include <LLGL/Utils/ForRange.h>
 
 
 namespace LLGL
@@ -15,6 +17,9 @@ namespace LLGL
 NullPipelineLayout::NullPipelineLayout(const PipelineLayoutDescriptor& desc) :
     desc { desc }
 {
+    staticSamplers_.reserve(desc.staticSamplers.size());
+    for (const StaticSamplerDescriptor& staticSamplerDesc : desc.staticSamplers)
+        staticSamplers_.push_back(MakeUnique<NullSampler>(staticSamplerDesc.sampler));
 }
 
 void NullPipelineLayout::SetName(const char* name)
@@ -45,6 +50,17 @@ std::uint32_t NullPipelineLayout::GetNumUniforms() const
     return static_cast<std::uint32_t>(desc.uniforms.size());
 }
 
+const NullSampler* NullPipelineLayout::FindStaticSampler(const BindingSlot& slot) const
+{
+    for_range(i, desc.staticSamplers.size())
+    {
+        const BindingSlot& staticSamplerSlot = desc.staticSamplers[i].slot;
+        if (staticSamplerSlot.index == slot.index && staticSamplerSlot.set == slot.set)
+            return staticSamplers_[i].get();
+    }
+    return nullptr;
+}
+
 
 } // /namespace LLGL
 
@@ -11,7 +11,10 @@
 
 #include <LLGL/PipelineLayout.h>
 #include <LLGL/PipelineLayoutFlags.h>
+#include "../Texture/NullSampler.h"
 #include <string>
+#include <vector>
+#include <memory>
 
 
 namespace LLGL
@@ -34,13 +37,17 @@ class NullPipelineLayout final : public PipelineLayout
 
         NullPipelineLayout(const PipelineLayoutDescriptor& desc);
 
+        // Returns the static sampler at the specified binding slot, or null if there is no such static sampler.
+        const NullSampler* FindStaticSampler(const BindingSlot& slot) const;
+
     public:
 
         const PipelineLayoutDescriptor desc;
 
     private:
 
-        std::string label_;
+        std::string                                 label_;
+        std::vector<std::unique_ptr<NullSampler>>   staticSamplers_;    // Sampler states of all static samplers in the order of the descriptor
 
 };
 
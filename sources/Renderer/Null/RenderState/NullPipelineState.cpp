@@ -6,21 +6,34 @@
  */
 
 #include "NullPipelineState.h"
+#include "../Shader/NullShader.h"
+#include "../../CheckedCast.h"
+#include "../../../Core/CoreUtils.h"
+
+#ifdef LLGL_ENABLE_SPIRV_REFLECT
+#   include "../Compute/NullComputeTranslator.h"
+#endif
+
 
 namespace LLGL
 {
 
 
-NullPipelineState::NullPipelineState(const GraphicsPipelineDescriptor& desc) :
-    isGraphicsPSO { true },
-    graphicsDesc  { desc }
+NullPipelineState::NullPipelineState(const GraphicsPipelineDescriptor& desc, NullPipelineCache&& cache) :
+    isGraphicsPSO { true             },
+    graphicsDesc  { desc             },
+    cache_        { std::move(cache) }
 {
 }
 
-NullPipelineState::NullPipelineState(const ComputePipelineDescriptor& desc) :
-    isGraphicsPSO { false },
-    computeDesc   { desc  }
+NullPipelineState::NullPipelineState(const ComputePipelineDescriptor& desc, NullPipelineCache&& cache) :
+    isGraphicsPSO { false            },
+    computeDesc   { desc             },
+    cache_        { std::move(cache) }
 {
+    #ifdef LLGL_ENABLE_SPIRV_REFLECT
+    BuildComputeProgram();
+    #endif
 }
 
 NullPipelineState::~NullPipelineState()
@@ -38,10 +51,60 @@ void NullPipelineState::SetName(const char* name)
 
 const Report* NullPipelineState::GetReport() const
 {
-    return nullptr; //TODO
+    return (report_ ? &report_ : nullptr);
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+#ifdef LLGL_ENABLE_SPIRV_REFLECT
+
+void NullPipelineState::BuildComputeProgram()
+{
+    if (computeDesc.computeShader == nullptr)
+        return;
+
+    /* Translate SPIR-V module into compute program; failures are reported but do not invalidate the PSO */
+    auto* shaderNull = LLGL_CAST(const NullShader*, computeDesc.computeShader);
+    const auto& binary = shaderNull->GetBinary();
+    if (binary.empty())
+    {
+        report_.Reset(StringView{ "compute shader cannot be executed: SPIR-V binary required" }, false);
+        return;
+    }
+
+    std::unique_ptr<NullComputeProgram> program;
+    if (cache_.computeProgram)
+    {
+        /* Take compute program from pipeline cache, so the SPIR-V module does not have to be translated again */
+        program = std::move(cache_.computeProgram);
+    }
+    else
+    {
+        program = MakeUnique<NullComputeProgram>();
+        std::string error;
+
+        NullComputeTranslator translator;
+        if (!translator.Translate(binary, shaderNull->GetEntryPoint().c_str(), *program, error))
+        {
+            report_.Reset("compute shader cannot be executed: " + error, false);
+            return;
+        }
+    }
+
+    #ifdef LLGL_ENABLE_JIT_COMPILER
+    /* Compile native kernel once per PSO; programs that cannot be compiled are interpreted */
+    computeKernel_ = NullComputeKernel::Compile(*program);
+    #endif
+
+    computeProgram_ = std::move(program);
+}
+
+#endif
+
+
 } // /namespace LLGL
 
 
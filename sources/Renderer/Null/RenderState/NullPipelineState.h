@@ -11,13 +11,36 @@
 
 #include <LLGL/PipelineState.h>
 #include <LLGL/PipelineStateFlags.h>
+#include "../../../Core/BasicReport.h"
+#include "../Shader/NullShader.h"
+#include "NullPipelineLayout.h"
 #include <string>
+#include <memory>
+
+#ifdef LLGL_ENABLE_SPIRV_REFLECT
+#   include "../Compute/NullComputeProgram.h"
+#   ifdef LLGL_ENABLE_JIT_COMPILER
+#       include "../Compute/NullComputeJIT.h"
+#   endif
+#endif
 
 
 namespace LLGL
 {
 
 
+// Objects restored from a serialized pipeline cache. The restored PSO descriptor refers to these objects, so they are owned by the PSO.
+struct NullPipelineCache
+{
+    std::unique_ptr<NullShader>             vertexShader;
+    std::unique_ptr<NullShader>             fragmentShader;
+    std::unique_ptr<NullShader>             computeShader;
+    std::unique_ptr<NullPipelineLayout>     pipelineLayout;
+    #ifdef LLGL_ENABLE_SPIRV_REFLECT
+    std::unique_ptr<NullComputeProgram>     computeProgram;     // Compute program that was translated when the cache was created
+    #endif
+};
+
 class NullPipelineState final : public PipelineState
 {
 
@@ -28,10 +51,30 @@ class NullPipelineState final : public PipelineState
 
     public:
 
-        NullPipelineState(const GraphicsPipelineDescriptor& desc);
-        NullPipelineState(const ComputePipelineDescriptor& desc);
+        NullPipelineState(const GraphicsPipelineDescriptor& desc, NullPipelineCache&& cache = {});
+        NullPipelineState(const ComputePipelineDescriptor& desc, NullPipelineCache&& cache = {});
         ~NullPipelineState();
 
+        #ifdef LLGL_ENABLE_SPIRV_REFLECT
+
+        // Returns the compute program translated from the SPIR-V compute shader, or null if the shader could not be translated.
+        inline const NullComputeProgram* GetComputeProgram() const
+        {
+            return computeProgram_.get();
+        }
+
+        #ifdef LLGL_ENABLE_JIT_COMPILER
+
+        // Returns the native kernel compiled from the compute program, or null if the program must be interpreted.
+        inline const NullComputeKernel* GetComputeKernel() const
+        {
+            return computeKernel_.get();
+        }
+
+        #endif
+
+        #endif
+
     public:
 
         const bool isGraphicsPSO;
@@ -44,7 +87,23 @@ class NullPipelineState final : public PipelineState
 
     private:
 
-        std::string label_;
+        #ifdef LLGL_ENABLE_SPIRV_REFLECT
+        void BuildComputeProgram();
+        #endif
+
+    private:
+
+        std::string                         label_;
+        BasicReport                         report_;
+        NullPipelineCache                   cache_;
+
+        #ifdef LLGL_ENABLE_SPIRV_REFLECT
+        std::unique_ptr<NullComputeProgram> computeProgram_;
+        #ifdef LLGL_ENABLE_JIT_COMPILER
+        std::unique_ptr<NullComputeKernel>  computeKernel_;
+        #endif
+        #endif
+
 };
 
 
@@ -6,6 +6,8 @@
  */
 
 #include "NullQueryHeap.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
 
 
 namespace LLGL
@@ -13,8 +15,9 @@ namespace LLGL
 
 
 NullQueryHeap::NullQueryHeap(const QueryHeapDescriptor& desc) :
-    QueryHeap { desc.type },
-    desc      { desc      }
+    QueryHeap { desc.type       },
+    desc      { desc            },
+    queries_  { desc.numQueries }
 {
 }
 
@@ -26,6 +29,122 @@ void NullQueryHeap::SetName(const char* name)
         label_.clear();
 }
 
+void NullQueryHeap::Begin(std::uint32_t query, const NullQueryCounters& counters)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    if (query < queries_.size())
+    {
+        queries_[query].begin       = counters;
+        queries_[query].available   = false;
+    }
+}
+
+static void SubtractPipelineStatistics(QueryPipelineStatistics& dst, const QueryPipelineStatistics& lhs, const QueryPipelineStatistics& rhs)
+{
+    dst.inputAssemblyVertices           = lhs.inputAssemblyVertices             - rhs.inputAssemblyVertices;
+    dst.inputAssemblyPrimitives         = lhs.inputAssemblyPrimitives           - rhs.inputAssemblyPrimitives;
+    dst.vertexShaderInvocations         = lhs.vertexShaderInvocations           - rhs.vertexShaderInvocations;
+    dst.geometryShaderInvocations       = lhs.geometryShaderInvocations         - rhs.geometryShaderInvocations;
+    dst.geometryShaderPrimitives        = lhs.geometryShaderPrimitives          - rhs.geometryShaderPrimitives;
+    dst.clippingInvocations             = lhs.clippingInvocations               - rhs.clippingInvocations;
+    dst.clippingPrimitives              = lhs.clippingPrimitives                - rhs.clippingPrimitives;
+    dst.fragmentShaderInvocations       = lhs.fragmentShaderInvocations         - rhs.fragmentShaderInvocations;
+    dst.tessControlShaderInvocations    = lhs.tessControlShaderInvocations      - rhs.tessControlShaderInvocations;
+    dst.tessEvaluationShaderInvocations = lhs.tessEvaluationShaderInvocations   - rhs.tessEvaluationShaderInvocations;
+    dst.computeShaderInvocations        = lhs.computeShaderInvocations          - rhs.computeShaderInvocations;
+}
+
+void NullQueryHeap::End(std::uint32_t query, const NullQueryCounters& counters)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    if (query < queries_.size())
+    {
+        auto& entry = queries_[query];
+        entry.result.time                       = counters.time                         - entry.begin.time;
+        entry.result.samplesPassed              = counters.samplesPassed                - entry.begin.samplesPassed;
+        entry.result.streamOutPrimitivesWritten = counters.streamOutPrimitivesWritten   - entry.begin.streamOutPrimitivesWritten;
+        entry.result.streamOutPrimitivesNeeded  = counters.streamOutPrimitivesNeeded    - entry.begin.streamOutPrimitivesNeeded;
+        SubtractPipelineStatistics(entry.result.pipelineStatistics, counters.pipelineStatistics, entry.begin.pipelineStatistics);
+        entry.available = true;
+    }
+}
+
+bool NullQueryHeap::ReadResults(std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize)
+{
+    if (data == nullptr || firstQuery + numQueries > queries_.size() || numQueries == 0)
+        return false;
+
+    std::lock_guard<std::mutex> guard{ mutex_ };
+
+    for_range(i, numQueries)
+    {
+        if (!queries_[firstQuery + i].available)
+            return false;
+    }
+
+    if (dataSize == numQueries * sizeof(QueryPipelineStatistics) && GetType() == QueryType::PipelineStatistics)
+    {
+        auto dst = reinterpret_cast<QueryPipelineStatistics*>(data);
+        for_range(i, numQueries)
+            dst[i] = queries_[firstQuery + i].result.pipelineStatistics;
+    }
+    else if (dataSize == numQueries * sizeof(std::uint64_t))
+    {
+        auto dst = reinterpret_cast<std::uint64_t*>(data);
+        for_range(i, numQueries)
+            dst[i] = GetResultValue(queries_[firstQuery + i].result);
+    }
+    else if (dataSize == numQueries * sizeof(std::uint32_t))
+    {
+        auto dst = reinterpret_cast<std::uint32_t*>(data);
+        for_range(i, numQueries)
+            dst[i] = static_cast<std::uint32_t>(GetResultValue(queries_[firstQuery + i].result));
+    }
+    else
+        return false;
+
+    return true;
+}
+
+void NullQueryHeap::SetSubmissionTicket(std::uint64_t ticket)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    submissionTicket_ = std::max(submissionTicket_, ticket);
+}
+
+std::uint64_t NullQueryHeap::GetSubmissionTicket()
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    return submissionTicket_;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::uint64_t NullQueryHeap::GetResultValue(const NullQueryCounters& result) const
+{
+    switch (GetType())
+    {
+        case QueryType::SamplesPassed:
+            return result.samplesPassed;
+        case QueryType::AnySamplesPassed:
+        case QueryType::AnySamplesPassedConservative:
+            return (result.samplesPassed > 0 ? 1 : 0);
+        case QueryType::TimeElapsed:
+            return result.time;
+        case QueryType::StreamOutPrimitivesWritten:
+            return result.streamOutPrimitivesWritten;
+        case QueryType::StreamOutOverflow:
+            return (result.streamOutPrimitivesNeeded > result.streamOutPrimitivesWritten ? 1 : 0);
+        case QueryType::PipelineStatistics:
+            return result.pipelineStatistics.fragmentShaderInvocations;
+        default:
+            return 0;
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -10,14 +10,27 @@
 
 
 #include <LLGL/QueryHeap.h>
+#include <LLGL/QueryHeapFlags.h>
 #include <vector>
 #include <string>
+#include <mutex>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
+// Counters the command executor measures at the begin and end of each query.
+struct NullQueryCounters
+{
+    std::uint64_t           time                        = 0; // CPU time in nanoseconds
+    std::uint64_t           samplesPassed               = 0;
+    std::uint64_t           streamOutPrimitivesWritten  = 0;
+    std::uint64_t           streamOutPrimitivesNeeded   = 0; // Primitives that would have been written without overflow
+    QueryPipelineStatistics pipelineStatistics;
+};
+
 class NullQueryHeap final : public QueryHeap
 {
 
@@ -29,13 +42,47 @@ class NullQueryHeap final : public QueryHeap
 
         NullQueryHeap(const QueryHeapDescriptor& desc);
 
+        // Stores the counters at the begin of the specified query and invalidates its previous result.
+        void Begin(std::uint32_t query, const NullQueryCounters& counters);
+
+        // Stores the difference to the counters at the begin of the specified query as its result.
+        void End(std::uint32_t query, const NullQueryCounters& counters);
+
+        /*
+        Copies the results of the specified queries into the output data, which must be an array of std::uint32_t, std::uint64_t, or QueryPipelineStatistics.
+        Returns false if any of the results is not available yet or the data size does not match.
+        */
+        bool ReadResults(std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize);
+
+        // Stores the ticket of the most recent submission that writes to this query heap.
+        void SetSubmissionTicket(std::uint64_t ticket);
+
+        // Returns the ticket of the most recent submission that writes to this query heap. Ticket 0 refers to no submission.
+        std::uint64_t GetSubmissionTicket();
+
     public:
 
         const QueryHeapDescriptor desc;
 
     private:
 
-        std::string label_;
+        struct Query
+        {
+            NullQueryCounters   begin;
+            NullQueryCounters   result;
+            bool                available   = false;
+        };
+
+    private:
+
+        std::uint64_t GetResultValue(const NullQueryCounters& result) const;
+
+    private:
+
+        std::string         label_;
+        std::vector<Query>  queries_;
+        std::uint64_t       submissionTicket_   = 0;
+        std::mutex          mutex_;                 // Guards queries_ and submissionTicket_ between the command queue worker and QueryResult
 
 };
 
@@ -20,7 +20,7 @@ namespace LLGL
 static std::uint32_t GetNumPipelineLayoutBindings(const PipelineLayout* pipelineLayout)
 {
     auto pipelineLayoutNull = LLGL_CAST(const NullPipelineLayout*, pipelineLayout);
-    return std::max(1u, static_cast<std::uint32_t>(pipelineLayoutNull->desc.bindings.size()));
+    return std::max(1u, static_cast<std::uint32_t>(pipelineLayoutNull->desc.heapBindings.size()));
 }
 
 NullResourceHeap::NullResourceHeap(const ResourceHeapDescriptor& desc, const ArrayView<ResourceViewDescriptor>& initialResourceViews) :
@@ -38,7 +38,7 @@ std::uint32_t NullResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor
 {
     /* Copy input resource views into resource heap via STL copy algorithm, since the descriptors are non-POD structs */
     std::uint32_t numWritten = 0;
-    if (resourceViews.size() + firstDescriptor < resourceViews_.size())
+    if (resourceViews.size() + firstDescriptor <= resourceViews_.size())
     {
         for_range(i, resourceViews.size())
         {
@@ -53,6 +53,12 @@ std::uint32_t NullResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor
     return numWritten;
 }
 
+const ResourceViewDescriptor* NullResourceHeap::GetResourceView(std::uint32_t descriptorSet, std::uint32_t binding) const
+{
+    const std::size_t index = static_cast<std::size_t>(descriptorSet) * numBindings_ + binding;
+    return (binding < numBindings_ && index < resourceViews_.size() ? &(resourceViews_[index]) : nullptr);
+}
+
 void NullResourceHeap::SetName(const char* name)
 {
     if (name != nullptr)
@@ -35,6 +35,21 @@ class NullResourceHeap final : public ResourceHeap
 
         std::uint32_t WriteResourceViews(std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews);
 
+        // Returns the resource view of the specified heap binding in a descriptor set, or null if out of bounds.
+        const ResourceViewDescriptor* GetResourceView(std::uint32_t descriptorSet, std::uint32_t binding) const;
+
+        // Returns the number of bindings per descriptor set.
+        inline std::uint32_t GetNumBindings() const
+        {
+            return numBindings_;
+        }
+
+        // Returns the resource views of all descriptor sets.
+        inline const std::vector<ResourceViewDescriptor>& GetResourceViews() const
+        {
+            return resourceViews_;
+        }
+
     private:
 
         std::string                         label_;
@@ -6,15 +6,47 @@
  */
 
 #include "NullShader.h"
+#include "../../../Core/StringUtils.h"
+#include <string.h>
 
 
 namespace LLGL
 {
 
 
+static std::vector<std::uint32_t> CopyShaderBinary(const ShaderDescriptor& desc)
+{
+    std::vector<std::uint32_t> binary;
+
+    /* Only compute shaders can be executed, so the binary of all other shader types is not retained */
+    if (desc.type != ShaderType::Compute)
+        return binary;
+
+    if (desc.sourceType == ShaderSourceType::BinaryFile)
+    {
+        /* Load binary from file */
+        const std::vector<char> fileContent = ReadFileBuffer(desc.source);
+        if (fileContent.size() % 4 == 0)
+        {
+            binary.resize(fileContent.size() / 4);
+            ::memcpy(binary.data(), fileContent.data(), fileContent.size());
+        }
+    }
+    else if (desc.sourceType == ShaderSourceType::BinaryBuffer && desc.source != nullptr && desc.sourceSize % 4 == 0)
+    {
+        /* Copy binary from buffer */
+        binary.resize(desc.sourceSize / 4);
+        ::memcpy(binary.data(), desc.source, desc.sourceSize);
+    }
+
+    return binary;
+}
+
 NullShader::NullShader(const ShaderDescriptor& desc) :
-    Shader { desc.type },
-    desc   { desc      }
+    Shader      { desc.type                                         },
+    desc        { desc                                              },
+    binary_     { CopyShaderBinary(desc)                            },
+    entryPoint_ { (desc.entryPoint != nullptr ? desc.entryPoint : "") }
 {
 }
 
@@ -11,6 +11,8 @@
 
 #include <LLGL/Shader.h>
 #include <string>
+#include <vector>
+#include <cstdint>
 
 
 namespace LLGL
@@ -30,6 +32,18 @@ class NullShader final : public Shader
 
         NullShader(const ShaderDescriptor& desc);
 
+        // Returns the shader binary as 32-bit words. This is empty if the shader was not created from a binary.
+        inline const std::vector<std::uint32_t>& GetBinary() const
+        {
+            return binary_;
+        }
+
+        // Returns the entry point name. The descriptor only holds a reference to the original string.
+        inline const std::string& GetEntryPoint() const
+        {
+            return entryPoint_;
+        }
+
     public:
 
         const ShaderDescriptor desc;
@@ -38,6 +52,11 @@ class NullShader final : public Shader
 
         std::string label_;
 
+    private:
+
+        std::vector<std::uint32_t>  binary_;
+        std::string                 entryPoint_;
+
 };
 
 
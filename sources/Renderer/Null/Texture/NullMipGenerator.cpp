@@ -0,0 +1,412 @@
+/*
+ * NullMipGenerator.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "NullMipGenerator.h"
+#include "../../../Core/Threading.h"
+#include "../../../Core/Float16Compressor.h"
+#include "../../../Core/CompilerExtensions.h"
+#include <LLGL/Format.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+#ifdef LLGL_HAS_SSE2
+#   include <emmintrin.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+// Minimum number of bytes per worker thread before MIP-map generation is split across multiple threads.
+constexpr std::size_t g_minMipSizePerThread = 64 * 1024;
+
+// Source rows a destination row is averaged from. Each row contributes two horizontally adjacent texels.
+struct NullMipSourceRows
+{
+    const char*     rows[4];
+    std::uint32_t   numRows;    // Either 1, 2, or 4
+};
+
+// Source texel X coordinates of the specified destination texel.
+static void GetSourceTexels(std::uint32_t x, std::uint32_t srcWidth, std::uint32_t& outX0, std::uint32_t& outX1)
+{
+    outX0 = std::min(x * 2u, srcWidth - 1u);
+    outX1 = std::min(x * 2u + 1u, srcWidth - 1u);
+}
+
+// Returns the shift of the sample count (two texels per row) to divide sums by.
+static int GetSampleShift(std::uint32_t numRows)
+{
+    return (numRows == 4 ? 3 : numRows == 2 ? 2 : 1);
+}
+
+
+/*
+ * RGBA8 kernel
+ */
+
+static void DownsampleRowRGBA8(char* dst, const NullMipSourceRows& src, std::uint32_t dstWidth, std::uint32_t srcWidth)
+{
+    const int shift = GetSampleShift(src.numRows);
+    std::uint32_t x = 0;
+
+    #ifdef LLGL_HAS_SSE2
+
+    /* Average two destination texels per iteration from four source texels in each row */
+    const __m128i zero          = _mm_setzero_si128();
+    const __m128i bias          = _mm_set1_epi16(static_cast<short>(1 << (shift - 1)));
+    const __m128i shiftCount    = _mm_cvtsi32_si128(shift);
+
+    for (; x + 2 <= dstWidth && x * 2 + 4 <= srcWidth; x += 2)
+    {
+        __m128i sumLo = zero, sumHi = zero;
+        for_range(i, src.numRows)
+        {
+            const __m128i texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src.rows[i] + x * 8));
+            sumLo = _mm_add_epi16(sumLo, _mm_unpacklo_epi8(texels, zero));
+            sumHi = _mm_add_epi16(sumHi, _mm_unpackhi_epi8(texels, zero));
+        }
+
+        /* Add horizontally adjacent texels: sumLo = [t0|t1], sumHi = [t2|t3] -> [t0+t1|t2+t3] */
+        __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(sumLo, sumHi), _mm_unpackhi_epi64(sumLo, sumHi));
+        sum = _mm_srl_epi16(_mm_add_epi16(sum, bias), shiftCount);
+
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x * 4), _mm_packus_epi16(sum, zero));
+    }
+
+    #endif // /LLGL_HAS_SSE2
+
+    for (; x < dstWidth; ++x)
+    {
+        std::uint32_t x0, x1;
+        GetSourceTexels(x, srcWidth, x0, x1);
+        for_range(c, 4)
+        {
+            std::uint32_t sum = (1u << (shift - 1));
+            for_range(i, src.numRows)
+            {
+                const auto* row = reinterpret_cast<const std::uint8_t*>(src.rows[i]);
+                sum += row[x0 * 4 + c] + row[x1 * 4 + c];
+            }
+            dst[x * 4 + c] = static_cast<char>(sum >> shift);
+        }
+    }
+}
+
+
+/*
+ * RGBA32F kernel
+ */
+
+#ifdef LLGL_HAS_SSE2
+
+static void DownsampleRowRGBA32F(char* dst, const NullMipSourceRows& src, std::uint32_t dstWidth, std::uint32_t srcWidth)
+{
+    const __m128 scale = _mm_set1_ps(1.0f / static_cast<float>(1 << GetSampleShift(src.numRows)));
+
+    for_range(x, dstWidth)
+    {
+        std::uint32_t x0, x1;
+        GetSourceTexels(x, srcWidth, x0, x1);
+
+        __m128 sum = _mm_setzero_ps();
+        for_range(i, src.numRows)
+        {
+            const auto* row = reinterpret_cast<const float*>(src.rows[i]);
+            sum = _mm_add_ps(sum, _mm_add_ps(_mm_loadu_ps(row + x0 * 4), _mm_loadu_ps(row + x1 * 4)));
+        }
+
+        _mm_storeu_ps(reinterpret_cast<float*>(dst) + x * 4, _mm_mul_ps(sum, scale));
+    }
+}
+
+#endif // /LLGL_HAS_SSE2
+
+
+/*
+ * sRGB kernel
+ */
+
+static float SRGBToLinear(float value)
+{
+    return (value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f));
+}
+
+// Lookup tables to decode 8-bit sRGB components into linear space and to encode them back with correct rounding.
+struct NullSRGBTables
+{
+    NullSRGBTables()
+    {
+        for_range(i, 256)
+            decode[i] = SRGBToLinear(static_cast<float>(i) / 255.0f);
+        for_range(i, 255)
+            thresholds[i] = SRGBToLinear((static_cast<float>(i) + 0.5f) / 255.0f);
+    }
+
+    inline std::uint8_t Encode(float value) const
+    {
+        return static_cast<std::uint8_t>(std::upper_bound(thresholds, thresholds + 255, value) - thresholds);
+    }
+
+    float decode[256];
+    float thresholds[255];  // Linear values at the midpoints between two sRGB values
+};
+
+static const NullSRGBTables& GetSRGBTables()
+{
+    static const NullSRGBTables tables;
+    return tables;
+}
+
+static int GetAlphaComponentIndex(ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::RGBA:
+        case ImageFormat::BGRA:
+            return 3;
+        case ImageFormat::Alpha:
+        case ImageFormat::ARGB:
+        case ImageFormat::ABGR:
+            return 0;
+        default:
+            return -1;
+    }
+}
+
+static void DownsampleRowSRGB8(char* dst, const NullMipSourceRows& src, std::uint32_t dstWidth, std::uint32_t srcWidth, std::uint32_t numComponents, int alphaIndex)
+{
+    const NullSRGBTables& tables = GetSRGBTables();
+    const int shift = GetSampleShift(src.numRows);
+    const float scale = 1.0f / static_cast<float>(1 << shift);
+
+    for_range(x, dstWidth)
+    {
+        std::uint32_t x0, x1;
+        GetSourceTexels(x, srcWidth, x0, x1);
+        for_range(c, numComponents)
+        {
+            if (static_cast<int>(c) == alphaIndex)
+            {
+                /* Alpha is always stored in linear space */
+                std::uint32_t sum = (1u << (shift - 1));
+                for_range(i, src.numRows)
+                {
+                    const auto* row = reinterpret_cast<const std::uint8_t*>(src.rows[i]);
+                    sum += row[x0 * numComponents + c] + row[x1 * numComponents + c];
+                }
+                dst[x * numComponents + c] = static_cast<char>(sum >> shift);
+            }
+            else
+            {
+                float sum = 0.0f;
+                for_range(i, src.numRows)
+                {
+                    const auto* row = reinterpret_cast<const std::uint8_t*>(src.rows[i]);
+                    sum += tables.decode[row[x0 * numComponents + c]] + tables.decode[row[x1 * numComponents + c]];
+                }
+                dst[x * numComponents + c] = static_cast<char>(tables.Encode(sum * scale));
+            }
+        }
+    }
+}
+
+
+/*
+ * Generic kernel
+ */
+
+static double ReadComponent(const char* src, DataType dataType)
+{
+    switch (dataType)
+    {
+        case DataType::Int8:    return static_cast<double>(*reinterpret_cast<const std::int8_t*>(src));
+        case DataType::UInt8:   return static_cast<double>(*reinterpret_cast<const std::uint8_t*>(src));
+        case DataType::Int16:   return static_cast<double>(*reinterpret_cast<const std::int16_t*>(src));
+        case DataType::UInt16:  return static_cast<double>(*reinterpret_cast<const std::uint16_t*>(src));
+        case DataType::Int32:   return static_cast<double>(*reinterpret_cast<const std::int32_t*>(src));
+        case DataType::UInt32:  return static_cast<double>(*reinterpret_cast<const std::uint32_t*>(src));
+        case DataType::Float16: return static_cast<double>(DecompressFloat16(*reinterpret_cast<const std::uint16_t*>(src)));
+        case DataType::Float32: return static_cast<double>(*reinterpret_cast<const float*>(src));
+        case DataType::Float64: return *reinterpret_cast<const double*>(src);
+        default:                return 0.0;
+    }
+}
+
+template <typename T>
+static void WriteIntComponent(char* dst, double value)
+{
+    /* Round to nearest and clamp to the range of the integral type */
+    value = std::round(value);
+    value = std::max<double>(value, static_cast<double>(std::numeric_limits<T>::min()));
+    value = std::min<double>(value, static_cast<double>(std::numeric_limits<T>::max()));
+    *reinterpret_cast<T*>(dst) = static_cast<T>(value);
+}
+
+static void WriteComponent(char* dst, DataType dataType, double value)
+{
+    switch (dataType)
+    {
+        case DataType::Int8:    WriteIntComponent<std::int8_t>(dst, value);                                     break;
+        case DataType::UInt8:   WriteIntComponent<std::uint8_t>(dst, value);                                    break;
+        case DataType::Int16:   WriteIntComponent<std::int16_t>(dst, value);                                    break;
+        case DataType::UInt16:  WriteIntComponent<std::uint16_t>(dst, value);                                   break;
+        case DataType::Int32:   WriteIntComponent<std::int32_t>(dst, value);                                    break;
+        case DataType::UInt32:  WriteIntComponent<std::uint32_t>(dst, value);                                   break;
+        case DataType::Float16: *reinterpret_cast<std::uint16_t*>(dst) = CompressFloat16(static_cast<float>(value));    break;
+        case DataType::Float32: *reinterpret_cast<float*>(dst) = static_cast<float>(value);                     break;
+        case DataType::Float64: *reinterpret_cast<double*>(dst) = value;                                        break;
+        default:                                                                                                break;
+    }
+}
+
+static void DownsampleRowGeneric(char* dst, const NullMipSourceRows& src, std::uint32_t dstWidth, std::uint32_t srcWidth, std::uint32_t numComponents, DataType dataType)
+{
+    const std::size_t componentSize = DataTypeSize(dataType);
+    const std::size_t texelSize     = componentSize * numComponents;
+    const double scale = 1.0 / static_cast<double>(1 << GetSampleShift(src.numRows));
+
+    for_range(x, dstWidth)
+    {
+        std::uint32_t x0, x1;
+        GetSourceTexels(x, srcWidth, x0, x1);
+        for_range(c, numComponents)
+        {
+            double sum = 0.0;
+            for_range(i, src.numRows)
+            {
+                sum += ReadComponent(src.rows[i] + x0 * texelSize + c * componentSize, dataType);
+                sum += ReadComponent(src.rows[i] + x1 * texelSize + c * componentSize, dataType);
+            }
+            WriteComponent(dst + x * texelSize + c * componentSize, dataType, sum * scale);
+        }
+    }
+}
+
+
+/*
+ * Global functions
+ */
+
+void GenerateNullMipImage(
+    Image&          dstImage,
+    const Image&    srcImage,
+    int             layerAxis,
+    std::uint32_t   baseArrayLayer,
+    std::uint32_t   numArrayLayers,
+    long            formatFlags)
+{
+    if ((formatFlags & (FormatFlags::IsCompressed | FormatFlags::IsPacked)) != 0)
+        return;
+
+    if (dstImage.GetFormat() != srcImage.GetFormat() || dstImage.GetDataType() != srcImage.GetDataType())
+        return;
+
+    const ImageFormat   format          = srcImage.GetFormat();
+    const DataType      dataType        = srcImage.GetDataType();
+    const std::uint32_t numComponents   = ImageFormatSize(format);
+    const std::uint32_t texelSize       = srcImage.GetBytesPerPixel();
+
+    if (texelSize == 0)
+        return;
+
+    const Extent3D& srcExtent = srcImage.GetExtent();
+    const Extent3D& dstExtent = dstImage.GetExtent();
+
+    /* Determine range of destination rows; array layers are not downsampled */
+    std::uint32_t beginY = 0, endY = dstExtent.height;
+    std::uint32_t beginZ = 0, endZ = dstExtent.depth;
+
+    if (layerAxis == 1)
+    {
+        beginY  = std::min(baseArrayLayer, dstExtent.height);
+        endY    = std::min(beginY + numArrayLayers, dstExtent.height);
+    }
+    else if (layerAxis == 2)
+    {
+        beginZ  = std::min(baseArrayLayer, dstExtent.depth);
+        endZ    = std::min(beginZ + numArrayLayers, dstExtent.depth);
+    }
+
+    const bool          scaleY      = (layerAxis != 1 && srcExtent.height > 1);
+    const bool          scaleZ      = (layerAxis == 3 && srcExtent.depth > 1);
+    const std::uint32_t numRowsY    = endY - beginY;
+    const std::size_t   numRows     = static_cast<std::size_t>(numRowsY) * (endZ - beginZ);
+
+    if (numRows == 0)
+        return;
+
+    const std::size_t srcRowStride      = srcImage.GetRowStride();
+    const std::size_t srcLayerStride    = srcImage.GetDepthStride();
+    const std::size_t dstRowStride      = dstImage.GetRowStride();
+    const std::size_t dstLayerStride    = dstImage.GetDepthStride();
+
+    const char* srcData = static_cast<const char*>(srcImage.GetData());
+    char*       dstData = static_cast<char*>(dstImage.GetData());
+
+    /* Select row kernel by image format */
+    const bool isSRGB   = ((formatFlags & FormatFlags::IsColorSpace_sRGB) != 0 && dataType == DataType::UInt8);
+    const bool isRGBA8  = (!isSRGB && numComponents == 4 && dataType == DataType::UInt8);
+    #ifdef LLGL_HAS_SSE2
+    const bool isRGBA32F = (numComponents == 4 && dataType == DataType::Float32);
+    #endif
+    const int alphaIndex = GetAlphaComponentIndex(format);
+
+    auto DownsampleRows = [&](std::size_t begin, std::size_t end)
+    {
+        for_subrange(i, begin, end)
+        {
+            const std::uint32_t y = beginY + static_cast<std::uint32_t>(i % numRowsY);
+            const std::uint32_t z = beginZ + static_cast<std::uint32_t>(i / numRowsY);
+
+            /* Gather source rows; rows are repeated at the image border for odd extents */
+            const std::uint32_t y0 = (scaleY ? std::min(y * 2u, srcExtent.height - 1u) : y);
+            const std::uint32_t y1 = (scaleY ? std::min(y * 2u + 1u, srcExtent.height - 1u) : y);
+            const std::uint32_t z0 = (scaleZ ? std::min(z * 2u, srcExtent.depth - 1u) : z);
+            const std::uint32_t z1 = (scaleZ ? std::min(z * 2u + 1u, srcExtent.depth - 1u) : z);
+
+            NullMipSourceRows src;
+            src.numRows = 0;
+            src.rows[src.numRows++] = srcData + z0 * srcLayerStride + y0 * srcRowStride;
+            if (scaleY)
+                src.rows[src.numRows++] = srcData + z0 * srcLayerStride + y1 * srcRowStride;
+            if (scaleZ)
+            {
+                src.rows[src.numRows++] = srcData + z1 * srcLayerStride + y0 * srcRowStride;
+                if (scaleY)
+                    src.rows[src.numRows++] = srcData + z1 * srcLayerStride + y1 * srcRowStride;
+            }
+
+            char* dst = dstData + z * dstLayerStride + y * dstRowStride;
+
+            if (isSRGB)
+                DownsampleRowSRGB8(dst, src, dstExtent.width, srcExtent.width, numComponents, alphaIndex);
+            else if (isRGBA8)
+                DownsampleRowRGBA8(dst, src, dstExtent.width, srcExtent.width);
+            #ifdef LLGL_HAS_SSE2
+            else if (isRGBA32F)
+                DownsampleRowRGBA32F(dst, src, dstExtent.width, srcExtent.width);
+            #endif
+            else
+                DownsampleRowGeneric(dst, src, dstExtent.width, srcExtent.width, numComponents, dataType);
+        }
+    };
+
+    /* Distribute rows of all array layers across worker threads */
+    const std::size_t minRowsPerThread = std::max<std::size_t>(1, g_minMipSizePerThread / std::max<std::size_t>(1, dstRowStride));
+    DoConcurrentRange(DownsampleRows, numRows, Constants::maxThreadCount, static_cast<unsigned>(std::min<std::size_t>(minRowsPerThread, ~0u)));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,43 @@
+/*
+ * NullMipGenerator.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_MIP_GENERATOR_H
+#define LLGL_NULL_MIP_GENERATOR_H
+
+
+#include <LLGL/Utils/Image.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Generates the destination MIP-map image by downsampling the source MIP-map image with a box filter.
+Only the array layers in the range [baseArrayLayer, baseArrayLayer + numArrayLayers) are updated.
+The layer axis denotes along which image axis the array layers are stored: 1 for Y-axis, 2 for Z-axis, or 3 if the image is not layered.
+Format flags are used to average sRGB formats in linear color space. Compressed and packed formats are ignored.
+*/
+void GenerateNullMipImage(
+    Image&          dstImage,
+    const Image&    srcImage,
+    int             layerAxis,
+    std::uint32_t   baseArrayLayer,
+    std::uint32_t   numArrayLayers,
+    long            formatFlags
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
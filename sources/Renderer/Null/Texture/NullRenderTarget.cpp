@@ -37,7 +37,7 @@ Extent2D NullRenderTarget::GetResolution() const
 
 std::uint32_t NullRenderTarget::GetSamples() const
 {
-    return desc.samples;
+    return NullTexture::ClampSamples(desc.samples);
 }
 
 std::uint32_t NullRenderTarget::GetNumColorAttachments() const
@@ -65,45 +65,73 @@ const RenderPass* NullRenderTarget::GetRenderPass() const
  * ======= Private: =======
  */
 
+// Returns the attachment descriptor as Null attachment.
+static NullAttachment MakeNullAttachment(const AttachmentDescriptor& attachmentDesc)
+{
+    NullAttachment attachment;
+    {
+        attachment.texture      = LLGL_CAST(NullTexture*, attachmentDesc.texture);
+        attachment.mipLevel     = attachmentDesc.mipLevel;
+        attachment.arrayLayer   = attachmentDesc.arrayLayer;
+    }
+    return attachment;
+}
+
 void NullRenderTarget::BuildAttachmentArray()
 {
+    /*
+    Without custom multi-sampling, the attachment textures are single-sampled.
+    The render target then renders into intermediate multi-sampled textures and resolves the color attachments into the attachment textures.
+    */
+    const bool isMultiSampled = (GetSamples() > 1);
+
+    auto IsIntermediateRequired = [this, isMultiSampled](const AttachmentDescriptor& attachment) -> bool
+    {
+        return
+        (
+            attachment.texture == nullptr ||
+            (isMultiSampled && !desc.customMultiSampling && LLGL_CAST(NullTexture*, attachment.texture)->GetNumSamples() == 1)
+        );
+    };
+
     for (const auto& attachment : desc.attachments)
     {
         const Format format = GetAttachmentFormat(attachment);
         if (IsColorFormat(format))
         {
-            /* Cache color attachment */
-            if (auto texture = attachment.texture)
+            /* Cache color attachment and its resolve attachment */
+            NullAttachment colorAttachment, resolveAttachment;
+            if (IsIntermediateRequired(attachment))
             {
-                auto textureNull = LLGL_CAST(NullTexture*, texture);
-                colorAttachments_.push_back(textureNull);
+                colorAttachment.texture = MakeIntermediateAttachment(format, BindFlags::ColorAttachment);
+                if (attachment.texture != nullptr)
+                    resolveAttachment = MakeNullAttachment(attachment);
             }
             else
-                colorAttachments_.push_back(MakeIntermediateAttachment(attachment));
+                colorAttachment = MakeNullAttachment(attachment);
+            colorAttachments_.push_back(colorAttachment);
+            resolveAttachments_.push_back(resolveAttachment);
         }
         else
         {
-            /* Cache depth-stencil attachment */
-            if (auto texture = attachment.texture)
-            {
-                auto textureNull = LLGL_CAST(NullTexture*, texture);
-                depthStencilAttachment_ = textureNull;
-                depthStencilFormat_     = textureNull->desc.format;
-            }
+            /* Cache depth-stencil attachment; Depth-stencil attachments are never resolved */
+            if (IsIntermediateRequired(attachment))
+                depthStencilAttachment_.texture = MakeIntermediateAttachment(format, BindFlags::DepthStencilAttachment);
             else
-                depthStencilFormat_ = attachment.format;
+                depthStencilAttachment_ = MakeNullAttachment(attachment);
+            depthStencilFormat_ = format;
         }
     }
 }
 
-NullTexture* NullRenderTarget::MakeIntermediateAttachment(const AttachmentDescriptor& attachmentDesc)
+NullTexture* NullRenderTarget::MakeIntermediateAttachment(const Format format, long bindFlags)
 {
     TextureDescriptor textureDesc;
     {
         textureDesc.type            = (desc.samples > 1 ? TextureType::Texture2DMS : TextureType::Texture2D);
-        textureDesc.bindFlags       = BindFlags::ColorAttachment;
+        textureDesc.bindFlags       = bindFlags;
         textureDesc.miscFlags       = MiscFlags::FixedSamples;
-        textureDesc.format          = attachmentDesc.format;
+        textureDesc.format          = format;
         textureDesc.extent.width    = desc.resolution.width;
         textureDesc.extent.height   = desc.resolution.height;
         textureDesc.mipLevels       = 1;
@@ -113,7 +141,6 @@ NullTexture* NullRenderTarget::MakeIntermediateAttachment(const AttachmentDescri
     return intermediateAttachments_.back().get();
 }
 
-
 } // /namespace LLGL
 
 
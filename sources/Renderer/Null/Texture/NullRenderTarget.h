@@ -19,6 +19,17 @@ namespace LLGL
 {
 
 
+/*
+Texture subresource that is bound as attachment to a render target.
+The rasterizer addresses the samples of multi-sampled attachments by their storage layer (see NullTexture::GetSampleLayer).
+*/
+struct NullAttachment
+{
+    NullTexture*    texture     = nullptr;
+    std::uint32_t   mipLevel    = 0;
+    std::uint32_t   arrayLayer  = 0;
+};
+
 class NullRenderTarget final : public RenderTarget
 {
 
@@ -39,6 +50,27 @@ class NullRenderTarget final : public RenderTarget
 
         NullRenderTarget(const RenderTargetDescriptor& desc);
 
+        // Returns the list of color attachments.
+        inline const std::vector<NullAttachment>& GetColorAttachments() const
+        {
+            return colorAttachments_;
+        }
+
+        /*
+        Returns the list of resolve attachments with one entry for each color attachment.
+        The texture of an entry is null if its color attachment is not resolved at the end of a render pass.
+        */
+        inline const std::vector<NullAttachment>& GetResolveAttachments() const
+        {
+            return resolveAttachments_;
+        }
+
+        // Returns the depth-stencil attachment. Its texture is null if this render target has no depth-stencil attachment.
+        inline const NullAttachment& GetDepthStencilAttachment() const
+        {
+            return depthStencilAttachment_;
+        }
+
     public:
 
         const RenderTargetDescriptor desc;
@@ -47,13 +79,14 @@ class NullRenderTarget final : public RenderTarget
 
         void BuildAttachmentArray();
 
-        NullTexture* MakeIntermediateAttachment(const AttachmentDescriptor& attachmentDesc);
+        NullTexture* MakeIntermediateAttachment(const Format format, long bindFlags);
 
     private:
 
         std::string                                 label_;
-        std::vector<NullTexture*>                   colorAttachments_;
-        NullTexture*                                depthStencilAttachment_     = nullptr;
+        std::vector<NullAttachment>                 colorAttachments_;
+        std::vector<NullAttachment>                 resolveAttachments_;
+        NullAttachment                              depthStencilAttachment_;
         std::vector<std::unique_ptr<NullTexture>>   intermediateAttachments_;
         Format                                      depthStencilFormat_         = Format::Undefined;
 
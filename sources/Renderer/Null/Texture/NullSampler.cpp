@@ -6,6 +6,18 @@
  */
 
 #include "NullSampler.h"
+#include "NullTexture.h"
+#include "../../../Core/Float16Compressor.h"
+#include "../../../Core/CompilerExtensions.h"
+#include <LLGL/Format.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <cmath>
+#include <string.h>
+
+#ifdef LLGL_HAS_SSE2
+#   include <emmintrin.h>
+#endif
 
 
 namespace LLGL
@@ -25,6 +37,770 @@ void NullSampler::SetName(const char* name)
         label_.clear();
 }
 
+constexpr std::uint32_t NullSampler::maxAnisotropy;
+
+
+/*
+ * Texel vectors
+ */
+
+#ifdef LLGL_HAS_SSE2
+
+typedef __m128 NullTexelVec;
+
+static inline NullTexelVec TexelSet(float r, float g, float b, float a)
+{
+    return _mm_setr_ps(r, g, b, a);
+}
+
+static inline NullTexelVec TexelLoad(const float* src)
+{
+    return _mm_loadu_ps(src);
+}
+
+static inline void TexelStore(float* dst, NullTexelVec v)
+{
+    _mm_storeu_ps(dst, v);
+}
+
+static inline float TexelGetR(NullTexelVec v)
+{
+    return _mm_cvtss_f32(v);
+}
+
+// Returns acc + v * weight.
+static inline NullTexelVec TexelMulAdd(NullTexelVec acc, NullTexelVec v, float weight)
+{
+    return _mm_add_ps(acc, _mm_mul_ps(v, _mm_set1_ps(weight)));
+}
+
+static inline NullTexelVec TexelScale(NullTexelVec v, float scale)
+{
+    return _mm_mul_ps(v, _mm_set1_ps(scale));
+}
+
+static inline NullTexelVec TexelLerp(NullTexelVec a, NullTexelVec b, float t)
+{
+    return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), _mm_set1_ps(t)));
+}
+
+// Decodes four 8-bit UNorm components at once.
+static inline NullTexelVec TexelDecodeUNorm8x4(const char* src)
+{
+    std::int32_t bits;
+    ::memcpy(&bits, src, sizeof(bits));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i components = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bits), zero), zero);
+    return _mm_mul_ps(_mm_cvtepi32_ps(components), _mm_set1_ps(1.0f / 255.0f));
+}
+
+// Swaps the red and blue components.
+static inline NullTexelVec TexelSwapRB(NullTexelVec v)
+{
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 1, 2));
+}
+
+#else // LLGL_HAS_SSE2
+
+struct NullTexelVec
+{
+    float v[4];
+};
+
+static inline NullTexelVec TexelSet(float r, float g, float b, float a)
+{
+    return NullTexelVec{ { r, g, b, a } };
+}
+
+static inline NullTexelVec TexelLoad(const float* src)
+{
+    return NullTexelVec{ { src[0], src[1], src[2], src[3] } };
+}
+
+static inline void TexelStore(float* dst, const NullTexelVec& v)
+{
+    ::memcpy(dst, v.v, sizeof(v.v));
+}
+
+static inline float TexelGetR(const NullTexelVec& v)
+{
+    return v.v[0];
+}
+
+static inline NullTexelVec TexelMulAdd(const NullTexelVec& acc, const NullTexelVec& v, float weight)
+{
+    return TexelSet(acc.v[0] + v.v[0] * weight, acc.v[1] + v.v[1] * weight, acc.v[2] + v.v[2] * weight, acc.v[3] + v.v[3] * weight);
+}
+
+static inline NullTexelVec TexelScale(const NullTexelVec& v, float scale)
+{
+    return TexelSet(v.v[0] * scale, v.v[1] * scale, v.v[2] * scale, v.v[3] * scale);
+}
+
+static inline NullTexelVec TexelLerp(const NullTexelVec& a, const NullTexelVec& b, float t)
+{
+    return TexelSet(
+        a.v[0] + (b.v[0] - a.v[0]) * t,
+        a.v[1] + (b.v[1] - a.v[1]) * t,
+        a.v[2] + (b.v[2] - a.v[2]) * t,
+        a.v[3] + (b.v[3] - a.v[3]) * t
+    );
+}
+
+static inline NullTexelVec TexelDecodeUNorm8x4(const char* src)
+{
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(src);
+    return TexelSet(bytes[0] / 255.0f, bytes[1] / 255.0f, bytes[2] / 255.0f, bytes[3] / 255.0f);
+}
+
+static inline NullTexelVec TexelSwapRB(const NullTexelVec& v)
+{
+    return TexelSet(v.v[2], v.v[1], v.v[0], v.v[3]);
+}
+
+#endif // /LLGL_HAS_SSE2
+
+static inline NullTexelVec TexelZero()
+{
+    return TexelSet(0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+
+/*
+ * Texel decoding
+ */
+
+// Decoding path of a texel format. Formats without a specialized path are decoded component by component.
+enum class NullTexelDecoder
+{
+    Undefined,
+    RGBA8UNorm,
+    BGRA8UNorm,
+    RGBA8UNorm_sRGB,
+    BGRA8UNorm_sRGB,
+    RGBA32Float,
+    D16UNorm,
+    D24UNormS8UInt,
+    D32Float,       // Also used for D32FloatS8X24UInt, since depth is stored in the first 32 bits
+    Generic,
+};
+
+struct NullTexelFormat
+{
+    NullTexelDecoder    decoder         = NullTexelDecoder::Undefined;
+    DataType            dataType        = DataType::Undefined;
+    std::uint32_t       numComponents   = 0;
+    std::uint32_t       componentSize   = 0;
+    int                 mapping[4]      = { 0, 1, 2, 3 };   // RGBA index of each stored component
+    bool                normalized      = false;
+    bool                sRGB            = false;
+    bool                integer         = false;
+};
+
+static const float* GetSRGBDecodeTable()
+{
+    static float table[256];
+    static const bool tableInitialized = []() -> bool
+    {
+        for_range(i, 256)
+        {
+            const float value = static_cast<float>(i) / 255.0f;
+            table[i] = (value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f));
+        }
+        return true;
+    }();
+    (void)tableInitialized;
+    return table;
+}
+
+// Returns the number of stored components and their RGBA indices for all image formats of uncompressed color formats.
+static std::uint32_t GetTexelComponentMapping(const ImageFormat format, int (&outMapping)[4])
+{
+    switch (format)
+    {
+        case ImageFormat::Alpha:    outMapping[0] = 3;                                                          return 1;
+        case ImageFormat::R:        outMapping[0] = 0;                                                          return 1;
+        case ImageFormat::RG:       outMapping[0] = 0; outMapping[1] = 1;                                       return 2;
+        case ImageFormat::RGB:      outMapping[0] = 0; outMapping[1] = 1; outMapping[2] = 2;                    return 3;
+        case ImageFormat::BGR:      outMapping[0] = 2; outMapping[1] = 1; outMapping[2] = 0;                    return 3;
+        case ImageFormat::RGBA:     outMapping[0] = 0; outMapping[1] = 1; outMapping[2] = 2; outMapping[3] = 3; return 4;
+        case ImageFormat::BGRA:     outMapping[0] = 2; outMapping[1] = 1; outMapping[2] = 0; outMapping[3] = 3; return 4;
+        case ImageFormat::ARGB:     outMapping[0] = 3; outMapping[1] = 0; outMapping[2] = 1; outMapping[3] = 2; return 4;
+        case ImageFormat::ABGR:     outMapping[0] = 3; outMapping[1] = 2; outMapping[2] = 1; outMapping[3] = 0; return 4;
+        default:                                                                                                return 0;
+    }
+}
+
+static NullTexelFormat GetTexelFormat(const FormatAttributes& formatAttribs)
+{
+    NullTexelFormat format;
+
+    /* Compressed and packed formats have no texel storage in Null textures */
+    if ((formatAttribs.flags & (FormatFlags::IsCompressed | FormatFlags::IsPacked)) != 0)
+        return format;
+
+    format.dataType         = formatAttribs.dataType;
+    format.componentSize    = static_cast<std::uint32_t>(DataTypeSize(formatAttribs.dataType));
+    format.normalized       = ((formatAttribs.flags & FormatFlags::IsNormalized) != 0);
+    format.sRGB             = ((formatAttribs.flags & FormatFlags::IsColorSpace_sRGB) != 0);
+    format.integer          = ((formatAttribs.flags & FormatFlags::IsInteger) != 0 && !format.normalized);
+
+    if (formatAttribs.format == ImageFormat::Depth)
+    {
+        if (formatAttribs.dataType == DataType::UInt16)
+            format.decoder = NullTexelDecoder::D16UNorm;
+        else if (formatAttribs.dataType == DataType::Float32)
+            format.decoder = NullTexelDecoder::D32Float;
+        format.integer = false;
+    }
+    else if (formatAttribs.format == ImageFormat::DepthStencil)
+    {
+        if (formatAttribs.dataType == DataType::UInt16)
+            format.decoder = NullTexelDecoder::D24UNormS8UInt;
+        else if (formatAttribs.dataType == DataType::Float32)
+            format.decoder = NullTexelDecoder::D32Float;
+        format.integer = false;
+    }
+    else
+    {
+        format.numComponents = GetTexelComponentMapping(formatAttribs.format, format.mapping);
+        if (format.numComponents == 0 || format.componentSize == 0)
+            return format;
+
+        const bool isUNorm8x4 = (format.numComponents == 4 && format.dataType == DataType::UInt8 && format.normalized);
+        if (isUNorm8x4 && formatAttribs.format == ImageFormat::RGBA)
+            format.decoder = (format.sRGB ? NullTexelDecoder::RGBA8UNorm_sRGB : NullTexelDecoder::RGBA8UNorm);
+        else if (isUNorm8x4 && formatAttribs.format == ImageFormat::BGRA)
+            format.decoder = (format.sRGB ? NullTexelDecoder::BGRA8UNorm_sRGB : NullTexelDecoder::BGRA8UNorm);
+        else if (format.numComponents == 4 && format.dataType == DataType::Float32 && formatAttribs.format == ImageFormat::RGBA)
+            format.decoder = NullTexelDecoder::RGBA32Float;
+        else
+            format.decoder = NullTexelDecoder::Generic;
+    }
+
+    return format;
+}
+
+template <typename T>
+static T ReadTexelComponent(const char* src)
+{
+    T value;
+    ::memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+static float DecodeTexelComponent(const char* src, DataType dataType, bool normalized)
+{
+    switch (dataType)
+    {
+        case DataType::Int8:
+        {
+            const float value = static_cast<float>(ReadTexelComponent<std::int8_t>(src));
+            return (normalized ? std::max(value / 127.0f, -1.0f) : value);
+        }
+        case DataType::UInt8:
+        {
+            const float value = static_cast<float>(ReadTexelComponent<std::uint8_t>(src));
+            return (normalized ? value / 255.0f : value);
+        }
+        case DataType::Int16:
+        {
+            const float value = static_cast<float>(ReadTexelComponent<std::int16_t>(src));
+            return (normalized ? std::max(value / 32767.0f, -1.0f) : value);
+        }
+        case DataType::UInt16:
+        {
+            const float value = static_cast<float>(ReadTexelComponent<std::uint16_t>(src));
+            return (normalized ? value / 65535.0f : value);
+        }
+        case DataType::Int32:
+            return static_cast<float>(ReadTexelComponent<std::int32_t>(src));
+        case DataType::UInt32:
+            return static_cast<float>(ReadTexelComponent<std::uint32_t>(src));
+        case DataType::Float16:
+            return DecompressFloat16(ReadTexelComponent<std::uint16_t>(src));
+        case DataType::Float32:
+            return ReadTexelComponent<float>(src);
+        case DataType::Float64:
+            return static_cast<float>(ReadTexelComponent<double>(src));
+        default:
+            return 0.0f;
+    }
+}
+
+static NullTexelVec DecodeTexelSRGB8x4(const char* src, bool isBGRA)
+{
+    const float*    lut     = GetSRGBDecodeTable();
+    const auto*     bytes   = reinterpret_cast<const std::uint8_t*>(src);
+    const int       r       = (isBGRA ? 2 : 0);
+    return TexelSet(lut[bytes[r]], lut[bytes[1]], lut[bytes[2 - r]], static_cast<float>(bytes[3]) / 255.0f);
+}
+
+static NullTexelVec DecodeTexelGeneric(const NullTexelFormat& format, const char* src)
+{
+    /* Missing components default to (0, 0, 0, 1) */
+    float rgba[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    for_range(i, format.numComponents)
+        rgba[format.mapping[i]] = DecodeTexelComponent(src + i * format.componentSize, format.dataType, format.normalized);
+
+    /* Alpha is always stored in linear space */
+    if (format.sRGB && format.dataType == DataType::UInt8)
+    {
+        const float* lut = GetSRGBDecodeTable();
+        for_range(i, 3)
+            rgba[i] = lut[static_cast<int>(rgba[i] * 255.0f + 0.5f)];
+    }
+
+    return TexelLoad(rgba);
+}
+
+static NullTexelVec DecodeTexel(const NullTexelFormat& format, const char* src)
+{
+    switch (format.decoder)
+    {
+        case NullTexelDecoder::RGBA8UNorm:
+            return TexelDecodeUNorm8x4(src);
+        case NullTexelDecoder::BGRA8UNorm:
+            return TexelSwapRB(TexelDecodeUNorm8x4(src));
+        case NullTexelDecoder::RGBA8UNorm_sRGB:
+            return DecodeTexelSRGB8x4(src, false);
+        case NullTexelDecoder::BGRA8UNorm_sRGB:
+            return DecodeTexelSRGB8x4(src, true);
+        case NullTexelDecoder::RGBA32Float:
+        {
+            float rgba[4];
+            ::memcpy(rgba, src, sizeof(rgba));
+            return TexelLoad(rgba);
+        }
+        case NullTexelDecoder::D16UNorm:
+            return TexelSet(static_cast<float>(ReadTexelComponent<std::uint16_t>(src)) / 65535.0f, 0.0f, 0.0f, 1.0f);
+        case NullTexelDecoder::D24UNormS8UInt:
+            return TexelSet(static_cast<float>(ReadTexelComponent<std::uint32_t>(src) & 0x00FFFFFFu) / 16777215.0f, 0.0f, 0.0f, 1.0f);
+        case NullTexelDecoder::D32Float:
+            return TexelSet(ReadTexelComponent<float>(src), 0.0f, 0.0f, 1.0f);
+        case NullTexelDecoder::Generic:
+            return DecodeTexelGeneric(format, src);
+        default:
+            return TexelSet(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+}
+
+
+/*
+ * Sampling
+ */
+
+// States of a single sample that are shared by all texels of its footprint.
+struct NullSampleContext
+{
+    const NullSamplerImage* image;
+    NullTexelFormat         format;
+    int                     numDims;            // Number of dimensions addressed by normalized coordinates
+    int                     layerAxis;          // Storage axis the array layers are stored along (1 or 2), or 0 if not layered
+    std::uint32_t           layer;              // Storage coordinate of the array layer or cube face
+    SamplerAddressMode      addressModes[3];
+    CompareOp               compareOp;
+    const float*            compareRef;
+    NullTexelVec            borderColor;
+};
+
+static bool CompareDepth(const CompareOp compareOp, float ref, float depth)
+{
+    switch (compareOp)
+    {
+        case CompareOp::NeverPass:      return false;
+        case CompareOp::Less:           return (ref <  depth);
+        case CompareOp::Equal:          return (ref == depth);
+        case CompareOp::LessEqual:      return (ref <= depth);
+        case CompareOp::Greater:        return (ref >  depth);
+        case CompareOp::NotEqual:       return (ref != depth);
+        case CompareOp::GreaterEqual:   return (ref >= depth);
+        case CompareOp::AlwaysPass:     return true;
+        default:                        return false;
+    }
+}
+
+// Converts the float into an integer with saturation; NaN is mapped to zero.
+static std::int32_t FloorToInt(float value)
+{
+    const float clamped = std::max(-1073741824.0f, std::min(std::floor(value), 1073741824.0f));
+    return (clamped == clamped ? static_cast<std::int32_t>(clamped) : 0);
+}
+
+// Applies the address mode to the texel coordinate. Returns -1 for texels outside of the image that take the border color.
+static std::int32_t AddressTexel(const SamplerAddressMode mode, std::int32_t coord, std::uint32_t size)
+{
+    const std::int32_t n = static_cast<std::int32_t>(size);
+    switch (mode)
+    {
+        case SamplerAddressMode::Repeat:
+        {
+            const std::int32_t r = coord % n;
+            return (r < 0 ? r + n : r);
+        }
+        case SamplerAddressMode::Mirror:
+        {
+            const std::int32_t period = n * 2;
+            std::int32_t r = coord % period;
+            if (r < 0)
+                r += period;
+            return (r < n ? r : period - 1 - r);
+        }
+        case SamplerAddressMode::Border:
+            return (coord >= 0 && coord < n ? coord : -1);
+        case SamplerAddressMode::MirrorOnce:
+            return std::max(0, std::min(coord < 0 ? -coord - 1 : coord, n - 1));
+        default:
+            return std::max(0, std::min(coord, n - 1));
+    }
+}
+
+static NullTexelVec FetchTexel(const NullSampleContext& ctx, std::uint32_t mipLevel, std::int32_t x, std::int32_t y, std::int32_t z)
+{
+    NullTexelVec texel;
+    if (x < 0 || y < 0 || z < 0)
+        texel = ctx.borderColor;
+    else
+    {
+        std::uint32_t pos[3] = { static_cast<std::uint32_t>(x), static_cast<std::uint32_t>(y), static_cast<std::uint32_t>(z) };
+        if (ctx.layerAxis > 0)
+            pos[ctx.layerAxis] = ctx.layer;
+        texel = DecodeTexel(ctx.format, ctx.image->texture->GetTexelPtr(mipLevel, pos[0], pos[1], pos[2]));
+    }
+
+    /* Depth comparison is applied to each texel before filtering */
+    if (ctx.compareRef != nullptr)
+        texel = TexelSet((CompareDepth(ctx.compareOp, *ctx.compareRef, TexelGetR(texel)) ? 1.0f : 0.0f), 0.0f, 0.0f, 1.0f);
+
+    return texel;
+}
+
+// Samples a single MIP-map level of the image view with nearest or linear filtering.
+static NullTexelVec SampleLevel(const NullSampleContext& ctx, const float* uvw, std::uint32_t level, const SamplerFilter filter)
+{
+    const std::uint32_t mipLevel    = ctx.image->baseMipLevel + level;
+    const Extent3D&     extent      = ctx.image->texture->GetMipImageExtent(mipLevel);
+    const std::uint32_t size[3]     = { extent.width, (ctx.numDims >= 2 ? extent.height : 1u), (ctx.numDims == 3 ? extent.depth : 1u) };
+
+    if (filter == SamplerFilter::Nearest)
+    {
+        std::int32_t pos[3] = { 0, 0, 0 };
+        for_range(i, ctx.numDims)
+            pos[i] = AddressTexel(ctx.addressModes[i], FloorToInt(uvw[i] * static_cast<float>(size[i])), size[i]);
+        return FetchTexel(ctx, mipLevel, pos[0], pos[1], pos[2]);
+    }
+
+    /* Determine the two texels and their blend weight along each dimension */
+    std::int32_t    pos0[3]     = { 0, 0, 0 };
+    std::int32_t    pos1[3]     = { 0, 0, 0 };
+    float           weights[3]  = { 0.0f, 0.0f, 0.0f };
+
+    for_range(i, ctx.numDims)
+    {
+        const float         coord   = uvw[i] * static_cast<float>(size[i]) - 0.5f;
+        const std::int32_t  texel   = FloorToInt(coord);
+        weights[i]  = std::max(0.0f, std::min(coord - std::floor(coord), 1.0f));
+        pos0[i]     = AddressTexel(ctx.addressModes[i], texel, size[i]);
+        pos1[i]     = AddressTexel(ctx.addressModes[i], texel + 1, size[i]);
+    }
+
+    /* Blend the 2, 4, or 8 texels of the footprint; texels without weight are skipped */
+    NullTexelVec color = TexelZero();
+    for_range(i, 1u << ctx.numDims)
+    {
+        float weight = 1.0f;
+        std::int32_t pos[3] = { 0, 0, 0 };
+        for_range(dim, ctx.numDims)
+        {
+            const bool isUpper = (((i >> dim) & 1u) != 0);
+            weight      *= (isUpper ? weights[dim] : 1.0f - weights[dim]);
+            pos[dim]     = (isUpper ? pos1[dim] : pos0[dim]);
+        }
+        if (weight > 0.0f)
+            color = TexelMulAdd(color, FetchTexel(ctx, mipLevel, pos[0], pos[1], pos[2]), weight);
+    }
+
+    return color;
+}
+
+// Samples the image view with MIP-mapping at the specified level of detail (before LOD bias and clamping).
+static NullTexelVec SampleLevels(const SamplerDescriptor& desc, const NullSampleContext& ctx, const float* uvw, float lod)
+{
+    lod = std::max(desc.minLOD, std::min(lod + desc.mipMapLODBias, desc.maxLOD));
+
+    SamplerFilter filter = (lod > 0.0f ? desc.minFilter : desc.magFilter);
+    SamplerFilter mipMapFilter = desc.mipMapFilter;
+
+    /* Integer formats cannot be interpolated */
+    if (ctx.format.integer)
+        filter = mipMapFilter = SamplerFilter::Nearest;
+
+    const std::uint32_t maxLevel = ctx.image->numMipLevels - 1;
+    if (!desc.mipMapEnabled || maxLevel == 0 || !(lod > 0.0f))
+        return SampleLevel(ctx, uvw, 0, filter);
+
+    lod = std::min(lod, static_cast<float>(maxLevel));
+
+    if (mipMapFilter == SamplerFilter::Nearest)
+    {
+        /* Select nearest MIP-map level; half-way cases round down */
+        const std::uint32_t level = static_cast<std::uint32_t>(std::max(std::ceil(lod + 0.5f) - 1.0f, 0.0f));
+        return SampleLevel(ctx, uvw, std::min(level, maxLevel), filter);
+    }
+
+    const std::uint32_t level   = static_cast<std::uint32_t>(lod);
+    const float         blend   = lod - static_cast<float>(level);
+    NullTexelVec        color   = SampleLevel(ctx, uvw, level, filter);
+
+    if (blend > 0.0f && level < maxLevel)
+        color = TexelLerp(color, SampleLevel(ctx, uvw, level + 1, filter), blend);
+
+    return color;
+}
+
+// Returns the storage axis the array layers of the texture are stored along, or 0 if the texture is not layered.
+static int GetTextureLayerAxis(const TextureType type)
+{
+    switch (type)
+    {
+        case TextureType::Texture1DArray:
+            return 1;
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+        case TextureType::Texture2DMSArray:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+// Selects the cube face of the direction vector and returns its normalized face coordinates.
+static std::uint32_t SelectCubeFace(const float* dir, float (&outUV)[3])
+{
+    const float ax = std::abs(dir[0]);
+    const float ay = std::abs(dir[1]);
+    const float az = std::abs(dir[2]);
+
+    std::uint32_t face = 0;
+    float ma = 0.0f, sc = 0.0f, tc = 0.0f;
+
+    if (ax >= ay && ax >= az)
+    {
+        ma      = ax;
+        face    = (dir[0] >= 0.0f ? 0 : 1);
+        sc      = (dir[0] >= 0.0f ? -dir[2] : dir[2]);
+        tc      = -dir[1];
+    }
+    else if (ay >= az)
+    {
+        ma      = ay;
+        face    = (dir[1] >= 0.0f ? 2 : 3);
+        sc      = dir[0];
+        tc      = (dir[1] >= 0.0f ? dir[2] : -dir[2]);
+    }
+    else
+    {
+        ma      = az;
+        face    = (dir[2] >= 0.0f ? 4 : 5);
+        sc      = (dir[2] >= 0.0f ? dir[0] : -dir[0]);
+        tc      = -dir[1];
+    }
+
+    const float invMa = (ma > 0.0f ? 0.5f / ma : 0.0f);
+    outUV[0] = sc * invMa + 0.5f;
+    outUV[1] = tc * invMa + 0.5f;
+    outUV[2] = 0.0f;
+
+    return face;
+}
+
+// Returns the array layer index of the unnormalized layer coordinate.
+static std::uint32_t SelectArrayLayer(float layer, std::uint32_t numLayers)
+{
+    const std::int32_t index = FloorToInt(layer + 0.5f);
+    return static_cast<std::uint32_t>(std::max(0, std::min(index, static_cast<std::int32_t>(numLayers) - 1)));
+}
+
+// Initializes the sample context and maps the coordinates onto normalized coordinates of a single array layer or cube face.
+static bool SetupSample(
+    const SamplerDescriptor&    desc,
+    const NullSamplerImage&     image,
+    const float*                coords,
+    const float*                compareRef,
+    NullSampleContext&          outContext,
+    float                       (&outUVW)[3])
+{
+    if (image.texture == nullptr || image.formatAttribs == nullptr || image.numMipLevels == 0 || image.numArrayLayers == 0)
+        return false;
+
+    outContext.image            = &image;
+    outContext.format           = GetTexelFormat(*image.formatAttribs);
+    outContext.layerAxis        = GetTextureLayerAxis(image.texture->GetType());
+    outContext.layer            = image.baseArrayLayer;
+    outContext.addressModes[0]  = desc.addressModeU;
+    outContext.addressModes[1]  = desc.addressModeV;
+    outContext.addressModes[2]  = desc.addressModeW;
+    outContext.compareOp        = desc.compareOp;
+    outContext.compareRef       = compareRef;
+    outContext.borderColor      = TexelLoad(desc.borderColor);
+
+    if (outContext.format.decoder == NullTexelDecoder::Undefined)
+        return false;
+
+    outUVW[0] = coords[0];
+    outUVW[1] = 0.0f;
+    outUVW[2] = 0.0f;
+
+    switch (image.type)
+    {
+        case TextureType::Texture1D:
+            outContext.numDims = 1;
+            break;
+
+        case TextureType::Texture1DArray:
+            outContext.numDims = 1;
+            outContext.layer += SelectArrayLayer(coords[1], image.numArrayLayers);
+            break;
+
+        case TextureType::Texture2D:
+        case TextureType::Texture2DMS:
+            outContext.numDims = 2;
+            outUVW[1] = coords[1];
+            break;
+
+        case TextureType::Texture2DArray:
+        case TextureType::Texture2DMSArray:
+            outContext.numDims = 2;
+            outUVW[1] = coords[1];
+            outContext.layer += SelectArrayLayer(coords[2], image.numArrayLayers);
+            break;
+
+        case TextureType::Texture3D:
+            outContext.numDims = 3;
+            outUVW[1] = coords[1];
+            outUVW[2] = coords[2];
+            break;
+
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+        {
+            /* Cube faces are sampled without filtering across face edges */
+            outContext.numDims = 2;
+            outContext.addressModes[0] = SamplerAddressMode::Clamp;
+            outContext.addressModes[1] = SamplerAddressMode::Clamp;
+            const std::uint32_t face = SelectCubeFace(coords, outUVW);
+            const std::uint32_t cube = (image.type == TextureType::TextureCubeArray ? SelectArrayLayer(coords[3], std::max(1u, image.numArrayLayers / 6)) : 0u);
+            outContext.layer += std::min(cube * 6 + face, image.numArrayLayers - 1);
+        }
+        break;
+
+        default:
+            return false;
+    }
+
+    /* Non-layered views of layered textures still address their base array layer */
+    if (outContext.layerAxis == 0)
+        outContext.layer = 0;
+
+    return true;
+}
+
+static void StoreDefaultColor(float (&outColor)[4])
+{
+    outColor[0] = 0.0f;
+    outColor[1] = 0.0f;
+    outColor[2] = 0.0f;
+    outColor[3] = 1.0f;
+}
+
+void NullSampler::SampleLod(const NullSamplerImage& image, const float* coords, float lod, const float* compareRef, float (&outColor)[4]) const
+{
+    NullSampleContext ctx;
+    float uvw[3];
+    if (SetupSample(desc, image, coords, compareRef, ctx, uvw))
+        TexelStore(outColor, SampleLevels(desc, ctx, uvw, lod));
+    else
+        StoreDefaultColor(outColor);
+}
+
+static float GetVectorLength(const float* v, const float* scale, int n)
+{
+    float sum = 0.0f;
+    for_range(i, n)
+        sum += (v[i] * scale[i]) * (v[i] * scale[i]);
+    return std::sqrt(sum);
+}
+
+void NullSampler::SampleGrad(const NullSamplerImage& image, const float* coords, const float* ddx, const float* ddy, const float* compareRef, float (&outColor)[4]) const
+{
+    NullSampleContext ctx;
+    float uvw[3];
+    if (!SetupSample(desc, image, coords, compareRef, ctx, uvw))
+    {
+        StoreDefaultColor(outColor);
+        return;
+    }
+
+    /* Scale derivatives by the extent of the base MIP-map level to get the footprint in texels */
+    const Extent3D& extent = image.texture->GetMipImageExtent(image.baseMipLevel);
+    float scale[3] =
+    {
+        static_cast<float>(extent.width),
+        static_cast<float>(ctx.numDims >= 2 ? extent.height : 1u),
+        static_cast<float>(ctx.numDims == 3 ? extent.depth : 1u),
+    };
+
+    const bool isCube = (image.type == TextureType::TextureCube || image.type == TextureType::TextureCubeArray);
+    int numGradDims = ctx.numDims;
+
+    if (isCube)
+    {
+        /* Derivatives of the direction vector are projected onto the cube face by the major axis */
+        const float ma = std::max(std::abs(coords[0]), std::max(std::abs(coords[1]), std::abs(coords[2])));
+        const float faceScale = (ma > 0.0f ? scale[0] * 0.5f / ma : 0.0f);
+        scale[0] = scale[1] = scale[2] = faceScale;
+        numGradDims = 3;
+    }
+
+    const float lengthX = GetVectorLength(ddx, scale, numGradDims);
+    const float lengthY = GetVectorLength(ddy, scale, numGradDims);
+    const float maxLength = std::max(lengthX, lengthY);
+    const float minLength = std::min(lengthX, lengthY);
+
+    /* Cube faces are sampled isotropically, since anisotropic taps could cross face edges */
+    std::uint32_t numTaps = 1;
+    const std::uint32_t maxTaps = std::min(desc.maxAnisotropy, NullSampler::maxAnisotropy);
+    if (maxTaps > 1 && !isCube && maxLength > 0.0f)
+    {
+        const float ratio = (minLength > 0.0f ? std::ceil(maxLength / minLength) : static_cast<float>(maxTaps));
+        numTaps = static_cast<std::uint32_t>(std::min(ratio, static_cast<float>(maxTaps)));
+    }
+
+    const float lod = std::log2(std::max(maxLength / static_cast<float>(numTaps), 1.0e-30f));
+
+    if (numTaps == 1)
+    {
+        TexelStore(outColor, SampleLevels(desc, ctx, uvw, lod));
+        return;
+    }
+
+    /* Average taps along the major axis of the footprint */
+    const float* majorAxis = (lengthX >= lengthY ? ddx : ddy);
+    NullTexelVec color = TexelZero();
+
+    for_range(i, numTaps)
+    {
+        const float offset = (static_cast<float>(i) + 0.5f) / static_cast<float>(numTaps) - 0.5f;
+        float tapUVW[3] = { uvw[0], uvw[1], uvw[2] };
+        for_range(dim, ctx.numDims)
+            tapUVW[dim] += majorAxis[dim] * offset;
+        color = TexelMulAdd(color, SampleLevels(desc, ctx, tapUVW, lod), 1.0f);
+    }
+
+    TexelStore(outColor, TexelScale(color, 1.0f / static_cast<float>(numTaps)));
+}
+
 
 } // /namespace LLGL
 
@@ -10,13 +10,36 @@
 
 
 #include <LLGL/Sampler.h>
+#include <LLGL/SamplerFlags.h>
+#include <LLGL/TextureFlags.h>
 #include <string>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
+class NullTexture;
+struct FormatAttributes;
+
+// Texture view the sampling engine reads texels from.
+struct NullSamplerImage
+{
+    NullTexture*                texture;
+    TextureType                 type;           // Type of the texture view
+    const FormatAttributes*     formatAttribs;  // Format attributes of the texture view
+    std::uint32_t               baseMipLevel;
+    std::uint32_t               numMipLevels;
+    std::uint32_t               baseArrayLayer;
+    std::uint32_t               numArrayLayers; // Number of array layers including all cube faces
+};
+
+/*
+Sampler of the Null renderer with a software sampling engine for all uncompressed formats Null textures can store.
+Each texel is decoded into a vector of four floats, so a bilinear sample blends its 2x2 footprint with four vector operations
+and trilinear or 3D samples blend eight texels. Integer formats are always sampled with point filtering.
+*/
 class NullSampler final : public Sampler
 {
 
@@ -28,6 +51,24 @@ class NullSampler final : public Sampler
 
         NullSampler(const SamplerDescriptor& desc);
 
+        /*
+        Samples the image at the specified level of detail and writes the filtered RGBA color into 'outColor'.
+        Coordinates are normalized (a direction vector for cube textures), followed by the array layer for array textures.
+        If 'compareRef' is non-null, each texel is replaced by the result of the sampler's compare operation against its depth value.
+        */
+        void SampleLod(const NullSamplerImage& image, const float* coords, float lod, const float* compareRef, float (&outColor)[4]) const;
+
+        /*
+        Samples the image with the level of detail derived from the coordinate derivatives 'ddx' and 'ddy'.
+        Anisotropic samplers take up to 'maxAnisotropy' samples along the major axis of the footprint.
+        */
+        void SampleGrad(const NullSamplerImage& image, const float* coords, const float* ddx, const float* ddy, const float* compareRef, float (&outColor)[4]) const;
+
+    public:
+
+        // Maximum number of anisotropic samples along the major axis of the footprint; higher values of 'maxAnisotropy' are clamped.
+        static constexpr std::uint32_t maxAnisotropy = 16;
+
     public:
 
         const SamplerDescriptor desc;
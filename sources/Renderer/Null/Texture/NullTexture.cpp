@@ -6,9 +6,13 @@
  */
 
 #include "NullTexture.h"
+#include "NullMipGenerator.h"
+#include "../../TextureUtils.h"
+#include "../../../Core/Threading.h"
 #include <LLGL/TextureFlags.h>
 #include <LLGL/Utils/ForRange.h>
 #include <algorithm>
+#include <string.h>
 
 
 namespace LLGL
@@ -19,18 +23,22 @@ static TextureDescriptor MakeNullTextureDesc(const TextureDescriptor& inDesc)
 {
     auto outDesc = inDesc;
     outDesc.mipLevels = NumMipLevels(inDesc);
+    if (IsMultiSampleTexture(inDesc.type))
+        outDesc.samples = NullTexture::ClampSamples(inDesc.samples);
     return outDesc;
 }
 
 NullTexture::NullTexture(const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc) :
     Texture       { desc.type, desc.bindFlags },
     desc          { MakeNullTextureDesc(desc) },
-    extent_       { LLGL::GetMipExtent(desc)  }
+    extent_       { LLGL::GetMipExtent(desc)  },
+    numSamples_   { IsMultiSampleTexture(desc.type) ? this->desc.samples : 1u }
 {
     AllocImages();
     if (imageDesc != nullptr)
     {
-        Write(TextureRegion{ Offset3D{}, extent_ }, *imageDesc);
+        const TextureSubresource subresource{ 0, this->desc.arrayLayers, 0, 1 };
+        Write(TextureRegion{ subresource, Offset3D{}, this->desc.extent }, *imageDesc);
         if ((desc.miscFlags & MiscFlags::GenerateMips) != 0)
             GenerateMips();
     }
@@ -64,30 +72,291 @@ std::uint32_t NullTexture::ClampMipLevel(std::uint32_t mipLevel) const
     return std::min(mipLevel, desc.mipLevels - 1);
 }
 
+// Returns true if the region is inside the specified extent.
+static bool IsNullRegionInside(const Offset3D& offset, const Extent3D& extent, const Extent3D& limit)
+{
+    return
+    (
+        offset.x >= 0 && static_cast<std::uint32_t>(offset.x) + extent.width  <= limit.width  &&
+        offset.y >= 0 && static_cast<std::uint32_t>(offset.y) + extent.height <= limit.height &&
+        offset.z >= 0 && static_cast<std::uint32_t>(offset.z) + extent.depth  <= limit.depth
+    );
+}
+
+// Returns true if the image descriptor matches the storage format, so its data can be copied without conversion.
+template <typename TImageDescriptor>
+static bool IsNullImageDataCompatible(const Image& image, const Extent3D& extent, const TImageDescriptor& imageDesc)
+{
+    return
+    (
+        image.GetFormat()   == imageDesc.format     &&
+        image.GetDataType() == imageDesc.dataType   &&
+        imageDesc.dataSize  >= static_cast<std::size_t>(extent.width) * extent.height * extent.depth * image.GetBytesPerPixel()
+    );
+}
+
 void NullTexture::Write(const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
-    //todo
+    const auto& subresource = textureRegion.subresource;
+    if (subresource.baseMipLevel < desc.mipLevels && imageDesc.data != nullptr)
+    {
+        const std::uint32_t mipLevel = subresource.baseMipLevel;
+        const auto offset = CalcTextureOffset(GetType(), textureRegion.offset, subresource.baseArrayLayer);
+        const auto extent = CalcTextureExtent(GetType(), textureRegion.extent, subresource.numArrayLayers);
+
+        /* Pending fast clears must not overwrite the new texels later */
+        ResolveClears(mipLevel);
+
+        MipLevel& mip = mips_[mipLevel];
+        if (mip.numTilesX == 0)
+            mip.image.WritePixels(offset, extent, imageDesc);
+        else if (IsNullRegionInside(offset, extent, mip.extent))
+        {
+            const std::size_t rowStride = static_cast<std::size_t>(extent.width) * mip.image.GetBytesPerPixel();
+            if (IsNullImageDataCompatible(mip.image, extent, imageDesc))
+            {
+                /* Scatter rows of image data directly into the storage tiles */
+                const char* src = static_cast<const char*>(imageDesc.data);
+                CopyTexelRows(mipLevel, offset, extent, const_cast<char*>(src), rowStride, rowStride * extent.height, false);
+            }
+            else
+            {
+                /* Convert image data into a linear staging image first */
+                Image staging{ extent, mip.image.GetFormat(), mip.image.GetDataType() };
+                staging.WritePixels(Offset3D{}, extent, imageDesc);
+                CopyTexelRows(mipLevel, offset, extent, static_cast<char*>(staging.GetData()), rowStride, rowStride * extent.height, false);
+            }
+        }
+    }
 }
 
 void NullTexture::Read(const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
 {
-    //todo
+    const auto& subresource = textureRegion.subresource;
+    if (subresource.baseMipLevel < desc.mipLevels && imageDesc.data != nullptr)
+    {
+        const std::uint32_t mipLevel = subresource.baseMipLevel;
+        const auto offset = CalcTextureOffset(GetType(), textureRegion.offset, subresource.baseArrayLayer);
+        const auto extent = CalcTextureExtent(GetType(), textureRegion.extent, subresource.numArrayLayers);
+
+        ResolveClears(mipLevel);
+
+        MipLevel& mip = mips_[mipLevel];
+        if (mip.numTilesX == 0)
+            mip.image.ReadPixels(offset, extent, imageDesc);
+        else if (IsNullRegionInside(offset, extent, mip.extent))
+        {
+            const std::size_t rowStride = static_cast<std::size_t>(extent.width) * mip.image.GetBytesPerPixel();
+            if (IsNullImageDataCompatible(mip.image, extent, imageDesc))
+            {
+                /* Gather rows of the storage tiles directly into the image data */
+                CopyTexelRows(mipLevel, offset, extent, static_cast<char*>(imageDesc.data), rowStride, rowStride * extent.height, true);
+            }
+            else
+            {
+                /* Gather texels into a linear staging image first and convert them into the output format */
+                Image staging{ extent, mip.image.GetFormat(), mip.image.GetDataType() };
+                CopyTexelRows(mipLevel, offset, extent, static_cast<char*>(staging.GetData()), rowStride, rowStride * extent.height, true);
+                staging.ReadPixels(Offset3D{}, extent, imageDesc);
+            }
+        }
+    }
+}
+
+// Returns the image axis array layers are stored along: 1 for Y-axis, 2 for Z-axis, or 3 if the texture is not layered.
+static int GetImageLayerAxis(TextureType type)
+{
+    switch (type)
+    {
+        case TextureType::Texture1DArray:
+            return 1;
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+        case TextureType::Texture2DMSArray:
+            return 2;
+        default:
+            return 3;
+    }
 }
 
 void NullTexture::GenerateMips(const TextureSubresource* subresource)
 {
-    //todo
+    /* Base MIP-map level is the source of the first generated MIP-map level */
+    std::uint32_t baseMipLevel = 0, numMipLevels = desc.mipLevels, baseArrayLayer = 0, numArrayLayers = desc.arrayLayers;
+    if (subresource != nullptr)
+    {
+        baseMipLevel    = std::min(subresource->baseMipLevel, desc.mipLevels);
+        numMipLevels    = std::min(subresource->numMipLevels, desc.mipLevels - baseMipLevel);
+        baseArrayLayer  = std::min(subresource->baseArrayLayer, desc.arrayLayers);
+        numArrayLayers  = std::min(subresource->numArrayLayers, desc.arrayLayers - baseArrayLayer);
+    }
+
+    const long formatFlags = GetFormatAttribs(desc.format).flags;
+    const int layerAxis = GetImageLayerAxis(GetType());
+
+    for_subrange(mipLevel, baseMipLevel, baseMipLevel + numMipLevels)
+        ResolveClears(mipLevel);
+
+    Image linearSrc; // Linear copy of the previous tiled MIP-map level
+
+    for (std::uint32_t mipLevel = baseMipLevel + 1; mipLevel < baseMipLevel + numMipLevels; ++mipLevel)
+    {
+        MipLevel& dst = mips_[mipLevel];
+        if (!IsMipTiled(mipLevel - 1))
+        {
+            GenerateNullMipImage(dst.image, mips_[mipLevel - 1].image, layerAxis, baseArrayLayer, numArrayLayers, formatFlags);
+            continue;
+        }
+
+        /* Tiled MIP-map levels are downsampled via linear copies, and the linear copy of each destination is the source of the next MIP-map level */
+        if (mipLevel == baseMipLevel + 1)
+            linearSrc = LinearizeMip(mipLevel - 1);
+
+        if (IsMipTiled(mipLevel))
+        {
+            Image linearDst = LinearizeMip(mipLevel);
+            GenerateNullMipImage(linearDst, linearSrc, layerAxis, baseArrayLayer, numArrayLayers, formatFlags);
+            CopyTexelRows(mipLevel, Offset3D{}, dst.extent, static_cast<char*>(linearDst.GetData()), linearDst.GetRowStride(), linearDst.GetDepthStride(), false);
+            linearSrc = std::move(linearDst);
+        }
+        else
+            GenerateNullMipImage(dst.image, linearSrc, layerAxis, baseArrayLayer, numArrayLayers, formatFlags);
+    }
 }
 
 std::uint32_t NullTexture::PackSubresourceIndex(std::uint32_t mipLevel, std::uint32_t arrayLayer) const
 {
-    return mipLevel * desc.mipLevels + arrayLayer;
+    return mipLevel * desc.arrayLayers + arrayLayer;
 }
 
 void NullTexture::UnpackSubresourceIndex(std::uint32_t subresource, std::uint32_t& outMipLevel, std::uint32_t& outArrayLayer) const
 {
-    outMipLevel     = subresource / desc.mipLevels;
-    outArrayLayer   = subresource % desc.mipLevels;
+    outMipLevel     = subresource / desc.arrayLayers;
+    outArrayLayer   = subresource % desc.arrayLayers;
+}
+
+void NullTexture::CopyToLinear(std::uint32_t mipLevel, const Offset3D& offset, const Extent3D& extent, char* dst, std::size_t rowStride, std::size_t layerStride)
+{
+    ResolveClears(mipLevel);
+    CopyTexelRows(mipLevel, offset, extent, dst, rowStride, layerStride, true);
+}
+
+void NullTexture::CopyFromLinear(std::uint32_t mipLevel, const Offset3D& offset, const Extent3D& extent, const char* src, std::size_t rowStride, std::size_t layerStride)
+{
+    ResolveClears(mipLevel);
+    CopyTexelRows(mipLevel, offset, extent, const_cast<char*>(src), rowStride, layerStride, false);
+}
+
+constexpr std::uint32_t NullTexture::tileSize;
+constexpr std::size_t NullTexture::maxClearTexelSize;
+constexpr std::uint32_t NullTexture::maxSamples;
+
+std::uint32_t NullTexture::ClampSamples(std::uint32_t samples)
+{
+    std::uint32_t supportedSamples = 1;
+    while (supportedSamples * 2 <= std::min(samples, maxSamples))
+        supportedSamples *= 2;
+    return supportedSamples;
+}
+
+void NullTexture::FastClear(std::uint32_t mipLevel, std::uint32_t arrayLayer, const void* texel, const float (&values)[4])
+{
+    const std::uint32_t numLayers = GetNumClearLayers();
+    if (!(mipLevel < desc.mipLevels && arrayLayer < numLayers))
+        return;
+
+    const Extent3D& extent = mips_[mipLevel].extent;
+    if (GetType() == TextureType::Texture3D && arrayLayer >= extent.depth)
+        return;
+
+    const std::size_t texelSize = GetBytesPerTexel();
+    if (texelSize == 0 || texelSize > maxClearTexelSize)
+        return;
+
+    /* Allocate fast-clear states with the first fast clear of this texture */
+    if (clearStates_.empty())
+        clearStates_.resize(static_cast<std::size_t>(desc.mipLevels) * numLayers);
+
+    /* Mark all tiles as pending; previous pending clears are simply replaced */
+    const std::uint32_t height = (IsTexture1D() ? 1u : extent.height);
+
+    ClearState& state = clearStates_[mipLevel * numLayers + arrayLayer];
+    {
+        state.numTilesX = (extent.width + tileSize - 1) / tileSize;
+        state.pendingTiles.assign(static_cast<std::size_t>(state.numTilesX) * ((height + tileSize - 1) / tileSize), 1u);
+        state.hasPending = true;
+        ::memcpy(state.texel, texel, texelSize);
+        ::memcpy(state.values, values, sizeof(values));
+    }
+    hasPendingClears_ = true;
+}
+
+const float* NullTexture::GetTileClearValues(std::uint32_t mipLevel, std::uint32_t arrayLayer, std::uint32_t tileX, std::uint32_t tileY) const
+{
+    if (const ClearState* state = FindClearState(mipLevel, arrayLayer))
+    {
+        if (state->hasPending && state->pendingTiles[tileY * state->numTilesX + tileX] != 0)
+            return state->values;
+    }
+    return nullptr;
+}
+
+void NullTexture::ResolveTileClear(std::uint32_t mipLevel, std::uint32_t arrayLayer, std::uint32_t tileX, std::uint32_t tileY)
+{
+    if (ClearState* state = FindClearState(mipLevel, arrayLayer))
+    {
+        std::uint8_t& pending = state->pendingTiles[tileY * state->numTilesX + tileX];
+        if (state->hasPending && pending != 0)
+        {
+            FillTile(mipLevel, arrayLayer, tileX, tileY, *state);
+            pending = 0;
+        }
+    }
+}
+
+void NullTexture::DiscardTileClear(std::uint32_t mipLevel, std::uint32_t arrayLayer, std::uint32_t tileX, std::uint32_t tileY)
+{
+    if (ClearState* state = FindClearState(mipLevel, arrayLayer))
+    {
+        if (state->hasPending)
+            state->pendingTiles[tileY * state->numTilesX + tileX] = 0;
+    }
+}
+
+void NullTexture::ResolveClears(std::uint32_t mipLevel)
+{
+    if (!hasPendingClears_ || mipLevel >= desc.mipLevels)
+        return;
+
+    const std::uint32_t numLayers = GetNumClearLayers();
+    for_range(arrayLayer, numLayers)
+    {
+        ClearState& state = clearStates_[mipLevel * numLayers + arrayLayer];
+        if (!state.hasPending)
+            continue;
+
+        for_range(i, state.pendingTiles.size())
+        {
+            if (state.pendingTiles[i] != 0)
+            {
+                FillTile(mipLevel, arrayLayer, static_cast<std::uint32_t>(i % state.numTilesX), static_cast<std::uint32_t>(i / state.numTilesX), state);
+                state.pendingTiles[i] = 0;
+            }
+        }
+
+        state.hasPending = false;
+    }
+}
+
+void NullTexture::ResolveClears()
+{
+    if (hasPendingClears_)
+    {
+        for_range(mipLevel, desc.mipLevels)
+            ResolveClears(mipLevel);
+        hasPendingClears_ = false;
+    }
 }
 
 
@@ -95,17 +364,146 @@ void NullTexture::UnpackSubresourceIndex(std::uint32_t subresource, std::uint32_
  * ======= Private: =======
  */
 
+// Returns true if textures of the specified type and binding are stored in tiles. 1D and compressed textures are always stored in linear rows.
+static bool IsNullTextureTiled(const TextureDescriptor& desc)
+{
+    if (desc.type == TextureType::Texture1D || desc.type == TextureType::Texture1DArray || IsCompressedFormat(desc.format))
+        return false;
+    return ((desc.bindFlags & (BindFlags::Sampled | BindFlags::ColorAttachment | BindFlags::DepthStencilAttachment)) != 0);
+}
+
 void NullTexture::AllocImages()
 {
     const auto& formatAttribs = GetFormatAttribs(desc.format);
-    images_.reserve(desc.mipLevels);
+    const bool isTiled = IsNullTextureTiled(desc);
+
+    mips_.resize(desc.mipLevels);
     for_range(mipLevel, desc.mipLevels)
     {
-        const auto mipExtent = LLGL::GetMipExtent(GetType(), extent_, mipLevel);
-        images_.emplace_back(mipExtent, formatAttribs.format, formatAttribs.dataType);
+        /* Store all array layers (including cube faces) of a MIP-map level in a single image */
+        MipLevel& mip = mips_[mipLevel];
+        if (numSamples_ > 1)
+            mip.extent = Extent3D{ desc.extent.width, desc.extent.height, desc.arrayLayers * numSamples_ };
+        else
+            mip.extent = CalcTextureExtent(GetType(), LLGL::GetMipExtent(GetType(), desc.extent, mipLevel), desc.arrayLayers);
+
+        if (isTiled && mip.extent.width >= tileSize && mip.extent.height >= tileSize)
+        {
+            /* Store each tile in a single image row, so the depth stride still separates array layers */
+            mip.numTilesX = (mip.extent.width + tileSize - 1) / tileSize;
+            const std::uint32_t numTilesY = (mip.extent.height + tileSize - 1) / tileSize;
+            mip.image = Image{ Extent3D{ tileSize * tileSize, mip.numTilesX * numTilesY, mip.extent.depth }, formatAttribs.format, formatAttribs.dataType };
+        }
+        else
+            mip.image = Image{ mip.extent, formatAttribs.format, formatAttribs.dataType };
     }
 }
 
+// Minimum number of bytes per worker thread before a copy between tiled and linear memory is split across multiple threads.
+constexpr std::size_t g_minTileCopySizePerThread = 256 * 1024;
+
+void NullTexture::CopyTexelRows(
+    std::uint32_t   mipLevel,
+    const Offset3D& offset,
+    const Extent3D& extent,
+    char*           linear,
+    std::size_t     rowStride,
+    std::size_t     layerStride,
+    bool            toLinear)
+{
+    if (!IsNullRegionInside(offset, extent, mips_[mipLevel].extent) || extent.width == 0)
+        return;
+
+    const std::size_t bpp = GetBytesPerTexel();
+
+    auto CopyRows = [&](std::size_t begin, std::size_t end)
+    {
+        for_subrange(i, begin, end)
+        {
+            const std::uint32_t row     = static_cast<std::uint32_t>(i % extent.height);
+            const std::uint32_t layer   = static_cast<std::uint32_t>(i / extent.height);
+            const std::uint32_t y       = static_cast<std::uint32_t>(offset.y) + row;
+            const std::uint32_t z       = static_cast<std::uint32_t>(offset.z) + layer;
+            char*               dstRow  = linear + layer * layerStride + row * rowStride;
+
+            /* Split row at the boundaries of storage tiles */
+            for (std::uint32_t x = 0; x < extent.width;)
+            {
+                const std::uint32_t texelX      = static_cast<std::uint32_t>(offset.x) + x;
+                const std::uint32_t numTexels   = std::min(GetNumContiguousTexels(mipLevel, texelX), extent.width - x);
+                char*               texels      = GetTexelPtr(mipLevel, texelX, y, z);
+                if (toLinear)
+                    ::memcpy(dstRow + x * bpp, texels, numTexels * bpp);
+                else
+                    ::memcpy(texels, dstRow + x * bpp, numTexels * bpp);
+                x += numTexels;
+            }
+        }
+    };
+
+    const std::size_t numRowsTotal      = static_cast<std::size_t>(extent.height) * extent.depth;
+    const std::size_t minRowsPerThread  = std::max<std::size_t>(1, g_minTileCopySizePerThread / (extent.width * bpp));
+    DoConcurrentRange(CopyRows, numRowsTotal, Constants::maxThreadCount, static_cast<unsigned>(std::min<std::size_t>(minRowsPerThread, ~0u)));
+}
+
+Image NullTexture::LinearizeMip(std::uint32_t mipLevel)
+{
+    const MipLevel& mip = mips_[mipLevel];
+    Image image{ mip.extent, mip.image.GetFormat(), mip.image.GetDataType() };
+    CopyTexelRows(mipLevel, Offset3D{}, mip.extent, static_cast<char*>(image.GetData()), image.GetRowStride(), image.GetDepthStride(), true);
+    return image;
+}
+
+bool NullTexture::IsTexture1D() const
+{
+    return (GetType() == TextureType::Texture1D || GetType() == TextureType::Texture1DArray);
+}
+
+// Fast clears address the depth slices of 3D textures and the samples of multi-sampled textures like array layers.
+std::uint32_t NullTexture::GetNumClearLayers() const
+{
+    return (GetType() == TextureType::Texture3D ? desc.extent.depth : desc.arrayLayers * numSamples_);
+}
+
+NullTexture::ClearState* NullTexture::FindClearState(std::uint32_t mipLevel, std::uint32_t arrayLayer)
+{
+    const std::uint32_t numLayers = GetNumClearLayers();
+    if (clearStates_.empty() || mipLevel >= desc.mipLevels || arrayLayer >= numLayers)
+        return nullptr;
+    return &(clearStates_[mipLevel * numLayers + arrayLayer]);
+}
+
+const NullTexture::ClearState* NullTexture::FindClearState(std::uint32_t mipLevel, std::uint32_t arrayLayer) const
+{
+    const std::uint32_t numLayers = GetNumClearLayers();
+    if (clearStates_.empty() || mipLevel >= desc.mipLevels || arrayLayer >= numLayers)
+        return nullptr;
+    return &(clearStates_[mipLevel * numLayers + arrayLayer]);
+}
+
+void NullTexture::FillTile(std::uint32_t mipLevel, std::uint32_t arrayLayer, std::uint32_t tileX, std::uint32_t tileY, const ClearState& state)
+{
+    /* Clip tile against the extent of a single array layer */
+    const Extent3D&     extent  = mips_[mipLevel].extent;
+    const std::uint32_t height  = (IsTexture1D() ? 1u : extent.height);
+    const std::int32_t  x       = static_cast<std::int32_t>(tileX * tileSize);
+    const std::int32_t  y       = static_cast<std::int32_t>(tileY * tileSize);
+    const std::uint32_t width   = std::min(tileSize, extent.width - tileX * tileSize);
+    const std::uint32_t rows    = std::min(tileSize, height - tileY * tileSize);
+    const auto          offset  = (GetType() == TextureType::Texture3D || numSamples_ > 1 ? Offset3D{ x, y, static_cast<std::int32_t>(arrayLayer) } : CalcTextureOffset(GetType(), Offset3D{ x, y, 0 }, arrayLayer));
+
+    /* Replicate clear texel into first row of the tile and copy that row into all other rows; fast-clear tiles never cross storage tiles */
+    const std::size_t   bpp         = GetBytesPerTexel();
+    const std::size_t   rowStride   = GetTexelRowStride(mipLevel);
+    char*               firstRow    = GetTexelPtr(mipLevel, static_cast<std::uint32_t>(offset.x), static_cast<std::uint32_t>(offset.y), static_cast<std::uint32_t>(offset.z));
+
+    for_range(i, width)
+        ::memcpy(firstRow + i * bpp, state.texel, bpp);
+
+    for_subrange(row, 1u, rows)
+        ::memcpy(firstRow + row * rowStride, firstRow, width * bpp);
+}
+
 
 } // /namespace LLGL
 
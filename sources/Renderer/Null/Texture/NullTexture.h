@@ -45,19 +45,164 @@ class NullTexture final : public Texture
         std::uint32_t PackSubresourceIndex(std::uint32_t mipLevel, std::uint32_t arrayLayer) const;
         void UnpackSubresourceIndex(std::uint32_t subresource, std::uint32_t& outMipLevel, std::uint32_t& outArrayLayer) const;
 
+        // Returns the number of bytes per texel of this texture's format.
+        inline std::uint32_t GetBytesPerTexel() const
+        {
+            return mips_[0].image.GetBytesPerPixel();
+        }
+
+        // Returns the extent of the specified MIP-map level. All array layers are stored along the Y-axis (1D arrays) or Z-axis (otherwise).
+        inline const Extent3D& GetMipImageExtent(std::uint32_t mipLevel) const
+        {
+            return mips_[mipLevel].extent;
+        }
+
+        // Returns the number of samples per texel. This is 1 for all textures that are not multi-sampled.
+        inline std::uint32_t GetNumSamples() const
+        {
+            return numSamples_;
+        }
+
+        /*
+        Returns the storage layer of the specified sample of an array layer. Multi-sampled textures store each sample in its own layer.
+        The layers of sample 0 come first, so all accesses that are not sample aware address sample 0.
+        */
+        inline std::uint32_t GetSampleLayer(std::uint32_t arrayLayer, std::uint32_t sample) const
+        {
+            return (sample * desc.arrayLayers + arrayLayer);
+        }
+
+        // Returns true if the specified MIP-map level is stored in tiles of tileSize x tileSize texels rather than linear rows.
+        inline bool IsMipTiled(std::uint32_t mipLevel) const
+        {
+            return (mips_[mipLevel].numTilesX > 0);
+        }
+
+        /*
+        Returns a pointer to the texel at the specified position of a MIP-map level (see GetMipImageExtent) without resolving pending fast clears.
+        Texels are only contiguous in memory up to the end of their storage tile (see GetNumContiguousTexels).
+        */
+        inline char* GetTexelPtr(std::uint32_t mipLevel, std::uint32_t x, std::uint32_t y, std::uint32_t z)
+        {
+            MipLevel& mip = mips_[mipLevel];
+            char* layer = static_cast<char*>(mip.image.GetData()) + static_cast<std::size_t>(z) * mip.image.GetDepthStride();
+            if (mip.numTilesX > 0)
+            {
+                const std::size_t tileIndex = static_cast<std::size_t>(y / tileSize) * mip.numTilesX + x / tileSize;
+                const std::size_t texelIndex = tileIndex * (tileSize * tileSize) + (y % tileSize) * tileSize + (x % tileSize);
+                return layer + texelIndex * mip.image.GetBytesPerPixel();
+            }
+            return layer + static_cast<std::size_t>(y) * mip.image.GetRowStride() + static_cast<std::size_t>(x) * mip.image.GetBytesPerPixel();
+        }
+
+        // Returns the stride (in bytes) between two rows of texels within the same storage tile.
+        inline std::size_t GetTexelRowStride(std::uint32_t mipLevel) const
+        {
+            const MipLevel& mip = mips_[mipLevel];
+            return (mip.numTilesX > 0 ? tileSize * mip.image.GetBytesPerPixel() : mip.image.GetRowStride());
+        }
+
+        // Returns the number of texels that are contiguous in memory starting at the specified X coordinate of a MIP-map level.
+        inline std::uint32_t GetNumContiguousTexels(std::uint32_t mipLevel, std::uint32_t x) const
+        {
+            const MipLevel& mip = mips_[mipLevel];
+            return (mip.numTilesX > 0 ? tileSize - x % tileSize : mip.extent.width - x);
+        }
+
+        /*
+        Copies a region of the specified MIP-map level into linear memory or vice versa, converting from or to the storage tiles.
+        Offset and extent are specified in the coordinates of GetMipImageExtent. Pending fast clears of the MIP-map level are resolved first.
+        */
+        void CopyToLinear(std::uint32_t mipLevel, const Offset3D& offset, const Extent3D& extent, char* dst, std::size_t rowStride, std::size_t layerStride);
+        void CopyFromLinear(std::uint32_t mipLevel, const Offset3D& offset, const Extent3D& extent, const char* src, std::size_t rowStride, std::size_t layerStride);
+
+        /*
+        Marks all tiles of the specified subresource as cleared without writing any texels.
+        The texel is the clear value encoded in the texture format and 'values' is the clear value as it is loaded into rasterizer tile buffers.
+        For 3D textures, the array layer denotes the depth slice. For multi-sampled textures, it denotes the storage layer (see GetSampleLayer).
+        */
+        void FastClear(std::uint32_t mipLevel, std::uint32_t arrayLayer, const void* texel, const float (&values)[4]);
+
+        // Returns the clear value of the specified tile if it still has a pending fast clear, or null otherwise.
+        const float* GetTileClearValues(std::uint32_t mipLevel, std::uint32_t arrayLayer, std::uint32_t tileX, std::uint32_t tileY) const;
+
+        // Writes the pending clear value into all texels of the specified tile.
+        void ResolveTileClear(std::uint32_t mipLevel, std::uint32_t arrayLayer, std::uint32_t tileX, std::uint32_t tileY);
+
+        // Drops the pending clear value of the specified tile. Only valid if the caller overwrites all texels of the tile.
+        void DiscardTileClear(std::uint32_t mipLevel, std::uint32_t arrayLayer, std::uint32_t tileX, std::uint32_t tileY);
+
+        // Writes all pending clear values of the specified MIP-map level into its texels.
+        void ResolveClears(std::uint32_t mipLevel);
+
+        // Writes all pending clear values of all MIP-map levels into their texels.
+        void ResolveClears();
+
+    public:
+
+        /*
+        Width and height (in texels) of each storage tile and each fast-clear tile. This matches the tile size of the Null rasterizer,
+        so each rasterizer tile of a tiled attachment is a single contiguous block of memory.
+        */
+        static constexpr std::uint32_t tileSize = 64;
+
+        // Maximum size (in bytes) of an encoded clear texel, i.e. the size of an RGBA64Float texel.
+        static constexpr std::size_t maxClearTexelSize = 32;
+
+        // Maximum number of samples per texel of multi-sampled textures.
+        static constexpr std::uint32_t maxSamples = 16;
+
+        // Returns the supported number of samples for the requested number, i.e. the next lower power of two up to maxSamples.
+        static std::uint32_t ClampSamples(std::uint32_t samples);
+
     public:
 
         const TextureDescriptor desc;
 
+    private:
+
+        // Fast-clear state of a single subresource.
+        struct ClearState
+        {
+            std::vector<std::uint8_t>   pendingTiles;               // Non-zero for each tile whose texels have not been written since the last fast clear
+            std::uint32_t               numTilesX   = 0;
+            bool                        hasPending  = false;
+            char                        texel[maxClearTexelSize];   // Clear value encoded in the texture format
+            float                       values[4];                  // Clear value as it is loaded into tile buffers
+        };
+
+        // Storage of a single MIP-map level. Tiled MIP-map levels store each tile in a single row of their image, padded to whole tiles.
+        struct MipLevel
+        {
+            Image           image;
+            Extent3D        extent;         // Extent in texels including all array layers
+            std::uint32_t   numTilesX = 0;  // Number of storage tiles along the X-axis, or 0 if the MIP-map level is stored in linear rows
+        };
+
     private:
 
         void AllocImages();
 
+        void CopyTexelRows(std::uint32_t mipLevel, const Offset3D& offset, const Extent3D& extent, char* linear, std::size_t rowStride, std::size_t layerStride, bool toLinear);
+
+        Image LinearizeMip(std::uint32_t mipLevel);
+
+        bool IsTexture1D() const;
+
+        std::uint32_t GetNumClearLayers() const;
+        ClearState* FindClearState(std::uint32_t mipLevel, std::uint32_t arrayLayer);
+        const ClearState* FindClearState(std::uint32_t mipLevel, std::uint32_t arrayLayer) const;
+
+        void FillTile(std::uint32_t mipLevel, std::uint32_t arrayLayer, std::uint32_t tileX, std::uint32_t tileY, const ClearState& state);
+
     private:
 
-        std::string         label_;
-        Extent3D            extent_;
-        std::vector<Image>  images_; // MIP-map images
+        std::string             label_;
+        Extent3D                extent_;
+        std::uint32_t           numSamples_         = 1;
+        std::vector<MipLevel>   mips_;
+        std::vector<ClearState> clearStates_;       // Fast-clear states for each subresource; empty until the first fast clear
+        bool                    hasPendingClears_   = false;
 
 };
 
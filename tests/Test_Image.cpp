@@ -6,7 +6,11 @@
  */
 
 #include <LLGL/Utils/Image.h>
+#include <LLGL/ImageFlags.h>
 #include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <cmath>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
@@ -108,6 +112,236 @@ void Test_Resize()
     SaveImagePNG(img1, "Output/img1-resize-smaller.png");
 }
 
+// Returns the root-mean-square error of the first 'numComponents' components of two RGBA8 images. The decompressed image may be wider due to its block alignment.
+double GetRGBA8Error(const std::uint8_t* img, const LLGL::Extent2D& extent, const char* decompressed, std::uint32_t decompressedWidth, int numComponents)
+{
+    double error = 0.0;
+    for (std::uint32_t y = 0; y < extent.height; ++y)
+    {
+        for (std::uint32_t x = 0; x < extent.width; ++x)
+        {
+            for (int c = 0; c < numComponents; ++c)
+            {
+                const double delta = static_cast<double>(img[(y * extent.width + x) * 4 + c]) - static_cast<std::uint8_t>(decompressed[(y * decompressedWidth + x) * 4 + c]);
+                error += delta * delta;
+            }
+        }
+    }
+    return std::sqrt(error / (extent.width * extent.height * numComponents));
+}
+
+// Compresses the specified RGBA8 image and returns its error after decompressing it again.
+double CompressAndDecompressRGBA8(
+    const std::vector<std::uint8_t>&    img,
+    const LLGL::Extent2D&               extent,
+    LLGL::ImageFormat                   format,
+    LLGL::DataType                      dataType,
+    LLGL::ImageCompressionMode          mode,
+    int                                 numComponents)
+{
+    const LLGL::SrcImageDescriptor srcImageDesc{ LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, img.data(), img.size() };
+    auto compressed = LLGL::CompressImageBuffer(srcImageDesc, extent, format, dataType, mode, LLGL::Constants::maxThreadCount);
+
+    /* Decompression requires a multiple of the block size */
+    const LLGL::Extent2D blockExtent{ (extent.width + 3) / 4 * 4, (extent.height + 3) / 4 * 4 };
+    const std::size_t blockSize = (format == LLGL::ImageFormat::BC1 || format == LLGL::ImageFormat::BC4 ? 8 : 16);
+    const LLGL::SrcImageDescriptor compressedImageDesc{ format, dataType, compressed.get(), blockExtent.width * blockExtent.height / 16 * blockSize };
+    auto decompressed = LLGL::DecompressImageBufferToRGBA8UNorm(compressedImageDesc, blockExtent);
+
+    return GetRGBA8Error(img.data(), extent, decompressed.get(), blockExtent.width, numComponents);
+}
+
+void Test_BlockCompression()
+{
+    /* Generate a smooth gradient with an extent that is not a multiple of the block size */
+    const LLGL::Extent2D gradientExtent{ 131, 67 };
+    std::vector<std::uint8_t> gradient(gradientExtent.width * gradientExtent.height * 4);
+
+    for (std::uint32_t y = 0; y < gradientExtent.height; ++y)
+    {
+        for (std::uint32_t x = 0; x < gradientExtent.width; ++x)
+        {
+            auto pixel = &gradient[(y * gradientExtent.width + x) * 4];
+            pixel[0] = static_cast<std::uint8_t>(x * 255 / gradientExtent.width);
+            pixel[1] = static_cast<std::uint8_t>(y * 255 / gradientExtent.height);
+            pixel[2] = static_cast<std::uint8_t>((x + y) * 255 / (gradientExtent.width + gradientExtent.height));
+            pixel[3] = static_cast<std::uint8_t>(255 - x * 255 / gradientExtent.width);
+        }
+    }
+
+    struct TestFormat
+    {
+        LLGL::ImageFormat   format;
+        LLGL::DataType      dataType;
+        int                 numComponents;
+    };
+
+    const TestFormat testFormats[] =
+    {
+        { LLGL::ImageFormat::BC1, LLGL::DataType::UInt8, 3 },
+        { LLGL::ImageFormat::BC2, LLGL::DataType::UInt8, 4 },
+        { LLGL::ImageFormat::BC3, LLGL::DataType::UInt8, 4 },
+        { LLGL::ImageFormat::BC4, LLGL::DataType::UInt8, 1 },
+        { LLGL::ImageFormat::BC4, LLGL::DataType::Int8,  1 },
+        { LLGL::ImageFormat::BC5, LLGL::DataType::UInt8, 2 },
+        { LLGL::ImageFormat::BC5, LLGL::DataType::Int8,  2 },
+    };
+
+    /* BC1 is tested with opaque pixels, since transparent pixels are decompressed to black */
+    std::vector<std::uint8_t> gradientOpaque = gradient;
+    for (std::size_t i = 3; i < gradientOpaque.size(); i += 4)
+        gradientOpaque[i] = 255;
+
+    for (const auto& testFormat : testFormats)
+    {
+        const auto& img = (testFormat.format == LLGL::ImageFormat::BC1 ? gradientOpaque : gradient);
+        const double rangeFitError      = CompressAndDecompressRGBA8(img, gradientExtent, testFormat.format, testFormat.dataType, LLGL::ImageCompressionMode::RangeFit, testFormat.numComponents);
+        const double clusterFitError    = CompressAndDecompressRGBA8(img, gradientExtent, testFormat.format, testFormat.dataType, LLGL::ImageCompressionMode::ClusterFit, testFormat.numComponents);
+
+        std::cout << "BC" << (static_cast<int>(testFormat.format) - static_cast<int>(LLGL::ImageFormat::BC1) + 1);
+        std::cout << (testFormat.dataType == LLGL::DataType::Int8 ? " (signed)" : "");
+        std::cout << ": RMSE range fit = " << rangeFitError << ", cluster fit = " << clusterFitError << std::endl;
+
+        if (rangeFitError > 8.0 || clusterFitError > rangeFitError)
+            throw std::runtime_error("block compression error exceeds tolerance");
+    }
+
+    /*
+    Red and green checkerboard: both colors are exactly representable in RGB565,
+    but their principal axis (1, -1, 0) is orthogonal to a power iteration seed of (1, 1, 1)
+    */
+    const LLGL::Extent2D checkerboardExtent{ 8, 8 };
+    std::vector<std::uint8_t> checkerboard(checkerboardExtent.width * checkerboardExtent.height * 4);
+
+    for (std::uint32_t y = 0; y < checkerboardExtent.height; ++y)
+    {
+        for (std::uint32_t x = 0; x < checkerboardExtent.width; ++x)
+        {
+            auto pixel = &checkerboard[(y * checkerboardExtent.width + x) * 4];
+            const bool isRed = ((x + y) % 2 == 0);
+            pixel[0] = (isRed ? 255 : 0);
+            pixel[1] = (isRed ? 0 : 255);
+            pixel[2] = 0;
+            pixel[3] = 255;
+        }
+    }
+
+    for (auto mode : { LLGL::ImageCompressionMode::RangeFit, LLGL::ImageCompressionMode::ClusterFit })
+    {
+        for (auto format : { LLGL::ImageFormat::BC1, LLGL::ImageFormat::BC3 })
+        {
+            if (CompressAndDecompressRGBA8(checkerboard, checkerboardExtent, format, LLGL::DataType::UInt8, mode, 4) != 0.0)
+                throw std::runtime_error("block compression of red and green checkerboard is not lossless");
+        }
+    }
+
+    std::cout << "Block compression of red and green checkerboard: lossless" << std::endl;
+}
+
+void Test_BlockDecompression()
+{
+    /* Single 4x4 blocks with known RGBA8 output; rows 2 and 3 of each block repeat the pixels of rows 0 and 1 */
+    struct TestBlock
+    {
+        const char*         name;
+        LLGL::ImageFormat   format;
+        LLGL::DataType      dataType;
+        std::uint8_t        data[16];
+        std::uint8_t        expected[8][4];
+    };
+
+    const TestBlock testBlocks[] =
+    {
+        {
+            /* RGB565 endpoints (16, 32, 8) and (0, 0, 31) replicate their high bits into the low bits */
+            "BC1 four-color mode", LLGL::ImageFormat::BC1, LLGL::DataType::UInt8,
+            { 0x08,0x84, 0x1F,0x00, 0xE4,0x1B,0xE4,0x1B },
+            {
+                { 132,130, 66,255 }, {   0,  0,255,255 }, {  88, 87,129,255 }, {  44, 43,192,255 },
+                {  44, 43,192,255 }, {  88, 87,129,255 }, {   0,  0,255,255 }, { 132,130, 66,255 },
+            },
+        },
+        {
+            /* First endpoint is less than the second: index 2 is the midpoint and index 3 is transparent black */
+            "BC1 three-color mode", LLGL::ImageFormat::BC1, LLGL::DataType::UInt8,
+            { 0x1F,0x00, 0x00,0xF8, 0xE4,0x1B,0xE4,0x1B },
+            {
+                {   0,  0,255,255 }, { 255,  0,  0,255 }, { 127,  0,127,255 }, {   0,  0,  0,  0 },
+                {   0,  0,  0,  0 }, { 127,  0,127,255 }, { 255,  0,  0,255 }, {   0,  0,255,255 },
+            },
+        },
+        {
+            /* Explicit 4-bit alpha; the color block always uses four colors regardless of the endpoint order */
+            "BC2", LLGL::ImageFormat::BC2, LLGL::DataType::UInt8,
+            { 0xF0,0xE1,0xD2,0x78, 0xF0,0xE1,0xD2,0x78, 0x1F,0x00, 0x00,0xF8, 0xE4,0x1B,0xE4,0x1B },
+            {
+                {   0,  0,255,  0 }, { 255,  0,  0,255 }, {  85,  0,170, 17 }, { 170,  0, 85,238 },
+                { 170,  0, 85, 34 }, {  85,  0,170,221 }, { 255,  0,  0,136 }, {   0,  0,255,119 },
+            },
+        },
+        {
+            /* First alpha endpoint is not greater than the second: four interpolated values, zero, and one */
+            "BC3 six-value alpha", LLGL::ImageFormat::BC3, LLGL::DataType::UInt8,
+            { 40,200, 0x88,0xC6,0xFA,0x88,0xC6,0xFA, 0xFF,0xFF, 0x00,0x00, 0x00,0x00,0x00,0x00 },
+            {
+                { 255,255,255, 40 }, { 255,255,255,200 }, { 255,255,255, 72 }, { 255,255,255,104 },
+                { 255,255,255,136 }, { 255,255,255,168 }, { 255,255,255,  0 }, { 255,255,255,255 },
+            },
+        },
+        {
+            "BC4 eight-value mode", LLGL::ImageFormat::BC4, LLGL::DataType::UInt8,
+            { 255,0, 0x88,0xC6,0xFA,0x88,0xC6,0xFA },
+            {
+                { 255,  0,  0,255 }, {   0,  0,  0,255 }, { 219,  0,  0,255 }, { 182,  0,  0,255 },
+                { 146,  0,  0,255 }, { 109,  0,  0,255 }, {  73,  0,  0,255 }, {  36,  0,  0,255 },
+            },
+        },
+        {
+            /* Signed endpoints 127 and -128, where -128 is clamped to -127 and the range [-127, 127] is mapped to [0, 255] */
+            "BC4 signed eight-value mode", LLGL::ImageFormat::BC4, LLGL::DataType::Int8,
+            { 0x7F,0x80, 0x88,0xC6,0xFA,0x88,0xC6,0xFA },
+            {
+                { 255,  0,  0,255 }, {   0,  0,  0,255 }, { 219,  0,  0,255 }, { 182,  0,  0,255 },
+                { 146,  0,  0,255 }, { 109,  0,  0,255 }, {  73,  0,  0,255 }, {  36,  0,  0,255 },
+            },
+        },
+        {
+            "BC5", LLGL::ImageFormat::BC5, LLGL::DataType::UInt8,
+            { 40,200, 0x88,0xC6,0xFA,0x88,0xC6,0xFA, 255,0, 0x00,0x00,0x00,0x00,0x00,0x00 },
+            {
+                {  40,255,  0,255 }, { 200,255,  0,255 }, {  72,255,  0,255 }, { 104,255,  0,255 },
+                { 136,255,  0,255 }, { 168,255,  0,255 }, {   0,255,  0,255 }, { 255,255,  0,255 },
+            },
+        },
+        {
+            /* Signed six-value mode for red, where index 6 and 7 are -1 and 1, and signed zero for green */
+            "BC5 signed six-value mode", LLGL::ImageFormat::BC5, LLGL::DataType::Int8,
+            { 0x80,0x7F, 0x88,0xC6,0xFA,0x88,0xC6,0xFA, 0x00,0x00, 0x00,0x00,0x00,0x00,0x00,0x00 },
+            {
+                {   0,128,  0,255 }, { 255,128,  0,255 }, {  51,128,  0,255 }, { 102,128,  0,255 },
+                { 153,128,  0,255 }, { 204,128,  0,255 }, {   0,128,  0,255 }, { 255,128,  0,255 },
+            },
+        },
+    };
+
+    const LLGL::Extent2D blockExtent{ 4, 4 };
+
+    for (const auto& testBlock : testBlocks)
+    {
+        const std::size_t blockSize = (testBlock.format == LLGL::ImageFormat::BC1 || testBlock.format == LLGL::ImageFormat::BC4 ? 8 : 16);
+        const LLGL::SrcImageDescriptor blockImageDesc{ testBlock.format, testBlock.dataType, testBlock.data, blockSize };
+        auto decompressed = LLGL::DecompressImageBufferToRGBA8UNorm(blockImageDesc, blockExtent);
+
+        for (int i = 0; i < 16; ++i)
+        {
+            if (::memcmp(decompressed.get() + i * 4, testBlock.expected[i % 8], 4) != 0)
+                throw std::runtime_error(std::string("block decompression mismatch: ") + testBlock.name);
+        }
+    }
+
+    std::cout << "Block decompression of known BC1-BC5 blocks: passed" << std::endl;
+}
+
 int main(int argc, char* argv[])
 {
     try
@@ -115,6 +349,8 @@ int main(int argc, char* argv[])
         //Test_PixelOperations();
         //Test_Blit();
         Test_Resize();
+        Test_BlockDecompression();
+        Test_BlockCompression();
     }
     catch (const std::exception& e)
     {
@@ -0,0 +1,426 @@
+/*
+ * Test_Null.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utils/VertexFormat.h>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <cstdint>
+
+
+/*
+Headless tests for the Null renderer.
+Null shaders are not executed, so the rasterizer takes the vertex attributes "position" and "color" as clip-space position and output color.
+*/
+
+struct Vertex
+{
+    float position[4];
+    float color[4];
+};
+
+struct RGBA8
+{
+    std::uint8_t r, g, b, a;
+};
+
+static const std::uint32_t g_width  = 64;
+static const std::uint32_t g_height = 64;
+
+class NullTest
+{
+
+    public:
+
+        NullTest() :
+            renderer_ { LLGL::RenderSystem::Load("Null") }
+        {
+            vertexFormat_.AppendAttribute({ "position", LLGL::Format::RGBA32Float });
+            vertexFormat_.AppendAttribute({ "color",    LLGL::Format::RGBA32Float });
+
+            LLGL::ShaderDescriptor vertShaderDesc{ LLGL::ShaderType::Vertex, "" };
+            {
+                vertShaderDesc.sourceType           = LLGL::ShaderSourceType::CodeString;
+                vertShaderDesc.vertex.inputAttribs  = vertexFormat_.attributes;
+            }
+            vertShader_ = renderer_->CreateShader(vertShaderDesc);
+
+            LLGL::ShaderDescriptor fragShaderDesc{ LLGL::ShaderType::Fragment, "" };
+            {
+                fragShaderDesc.sourceType           = LLGL::ShaderSourceType::CodeString;
+            }
+            fragShader_ = renderer_->CreateShader(fragShaderDesc);
+
+            commandQueue_   = renderer_->GetCommandQueue();
+            commands_       = renderer_->CreateCommandBuffer();
+        }
+
+        void TestTriangle();
+        void TestDepthOverdraw();
+        void TestMultiSampleEdge();
+        void TestCopyTexture();
+        void TestPipelineCache();
+
+    private:
+
+        LLGL::Texture* CreateColorTexture(std::uint32_t width = g_width, std::uint32_t height = g_height)
+        {
+            LLGL::TextureDescriptor texDesc;
+            {
+                texDesc.type        = LLGL::TextureType::Texture2D;
+                texDesc.bindFlags   = LLGL::BindFlags::ColorAttachment | LLGL::BindFlags::Sampled | LLGL::BindFlags::CopySrc | LLGL::BindFlags::CopyDst;
+                texDesc.miscFlags   = 0;
+                texDesc.format      = LLGL::Format::RGBA8UNorm;
+                texDesc.extent      = { width, height, 1 };
+                texDesc.mipLevels   = 1;
+            }
+            return renderer_->CreateTexture(texDesc);
+        }
+
+        LLGL::RenderTarget* CreateRenderTarget(LLGL::Texture& colorTexture, LLGL::Format depthFormat, std::uint32_t samples = 1)
+        {
+            LLGL::RenderTargetDescriptor renderTargetDesc;
+            {
+                renderTargetDesc.resolution = { g_width, g_height };
+                renderTargetDesc.samples    = samples;
+                renderTargetDesc.attachments.push_back(LLGL::AttachmentDescriptor{ &colorTexture });
+                if (depthFormat != LLGL::Format::Undefined)
+                    renderTargetDesc.attachments.push_back(LLGL::AttachmentDescriptor{ depthFormat });
+            }
+            return renderer_->CreateRenderTarget(renderTargetDesc);
+        }
+
+        LLGL::GraphicsPipelineDescriptor GetPipelineDesc(const LLGL::RenderTarget& renderTarget, bool depthTest)
+        {
+            LLGL::GraphicsPipelineDescriptor pipelineDesc;
+            {
+                pipelineDesc.vertexShader                   = vertShader_;
+                pipelineDesc.fragmentShader                 = fragShader_;
+                pipelineDesc.renderPass                     = renderTarget.GetRenderPass();
+                pipelineDesc.depth.testEnabled              = depthTest;
+                pipelineDesc.depth.writeEnabled             = depthTest;
+                pipelineDesc.depth.compareOp                = LLGL::CompareOp::Less;
+                pipelineDesc.rasterizer.multiSampleEnabled  = (renderTarget.GetSamples() > 1);
+            }
+            return pipelineDesc;
+        }
+
+        LLGL::Buffer* CreateVertexBuffer(const std::vector<Vertex>& vertices)
+        {
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.size          = vertices.size() * sizeof(Vertex);
+                bufferDesc.bindFlags     = LLGL::BindFlags::VertexBuffer;
+                bufferDesc.vertexAttribs = vertexFormat_.attributes;
+            }
+            return renderer_->CreateBuffer(bufferDesc, vertices.data());
+        }
+
+        // Draws the vertices into the render target with the specified PSO, waits for the queue, and returns the color texture as RGBA8 pixels.
+        std::vector<RGBA8> Render(
+            LLGL::RenderTarget&     renderTarget,
+            LLGL::PipelineState&    pipelineState,
+            LLGL::Texture&          colorTexture,
+            const std::vector<Vertex>& vertices)
+        {
+            auto vertexBuffer = CreateVertexBuffer(vertices);
+
+            commands_->Begin();
+            {
+                commands_->SetVertexBuffer(*vertexBuffer);
+                commands_->BeginRenderPass(renderTarget);
+                {
+                    commands_->Clear(LLGL::ClearFlags::ColorDepth, LLGL::ClearValue{});
+                    commands_->SetPipelineState(pipelineState);
+                    commands_->Draw(static_cast<std::uint32_t>(vertices.size()), 0);
+                }
+                commands_->EndRenderPass();
+            }
+            commands_->End();
+            commandQueue_->Submit(*commands_);
+            commandQueue_->WaitIdle();
+
+            renderer_->Release(*vertexBuffer);
+
+            return ReadColorTexture(colorTexture);
+        }
+
+        std::vector<RGBA8> ReadColorTexture(LLGL::Texture& texture)
+        {
+            const LLGL::Extent3D extent = texture.GetMipExtent(0);
+            std::vector<RGBA8> pixels(extent.width * extent.height);
+            const LLGL::DstImageDescriptor imageDesc{ LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, pixels.data(), pixels.size() * sizeof(RGBA8) };
+            renderer_->ReadTexture(texture, LLGL::TextureRegion{ LLGL::Offset3D{}, extent }, imageDesc);
+            return pixels;
+        }
+
+    private:
+
+        LLGL::RenderSystemPtr               renderer_;
+        LLGL::VertexFormat                  vertexFormat_;
+        LLGL::Shader*                       vertShader_     = nullptr;
+        LLGL::Shader*                       fragShader_     = nullptr;
+        LLGL::CommandQueue*                 commandQueue_   = nullptr;
+        LLGL::CommandBuffer*                commands_       = nullptr;
+
+};
+
+static void ExpectPixel(const std::vector<RGBA8>& pixels, std::uint32_t x, std::uint32_t y, const RGBA8& expected, const char* test)
+{
+    const RGBA8& actual = pixels[y * g_width + x];
+    if (actual.r != expected.r || actual.g != expected.g || actual.b != expected.b || actual.a != expected.a)
+    {
+        throw std::runtime_error(
+            std::string(test) + ": pixel (" + std::to_string(x) + ", " + std::to_string(y) + ") is (" +
+            std::to_string(actual.r) + ", " + std::to_string(actual.g) + ", " + std::to_string(actual.b) + ", " + std::to_string(actual.a) +
+            "), expected (" +
+            std::to_string(expected.r) + ", " + std::to_string(expected.g) + ", " + std::to_string(expected.b) + ", " + std::to_string(expected.a) + ")"
+        );
+    }
+}
+
+// Appends two triangles that cover the rectangle [x0, x1] x [y0, y1] in normalized device coordinates at depth z.
+static void AppendQuad(std::vector<Vertex>& vertices, float x0, float y0, float x1, float y1, float z, float r, float g, float b)
+{
+    const Vertex v0{ { x0, y0, z, 1 }, { r, g, b, 1 } };
+    const Vertex v1{ { x1, y0, z, 1 }, { r, g, b, 1 } };
+    const Vertex v2{ { x1, y1, z, 1 }, { r, g, b, 1 } };
+    const Vertex v3{ { x0, y1, z, 1 }, { r, g, b, 1 } };
+    vertices.insert(vertices.end(), { v0, v3, v2, v0, v2, v1 });
+}
+
+static const RGBA8 g_black  = {   0,   0,   0,   0 };
+static const RGBA8 g_red    = { 255,   0,   0, 255 };
+static const RGBA8 g_green  = {   0, 255,   0, 255 };
+static const RGBA8 g_blue   = {   0,   0, 255, 255 };
+static const RGBA8 g_white  = { 255, 255, 255, 255 };
+
+void NullTest::TestTriangle()
+{
+    auto colorTexture   = CreateColorTexture();
+    auto renderTarget   = CreateRenderTarget(*colorTexture, LLGL::Format::Undefined);
+    auto pipelineState  = renderer_->CreatePipelineState(GetPipelineDesc(*renderTarget, false));
+
+    /* Triangle covers the upper-left half of the render target, i.e. all pixels with x + y < 63 */
+    const std::vector<Vertex> vertices =
+    {
+        { { -1, -1, 0, 1 }, { 1, 0, 0, 1 } },
+        { { -1,  1, 0, 1 }, { 1, 0, 0, 1 } },
+        { {  1,  1, 0, 1 }, { 1, 0, 0, 1 } },
+    };
+    auto pixels = Render(*renderTarget, *pipelineState, *colorTexture, vertices);
+
+    ExpectPixel(pixels,  4,  4, g_red,   "triangle");
+    ExpectPixel(pixels,  4, 50, g_red,   "triangle");
+    ExpectPixel(pixels, 50,  4, g_red,   "triangle");
+    ExpectPixel(pixels, 59, 59, g_black, "triangle");
+    ExpectPixel(pixels, 20, 50, g_black, "triangle");
+    ExpectPixel(pixels, 50, 20, g_black, "triangle");
+
+    renderer_->Release(*pipelineState);
+    renderer_->Release(*renderTarget);
+    renderer_->Release(*colorTexture);
+}
+
+void NullTest::TestDepthOverdraw()
+{
+    auto colorTexture   = CreateColorTexture();
+    auto renderTarget   = CreateRenderTarget(*colorTexture, LLGL::Format::D32Float);
+    auto pipelineState  = renderer_->CreatePipelineState(GetPipelineDesc(*renderTarget, true));
+
+    std::vector<Vertex> vertices;
+    AppendQuad(vertices, -1, -1, 1, 1, 0.5f, 1, 0, 0);  // Red full-screen quad
+    AppendQuad(vertices, -1, -1, 0, 1, 0.8f, 0, 1, 0);  // Green left half behind red quad
+    AppendQuad(vertices,  0, -1, 1, 1, 0.2f, 0, 0, 1);  // Blue right half in front of red quad
+
+    /* Overdraw many full-screen quads that are all hidden behind the previous ones */
+    for (int i = 0; i < 256; ++i)
+        AppendQuad(vertices, -1, -1, 1, 1, 0.9f, 1, 1, 1);
+
+    auto pixels = Render(*renderTarget, *pipelineState, *colorTexture, vertices);
+
+    ExpectPixel(pixels,  4,  4, g_red,  "depth overdraw");
+    ExpectPixel(pixels,  4, 59, g_red,  "depth overdraw");
+    ExpectPixel(pixels, 59,  4, g_blue, "depth overdraw");
+    ExpectPixel(pixels, 59, 59, g_blue, "depth overdraw");
+
+    renderer_->Release(*pipelineState);
+    renderer_->Release(*renderTarget);
+    renderer_->Release(*colorTexture);
+}
+
+void NullTest::TestMultiSampleEdge()
+{
+    auto colorTexture   = CreateColorTexture();
+    auto renderTarget   = CreateRenderTarget(*colorTexture, LLGL::Format::D32Float, 4);
+    auto pipelineState  = renderer_->CreatePipelineState(GetPipelineDesc(*renderTarget, true));
+
+    if (renderTarget->GetSamples() != 4)
+        throw std::runtime_error("multi-sample edge: render target has " + std::to_string(renderTarget->GetSamples()) + " samples, expected 4");
+
+    /* White triangle with a shallow diagonal edge, so the edge pixels are partially covered */
+    const std::vector<Vertex> vertices =
+    {
+        { { -1.0f, -1.0f, 0.5f, 1 }, { 1, 1, 1, 1 } },
+        { { -1.0f,  1.0f, 0.5f, 1 }, { 1, 1, 1, 1 } },
+        { {  0.7f,  1.0f, 0.5f, 1 }, { 1, 1, 1, 1 } },
+    };
+    auto pixels = Render(*renderTarget, *pipelineState, *colorTexture, vertices);
+
+    ExpectPixel(pixels,  2,  2, g_white, "multi-sample edge");
+    ExpectPixel(pixels, 60, 60, g_black, "multi-sample edge");
+
+    /* Resolved edge pixels must blend between the triangle and the clear color */
+    std::size_t numEdgePixels = 0;
+    for (const RGBA8& pixel : pixels)
+    {
+        if (pixel.r > 0 && pixel.r < 255)
+        {
+            if (pixel.r != pixel.g || pixel.r != pixel.b || pixel.r != pixel.a)
+                throw std::runtime_error("multi-sample edge: resolved edge pixel is not a uniform blend of white and the clear color");
+            ++numEdgePixels;
+        }
+    }
+    if (numEdgePixels < g_height / 2)
+        throw std::runtime_error("multi-sample edge: only " + std::to_string(numEdgePixels) + " partially covered pixels along the triangle edge");
+
+    renderer_->Release(*pipelineState);
+    renderer_->Release(*renderTarget);
+    renderer_->Release(*colorTexture);
+}
+
+void NullTest::TestCopyTexture()
+{
+    auto colorTexture   = CreateColorTexture();
+    auto renderTarget   = CreateRenderTarget(*colorTexture, LLGL::Format::Undefined);
+    auto pipelineState  = renderer_->CreatePipelineState(GetPipelineDesc(*renderTarget, false));
+
+    /* Render four colored quadrants */
+    std::vector<Vertex> vertices;
+    AppendQuad(vertices, -1,  0, 0, 1, 0, 1, 0, 0); // Upper-left red
+    AppendQuad(vertices,  0,  0, 1, 1, 0, 0, 1, 0); // Upper-right green
+    AppendQuad(vertices, -1, -1, 0, 0, 0, 0, 0, 1); // Lower-left blue
+    AppendQuad(vertices,  0, -1, 1, 0, 0, 1, 1, 1); // Lower-right white
+    auto srcPixels = Render(*renderTarget, *pipelineState, *colorTexture, vertices);
+
+    ExpectPixel(srcPixels,  4,  4, g_red,   "copy texture source");
+    ExpectPixel(srcPixels, 59,  4, g_green, "copy texture source");
+    ExpectPixel(srcPixels,  4, 59, g_blue,  "copy texture source");
+    ExpectPixel(srcPixels, 59, 59, g_white, "copy texture source");
+
+    /* Copy the center region that overlaps all four quadrants into another texture */
+    const std::uint32_t copySize = 32;
+    auto dstTexture = CreateColorTexture(copySize, copySize);
+
+    LLGL::BufferDescriptor bufferDesc;
+    {
+        bufferDesc.size             = g_width * g_height * sizeof(RGBA8);
+        bufferDesc.bindFlags        = LLGL::BindFlags::CopyDst;
+        bufferDesc.cpuAccessFlags   = LLGL::CPUAccessFlags::Read;
+    }
+    auto dstBuffer = renderer_->CreateBuffer(bufferDesc);
+
+    const LLGL::Offset3D srcOffset{ 16, 16, 0 };
+    const LLGL::Extent3D copyExtent{ copySize, copySize, 1 };
+
+    commands_->Begin();
+    {
+        commands_->CopyTexture(*dstTexture, LLGL::TextureLocation{}, *colorTexture, LLGL::TextureLocation{ srcOffset }, copyExtent);
+        commands_->CopyBufferFromTexture(*dstBuffer, 0, *colorTexture, LLGL::TextureRegion{ srcOffset, copyExtent });
+    }
+    commands_->End();
+    commandQueue_->Submit(*commands_);
+    commandQueue_->WaitIdle();
+
+    auto copiedPixels = ReadColorTexture(*dstTexture);
+
+    std::vector<RGBA8> bufferPixels(copySize * copySize);
+    renderer_->ReadBuffer(*dstBuffer, 0, bufferPixels.data(), bufferPixels.size() * sizeof(RGBA8));
+
+    for (std::uint32_t y = 0; y < copySize; ++y)
+    {
+        for (std::uint32_t x = 0; x < copySize; ++x)
+        {
+            const RGBA8& expected = srcPixels[(y + srcOffset.y) * g_width + (x + srcOffset.x)];
+            const RGBA8& copied = copiedPixels[y * copySize + x];
+            const RGBA8& buffered = bufferPixels[y * copySize + x];
+            if (copied.r != expected.r || copied.g != expected.g || copied.b != expected.b || copied.a != expected.a)
+                throw std::runtime_error("copy texture: texel (" + std::to_string(x) + ", " + std::to_string(y) + ") does not match the source region");
+            if (buffered.r != expected.r || buffered.g != expected.g || buffered.b != expected.b || buffered.a != expected.a)
+                throw std::runtime_error("copy buffer from texture: texel (" + std::to_string(x) + ", " + std::to_string(y) + ") does not match the source region");
+        }
+    }
+
+    renderer_->Release(*dstBuffer);
+    renderer_->Release(*dstTexture);
+    renderer_->Release(*pipelineState);
+    renderer_->Release(*renderTarget);
+    renderer_->Release(*colorTexture);
+}
+
+void NullTest::TestPipelineCache()
+{
+    auto colorTexture   = CreateColorTexture();
+    auto renderTarget   = CreateRenderTarget(*colorTexture, LLGL::Format::D32Float);
+
+    /* Create PSO and serialize it into a cache, then restore a second PSO from that cache */
+    std::unique_ptr<LLGL::Blob> pipelineCache;
+    auto pipelineState = renderer_->CreatePipelineState(GetPipelineDesc(*renderTarget, true), &pipelineCache);
+    if (!pipelineCache || pipelineCache->GetSize() == 0)
+        throw std::runtime_error("pipeline cache: no serialized cache was returned");
+
+    auto cachedPipelineState = renderer_->CreatePipelineState(*pipelineCache);
+
+    /* Both PSOs must render the same depth-tested image */
+    std::vector<Vertex> vertices;
+    AppendQuad(vertices, -1, -1, 1, 1, 0.5f, 1, 0, 0);
+    AppendQuad(vertices, -1, -1, 0, 1, 0.8f, 0, 1, 0);
+    AppendQuad(vertices,  0, -1, 1, 1, 0.2f, 0, 0, 1);
+
+    auto pixels         = Render(*renderTarget, *pipelineState, *colorTexture, vertices);
+    auto cachedPixels   = Render(*renderTarget, *cachedPipelineState, *colorTexture, vertices);
+
+    ExpectPixel(cachedPixels,  4, 32, g_red,  "pipeline cache");
+    ExpectPixel(cachedPixels, 59, 32, g_blue, "pipeline cache");
+
+    for (std::size_t i = 0; i < pixels.size(); ++i)
+    {
+        if (pixels[i].r != cachedPixels[i].r || pixels[i].g != cachedPixels[i].g || pixels[i].b != cachedPixels[i].b || pixels[i].a != cachedPixels[i].a)
+            throw std::runtime_error("pipeline cache: PSO restored from cache renders a different image");
+    }
+
+    renderer_->Release(*cachedPipelineState);
+    renderer_->Release(*pipelineState);
+    renderer_->Release(*renderTarget);
+    renderer_->Release(*colorTexture);
+}
+
+int main()
+{
+    try
+    {
+        NullTest test;
+        test.TestTriangle();
+        test.TestDepthOverdraw();
+        test.TestMultiSampleEdge();
+        test.TestCopyTexture();
+        test.TestPipelineCache();
+        std::cout << "Null renderer tests passed" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+
+// ================================================================================